@@ -141,6 +141,33 @@ BENCHMARK_CAPTURE(FHEW_BINGATE, STD128_XOR, STD128, XOR)->Unit(benchmark::kMicro
 
 BENCHMARK_CAPTURE(FHEW_BINGATE, STD128_XNOR, STD128, XNOR)->Unit(benchmark::kMicrosecond);
 
+// benchmark for binary gates with the external products of the accumulator computed by the FFT
+template <class ParamSet, class BinGate>
+void FHEW_BINGATE_FFT(benchmark::State& state, ParamSet param_set, BinGate bin_gate) {
+    BINGATE gate(bin_gate);
+    BINFHE_PARAMSET param(param_set);
+
+    BinFHEContext cc = GenerateFHEWContext(param);
+    cc.SetFFTAccumulator(true);
+
+    LWEPrivateKey sk = cc.KeyGen();
+
+    cc.BTKeyGen(sk);
+
+    LWECiphertext ct1 = cc.Encrypt(sk, 1);
+    LWECiphertext ct2 = cc.Encrypt(sk, 1);
+
+    for (auto _ : state) {
+        LWECiphertext ct11 = cc.EvalBinGate(gate, ct1, ct2);
+    }
+}
+
+BENCHMARK_CAPTURE(FHEW_BINGATE_FFT, MEDIUM_NAND, MEDIUM, NAND)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(FHEW_BINGATE_FFT, STD128_NAND, STD128, NAND)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(FHEW_BINGATE_FFT, STD128_XOR, STD128, XOR)->Unit(benchmark::kMicrosecond);
+
 // benchmark for key switching
 template <class ParamSet>
 void FHEW_KEYSWITCH(benchmark::State& state, ParamSet param_set) {
@@ -108,11 +108,35 @@ using namespace lbcrypto;
         b->ArgName("ringdm")->Arg(r);
 }
 
+// the IFMA kernel only handles moduli below 2^50 and falls back to AVX2 for larger ones
+[[maybe_unused]] static void RingKernelArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"ringdm", "kernel", "bits"});
+    for (uint32_t r : {1024, 4096, 8192}) {
+        for (auto k : {intnat::NTT_KERNEL_SCALAR, intnat::NTT_KERNEL_AVX2, intnat::NTT_KERNEL_AVX512IFMA}) {
+            for (uint32_t bits : {49, MAX_MODULUS_SIZE})
+                b->Args({r, k, bits});
+        }
+    }
+}
+
+[[maybe_unused]] static bool SetBenchmarkNTTKernel(benchmark::State& state) {
+    auto kernel = static_cast<intnat::NTTKernel>(state.range(1));
+    if (!intnat::IsNTTKernelSupported(kernel)) {
+        state.SkipWithError("NTT kernel is not supported by this CPU");
+        return false;
+    }
+    intnat::SetNTTKernel(kernel);
+    return true;
+}
+
 [[maybe_unused]] static void NativeNTT(benchmark::State& state) {
+    if (!SetBenchmarkNTTKernel(state))
+        return;
+
     uint32_t n = state.range(0);
     uint32_t m = n << 1;
 
-    NativeInteger modulusQ(LastPrime<NativeInteger>(MAX_MODULUS_SIZE, m));
+    NativeInteger modulusQ(LastPrime<NativeInteger>(state.range(2), m));
     NativeInteger rootOfUnity = RootOfUnity(m, modulusQ);
 
     DiscreteUniformGeneratorImpl<NativeVector> dug;
@@ -126,13 +150,17 @@ using namespace lbcrypto;
         crtFTT.ForwardTransformToBitReverse(x, rootOfUnity, m, &X);
 
     state.SetComplexityN(state.range(0));
+    intnat::SetNTTKernel(intnat::NTT_KERNEL_AUTO);
 }
 
 [[maybe_unused]] static void NativeINTT(benchmark::State& state) {
+    if (!SetBenchmarkNTTKernel(state))
+        return;
+
     uint32_t n = state.range(0);
     uint32_t m = n << 1;
 
-    NativeInteger modulusQ(LastPrime<NativeInteger>(MAX_MODULUS_SIZE, m));
+    NativeInteger modulusQ(LastPrime<NativeInteger>(state.range(2), m));
     NativeInteger rootOfUnity = RootOfUnity(m, modulusQ);
 
     DiscreteUniformGeneratorImpl<NativeVector> dug;
@@ -146,6 +174,7 @@ using namespace lbcrypto;
         crtFTT.InverseTransformFromBitReverse(x, rootOfUnity, m, &X);
 
     state.SetComplexityN(state.range(0));
+    intnat::SetNTTKernel(intnat::NTT_KERNEL_AUTO);
 }
 
 [[maybe_unused]] static void NativeNTTInPlace(benchmark::State& state) {
@@ -187,8 +216,8 @@ using namespace lbcrypto;
 }
 
 // BENCHMARK(NativeNTT)->Unit(benchmark::kMicrosecond)->RangeMultiplier(2)->Range(1<<10, 1<<16)->Complexity(benchmark::oAuto);
-BENCHMARK(NativeNTT)->Unit(benchmark::kMicrosecond)->Apply(RingArgs);          // ->Complexity(benchmark::oAuto);
-BENCHMARK(NativeINTT)->Unit(benchmark::kMicrosecond)->Apply(RingArgs);         // ->Complexity(benchmark::oAuto);
+BENCHMARK(NativeNTT)->Unit(benchmark::kMicrosecond)->Apply(RingKernelArgs);    // ->Complexity(benchmark::oAuto);
+BENCHMARK(NativeINTT)->Unit(benchmark::kMicrosecond)->Apply(RingKernelArgs);   // ->Complexity(benchmark::oAuto);
 BENCHMARK(NativeNTTInPlace)->Unit(benchmark::kMicrosecond)->Apply(RingArgs);   // ->Complexity(benchmark::oAuto);
 BENCHMARK(NativeINTTInPlace)->Unit(benchmark::kMicrosecond)->Apply(RingArgs);  // ->Complexity(benchmark::oAuto);
 
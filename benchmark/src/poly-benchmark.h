@@ -303,6 +303,42 @@ static void GenerateDCRTPolys(uint32_t order, uint32_t bits,
     }
 }
 
+// The scalar NTT variants are compared with the SIMD kernels disabled, otherwise the
+// variant is only used for moduli the vectorized kernels do not cover.
+static void NTTVariantArguments(benchmark::internal::Benchmark* b) {
+    b->ArgName("variant")->Arg(intnat::NTT_VARIANT_STANDARD)->Arg(intnat::NTT_VARIANT_HARVEY_LAZY);
+}
+
+[[maybe_unused]] static void Native_ntt_variant(benchmark::State& state) {
+    auto variant = intnat::GetNTTVariant();
+    intnat::SetNTTKernel(intnat::NTT_KERNEL_SCALAR);
+    intnat::SetNTTVariant(static_cast<intnat::NTTVariant>(state.range(0)));
+    std::shared_ptr<std::vector<NativePoly>> polys = NativepolysCoef;
+    NativePoly p;
+    size_t i{POLY_NUM_M1};
+    while (state.KeepRunning()) {
+        p = (*polys)[(i = (i + 1) & POLY_NUM_M1)];
+        p.SwitchFormat();
+    }
+    intnat::SetNTTVariant(variant);
+    intnat::SetNTTKernel(intnat::NTT_KERNEL_AUTO);
+}
+
+[[maybe_unused]] static void Native_intt_variant(benchmark::State& state) {
+    auto variant = intnat::GetNTTVariant();
+    intnat::SetNTTKernel(intnat::NTT_KERNEL_SCALAR);
+    intnat::SetNTTVariant(static_cast<intnat::NTTVariant>(state.range(0)));
+    std::shared_ptr<std::vector<NativePoly>> polys = NativepolysEval;
+    NativePoly p;
+    size_t i{POLY_NUM_M1};
+    while (state.KeepRunning()) {
+        p = (*polys)[(i = (i + 1) & POLY_NUM_M1)];
+        p.SwitchFormat();
+    }
+    intnat::SetNTTVariant(variant);
+    intnat::SetNTTKernel(intnat::NTT_KERNEL_AUTO);
+}
+
 // ************************************************************************************
 
 [[maybe_unused]] static void Native_CRTInterpolate(benchmark::State& state) {
@@ -386,6 +422,8 @@ BENCHMARK(Native_ntt)->Unit(benchmark::kMicrosecond);
 BENCHMARK(DCRT_ntt)->Unit(benchmark::kMicrosecond)->Apply(DCRTArguments);
 BENCHMARK(Native_intt)->Unit(benchmark::kMicrosecond);
 BENCHMARK(DCRT_intt)->Unit(benchmark::kMicrosecond)->Apply(DCRTArguments);
+BENCHMARK(Native_ntt_variant)->Unit(benchmark::kMicrosecond)->Apply(NTTVariantArguments);
+BENCHMARK(Native_intt_variant)->Unit(benchmark::kMicrosecond)->Apply(NTTVariantArguments);
 // BENCHMARK(Native_ntt_intt)->Unit(benchmark::kMicrosecond);
 // BENCHMARK(DCRT_ntt_intt)->Unit(benchmark::kMicrosecond)->Apply(DCRTArguments);
 // BENCHMARK(Native_intt_ntt)->Unit(benchmark::kMicrosecond);
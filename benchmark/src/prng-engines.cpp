@@ -0,0 +1,180 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+  Description:
+  This code compares the built-in PRNG engines (BLAKE2, AES-CTR and ChaCha20): the raw throughput of
+  PRNG::Fill() and the throughput of the CKKS and BFV operations dominated by sampling (key generation
+  and public-key encryption).
+ */
+
+#define _USE_MATH_DEFINES
+
+#include "benchmark/benchmark.h"
+#include "math/distributiongenerator.h"
+#include "scheme/ckksrns/gen-cryptocontext-ckksrns.h"
+#include "scheme/bfvrns/gen-cryptocontext-bfvrns.h"
+#include "gen-cryptocontext.h"
+#include "cryptocontext.h"
+#include "utils/prng/aesctrengine.h"
+
+#include <vector>
+
+using namespace lbcrypto;
+
+static void EngineArgs(benchmark::internal::Benchmark* b) {
+    b->ArgName("engine");
+    for (auto e : {PRNG_BLAKE2, PRNG_AES_CTR, PRNG_CHACHA20})
+        b->Arg(e);
+}
+
+static bool SetBenchmarkPRNGEngine(benchmark::State& state) {
+    auto engine = static_cast<PRNGEngineType>(state.range(0));
+    if (engine == PRNG_AES_CTR && !default_prng::AESCTREngine::IsSupported()) {
+        state.SkipWithError("AES-CTR engine is not supported by this CPU");
+        return false;
+    }
+    PseudoRandomNumberGenerator::SetPRNGEngine(engine);
+    state.SetLabel(engine == PRNG_BLAKE2 ? "BLAKE2" : (engine == PRNG_AES_CTR ? "AES-CTR" : "ChaCha20"));
+    return true;
+}
+
+static CryptoContext<DCRTPoly> GenerateCKKSContext() {
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetScalingModSize(50);
+    parameters.SetMultiplicativeDepth(10);
+    parameters.SetRingDim(1 << 15);
+    auto cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+    return cc;
+}
+
+static CryptoContext<DCRTPoly> GenerateBFVrnsContext() {
+    CCParams<CryptoContextBFVRNS> parameters;
+    parameters.SetPlaintextModulus(65537);
+    parameters.SetMultiplicativeDepth(4);
+    auto cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+    return cc;
+}
+
+static void PRNG_Fill(benchmark::State& state) {
+    if (!SetBenchmarkPRNGEngine(state))
+        return;
+    std::vector<uint64_t> buffer(1 << 16);
+    PRNG& prng = PseudoRandomNumberGenerator::GetPRNG();
+    while (state.KeepRunning()) {
+        prng.Fill(buffer.data(), buffer.size() * sizeof(buffer[0]));
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    state.SetBytesProcessed(state.iterations() * buffer.size() * sizeof(buffer[0]));
+}
+
+BENCHMARK(PRNG_Fill)->Unit(benchmark::kMicrosecond)->Apply(EngineArgs);
+
+static void CKKSrns_KeyGen(benchmark::State& state) {
+    if (!SetBenchmarkPRNGEngine(state))
+        return;
+    auto cc = GenerateCKKSContext();
+    while (state.KeepRunning()) {
+        auto keyPair = cc->KeyGen();
+        benchmark::DoNotOptimize(keyPair);
+    }
+}
+
+BENCHMARK(CKKSrns_KeyGen)->Unit(benchmark::kMillisecond)->Apply(EngineArgs);
+
+// EvalMultKeyGen() and EvalRotateKeyGen() keep the keys they generated, so KeySwitchGen() is measured instead
+static void CKKSrns_KeySwitchGen(benchmark::State& state) {
+    if (!SetBenchmarkPRNGEngine(state))
+        return;
+    auto cc       = GenerateCKKSContext();
+    auto keyPair1 = cc->KeyGen();
+    auto keyPair2 = cc->KeyGen();
+    while (state.KeepRunning()) {
+        auto evalKey = cc->KeySwitchGen(keyPair1.secretKey, keyPair2.secretKey);
+        benchmark::DoNotOptimize(evalKey);
+    }
+}
+
+BENCHMARK(CKKSrns_KeySwitchGen)->Unit(benchmark::kMillisecond)->Apply(EngineArgs);
+
+static void CKKSrns_Encrypt(benchmark::State& state) {
+    if (!SetBenchmarkPRNGEngine(state))
+        return;
+    auto cc      = GenerateCKKSContext();
+    auto keyPair = cc->KeyGen();
+
+    std::vector<double> vectorOfInts(cc->GetEncodingParams()->GetBatchSize(), 0.5);
+    auto plaintext = cc->MakeCKKSPackedPlaintext(vectorOfInts);
+    while (state.KeepRunning()) {
+        auto ciphertext = cc->Encrypt(keyPair.publicKey, plaintext);
+        benchmark::DoNotOptimize(ciphertext);
+    }
+}
+
+BENCHMARK(CKKSrns_Encrypt)->Unit(benchmark::kMillisecond)->Apply(EngineArgs);
+
+static void BFVrns_KeyGen(benchmark::State& state) {
+    if (!SetBenchmarkPRNGEngine(state))
+        return;
+    auto cc = GenerateBFVrnsContext();
+    while (state.KeepRunning()) {
+        auto keyPair = cc->KeyGen();
+        benchmark::DoNotOptimize(keyPair);
+    }
+}
+
+BENCHMARK(BFVrns_KeyGen)->Unit(benchmark::kMicrosecond)->Apply(EngineArgs);
+
+static void BFVrns_Encrypt(benchmark::State& state) {
+    if (!SetBenchmarkPRNGEngine(state))
+        return;
+    auto cc      = GenerateBFVrnsContext();
+    auto keyPair = cc->KeyGen();
+
+    std::vector<int64_t> vectorOfInts(cc->GetEncodingParams()->GetBatchSize(), 1);
+    auto plaintext = cc->MakePackedPlaintext(vectorOfInts);
+    while (state.KeepRunning()) {
+        auto ciphertext = cc->Encrypt(keyPair.publicKey, plaintext);
+        benchmark::DoNotOptimize(ciphertext);
+    }
+}
+
+BENCHMARK(BFVrns_Encrypt)->Unit(benchmark::kMicrosecond)->Apply(EngineArgs);
+
+// execute the benchmarks
+BENCHMARK_MAIN();
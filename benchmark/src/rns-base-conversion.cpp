@@ -0,0 +1,138 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Description:
+  This code benchmarks the RNS base conversions behind hybrid key switching (ApproxSwitchCRTBasis,
+  used by ApproxModUp/ApproxModDown) and BFV basis extension (SwitchCRTBasis, used by ExpandCRTBasis).
+ */
+
+#define _USE_MATH_DEFINES
+
+#include "benchmark/benchmark.h"
+#include "lattice/lat-hal.h"
+
+#include <map>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+using namespace lbcrypto;
+
+// polynomial over Q and the precomputations of the conversion from Q to P
+struct BaseConvSetup {
+    std::shared_ptr<ILDCRTParams<BigInteger>> paramsQ;
+    std::shared_ptr<ILDCRTParams<BigInteger>> paramsP;
+    DCRTPoly x;
+    std::vector<NativeInteger> QHatInvModq;
+    std::vector<NativeInteger> QHatInvModqPrecon;
+    // (Q/q_i) mod p_j indexed [i][j] for the approximate and [j][i] for the exact conversion
+    std::vector<std::vector<NativeInteger>> QHatModp;
+    std::vector<std::vector<NativeInteger>> QHatModpT;
+    std::vector<std::vector<NativeInteger>> alphaQModp;
+    std::vector<DoubleNativeInt> modpBarrettMu;
+    std::vector<double> qInv;
+};
+
+static std::shared_ptr<BaseConvSetup> GetSetup(uint32_t ringDim, uint32_t sizeQ, uint32_t sizeP) {
+    static std::map<std::tuple<uint32_t, uint32_t, uint32_t>, std::shared_ptr<BaseConvSetup>> setups;
+    auto& setup = setups[std::make_tuple(ringDim, sizeQ, sizeP)];
+    if (setup)
+        return setup;
+
+    setup          = std::make_shared<BaseConvSetup>();
+    setup->paramsQ = std::make_shared<ILDCRTParams<BigInteger>>(2 * ringDim, sizeQ, 50);
+    setup->paramsP = std::make_shared<ILDCRTParams<BigInteger>>(2 * ringDim, sizeP, 60);
+
+    const BigInteger Q(setup->paramsQ->GetModulus());
+    setup->QHatInvModq.resize(sizeQ);
+    setup->QHatInvModqPrecon.resize(sizeQ);
+    setup->QHatModp.assign(sizeQ, std::vector<NativeInteger>(sizeP));
+    setup->QHatModpT.assign(sizeP, std::vector<NativeInteger>(sizeQ));
+    setup->alphaQModp.assign(sizeQ + 1, std::vector<NativeInteger>(sizeP));
+    setup->modpBarrettMu.resize(sizeP);
+    setup->qInv.resize(sizeQ);
+    for (uint32_t i = 0; i < sizeQ; ++i) {
+        const NativeInteger& qi = setup->paramsQ->GetParams()[i]->GetModulus();
+        const BigInteger QHati  = Q / BigInteger(qi);
+        setup->QHatInvModq[i]   = NativeInteger((QHati % BigInteger(qi)).ConvertToInt()).ModInverse(qi);
+        setup->QHatInvModqPrecon[i] = setup->QHatInvModq[i].PrepModMulConst(qi);
+        setup->qInv[i]              = 1. / static_cast<double>(qi.ConvertToInt());
+        for (uint32_t j = 0; j < sizeP; ++j) {
+            const BigInteger pj(setup->paramsP->GetParams()[j]->GetModulus());
+            setup->QHatModp[i][j] = setup->QHatModpT[j][i] = NativeInteger((QHati % pj).ConvertToInt());
+        }
+    }
+    for (uint32_t j = 0; j < sizeP; ++j) {
+        const BigInteger pj(setup->paramsP->GetParams()[j]->GetModulus());
+        for (uint32_t a = 0; a <= sizeQ; ++a)
+            setup->alphaQModp[a][j] = NativeInteger(((BigInteger(a) * Q) % pj).ConvertToInt());
+        setup->modpBarrettMu[j] = (BigInteger(1).LShiftEq(128) / pj).ConvertToInt<DoubleNativeInt>();
+    }
+
+    DCRTPoly::DugType dug;
+    setup->x = DCRTPoly(dug, setup->paramsQ, Format::COEFFICIENT);
+    return setup;
+}
+
+static void BaseConvArguments(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"ringDim", "sizeQ", "sizeP"});
+    for (int64_t ringDim : {1 << 14, 1 << 16}) {
+        b->Args({ringDim, 4, 2});
+        b->Args({ringDim, 12, 4});
+        b->Args({ringDim, 24, 8});
+    }
+}
+
+static void DCRT_ApproxSwitchCRTBasis(benchmark::State& state) {
+    auto s = GetSetup(state.range(0), state.range(1), state.range(2));
+    while (state.KeepRunning()) {
+        auto ans = s->x.ApproxSwitchCRTBasis(s->paramsQ, s->paramsP, s->QHatInvModq, s->QHatInvModqPrecon, s->QHatModp,
+                                             s->modpBarrettMu);
+        benchmark::DoNotOptimize(ans);
+    }
+}
+
+BENCHMARK(DCRT_ApproxSwitchCRTBasis)->Unit(benchmark::kMicrosecond)->Apply(BaseConvArguments);
+
+static void DCRT_SwitchCRTBasis(benchmark::State& state) {
+    auto s = GetSetup(state.range(0), state.range(1), state.range(2));
+    while (state.KeepRunning()) {
+        auto ans = s->x.SwitchCRTBasis(s->paramsP, s->QHatInvModq, s->QHatInvModqPrecon, s->QHatModpT, s->alphaQModp,
+                                       s->modpBarrettMu, s->qInv);
+        benchmark::DoNotOptimize(ans);
+    }
+}
+
+BENCHMARK(DCRT_SwitchCRTBasis)->Unit(benchmark::kMicrosecond)->Apply(BaseConvArguments);
+
+// execute the benchmarks
+BENCHMARK_MAIN();
@@ -43,9 +43,13 @@
 #include <limits>
 #include <iterator>
 #include <random>
+#include <sstream>
+#include <string>
+#include <vector>
 
 #include "cryptocontext-ser.h"
 #include "ciphertext-ser.h"
+#include "ciphertext-wire.h"
 #include "scheme/ckksrns/ckksrns-ser.h"
 #include "scheme/ckksrns/gen-cryptocontext-ckksrns.h"
 #include "gen-cryptocontext.h"
@@ -121,4 +125,93 @@ void CKKS_serialize(benchmark::State& state) {
 
 BENCHMARK(CKKS_serialize)->Unit(benchmark::kMicrosecond)->MinTime(10.0);
 
+// ciphertext of the given ring dimension, depth and scaling modulus size
+static Ciphertext<DCRTPoly> MakeCiphertext(uint32_t ringDim, uint32_t depth, uint32_t scaleModSize) {
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetRingDim(ringDim);
+    parameters.SetMultiplicativeDepth(depth);
+    parameters.SetScalingModSize(scaleModSize);
+    parameters.SetFirstModSize(scaleModSize + 10);
+    parameters.SetSecurityLevel(HEStd_NotSet);
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+
+    KeyPair<DCRTPoly> kp            = cc->KeyGen();
+    std::vector<double> vals        = {1.0, 3.0, 5.0, 7.0, 9.0, 2.0, 4.0, 6.0, 8.0, 11.0};
+    Ciphertext<DCRTPoly> ciphertext = cc->Encrypt(kp.publicKey, cc->MakeCKKSPackedPlaintext(vals));
+    return ciphertext;
+}
+
+static void CiphertextArguments(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"ringDim", "depth", "scaleModSize"});
+    for (int64_t scaleModSize : {36, 50}) {
+        b->Args({1 << 14, 10, scaleModSize});
+        b->Args({1 << 16, 20, scaleModSize});
+    }
+}
+
+// throughput is reported in serialized bytes
+void CKKS_SerializeCiphertext(benchmark::State& state) {
+    auto ciphertext = MakeCiphertext(state.range(0), state.range(1), state.range(2));
+    size_t bytes    = 0;
+    while (state.KeepRunning()) {
+        std::stringstream s;
+        Serial::Serialize(ciphertext, s, SerType::BINARY);
+        bytes = s.tellp();
+    }
+    state.SetBytesProcessed(state.iterations() * bytes);
+    state.counters["bytes"] = bytes;
+}
+
+BENCHMARK(CKKS_SerializeCiphertext)->Unit(benchmark::kMicrosecond)->Apply(CiphertextArguments);
+
+void CKKS_DeserializeCiphertext(benchmark::State& state) {
+    auto ciphertext = MakeCiphertext(state.range(0), state.range(1), state.range(2));
+    std::stringstream s;
+    Serial::Serialize(ciphertext, s, SerType::BINARY);
+    const std::string serialized = s.str();
+    while (state.KeepRunning()) {
+        std::stringstream in(serialized);
+        Ciphertext<DCRTPoly> newC;
+        Serial::Deserialize(newC, in, SerType::BINARY);
+        benchmark::DoNotOptimize(newC);
+    }
+    state.SetBytesProcessed(state.iterations() * serialized.size());
+    state.counters["bytes"] = serialized.size();
+}
+
+BENCHMARK(CKKS_DeserializeCiphertext)->Unit(benchmark::kMicrosecond)->Apply(CiphertextArguments);
+
+// flat wire format: the towers are gathered from the ciphertext and used in place when adopted
+void CKKS_WriteCiphertextWire(benchmark::State& state) {
+    auto ciphertext = MakeCiphertext(state.range(0), state.range(1), state.range(2));
+    size_t bytes    = 0;
+    while (state.KeepRunning()) {
+        std::stringstream s;
+        bytes = WriteCiphertextWire(s, ciphertext);
+    }
+    state.SetBytesProcessed(state.iterations() * bytes);
+    state.counters["bytes"] = bytes;
+}
+
+BENCHMARK(CKKS_WriteCiphertextWire)->Unit(benchmark::kMicrosecond)->Apply(CiphertextArguments);
+
+void CKKS_AdoptCiphertextWire(benchmark::State& state) {
+    auto ciphertext = MakeCiphertext(state.range(0), state.range(1), state.range(2));
+    auto cc         = ciphertext->GetCryptoContext();
+    std::stringstream s;
+    const size_t bytes = WriteCiphertextWire(s, ciphertext);
+    auto message       = std::make_shared<std::vector<uint64_t>>((bytes + 7) / 8);
+    s.read(reinterpret_cast<char*>(message->data()), bytes);
+    while (state.KeepRunning()) {
+        auto newC = AdoptCiphertextWire(cc, message->data(), bytes, message);
+        benchmark::DoNotOptimize(newC);
+    }
+    state.SetBytesProcessed(state.iterations() * bytes);
+    state.counters["bytes"] = bytes;
+}
+
+BENCHMARK(CKKS_AdoptCiphertextWire)->Unit(benchmark::kMicrosecond)->Apply(CiphertextArguments);
+
 BENCHMARK_MAIN();
@@ -43,6 +43,7 @@
 
 #include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace lbcrypto {
@@ -65,9 +66,17 @@ class BinFHEScheme {
 public:
     BinFHEScheme() = default;
 
-    explicit BinFHEScheme(BINFHE_METHOD method) {
+    /**
+   * @param method the bootstrapping method
+   * @param fftAcc whether the GINX accumulator computes the external products in the FFT domain
+   */
+    explicit BinFHEScheme(BINFHE_METHOD method, bool fftAcc = false) {
+        if (fftAcc && method != GINX)
+            OPENFHE_THROW("The FFT accumulator is only available for GINX");
         if (method == AP)
             ACCscheme = std::make_shared<RingGSWAccumulatorDM>();
+        else if (method == GINX && fftAcc)
+            ACCscheme = std::make_shared<RingGSWAccumulatorCGGIFFT>();
         else if (method == GINX)
             ACCscheme = std::make_shared<RingGSWAccumulatorCGGI>();
         else if (method == LMKCDEY)
@@ -88,6 +97,14 @@ public:
     RingGSWBTKey KeyGen(const std::shared_ptr<BinFHECryptoParams>& params, ConstLWEPrivateKey& LWEsk,
                         KEYGEN_MODE keygenMode) const;
 
+    /**
+   * Prepares refresh keys that were not generated by this scheme (e.g., deserialized ones) for its accumulator
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param ek the refresh key
+   */
+    void PrecomputeBTKey(const std::shared_ptr<BinFHECryptoParams>& params, RingGSWBTKey& ek) const;
+
     /**
    * Evaluates a binary gate (calls bootstrapping as a subroutine)
    *
@@ -114,6 +131,21 @@ public:
     LWECiphertext EvalBinGate(const std::shared_ptr<BinFHECryptoParams>& params, BINGATE gate, const RingGSWBTKey& EK,
                               const std::vector<LWECiphertext>& ctvector, bool extended = false) const;
 
+    /**
+   * Evaluates the same binary gate on many independent pairs of ciphertexts. The gates are
+   * distributed over the OpenMP threads, each running whole bootstrappings against the shared keys.
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param gate the gate; can be AND, OR, NAND, NOR, XOR, or XNOR
+   * @param EK a shared pointer to the bootstrapping keys
+   * @param ctpairs the pairs of input ciphertexts
+   * @return the resulting ciphertexts, in the order of the inputs
+   */
+    std::vector<LWECiphertext> EvalBinGateBatch(const std::shared_ptr<BinFHECryptoParams>& params, BINGATE gate,
+                                                const RingGSWBTKey& EK,
+                                                const std::vector<std::pair<LWECiphertext, LWECiphertext>>& ctpairs,
+                                                bool extended = false) const;
+
     /**
    * Evaluates NOT gate
    *
@@ -148,6 +180,41 @@ public:
                            ConstLWECiphertext& ct, const std::vector<NativeInteger>& LUT,
                            const NativeInteger& beta) const;
 
+    /**
+   * Evaluates several arbitrary functions on the same ciphertext with the blind rotations shared
+   * by all of them. The test polynomial of function k is factored as v0 * v_k with
+   * v0 = Delta/2 (1 + X + ... + X^{N-1}), the inverse of (1 - X) up to Delta, and
+   * v_k = (1 - X) * LUT_k, which has small coefficients (the steps of the function, with their
+   * common factor moved to v0). Only v0 is blind rotated, and the accumulator is multiplied by
+   * each v_k, at the cost of the noise of the accumulator growing by the 1-norm of v_k.
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param EK a shared pointer to the bootstrapping keys
+   * @param ct input ciphertext
+   * @param LUTs the look-up tables of the to-be-evaluated functions
+   * @param beta the error bound
+   * @return the resulting ciphertexts, in the order of the look-up tables
+   */
+    std::vector<LWECiphertext> EvalFuncMulti(const std::shared_ptr<BinFHECryptoParams>& params,
+                                             const RingGSWBTKey& EK, ConstLWECiphertext& ct,
+                                             const std::vector<std::vector<NativeInteger>>& LUTs,
+                                             const NativeInteger& beta) const;
+
+    /**
+   * Evaluates the same arbitrary function on many independent ciphertexts, distributing the
+   * ciphertexts over the OpenMP threads
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param EK a shared pointer to the bootstrapping keys
+   * @param cts input ciphertexts
+   * @param LUT the look-up table of the to-be-evaluated function
+   * @param beta the error bound
+   * @return the resulting ciphertexts, in the order of the inputs
+   */
+    std::vector<LWECiphertext> EvalFuncBatch(const std::shared_ptr<BinFHECryptoParams>& params,
+                                             const RingGSWBTKey& EK, const std::vector<LWECiphertext>& cts,
+                                             const std::vector<NativeInteger>& LUT, const NativeInteger& beta) const;
+
     /**
    * Evaluate a round down function
    *
@@ -217,6 +284,19 @@ private:
     RLWECiphertext BootstrapFuncCore(const std::shared_ptr<BinFHECryptoParams>& params, ConstRingGSWACCKey& ek,
                                      ConstLWECiphertext& ct, const Func f, const NativeInteger& fmod) const;
 
+    /**
+   * Core bootstrapping operation for several functions: blind rotation of the common factor
+   * v0 = scale/2 (1 + X + ... + X^{N-1}) of their test polynomials
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param ek a shared pointer to the bootstrapping keys
+   * @param ct input ciphertext
+   * @param scale the value of v0 * (1 - X)
+   * @return the output RingLWE accumulator
+   */
+    RLWECiphertext BootstrapFuncMultiCore(const std::shared_ptr<BinFHECryptoParams>& params, ConstRingGSWACCKey& ek,
+                                          ConstLWECiphertext& ct, const NativeInteger& scale) const;
+
     /**
    * Bootstraps a fresh ciphertext
    *
@@ -231,6 +311,22 @@ private:
     LWECiphertext BootstrapFunc(const std::shared_ptr<BinFHECryptoParams>& params, const RingGSWBTKey& EK,
                                 ConstLWECiphertext& ct, const Func f, const NativeInteger& fmod) const;
 
+    /**
+   * Bootstraps a fresh ciphertext for several functions with one blind rotation
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param EK a shared pointer to the bootstrapping keys
+   * @param ct input ciphertext
+   * @param f functions to evaluate, called as f(k, x, q, Q) for function k
+   * @param count number of functions
+   * @param fmod modulus over which the functions are defined
+   * @return the resulting ciphertexts, one per function
+   */
+    template <typename Func>
+    std::vector<LWECiphertext> BootstrapFuncMulti(const std::shared_ptr<BinFHECryptoParams>& params,
+                                                  const RingGSWBTKey& EK, ConstLWECiphertext& ct, const Func f,
+                                                  uint32_t count, const NativeInteger& fmod) const;
+
 protected:
     std::shared_ptr<LWEEncryptionScheme> LWEscheme{std::make_shared<LWEEncryptionScheme>()};
     std::shared_ptr<RingGSWAccumulator> ACCscheme{nullptr};
@@ -0,0 +1,77 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+  Persistent cache of the bootstrapping keys in a page-aligned file that is memory-mapped when loaded
+ */
+
+#ifndef BINFHE_KEYCACHE_H
+#define BINFHE_KEYCACHE_H
+
+#include "binfhe-base-scheme.h"
+
+#include <memory>
+#include <string>
+
+namespace lbcrypto {
+
+/**
+ * Writes the refreshing and switching keys of a bootstrapping key to a cache file. The file starts
+ * with a versioned header that records the parameters and the dimensions of the keys, followed by
+ * sections aligned to 4096 bytes: the Ring GSW polynomials in EVALUATION format as 64-bit words, their
+ * double-precision FFT form if all of them have it, and the buffers of the switching key in the layout
+ * of LWESwitchingKeyImpl. The words are in the byte order of the machine, which is checked when
+ * loading. The public key is not part of the cache.
+ *
+ * @param filename the cache file
+ * @param params the parameters the key was generated with
+ * @param key the bootstrapping key
+ */
+void SaveBTKeyCache(const std::string& filename, const std::shared_ptr<BinFHECryptoParams>& params,
+                    const RingGSWBTKey& key);
+
+/**
+ * Loads a bootstrapping key from a cache file written by SaveBTKeyCache. The file is memory-mapped
+ * privately (read into memory on platforms without mmap) and the keys are used in place from it: the
+ * switching key, the FFT form of the refreshing key and its NTT-form polynomials, which are adopted as
+ * chunks of an ArenaSlab. The mapping stays alive as long as any of them, and writing to a polynomial
+ * copies only the affected page. Polynomial values that are not below Q are rejected.
+ *
+ * @param filename the cache file
+ * @param params the parameters of the context, which have to match the ones recorded in the file
+ * @return the bootstrapping key without the public key
+ */
+RingGSWBTKey LoadBTKeyCache(const std::string& filename, const std::shared_ptr<BinFHECryptoParams>& params);
+
+}  // namespace lbcrypto
+
+#endif
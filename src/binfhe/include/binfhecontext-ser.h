@@ -52,4 +52,7 @@ CEREAL_REGISTER_TYPE(lbcrypto::RingGSWACCKeyImpl);
 CEREAL_REGISTER_TYPE(lbcrypto::BinFHECryptoParams);
 CEREAL_REGISTER_TYPE(lbcrypto::BinFHEContext);
 
+// Records the flat layout of the switching key; archives without it load as version 1
+CEREAL_CLASS_VERSION(lbcrypto::LWESwitchingKeyImpl, lbcrypto::LWESwitchingKeyImpl::SerializedVersion());
+
 #endif
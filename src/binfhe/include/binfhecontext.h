@@ -44,6 +44,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace lbcrypto {
@@ -272,6 +273,7 @@ public:
    */
     void BTKeyLoad(const RingGSWBTKey& key) {
         m_BTKey = key;
+        m_binfhescheme->PrecomputeBTKey(m_params, m_BTKey);
     }
 
     /**
@@ -282,8 +284,36 @@ public:
    */
     void BTKeyMapLoadSingleElement(uint32_t baseG, const RingGSWBTKey& key) {
         m_BTKey_map[baseG] = key;
+        m_binfhescheme->PrecomputeBTKey(m_params, m_BTKey_map[baseG]);
     }
 
+    /**
+   * Saves the refreshing and switching keys of the context to a page-aligned cache file that
+   * BTKeyLoadCache memory-maps; the FFT form of the refreshing key is saved with it if it was computed
+   *
+   * @param filename the cache file
+   */
+    void BTKeySaveCache(const std::string& filename) const;
+
+    /**
+   * Loads bootstrapping keys from a cache file written by BTKeySaveCache for the same parameters,
+   * using the mapped switching key and FFT form in place instead of deserializing them
+   *
+   * @param filename the cache file
+   */
+    void BTKeyLoadCache(const std::string& filename);
+
+    /**
+   * Selects the accumulator of the GINX bootstrapping: the default one with the external products mod Q
+   * in the NTT domain, or the approximate one that computes them in the double-precision FFT domain (see
+   * RingGSWAccumulatorCGGIFFT), which rejects parameters beyond the bound of its rounding error. The FFT
+   * form of the bootstrapping keys that are already in the context is computed here; keys generated or
+   * loaded later get it in BTKeyGen/BTKeyLoad.
+   *
+   * @param useFFT whether to use the FFT accumulator
+   */
+    void SetFFTAccumulator(bool useFFT);
+
     /**
    * Clear the bootstrapping keys in the current context
    */
@@ -314,6 +344,18 @@ public:
    */
     LWECiphertext EvalBinGate(BINGATE gate, const std::vector<LWECiphertext>& ctvector, bool extended = false) const;
 
+    /**
+   * Evaluates the same binary gate on many independent pairs of ciphertexts, e.g., one layer of a
+   * circuit. The bootstrappings run in parallel over the OpenMP threads.
+   *
+   * @param gate the gate; can be AND, OR, NAND, NOR, XOR, or XNOR
+   * @param ctpairs the pairs of input ciphertexts
+   * @return the resulting ciphertexts, in the order of the inputs
+   */
+    std::vector<LWECiphertext> EvalBinGateBatch(BINGATE gate,
+                                                const std::vector<std::pair<LWECiphertext, LWECiphertext>>& ctpairs,
+                                                bool extended = false) const;
+
     /**
    * Bootstraps a ciphertext (without peforming any operation)
    *
@@ -331,6 +373,28 @@ public:
    */
     LWECiphertext EvalFunc(ConstLWECiphertext& ct, const std::vector<NativeInteger>& LUT) const;
 
+    /**
+   * Evaluates several arbitrary functions of the same ciphertext with the blind rotations shared
+   * between them (one bootstrap instead of one per function for negacyclic functions). The
+   * noise of the results grows with the number and the size of the steps of the functions.
+   *
+   * @param ct ciphertext to be bootstrapped
+   * @param LUTs the look-up tables of the to-be-evaluated functions
+   * @return the resulting ciphertexts, in the order of the look-up tables
+   */
+    std::vector<LWECiphertext> EvalFuncMulti(ConstLWECiphertext& ct,
+                                             const std::vector<std::vector<NativeInteger>>& LUTs) const;
+
+    /**
+   * Evaluates the same arbitrary function on many independent ciphertexts in parallel
+   *
+   * @param cts ciphertexts to be bootstrapped
+   * @param LUT the look-up table of the to-be-evaluated function
+   * @return the resulting ciphertexts, in the order of the inputs
+   */
+    std::vector<LWECiphertext> EvalFuncBatch(const std::vector<LWECiphertext>& cts,
+                                             const std::vector<NativeInteger>& LUT) const;
+
     /**
    * Generate the LUT for the to-be-evaluated function
    *
@@ -37,62 +37,228 @@
 #include "math/math-hal.h"
 #include "utils/serializable.h"
 
+#include <array>
+#include <cstdint>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
 namespace lbcrypto {
+
+/**
+ * @brief 256-bit seed from which a switching key is generated deterministically
+ */
+using LWESwitchingKeySeed = std::array<uint32_t, 8>;
+
 /**
  * @brief Class that stores the LWE scheme switching key
+ *
+ * The key consists of N * digitCount * baseKS LWE encryptions (a, b) of dimension n, one for every
+ * coefficient i of the old secret key, digit j and digit value v. All vectors a are stored back to
+ * back in one buffer in [N][digitCount][baseKS][n] order, as 32-bit words when qKS fits into 31
+ * bits and as 64-bit words otherwise, and the values b in one more buffer in the same order.
+ * The buffers are either owned by the key or, for a key created over external memory such as a
+ * memory-mapped file, read-only views kept alive by an owner object.
  */
 class LWESwitchingKeyImpl : public Serializable {
 public:
     LWESwitchingKeyImpl() = default;
 
+    /**
+   * Creates a key with all elements set to zero
+   *
+   * @param N is the dimension of the old secret key.
+   * @param digitCount is the number of digits of the decomposition.
+   * @param baseKS is the base of the decomposition.
+   * @param n is the dimension of the new secret key.
+   * @param qKS is the key switching modulus.
+   */
+    LWESwitchingKeyImpl(uint32_t N, uint32_t digitCount, uint32_t baseKS, uint32_t n, const NativeInteger& qKS)
+        : m_N(N), m_digitCount(digitCount), m_baseKS(baseKS), m_n(n), m_qKS(qKS) {
+        Allocate();
+    }
+
+    /**
+   * Creates a key from the elements indexed [i][v][j] (coefficient, digit value, digit)
+   */
     LWESwitchingKeyImpl(const std::vector<std::vector<std::vector<NativeVector>>>& keyA,
-                        const std::vector<std::vector<std::vector<NativeInteger>>>& keyB)
-        : m_keyA(keyA), m_keyB(keyB) {}
+                        const std::vector<std::vector<std::vector<NativeInteger>>>& keyB) {
+        FromNested(keyA, keyB);
+    }
 
+    [[deprecated("The key is stored in flat buffers; use the constructor taking const references")]]
     LWESwitchingKeyImpl(std::vector<std::vector<std::vector<NativeVector>>>&& keyA,
-                        std::vector<std::vector<std::vector<NativeInteger>>>&& keyB)
-        : m_keyA(std::move(keyA)), m_keyB(std::move(keyB)) {}
+                        std::vector<std::vector<std::vector<NativeInteger>>>&& keyB) {
+        FromNested(keyA, keyB);
+    }
 
-    LWESwitchingKeyImpl(const LWESwitchingKeyImpl& rhs) : m_keyA(rhs.m_keyA), m_keyB(rhs.m_keyB) {}
+    /**
+   * Creates a read-only key over external buffers in the layout of GetKeyA()/GetKeyB() without
+   * copying them
+   *
+   * @param N is the dimension of the old secret key.
+   * @param digitCount is the number of digits of the decomposition.
+   * @param baseKS is the base of the decomposition.
+   * @param n is the dimension of the new secret key.
+   * @param qKS is the key switching modulus.
+   * @param keyA are the vectors a, in 32-bit words if qKS fits into 31 bits and in 64-bit words otherwise.
+   * @param keyB are the values b.
+   * @param owner keeps the buffers alive as long as the key or a copy of it exists.
+   */
+    LWESwitchingKeyImpl(uint32_t N, uint32_t digitCount, uint32_t baseKS, uint32_t n, const NativeInteger& qKS,
+                        const void* keyA, const uint64_t* keyB, std::shared_ptr<const void> owner)
+        : m_N(N),
+          m_digitCount(digitCount),
+          m_baseKS(baseKS),
+          m_n(n),
+          m_qKS(qKS),
+          m_compact(IsCompactModulus(qKS)),
+          m_owner(std::move(owner)),
+          m_a(keyA),
+          m_b(keyB) {}
 
-    LWESwitchingKeyImpl(LWESwitchingKeyImpl&& rhs) noexcept
-        : m_keyA(std::move(rhs.m_keyA)), m_keyB(std::move(rhs.m_keyB)) {}
+    LWESwitchingKeyImpl(const LWESwitchingKeyImpl& rhs) {
+        *this = rhs;
+    }
 
     LWESwitchingKeyImpl& operator=(const LWESwitchingKeyImpl& rhs) {
-        m_keyA = rhs.m_keyA;
-        m_keyB = rhs.m_keyB;
+        m_N          = rhs.m_N;
+        m_digitCount = rhs.m_digitCount;
+        m_baseKS     = rhs.m_baseKS;
+        m_n          = rhs.m_n;
+        m_qKS        = rhs.m_qKS;
+        m_compact    = rhs.m_compact;
+        m_keyA32     = rhs.m_keyA32;
+        m_keyA64     = rhs.m_keyA64;
+        m_keyB       = rhs.m_keyB;
+        m_owner      = rhs.m_owner;
+        m_a          = rhs.m_a;
+        m_b          = rhs.m_b;
+        if (m_owner == nullptr)
+            Bind();
         return *this;
     }
 
-    LWESwitchingKeyImpl& operator=(LWESwitchingKeyImpl&& rhs) noexcept {
-        m_keyA = std::move(rhs.m_keyA);
-        m_keyB = std::move(rhs.m_keyB);
-        return *this;
+    // the buffers keep their addresses when moved, so the views m_a and m_b stay valid
+    LWESwitchingKeyImpl(LWESwitchingKeyImpl&& rhs)            = default;
+    LWESwitchingKeyImpl& operator=(LWESwitchingKeyImpl&& rhs) = default;
+
+    bool IsCompact() const {
+        return m_compact;
+    }
+
+    uint32_t GetN() const {
+        return m_N;
+    }
+
+    uint32_t GetDigitCount() const {
+        return m_digitCount;
+    }
+
+    uint32_t GetBaseKS() const {
+        return m_baseKS;
+    }
+
+    uint32_t Getn() const {
+        return m_n;
+    }
+
+    const NativeInteger& GetqKS() const {
+        return m_qKS;
+    }
+
+    /**
+   * @return the vector a of element (i, j, v) in 32-bit words, only valid if IsCompact()
+   */
+    const uint32_t* GetElementA32(uint32_t i, uint32_t j, uint32_t v) const {
+        return static_cast<const uint32_t*>(m_a) + Index(i, j, v) * m_n;
+    }
+
+    /**
+   * @return the vector a of element (i, j, v) in 64-bit words, only valid if !IsCompact()
+   */
+    const uint64_t* GetElementA64(uint32_t i, uint32_t j, uint32_t v) const {
+        return static_cast<const uint64_t*>(m_a) + Index(i, j, v) * m_n;
+    }
+
+    /**
+   * @return the value b of element (i, j, v)
+   */
+    uint64_t GetElementB(uint32_t i, uint32_t j, uint32_t v) const {
+        return m_b[Index(i, j, v)];
+    }
+
+    /**
+   * @return the buffer of all vectors a, N * digitCount * baseKS * n words of 32 bits if IsCompact()
+   * and of 64 bits otherwise
+   */
+    const void* GetKeyA() const {
+        return m_a;
+    }
+
+    /**
+   * @return the buffer of all values b, N * digitCount * baseKS words
+   */
+    const uint64_t* GetKeyB() const {
+        return m_b;
     }
 
-    const std::vector<std::vector<std::vector<NativeVector>>>& GetElementsA() const {
-        return m_keyA;
+    [[deprecated("The key is stored in flat buffers; use GetElementA32/GetElementA64 or GetKeyA")]]
+    std::vector<std::vector<std::vector<NativeVector>>> GetElementsA() const {
+        return ToNestedA();
     }
 
-    const std::vector<std::vector<std::vector<NativeInteger>>>& GetElementsB() const {
-        return m_keyB;
+    [[deprecated("The key is stored in flat buffers; use GetElementB or GetKeyB")]]
+    std::vector<std::vector<std::vector<NativeInteger>>> GetElementsB() const {
+        return ToNestedB();
     }
 
+    [[deprecated("The key is stored in flat buffers; use SetElement")]]
     void SetElementsA(const std::vector<std::vector<std::vector<NativeVector>>>& keyA) {
-        m_keyA = keyA;
+        // keeps the values b if the dimensions do not change
+        FromNested(keyA, ToNestedB());
     }
 
+    [[deprecated("The key is stored in flat buffers; use SetElement")]]
     void SetElementsB(const std::vector<std::vector<std::vector<NativeInteger>>>& keyB) {
-        m_keyB = keyB;
+        if (keyB.size() != m_N ||
+            (m_N && (keyB[0].size() != m_baseKS || (m_baseKS && keyB[0][0].size() != m_digitCount))))
+            OPENFHE_THROW("the dimensions of the values b do not match the key");
+        FromNested(ToNestedA(), keyB);
+    }
+
+    /**
+   * Sets element (i, j, v) of the key
+   *
+   * @param i is the coefficient of the old secret key.
+   * @param j is the digit.
+   * @param v is the digit value.
+   * @param a is the vector a of dimension n with entries mod qKS.
+   * @param b is the value b mod qKS.
+   */
+    void SetElement(uint32_t i, uint32_t j, uint32_t v, const NativeVector& a, const NativeInteger& b) {
+        if (m_owner != nullptr)
+            OPENFHE_THROW("a switching key over external memory is read-only");
+        size_t offset = Index(i, j, v) * m_n;
+        for (uint32_t k = 0; k < m_n; ++k) {
+            if (m_compact)
+                m_keyA32[offset + k] = a[k].ConvertToInt<uint32_t>();
+            else
+                m_keyA64[offset + k] = a[k].ConvertToInt<uint64_t>();
+        }
+        m_keyB[Index(i, j, v)] = b.ConvertToInt<uint64_t>();
     }
 
     bool operator==(const LWESwitchingKeyImpl& other) const {
-        return (m_keyA == other.m_keyA && m_keyB == other.m_keyB);
+        if (m_N != other.m_N || m_digitCount != other.m_digitCount || m_baseKS != other.m_baseKS ||
+            m_n != other.m_n || m_qKS != other.m_qKS)
+            return false;
+        size_t size   = size_t(m_N) * m_digitCount * m_baseKS;
+        size_t bytesA = size * m_n * (m_compact ? sizeof(uint32_t) : sizeof(uint64_t));
+        return size == 0 || (std::memcmp(m_a, other.m_a, bytesA) == 0 &&
+                             std::memcmp(m_b, other.m_b, size * sizeof(uint64_t)) == 0);
     }
 
     bool operator!=(const LWESwitchingKeyImpl& other) const {
@@ -101,7 +267,36 @@ public:
 
     template <class Archive>
     void save(Archive& ar, std::uint32_t const version) const {
-        ar(::cereal::make_nvp("a", m_keyA));
+        if (version < 2) {
+            // the nested layout of version 1; archives get version 0 where binfhecontext-ser.h is not included
+            auto keyA = ToNestedA();
+            auto keyB = ToNestedB();
+            ar(::cereal::make_nvp("a", keyA));
+            ar(::cereal::make_nvp("b", keyB));
+            return;
+        }
+        ar(::cereal::make_nvp("N", m_N));
+        ar(::cereal::make_nvp("d", m_digitCount));
+        ar(::cereal::make_nvp("B", m_baseKS));
+        ar(::cereal::make_nvp("n", m_n));
+        ar(::cereal::make_nvp("q", m_qKS));
+        // each buffer is written as one contiguous block by the binary archives
+        if (m_owner != nullptr) {
+            // external buffers are written in the same form as owned ones
+            size_t size = size_t(m_N) * m_digitCount * m_baseKS;
+            auto a32    = static_cast<const uint32_t*>(m_a);
+            auto a64    = static_cast<const uint64_t*>(m_a);
+            if (m_compact)
+                ar(::cereal::make_nvp("a", std::vector<uint32_t>(a32, a32 + size * m_n)));
+            else
+                ar(::cereal::make_nvp("a", std::vector<uint64_t>(a64, a64 + size * m_n)));
+            ar(::cereal::make_nvp("b", std::vector<uint64_t>(m_b, m_b + size)));
+            return;
+        }
+        if (m_compact)
+            ar(::cereal::make_nvp("a", m_keyA32));
+        else
+            ar(::cereal::make_nvp("a", m_keyA64));
         ar(::cereal::make_nvp("b", m_keyB));
     }
 
@@ -112,20 +307,129 @@ public:
                           " is from a later version of the library");
         }
 
-        ar(::cereal::make_nvp("a", m_keyA));
+        if (version < 2) {
+            std::vector<std::vector<std::vector<NativeVector>>> keyA;
+            std::vector<std::vector<std::vector<NativeInteger>>> keyB;
+            ar(::cereal::make_nvp("a", keyA));
+            ar(::cereal::make_nvp("b", keyB));
+            FromNested(keyA, keyB);
+            return;
+        }
+
+        ar(::cereal::make_nvp("N", m_N));
+        ar(::cereal::make_nvp("d", m_digitCount));
+        ar(::cereal::make_nvp("B", m_baseKS));
+        ar(::cereal::make_nvp("n", m_n));
+        ar(::cereal::make_nvp("q", m_qKS));
+        m_compact = IsCompactModulus(m_qKS);
+        m_owner.reset();
+        m_keyA32.clear();
+        m_keyA64.clear();
+        if (m_compact)
+            ar(::cereal::make_nvp("a", m_keyA32));
+        else
+            ar(::cereal::make_nvp("a", m_keyA64));
         ar(::cereal::make_nvp("b", m_keyB));
+
+        size_t size = size_t(m_N) * m_digitCount * m_baseKS;
+        if (m_keyB.size() != size || (m_compact ? m_keyA32.size() : m_keyA64.size()) != size * m_n)
+            OPENFHE_THROW("inconsistent dimensions of the deserialized switching key");
+        Bind();
     }
 
     std::string SerializedObjectName() const override {
         return "LWEPrivateKey";
     }
     static uint32_t SerializedVersion() {
-        return 1;
+        return 2;
     }
 
 private:
-    std::vector<std::vector<std::vector<NativeVector>>> m_keyA;
-    std::vector<std::vector<std::vector<NativeInteger>>> m_keyB;
+    // the vectors a fit into 32-bit words, and the differences of two entries do not overflow
+    static bool IsCompactModulus(const NativeInteger& qKS) {
+        return qKS.GetMSB() <= 31;
+    }
+
+    size_t Index(uint32_t i, uint32_t j, uint32_t v) const {
+        return (size_t(i) * m_digitCount + j) * m_baseKS + v;
+    }
+
+    void Allocate() {
+        size_t size = size_t(m_N) * m_digitCount * m_baseKS;
+        m_compact   = IsCompactModulus(m_qKS);
+        m_owner.reset();
+        m_keyA32.assign(m_compact ? size * m_n : 0, 0);
+        m_keyA64.assign(m_compact ? 0 : size * m_n, 0);
+        m_keyB.assign(size, 0);
+        Bind();
+    }
+
+    // points the views to the owned buffers
+    void Bind() {
+        m_a = m_compact ? static_cast<const void*>(m_keyA32.data()) : static_cast<const void*>(m_keyA64.data());
+        m_b = m_keyB.data();
+    }
+
+    // the elements in the layout of version 1, indexed [i][v][j]; values b missing from keyB are set to zero
+    void FromNested(const std::vector<std::vector<std::vector<NativeVector>>>& keyA,
+                    const std::vector<std::vector<std::vector<NativeInteger>>>& keyB) {
+        m_N          = keyA.size();
+        m_baseKS     = m_N ? keyA[0].size() : 0;
+        m_digitCount = m_baseKS ? keyA[0][0].size() : 0;
+        m_n          = m_digitCount ? keyA[0][0][0].GetLength() : 0;
+        m_qKS        = m_digitCount ? keyA[0][0][0].GetModulus() : NativeInteger(0);
+        Allocate();
+        const bool hasB = keyB.size() == m_N && (m_N == 0 || (keyB[0].size() == m_baseKS &&
+                                                                (m_baseKS == 0 || keyB[0][0].size() == m_digitCount)));
+        for (uint32_t i = 0; i < m_N; ++i) {
+            for (uint32_t v = 0; v < m_baseKS; ++v) {
+                for (uint32_t j = 0; j < m_digitCount; ++j)
+                    SetElement(i, j, v, keyA[i][v][j], hasB ? keyB[i][v][j] : NativeInteger(0));
+            }
+        }
+    }
+
+    std::vector<std::vector<std::vector<NativeVector>>> ToNestedA() const {
+        std::vector<std::vector<std::vector<NativeVector>>> keyA(
+            m_N, std::vector<std::vector<NativeVector>>(m_baseKS, std::vector<NativeVector>(m_digitCount)));
+        for (uint32_t i = 0; i < m_N; ++i) {
+            for (uint32_t v = 0; v < m_baseKS; ++v) {
+                for (uint32_t j = 0; j < m_digitCount; ++j) {
+                    NativeVector a(m_n, m_qKS);
+                    for (uint32_t k = 0; k < m_n; ++k)
+                        a[k] = m_compact ? GetElementA32(i, j, v)[k] : GetElementA64(i, j, v)[k];
+                    keyA[i][v][j] = std::move(a);
+                }
+            }
+        }
+        return keyA;
+    }
+
+    std::vector<std::vector<std::vector<NativeInteger>>> ToNestedB() const {
+        std::vector<std::vector<std::vector<NativeInteger>>> keyB(
+            m_N, std::vector<std::vector<NativeInteger>>(m_baseKS, std::vector<NativeInteger>(m_digitCount)));
+        for (uint32_t i = 0; i < m_N; ++i) {
+            for (uint32_t v = 0; v < m_baseKS; ++v) {
+                for (uint32_t j = 0; j < m_digitCount; ++j)
+                    keyB[i][v][j] = GetElementB(i, j, v);
+            }
+        }
+        return keyB;
+    }
+
+    uint32_t m_N{0};
+    uint32_t m_digitCount{0};
+    uint32_t m_baseKS{0};
+    uint32_t m_n{0};
+    NativeInteger m_qKS{0};
+    bool m_compact{true};
+    std::vector<uint32_t> m_keyA32;
+    std::vector<uint64_t> m_keyA64;
+    std::vector<uint64_t> m_keyB;
+    // keeps external buffers alive, nullptr if the key owns its buffers
+    std::shared_ptr<const void> m_owner;
+    const void* m_a{nullptr};
+    const uint64_t* m_b{nullptr};
 };
 
 }  // namespace lbcrypto
@@ -40,6 +40,7 @@
 #include "lwe-keypair.h"
 #include "lwe-cryptoparameters.h"
 
+#include <functional>
 #include <memory>
 
 namespace lbcrypto {
@@ -204,6 +205,37 @@ public:
     LWESwitchingKey KeySwitchGen(const std::shared_ptr<LWECryptoParams>& params, ConstLWEPrivateKey& sk,
                                  ConstLWEPrivateKey& skN) const;
 
+    /**
+   * Generates a switching key from a seed. Row i of the key (all encryptions of the coefficient i
+   * of skN) is drawn from its own Blake2 stream keyed by (seed, i), so the rows are generated in
+   * parallel and the key only depends on the seed and the secret keys.
+   *
+   * @param params a shared pointer to LWE scheme parameters
+   * @param sk new secret key
+   * @param skN old secret key
+   * @param seed the seed of the key
+   * @return a shared pointer to the switching key
+   */
+    LWESwitchingKey KeySwitchGen(const std::shared_ptr<LWECryptoParams>& params, ConstLWEPrivateKey& sk,
+                                 ConstLWEPrivateKey& skN, const LWESwitchingKeySeed& seed) const;
+
+    /**
+   * Generates the switching key of a seed in batches of rowsPerBatch rows and passes every batch
+   * to sink as soon as it is ready, so that the key can be written out without holding all of it
+   * in memory. The batches are switching keys with N = rowsPerBatch (fewer for the last one) and
+   * together are identical to the key returned by KeySwitchGen for the same seed.
+   *
+   * @param params a shared pointer to LWE scheme parameters
+   * @param sk new secret key
+   * @param skN old secret key
+   * @param seed the seed of the key
+   * @param rowsPerBatch number of rows generated at once
+   * @param sink called in order with every batch and the index of its first row
+   */
+    void KeySwitchGenStream(const std::shared_ptr<LWECryptoParams>& params, ConstLWEPrivateKey& sk,
+                            ConstLWEPrivateKey& skN, const LWESwitchingKeySeed& seed, uint32_t rowsPerBatch,
+                            const std::function<void(ConstLWESwitchingKey& batch, uint32_t firstRow)>& sink) const;
+
     /**
    * Switches ciphertext from (Q,N) to (Q,n)
    *
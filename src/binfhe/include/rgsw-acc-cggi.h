@@ -42,7 +42,7 @@ namespace lbcrypto {
  * @brief Ring GSW accumulator schemes described in
  * https://eprint.iacr.org/2018/421.pdf and https://eprint.iacr.org/2020/086
  */
-class RingGSWAccumulatorCGGI final : public RingGSWAccumulator {
+class RingGSWAccumulatorCGGI : public RingGSWAccumulator {
 public:
     RingGSWAccumulatorCGGI() = default;
 
@@ -68,7 +68,7 @@ public:
     void EvalAcc(const std::shared_ptr<RingGSWCryptoParams>& params, ConstRingGSWACCKey& ek, RLWECiphertext& acc,
                  const NativeVector& a) const override;
 
-private:
+protected:
     /**
    * Key generation for internal Ring GSW as described in https://eprint.iacr.org/2020/086
    *
@@ -93,6 +93,62 @@ private:
                       ConstRingGSWEvalKey& ek2, const NativeInteger& a, RLWECiphertext& acc) const;
 };
 
+/**
+ * @brief The CGGI accumulator with the external products computed in the double-precision FFT domain,
+ * as in https://eprint.iacr.org/2018/421.pdf. The keys are the ones of RingGSWAccumulatorCGGI with
+ * their FFT form precomputed, the accumulator is kept in COEFFICIENT format and the products are
+ * rounded back to integers mod Q.
+ *
+ * The accumulator is approximate: the sums of the products reach N * 2 * (digitsG - 1) * baseG * Q / 2
+ * in magnitude (2^47 for STD128), where the FFT rounding error of the doubles is no longer far below one,
+ * so a coefficient can differ from the exact result of RingGSWAccumulatorCGGI by a few units mod Q. This
+ * error is small next to the bootstrapping noise, but the ciphertexts are not bit for bit the same as
+ * the ones of the NTT accumulator. Parameters with a magnitude of 2^50 or more, where the rounding error
+ * is no longer bounded by a few units, are rejected.
+ */
+class RingGSWAccumulatorCGGIFFT final : public RingGSWAccumulatorCGGI {
+public:
+    RingGSWAccumulatorCGGIFFT() = default;
+
+    /**
+   * Checks that the parameters are within the bound of the rounding error: Q < 2^32 and
+   * N * 2 * (digitsG - 1) * baseG * Q / 2 < 2^50
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   */
+    static void CheckParams(const std::shared_ptr<RingGSWCryptoParams>& params);
+
+    /**
+   * Key generation as in RingGSWAccumulatorCGGI, followed by the FFT precomputation
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param skNTT secret key polynomial in the EVALUATION representation
+   * @param LWEsk the secret key
+   * @return a shared pointer to the resulting keys
+   */
+    RingGSWACCKey KeyGenAcc(const std::shared_ptr<RingGSWCryptoParams>& params, const NativePoly& skNTT,
+                            ConstLWEPrivateKey& LWEsk) const override;
+
+    /**
+   * Main accumulator function used in bootstrapping - GINX variant with FFT external products
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param ek the accumulator key with the precomputed FFT form
+   * @param acc previous value of the accumulator
+   * @param a value to update the accumulator with
+   */
+    void EvalAcc(const std::shared_ptr<RingGSWCryptoParams>& params, ConstRingGSWACCKey& ek, RLWECiphertext& acc,
+                 const NativeVector& a) const override;
+
+    /**
+   * Computes the FFT form of all the Ring GSW keys of ek that do not have it yet
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param ek the accumulator key
+   */
+    void PrecomputeAccKey(const std::shared_ptr<RingGSWCryptoParams>& params, RingGSWACCKey& ek) const override;
+};
+
 }  // namespace lbcrypto
 
 #endif  // _RGSW_ACC_CGGI_H_
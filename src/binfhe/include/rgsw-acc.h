@@ -36,11 +36,35 @@
 #include "rgsw-acckey.h"
 #include "rgsw-cryptoparameters.h"
 
+#include <cstdint>
 #include <vector>
 #include <memory>
 
 namespace lbcrypto {
 
+/**
+ * @brief Scratch space of the accumulator updates: the accumulator in COEFFICIENT format, its gadget
+ * digits and the inner products with the key, all in the ring of one RingGSWCryptoParams. Every thread
+ * keeps one workspace that is resized only when the parameters change, so the updates in the loop of
+ * EvalAcc do not allocate.
+ */
+struct RingGSWAccWorkspace {
+    std::shared_ptr<ILNativeParams> polyParams;
+    // the two components of the accumulator
+    std::vector<NativePoly> ct;
+    // the digits of the accumulator, at least (digitsG - 1) * 2
+    std::vector<NativePoly> dct;
+    // the inner products of the digits with the two columns of a key, and a temporary
+    std::vector<NativePoly> sum;
+    NativePoly tmp;
+    // the operand tables of the fused inner product, the key components in 64-bit or packed 32-bit words
+    std::vector<const uint64_t*> x;
+    std::vector<const uint64_t*> a;
+    std::vector<const uint64_t*> b;
+    std::vector<const uint32_t*> a32;
+    std::vector<const uint32_t*> b32;
+};
+
 /**
  * @brief Ring GSW accumulator schemes described in
  * https://eprint.iacr.org/2014/816, https://eprint.iacr.org/2020/086 and https://eprint.iacr.org/2022/198
@@ -75,6 +99,15 @@ public:
         OPENFHE_THROW("ACC operation not supported");
     }
 
+    /**
+   * Prepares an accumulator key (e.g., a generated or deserialized one) for EvalAcc: packs the Ring GSW
+   * keys into 32-bit words for the external product if Q < 2^31 and they are not packed yet
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param ek the accumulator key
+   */
+    virtual void PrecomputeAccKey(const std::shared_ptr<RingGSWCryptoParams>& params, RingGSWACCKey& ek) const;
+
     /**
    * The signed digit decomposition which takes an RLWE ciphertext input and outputs a vector of its digits, i.e., an
    * RLWE' ciphertext
@@ -97,6 +130,45 @@ public:
    */
     void SignedDigitDecompose(const std::shared_ptr<RingGSWCryptoParams>& params, const NativePoly& input,
                               std::vector<NativePoly>& output) const;
+
+protected:
+    /**
+   * Returns the workspace of the calling thread, sized for params
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @return the workspace
+   */
+    static RingGSWAccWorkspace& GetWorkspace(const std::shared_ptr<RingGSWCryptoParams>& params);
+
+    /**
+   * Decomposes an RLWE ciphertext in EVALUATION format into ws.dct[0 .. (digitsG - 1) * 2) in EVALUATION format
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param input input RLWE ciphertext
+   * @param ws the workspace of the calling thread
+   */
+    void DecomposeToEval(const std::shared_ptr<RingGSWCryptoParams>& params, const std::vector<NativePoly>& input,
+                         RingGSWAccWorkspace& ws) const;
+
+    /**
+   * Decomposes a ring element in COEFFICIENT format into ws.dct[0 .. digitsG - 1) in EVALUATION format
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param input input ring element
+   * @param ws the workspace of the calling thread
+   */
+    void DecomposeToEval(const std::shared_ptr<RingGSWCryptoParams>& params, const NativePoly& input,
+                         RingGSWAccWorkspace& ws) const;
+
+    /**
+   * Computes ws.sum[k] = sum_d ws.dct[d] * key[d][k] for k = 0, 1 with the products of each coefficient
+   * accumulated before a single modular reduction
+   *
+   * @param key the key, count x 2 polynomials in EVALUATION format, read from its packed form if it has one
+   * @param count the number of digits
+   * @param ws the workspace of the calling thread
+   */
+    static void InnerProduct(const RingGSWEvalKeyImpl& key, uint32_t count, RingGSWAccWorkspace& ws);
 };
 }  // namespace lbcrypto
 
@@ -68,17 +68,35 @@ public:
 
     explicit RingGSWEvalKeyImpl(const std::vector<std::vector<NativePoly>>& elements) : m_elements(elements) {}
 
-    RingGSWEvalKeyImpl(const RingGSWEvalKeyImpl& rhs) : m_elements(rhs.m_elements) {}
-
-    RingGSWEvalKeyImpl(RingGSWEvalKeyImpl&& rhs) noexcept : m_elements(std::move(rhs.m_elements)) {}
+    RingGSWEvalKeyImpl(const RingGSWEvalKeyImpl& rhs)
+        : m_elements(rhs.m_elements),
+          m_fftElements(rhs.m_fftElements),
+          m_fftSize(rhs.m_fftSize),
+          m_packedElements(rhs.m_packedElements),
+          m_packedSize(rhs.m_packedSize) {}
+
+    RingGSWEvalKeyImpl(RingGSWEvalKeyImpl&& rhs) noexcept
+        : m_elements(std::move(rhs.m_elements)),
+          m_fftElements(std::move(rhs.m_fftElements)),
+          m_fftSize(std::exchange(rhs.m_fftSize, 0)),
+          m_packedElements(std::move(rhs.m_packedElements)),
+          m_packedSize(std::exchange(rhs.m_packedSize, 0)) {}
 
     RingGSWEvalKeyImpl& operator=(const RingGSWEvalKeyImpl& rhs) {
-        RingGSWEvalKeyImpl::m_elements = rhs.m_elements;
+        RingGSWEvalKeyImpl::m_elements       = rhs.m_elements;
+        RingGSWEvalKeyImpl::m_fftElements    = rhs.m_fftElements;
+        RingGSWEvalKeyImpl::m_fftSize        = rhs.m_fftSize;
+        RingGSWEvalKeyImpl::m_packedElements = rhs.m_packedElements;
+        RingGSWEvalKeyImpl::m_packedSize     = rhs.m_packedSize;
         return *this;
     }
 
     RingGSWEvalKeyImpl& operator=(RingGSWEvalKeyImpl&& rhs) noexcept {
-        RingGSWEvalKeyImpl::m_elements = std::move(rhs.m_elements);
+        RingGSWEvalKeyImpl::m_elements       = std::move(rhs.m_elements);
+        RingGSWEvalKeyImpl::m_fftElements    = std::move(rhs.m_fftElements);
+        RingGSWEvalKeyImpl::m_fftSize        = std::exchange(rhs.m_fftSize, 0);
+        RingGSWEvalKeyImpl::m_packedElements = std::move(rhs.m_packedElements);
+        RingGSWEvalKeyImpl::m_packedSize     = std::exchange(rhs.m_packedSize, 0);
         return *this;
     }
 
@@ -88,6 +106,63 @@ public:
 
     void SetElements(const std::vector<std::vector<NativePoly>>& elements) {
         m_elements = elements;
+        ResetDerived();
+    }
+
+    /**
+   * Gets the key in the double-precision FFT domain used by RingGSWAccumulatorCGGIFFT: for every row and
+   * column the real and then the imaginary parts of the N/2 FFT values. nullptr if it was not
+   * precomputed; it is derived from the elements and is not serialized. The buffer is immutable and
+   * shared by the copies of the key.
+   */
+    const double* GetFFTElements() const {
+        return m_fftElements.get();
+    }
+
+    /**
+   * @return the number of doubles of the FFT form, 0 if it was not precomputed
+   */
+    size_t GetFFTSize() const {
+        return m_fftSize;
+    }
+
+    void SetFFTElements(std::vector<double>&& fftElements) {
+        auto buffer   = std::make_shared<const std::vector<double>>(std::move(fftElements));
+        m_fftSize     = buffer->size();
+        m_fftElements = std::shared_ptr<const double>(buffer, buffer->data());
+    }
+
+    /**
+   * Sets the FFT form to a buffer of external memory, e.g., a memory-mapped key file
+   *
+   * @param fftElements the buffer, whose control block keeps the memory alive
+   * @param size the number of doubles
+   */
+    void SetFFTElements(std::shared_ptr<const double> fftElements, size_t size) {
+        m_fftElements = std::move(fftElements);
+        m_fftSize     = m_fftElements != nullptr ? size : 0;
+    }
+
+    /**
+   * Gets the EVALUATION form of the elements packed into 32-bit words, used by the external product
+   * when Q < 2^31: for every row and column the N values. nullptr if it was not precomputed; like the
+   * FFT form, it is derived from the elements, is not serialized and is shared by the copies of the key.
+   */
+    const uint32_t* GetPackedElements() const {
+        return m_packedElements.get();
+    }
+
+    /**
+   * @return the number of words of the packed form, 0 if it was not precomputed
+   */
+    size_t GetPackedSize() const {
+        return m_packedSize;
+    }
+
+    void SetPackedElements(std::vector<uint32_t>&& packedElements) {
+        auto buffer      = std::make_shared<const std::vector<uint32_t>>(std::move(packedElements));
+        m_packedSize     = buffer->size();
+        m_packedElements = std::shared_ptr<const uint32_t>(buffer, buffer->data());
     }
 
     /**
@@ -102,7 +177,12 @@ public:
         }
     }
 
+    /**
+   * Gives write access to a row of elements, so the FFT and packed forms derived from them are dropped;
+   * they have to be precomputed again after the row is changed
+   */
     std::vector<NativePoly>& operator[](uint32_t i) {
+        ResetDerived();
         return m_elements[i];
     }
 
@@ -142,6 +222,7 @@ public:
                           " is from a later version of the library");
         }
         ar(::cereal::make_nvp("elements", m_elements));
+        ResetDerived();
     }
 
     std::string SerializedObjectName() const override {
@@ -152,7 +233,18 @@ public:
     }
 
 private:
+    void ResetDerived() {
+        m_fftElements.reset();
+        m_fftSize = 0;
+        m_packedElements.reset();
+        m_packedSize = 0;
+    }
+
     std::vector<std::vector<NativePoly>> m_elements;
+    std::shared_ptr<const double> m_fftElements;
+    size_t m_fftSize{0};
+    std::shared_ptr<const uint32_t> m_packedElements;
+    size_t m_packedSize{0};
 };
 
 }  // namespace lbcrypto
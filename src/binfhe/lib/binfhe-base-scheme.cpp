@@ -31,6 +31,10 @@
 
 #include "binfhe-base-scheme.h"
 
+#include "utils/exception.h"
+#include "utils/parallel.h"
+
+#include <numeric>
 #include <string>
 
 namespace lbcrypto {
@@ -68,10 +72,16 @@ RingGSWBTKey BinFHEScheme::KeyGen(const std::shared_ptr<BinFHECryptoParams>& par
     skNPoly.SetFormat(Format::EVALUATION);
 
     ek.BSkey = ACCscheme->KeyGenAcc(RGSWParams, skNPoly, LWEsk);
+    ACCscheme->PrecomputeAccKey(RGSWParams, ek.BSkey);
 
     return ek;
 }
 
+void BinFHEScheme::PrecomputeBTKey(const std::shared_ptr<BinFHECryptoParams>& params, RingGSWBTKey& ek) const {
+    if (ek.BSkey != nullptr)
+        ACCscheme->PrecomputeAccKey(params->GetRingGSWParams(), ek.BSkey);
+}
+
 // Full evaluation as described in https://eprint.iacr.org/2020/086
 LWECiphertext BinFHEScheme::EvalBinGate(const std::shared_ptr<BinFHECryptoParams>& params, BINGATE gate,
                                         const RingGSWBTKey& EK, ConstLWECiphertext& ct1,
@@ -125,6 +135,34 @@ LWECiphertext BinFHEScheme::EvalBinGate(const std::shared_ptr<BinFHECryptoParams
     return LWEscheme->SwitchCTtoqn(LWEParams, EK.KSkey, ctExt);
 }
 
+// The gates of a batch are independent, so each thread runs whole bootstrappings against the shared
+// (read-only) keys; the inner loops over the digits then run in the calling thread
+std::vector<LWECiphertext> BinFHEScheme::EvalBinGateBatch(
+    const std::shared_ptr<BinFHECryptoParams>& params, BINGATE gate, const RingGSWBTKey& EK,
+    const std::vector<std::pair<LWECiphertext, LWECiphertext>>& ctpairs, bool extended) const {
+    // the inputs are checked before the parallel region, so no gate of the batch is started for an invalid one
+    if (params == nullptr)
+        OPENFHE_THROW("BinFHECryptoParams is empty");
+    for (const auto& [ct1, ct2] : ctpairs) {
+        if (ct1 == nullptr)
+            OPENFHE_THROW("Ciphertext1 is empty");
+        if (ct2 == nullptr)
+            OPENFHE_THROW("Ciphertext2 is empty");
+        if (ct1 == ct2)
+            OPENFHE_THROW("Input ciphertexts should be independant");
+    }
+
+    const uint32_t size = ctpairs.size();
+    std::vector<LWECiphertext> result(size);
+    ThreadException e;
+#pragma omp parallel for schedule(dynamic) num_threads(OpenFHEParallelControls.GetThreadLimit(size))
+    for (uint32_t i = 0; i < size; ++i) {
+        e.Run([&, i] { result[i] = EvalBinGate(params, gate, EK, ctpairs[i].first, ctpairs[i].second, extended); });
+    }
+    e.Rethrow();
+    return result;
+}
+
 // Full evaluation as described in https://eprint.iacr.org/2020/086
 LWECiphertext BinFHEScheme::EvalBinGate(const std::shared_ptr<BinFHECryptoParams>& params, BINGATE gate,
                                         const RingGSWBTKey& EK, const std::vector<LWECiphertext>& ctvector, bool extended) const {
@@ -241,21 +279,40 @@ LWECiphertext BinFHEScheme::EvalNOT(const std::shared_ptr<BinFHECryptoParams>& p
 LWECiphertext BinFHEScheme::EvalFunc(const std::shared_ptr<BinFHECryptoParams>& params, const RingGSWBTKey& EK,
                                      ConstLWECiphertext& ct, const std::vector<NativeInteger>& LUT,
                                      const NativeInteger& beta) const {
+    return EvalFuncMulti(params, EK, ct, {LUT}, beta)[0];
+}
+
+// Evaluate several arbitrary functions of the same ciphertext with shared blind rotations
+// Modulus of ct is q | 2N
+std::vector<LWECiphertext> BinFHEScheme::EvalFuncMulti(const std::shared_ptr<BinFHECryptoParams>& params,
+                                                       const RingGSWBTKey& EK, ConstLWECiphertext& ct,
+                                                       const std::vector<std::vector<NativeInteger>>& LUTs,
+                                                       const NativeInteger& beta) const {
     if (params == nullptr)
         OPENFHE_THROW("BinFHECryptoParams is empty");
     if (ct == nullptr)
         OPENFHE_THROW("Ciphertext is empty");
+    if (LUTs.empty())
+        return {};
 
     auto ct1 = std::make_shared<LWECiphertextImpl>(*ct);
     NativeInteger q{ct->GetModulus()};
-    uint32_t functionProperty{this->checkInputFunction(LUT, q)};
+    uint32_t count{static_cast<uint32_t>(LUTs.size())};
+
+    // the functions share the path of the most general one; negacyclic and periodic
+    // functions are evaluated together as arbitrary ones
+    uint32_t functionProperty{this->checkInputFunction(LUTs[0], q)};
+    for (uint32_t k = 1; k < count; ++k) {
+        if (this->checkInputFunction(LUTs[k], q) != functionProperty)
+            functionProperty = 2;
+    }
 
     if (functionProperty == 0) {  // negacyclic function only needs one bootstrap
-        auto fLUT = [LUT](NativeInteger x, NativeInteger q, NativeInteger Q) -> NativeInteger {
-            return LUT[x.ConvertToInt()];
+        auto fLUT = [&LUTs](uint32_t k, NativeInteger x, NativeInteger q, NativeInteger Q) -> NativeInteger {
+            return LUTs[k][x.ConvertToInt()];
         };
         LWEscheme->EvalAddConstEq(ct1, beta);
-        return BootstrapFunc(params, EK, ct1, fLUT, q);
+        return BootstrapFuncMulti(params, EK, ct1, fLUT, count, q);
     }
 
     if (functionProperty == 2) {  // arbitary funciton
@@ -267,14 +324,6 @@ LWECiphertext BinFHEScheme::EvalFunc(const std::shared_ptr<BinFHECryptoParams>&
             OPENFHE_THROW(errMsg);
         }
 
-        // TODO: figure out a way to not do this :(
-
-        // repeat the LUT to make it periodic
-        std::vector<NativeInteger> LUT2;
-        LUT2.reserve(LUT.size() + LUT.size());
-        LUT2.insert(LUT2.end(), LUT.begin(), LUT.end());
-        LUT2.insert(LUT2.end(), LUT.begin(), LUT.end());
-
         NativeInteger dq{q << 1};
         // raise the modulus of ct1 : q -> 2q
         ct1->GetA().SetModulus(dq);
@@ -295,14 +344,17 @@ LWECiphertext BinFHEScheme::EvalFunc(const std::shared_ptr<BinFHECryptoParams>&
 
         // Now the input is within the range [0, q/2).
         // Note that for non-periodic function, the input q is boosted up to 2q
-        auto fLUT2 = [LUT2](NativeInteger x, NativeInteger q, NativeInteger Q) -> NativeInteger {
+        // and the LUT is repeated to make it periodic
+        auto fLUT2 = [&LUTs](uint32_t k, NativeInteger x, NativeInteger q, NativeInteger Q) -> NativeInteger {
+            const auto& LUT = LUTs[k];
             if (x < (q >> 1))
-                return LUT2[x.ConvertToInt()];
+                return LUT[x.ConvertToInt() % LUT.size()];
             else
-                return Q - LUT2[x.ConvertToInt() - q.ConvertToInt() / 2];
+                return Q - LUT[(x.ConvertToInt() - q.ConvertToInt() / 2) % LUT.size()];
         };
-        auto ct4 = BootstrapFunc(params, EK, ct3, fLUT2, dq);
-        ct4->SetModulus(q);
+        auto ct4 = BootstrapFuncMulti(params, EK, ct3, fLUT2, count, dq);
+        for (auto& ctk : ct4)
+            ctk->SetModulus(q);
         return ct4;
     }
 
@@ -322,13 +374,36 @@ LWECiphertext BinFHEScheme::EvalFunc(const std::shared_ptr<BinFHECryptoParams>&
 
     // Now the input is within the range [0, q/2).
     // Note that for non-periodic function, the input q is boosted up to 2q
-    auto fLUT1 = [LUT](NativeInteger x, NativeInteger q, NativeInteger Q) -> NativeInteger {
+    auto fLUT1 = [&LUTs](uint32_t k, NativeInteger x, NativeInteger q, NativeInteger Q) -> NativeInteger {
         if (x < (q >> 1))
-            return LUT[x.ConvertToInt()];
+            return LUTs[k][x.ConvertToInt()];
         else
-            return Q - LUT[x.ConvertToInt() - q.ConvertToInt() / 2];
+            return Q - LUTs[k][x.ConvertToInt() - q.ConvertToInt() / 2];
     };
-    return BootstrapFunc(params, EK, ct2, fLUT1, q);
+    return BootstrapFuncMulti(params, EK, ct2, fLUT1, count, q);
+}
+
+std::vector<LWECiphertext> BinFHEScheme::EvalFuncBatch(const std::shared_ptr<BinFHECryptoParams>& params,
+                                                       const RingGSWBTKey& EK, const std::vector<LWECiphertext>& cts,
+                                                       const std::vector<NativeInteger>& LUT,
+                                                       const NativeInteger& beta) const {
+    // the inputs are checked before the parallel region, so no function of the batch is started for an invalid one
+    if (params == nullptr)
+        OPENFHE_THROW("BinFHECryptoParams is empty");
+    for (const auto& ct : cts) {
+        if (ct == nullptr)
+            OPENFHE_THROW("Ciphertext is empty");
+    }
+
+    const uint32_t size = cts.size();
+    std::vector<LWECiphertext> result(size);
+    ThreadException e;
+#pragma omp parallel for schedule(dynamic) num_threads(OpenFHEParallelControls.GetThreadLimit(size))
+    for (uint32_t i = 0; i < size; ++i) {
+        e.Run([&, i] { result[i] = EvalFunc(params, EK, cts[i], LUT, beta); });
+    }
+    e.Rethrow();
+    return result;
 }
 
 // Evaluate Homomorphic Flooring
@@ -625,6 +700,36 @@ RLWECiphertext BinFHEScheme::BootstrapFuncCore(const std::shared_ptr<BinFHECrypt
     return acc;
 }
 
+// Multi-value bootstrapping as described in https://eprint.iacr.org/2018/622
+RLWECiphertext BinFHEScheme::BootstrapFuncMultiCore(const std::shared_ptr<BinFHECryptoParams>& params,
+                                                    ConstRingGSWACCKey& ek, ConstLWECiphertext& ct,
+                                                    const NativeInteger& scale) const {
+    if (ek == nullptr) {
+        std::string errMsg =
+            "Bootstrapping keys have not been generated. Please call BTKeyGen before calling bootstrapping.";
+        OPENFHE_THROW(errMsg);
+    }
+
+    auto& LWEParams  = params->GetLWEParams();
+    auto& RGSWParams = params->GetRingGSWParams();
+    auto polyParams  = RGSWParams->GetPolyParams();
+
+    // v0 = scale/2 (1 + X + ... + X^{N-1}) satisfies v0 * (1 - X) = scale, 2 is invertible as Q is odd
+    NativeInteger Q = LWEParams->GetQ();
+    NativeVector m(LWEParams->GetN(), Q, scale.ModMul(NativeInteger(2).ModInverse(Q), Q));
+
+    std::vector<NativePoly> res(2);
+    // no need to do NTT as all coefficients of this poly are zero
+    res[0] = NativePoly(polyParams, Format::EVALUATION, true);
+    res[1] = NativePoly(polyParams, Format::COEFFICIENT, false);
+    res[1].SetValues(std::move(m), Format::COEFFICIENT);
+    res[1].SetFormat(Format::EVALUATION);
+
+    auto acc = std::make_shared<RLWECiphertextImpl>(std::move(res));
+    ACCscheme->EvalAcc(RGSWParams, ek, acc, ct->GetA());
+    return acc;
+}
+
 // Full evaluation as described in https://eprint.iacr.org/2020/086
 template <typename Func>
 LWECiphertext BinFHEScheme::BootstrapFunc(const std::shared_ptr<BinFHECryptoParams>& params, const RingGSWBTKey& EK,
@@ -647,4 +752,92 @@ LWECiphertext BinFHEScheme::BootstrapFunc(const std::shared_ptr<BinFHECryptoPara
     return LWEscheme->ModSwitch(fmod, ctKS);
 }
 
+template <typename Func>
+std::vector<LWECiphertext> BinFHEScheme::BootstrapFuncMulti(const std::shared_ptr<BinFHECryptoParams>& params,
+                                                            const RingGSWBTKey& EK, ConstLWECiphertext& ct,
+                                                            const Func f, uint32_t count,
+                                                            const NativeInteger& fmod) const {
+    // a single function is evaluated directly, without the noise growth of the factorization
+    if (count == 1) {
+        auto f0 = [&f](NativeInteger x, NativeInteger q, NativeInteger Q) -> NativeInteger {
+            return f(0, x, q, Q);
+        };
+        return {BootstrapFunc(params, EK, ct, f0, fmod)};
+    }
+
+    auto& LWEParams = params->GetLWEParams();
+    auto polyParams = params->GetRingGSWParams()->GetPolyParams();
+    NativeInteger Q = LWEParams->GetQ();
+    uint32_t N      = LWEParams->GetN();
+    int64_t mod{fmod.ConvertToInt<int64_t>()};
+    NativeInteger ctMod{ct->GetModulus()};
+    uint32_t factor{2 * N / ctMod.ConvertToInt<uint32_t>()};
+    const NativeInteger& b = ct->GetB();
+
+    // the steps (1 - X) * LUT_k of the test polynomials, with each value repeated up to the next step of the
+    // rotation. The values are lifted from Z_fmod to the integers so that the steps are small: the differences
+    // are taken in (-fmod/2, fmod/2], and the wrap-around step lut[0] + lut[N-1] mod 2 fmod as the inverse
+    // of (1 - X) halves it
+    std::vector<std::vector<int64_t>> steps(count, std::vector<int64_t>(N));
+    std::vector<int64_t> lut(N);
+    int64_t g{mod};
+    for (uint32_t k = 0; k < count; ++k) {
+        for (uint32_t j = 0; j < (ctMod >> 1); ++j) {
+            auto value{f(k, b.ModSub(j, ctMod), ctMod, fmod).template ConvertToInt<int64_t>()};
+            std::fill(lut.begin() + j * factor, lut.begin() + (j + 1) * factor, value);
+        }
+        int64_t last{lut[0]};
+        for (uint32_t i = 1; i < N; ++i) {
+            int64_t d{(lut[i] - lut[i - 1]) % mod};
+            if (d > (mod >> 1))
+                d -= mod;
+            else if (d <= -(mod >> 1))
+                d += mod;
+            steps[k][i] = d;
+            last += d;
+        }
+        int64_t d0{(lut[0] + last) % (2 * mod)};
+        if (d0 > mod)
+            d0 -= 2 * mod;
+        else if (d0 <= -mod)
+            d0 += 2 * mod;
+        steps[k][0] = d0;
+        for (auto d : steps[k])
+            g = std::gcd(g, d);
+    }
+
+    // the common factor of the steps (e.g. fmod/p for functions over Z_p) is moved to v0 so that the
+    // noise of the accumulator is only multiplied by the 1-norm of the reduced steps
+    NativeInteger delta{Q.ConvertToInt() / fmod.ConvertToInt()};
+    auto acc{BootstrapFuncMultiCore(params, EK.BSkey, ct, delta * NativeInteger(g))->GetElements()};
+
+    std::vector<LWECiphertext> result(count);
+    for (uint32_t k = 0; k < count; ++k) {
+        NativeVector v(N, Q);
+        for (uint32_t i = 0; i < N; ++i) {
+            int64_t d{steps[k][i] / g};
+            v[i] = (d < 0) ? Q - NativeInteger(-d) : NativeInteger(d);
+        }
+        NativePoly vPoly(polyParams, Format::COEFFICIENT, false);
+        vPoly.SetValues(std::move(v), Format::COEFFICIENT);
+        vPoly.SetFormat(Format::EVALUATION);
+
+        // the accumulator result is encrypted w.r.t. the transposed secret key
+        // we can transpose "a" to get an encryption under the original secret key
+        NativePoly a{(acc[0] * vPoly).Transpose()};
+        NativePoly c{acc[1] * vPoly};
+        a.SetFormat(Format::COEFFICIENT);
+        c.SetFormat(Format::COEFFICIENT);
+
+        auto ctExt = std::make_shared<LWECiphertextImpl>(std::move(a.GetValues()), c[0]);
+        // Modulus switching to a middle step Q'
+        auto ctMS = LWEscheme->ModSwitch(LWEParams->GetqKS(), ctExt);
+        // Key switching
+        auto ctKS = LWEscheme->KeySwitch(LWEParams, EK.KSkey, ctMS);
+        // Modulus switching
+        result[k] = LWEscheme->ModSwitch(fmod, ctKS);
+    }
+    return result;
+}
+
 };  // namespace lbcrypto
@@ -0,0 +1,452 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+  Implementation of the persistent cache of the bootstrapping keys
+ */
+
+#include "binfhe-keycache.h"
+
+#include "utils/parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #define BTKEY_CACHE_MMAP 1
+#else
+    #define BTKEY_CACHE_MMAP 0
+#endif
+
+namespace lbcrypto {
+
+namespace {
+
+constexpr char BTKEY_CACHE_MAGIC[8]      = {'O', 'F', 'H', 'E', 'B', 'T', 'K', 'C'};
+constexpr uint64_t BTKEY_CACHE_VERSION   = 1;
+constexpr uint64_t BTKEY_CACHE_BYTEORDER = 0x0102030405060708;
+constexpr uint64_t BTKEY_CACHE_ALIGN     = 4096;
+
+// the header of the cache file; all sizes are in words of the respective section
+struct BTKeyCacheHeader {
+    char magic[8];
+    uint64_t version;
+    uint64_t byteOrder;
+    // parameters
+    uint64_t method;
+    uint64_t N;
+    uint64_t Q;
+    uint64_t n;
+    uint64_t qKS;
+    uint64_t baseKS;
+    uint64_t baseG;
+    uint64_t digitsG;
+    uint64_t numAutoKeys;
+    // refreshing key: dim1 x dim2 x dim3 Ring GSW keys, numKeys of them present with numPolys polynomials in total
+    uint64_t dim1;
+    uint64_t dim2;
+    uint64_t dim3;
+    uint64_t numKeys;
+    uint64_t numPolys;
+    // whether the FFT form of the keys is stored
+    uint64_t hasFFT;
+    // switching key, all zero if there is none
+    uint64_t ksN;
+    uint64_t ksDigitCount;
+    uint64_t ksBaseKS;
+    uint64_t ksn;
+    // byte offsets of the sections
+    uint64_t shapeOffset;
+    uint64_t polyOffset;
+    uint64_t fftOffset;
+    uint64_t ksAOffset;
+    uint64_t ksBOffset;
+    uint64_t fileSize;
+};
+
+uint64_t AlignUp(uint64_t x) {
+    return (x + BTKEY_CACHE_ALIGN - 1) & ~(BTKEY_CACHE_ALIGN - 1);
+}
+
+// the parameters of the header that have to match the context
+void SetParams(BTKeyCacheHeader& h, const std::shared_ptr<BinFHECryptoParams>& params) {
+    const auto& LWEParams  = params->GetLWEParams();
+    const auto& RGSWParams = params->GetRingGSWParams();
+    h.method               = RGSWParams->GetMethod();
+    h.N                    = RGSWParams->GetN();
+    h.Q                    = RGSWParams->GetQ().ConvertToInt<uint64_t>();
+    h.n                    = LWEParams->Getn();
+    h.qKS                  = LWEParams->GetqKS().ConvertToInt<uint64_t>();
+    h.baseKS               = LWEParams->GetBaseKS();
+    h.baseG                = RGSWParams->GetBaseG();
+    h.digitsG              = RGSWParams->GetDigitsG();
+    h.numAutoKeys          = RGSWParams->GetNumAutoKeys();
+}
+
+// the sizes derived from the header are checked, so that a corrupted file cannot wrap them around
+uint64_t MulSize(uint64_t a, uint64_t b) {
+    if (a != 0 && b > std::numeric_limits<uint64_t>::max() / a)
+        OPENFHE_THROW("The bootstrapping key cache is corrupted");
+    return a * b;
+}
+
+uint64_t AddSize(uint64_t a, uint64_t b) {
+    if (b > std::numeric_limits<uint64_t>::max() - a)
+        OPENFHE_THROW("The bootstrapping key cache is corrupted");
+    return a + b;
+}
+
+// the rows of the Ring GSW key at [.][i2][i3] of the refreshing key generated by KeyGenAcc, zero if there is none;
+// all keys have 2 columns
+uint32_t ExpectedRows(const std::shared_ptr<RingGSWCryptoParams>& params, uint64_t i2, uint64_t i3) {
+    const uint32_t digitsG2{(params->GetDigitsG() - 1) << 1};
+    switch (params->GetMethod()) {
+        case AP:
+            return i2 != 0 ? digitsG2 : 0;
+        case LMKCDEY:
+            // the automorphism keys
+            if (i2 == 1)
+                return i3 <= params->GetNumAutoKeys() ? digitsG2 >> 1 : 0;
+            return digitsG2;
+        default:
+            return digitsG2;
+    }
+}
+
+// read-only view of a whole file
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& filename) {
+#if BTKEY_CACHE_MMAP
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0)
+            OPENFHE_THROW("Cannot open the bootstrapping key cache " + filename);
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+            close(fd);
+            OPENFHE_THROW("Cannot read the bootstrapping key cache " + filename);
+        }
+        m_size = static_cast<size_t>(st.st_size);
+        // a private mapping shares the pages with the page cache until a polynomial adopted from it is
+        // written, which copies only that page and never changes the file
+        void* data{mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0)};
+        close(fd);
+        if (data == MAP_FAILED)
+            OPENFHE_THROW("Cannot map the bootstrapping key cache " + filename);
+        m_data = static_cast<uint8_t*>(data);
+#else
+        std::ifstream file(filename, std::ios::binary | std::ios::ate);
+        if (!file.is_open())
+            OPENFHE_THROW("Cannot open the bootstrapping key cache " + filename);
+        m_size = static_cast<size_t>(file.tellg());
+        // 64-bit words keep the sections aligned for the element types
+        m_buffer.resize((m_size + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+        file.seekg(0);
+        if (!file.read(reinterpret_cast<char*>(m_buffer.data()), m_size))
+            OPENFHE_THROW("Cannot read the bootstrapping key cache " + filename);
+        m_data = reinterpret_cast<uint8_t*>(m_buffer.data());
+#endif
+    }
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+#if BTKEY_CACHE_MMAP
+        munmap(m_data, m_size);
+#endif
+    }
+
+    const uint8_t* Data() const {
+        return m_data;
+    }
+
+    uint8_t* Data() {
+        return m_data;
+    }
+
+    size_t Size() const {
+        return m_size;
+    }
+
+private:
+    uint8_t* m_data{nullptr};
+    size_t m_size{0};
+#if !BTKEY_CACHE_MMAP
+    std::vector<uint64_t> m_buffer;
+#endif
+};
+
+}  // namespace
+
+void SaveBTKeyCache(const std::string& filename, const std::shared_ptr<BinFHECryptoParams>& params,
+                    const RingGSWBTKey& key) {
+    if (key.BSkey == nullptr)
+        OPENFHE_THROW("The bootstrapping key is empty");
+
+    BTKeyCacheHeader h{};
+    std::memcpy(h.magic, BTKEY_CACHE_MAGIC, sizeof(h.magic));
+    h.version   = BTKEY_CACHE_VERSION;
+    h.byteOrder = BTKEY_CACHE_BYTEORDER;
+    SetParams(h, params);
+
+    // the rows and columns of the Ring GSW keys in [dim1][dim2][dim3] order, zero for the missing ones
+    const auto& acc = key.BSkey->GetElements();
+    std::vector<uint32_t> shapes;
+    std::vector<const RingGSWEvalKeyImpl*> keys;
+    h.dim1   = acc.size();
+    h.dim2   = h.dim1 ? acc[0].size() : 0;
+    h.dim3   = h.dim2 ? acc[0][0].size() : 0;
+    h.hasFFT = 1;
+    for (const auto& l1 : acc) {
+        for (const auto& l2 : l1) {
+            if (l1.size() != h.dim2 || l2.size() != h.dim3)
+                OPENFHE_THROW("The refreshing key has irregular dimensions");
+            for (const auto& ek : l2) {
+                uint32_t rows{0}, cols{0};
+                if (ek != nullptr) {
+                    const auto& elements = ek->GetElements();
+                    rows                 = elements.size();
+                    cols                 = rows ? elements[0].size() : 0;
+                    for (const auto& row : elements) {
+                        if (row.size() != cols)
+                            OPENFHE_THROW("A Ring GSW key of the refreshing key has irregular dimensions");
+                    }
+                    if (ek->GetFFTSize() != uint64_t(rows) * cols * h.N)
+                        h.hasFFT = 0;
+                    keys.push_back(ek.get());
+                    h.numPolys += uint64_t(rows) * cols;
+                }
+                shapes.push_back(rows);
+                shapes.push_back(cols);
+            }
+        }
+    }
+    h.numKeys = keys.size();
+
+    const void* ksA{nullptr};
+    const uint64_t* ksB{nullptr};
+    uint64_t ksASize{0};
+    if (key.KSkey != nullptr) {
+        h.ksN          = key.KSkey->GetN();
+        h.ksDigitCount = key.KSkey->GetDigitCount();
+        h.ksBaseKS     = key.KSkey->GetBaseKS();
+        h.ksn          = key.KSkey->Getn();
+        if (key.KSkey->GetqKS().ConvertToInt<uint64_t>() != h.qKS)
+            OPENFHE_THROW("The switching key does not match the parameters");
+        ksA     = key.KSkey->GetKeyA();
+        ksB     = key.KSkey->GetKeyB();
+        ksASize = h.ksN * h.ksDigitCount * h.ksBaseKS * h.ksn * (key.KSkey->IsCompact() ? 4 : 8);
+    }
+    const uint64_t ksBSize{h.ksN * h.ksDigitCount * h.ksBaseKS * sizeof(uint64_t)};
+
+    h.shapeOffset = AlignUp(sizeof(h));
+    h.polyOffset  = AlignUp(h.shapeOffset + shapes.size() * sizeof(uint32_t));
+    h.fftOffset   = AlignUp(h.polyOffset + h.numPolys * h.N * sizeof(uint64_t));
+    h.ksAOffset   = AlignUp(h.fftOffset + h.hasFFT * h.numPolys * h.N * sizeof(double));
+    h.ksBOffset   = AlignUp(h.ksAOffset + ksASize);
+    h.fileSize    = h.ksBOffset + ksBSize;
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+        OPENFHE_THROW("Cannot create the bootstrapping key cache " + filename);
+    auto write = [&file](const void* data, uint64_t size) {
+        file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    };
+    auto pad = [&file](uint64_t offset) {
+        static const char zeros[BTKEY_CACHE_ALIGN] = {};
+        file.write(zeros, static_cast<std::streamsize>(offset - static_cast<uint64_t>(file.tellp())));
+    };
+
+    write(&h, sizeof(h));
+    pad(h.shapeOffset);
+    write(shapes.data(), shapes.size() * sizeof(uint32_t));
+    pad(h.polyOffset);
+    std::vector<uint64_t> words(h.N);
+    for (const auto* ek : keys) {
+        for (const auto& row : ek->GetElements()) {
+            for (const auto& poly : row) {
+                NativePoly eval(poly);
+                eval.SetFormat(Format::EVALUATION);
+                for (uint32_t j = 0; j < h.N; ++j)
+                    words[j] = eval[j].ConvertToInt<uint64_t>();
+                write(words.data(), words.size() * sizeof(uint64_t));
+            }
+        }
+    }
+    pad(h.fftOffset);
+    if (h.hasFFT) {
+        for (const auto* ek : keys)
+            write(ek->GetFFTElements(), ek->GetFFTSize() * sizeof(double));
+    }
+    pad(h.ksAOffset);
+    write(ksA, ksASize);
+    pad(h.ksBOffset);
+    write(ksB, ksBSize);
+    if (!file.good())
+        OPENFHE_THROW("Cannot write the bootstrapping key cache " + filename);
+}
+
+RingGSWBTKey LoadBTKeyCache(const std::string& filename, const std::shared_ptr<BinFHECryptoParams>& params) {
+    auto file = std::make_shared<MappedFile>(filename);
+    const uint8_t* data{file->Data()};
+
+    BTKeyCacheHeader h;
+    if (file->Size() < sizeof(h))
+        OPENFHE_THROW("The bootstrapping key cache " + filename + " is truncated");
+    std::memcpy(&h, data, sizeof(h));
+    if (std::memcmp(h.magic, BTKEY_CACHE_MAGIC, sizeof(h.magic)) != 0)
+        OPENFHE_THROW(filename + " is not a bootstrapping key cache");
+    if (h.version > BTKEY_CACHE_VERSION) {
+        OPENFHE_THROW("bootstrapping key cache version " + std::to_string(h.version) +
+                      " is from a later version of the library");
+    }
+    if (h.byteOrder != BTKEY_CACHE_BYTEORDER)
+        OPENFHE_THROW("The bootstrapping key cache was written on a machine with a different byte order");
+
+    BTKeyCacheHeader expected{};
+    SetParams(expected, params);
+    if (h.method != expected.method || h.N != expected.N || h.Q != expected.Q || h.n != expected.n ||
+        h.qKS != expected.qKS || h.baseKS != expected.baseKS || h.baseG != expected.baseG ||
+        h.digitsG != expected.digitsG || h.numAutoKeys != expected.numAutoKeys)
+        OPENFHE_THROW("The bootstrapping key cache was generated for different parameters");
+
+    // the shape of the refreshing key generated by KeyGenAcc of the method
+    const auto& LWEParams{params->GetLWEParams()};
+    const auto& RGSWParams{params->GetRingGSWParams()};
+    const bool isAP{h.method == AP};
+    if (h.dim1 != (isAP ? h.n : 1) || h.dim2 != (isAP ? RGSWParams->GetBaseR() : 2) ||
+        h.dim3 != (isAP ? RGSWParams->GetDigitsR().size() : h.n))
+        OPENFHE_THROW("The refreshing key in the bootstrapping key cache does not match the parameters");
+
+    // the shape of the switching key generated by KeySwitchGen, all zero if there is none
+    const uint64_t ksN{LWEParams->GetN()};
+    const auto ksDigitCount{static_cast<uint64_t>(
+        std::ceil(log(NativeInteger(h.qKS).ConvertToDouble()) / log(static_cast<double>(h.baseKS))))};
+    const bool hasKS{h.ksN != 0 || h.ksDigitCount != 0 || h.ksBaseKS != 0 || h.ksn != 0};
+    if (hasKS && (h.ksN != ksN || h.ksDigitCount != ksDigitCount || h.ksBaseKS != h.baseKS || h.ksn != h.n))
+        OPENFHE_THROW("The switching key in the bootstrapping key cache does not match the parameters");
+
+    const bool compact{NativeInteger(h.qKS).GetMSB() <= 31};
+    const uint64_t numSlots{MulSize(MulSize(h.dim1, h.dim2), h.dim3)};
+    const uint64_t polyWords{MulSize(h.numPolys, h.N)};
+    const uint64_t ksSize{MulSize(MulSize(h.ksN, h.ksDigitCount), h.ksBaseKS)};
+    const uint64_t ksABytes{MulSize(MulSize(ksSize, h.ksn), compact ? 4 : 8)};
+    if (h.hasFFT > 1 || h.fileSize != file->Size() || h.shapeOffset < sizeof(h) ||
+        h.polyOffset < AddSize(h.shapeOffset, MulSize(numSlots, 2 * sizeof(uint32_t))) ||
+        h.fftOffset < AddSize(h.polyOffset, MulSize(polyWords, sizeof(uint64_t))) ||
+        h.ksAOffset < AddSize(h.fftOffset, MulSize(h.hasFFT * polyWords, sizeof(double))) ||
+        h.ksBOffset < AddSize(h.ksAOffset, ksABytes) ||
+        h.fileSize < AddSize(h.ksBOffset, MulSize(ksSize, sizeof(uint64_t))) || h.shapeOffset % BTKEY_CACHE_ALIGN ||
+        h.polyOffset % BTKEY_CACHE_ALIGN || h.fftOffset % BTKEY_CACHE_ALIGN || h.ksAOffset % BTKEY_CACHE_ALIGN ||
+        h.ksBOffset % BTKEY_CACHE_ALIGN)
+        OPENFHE_THROW("The bootstrapping key cache " + filename + " is corrupted");
+
+    // the slots of the present keys and the index of their first polynomial
+    const auto* shapes{reinterpret_cast<const uint32_t*>(data + h.shapeOffset)};
+    std::vector<uint64_t> slots;
+    std::vector<uint64_t> firstPoly;
+    uint64_t numPolys{0};
+    for (uint64_t s = 0; s < numSlots; ++s) {
+        const uint32_t rows{ExpectedRows(RGSWParams, (s / h.dim3) % h.dim2, s % h.dim3)};
+        if (shapes[2 * s] != rows || shapes[2 * s + 1] != (rows ? 2 : 0))
+            OPENFHE_THROW("The refreshing key in the bootstrapping key cache does not match the parameters");
+        if (rows != 0) {
+            slots.push_back(s);
+            firstPoly.push_back(numPolys);
+            numPolys += uint64_t(rows) * 2;
+        }
+    }
+    if (slots.size() != h.numKeys || numPolys != h.numPolys)
+        OPENFHE_THROW("The bootstrapping key cache " + filename + " is corrupted");
+
+    RingGSWBTKey key;
+    key.BSkey = std::make_shared<RingGSWACCKeyImpl>(h.dim1, h.dim2, h.dim3);
+    std::vector<RingGSWEvalKeyImpl*> keys;
+    auto& acc = *key.BSkey;
+    for (auto s : slots) {
+        auto& ek = acc[s / (h.dim2 * h.dim3)][(s / h.dim3) % h.dim2][s % h.dim3];
+        ek       = std::make_shared<RingGSWEvalKeyImpl>(shapes[2 * s], shapes[2 * s + 1]);
+        keys.push_back(ek.get());
+    }
+
+    // the NTT arithmetic assumes reduced values
+    const auto* words{reinterpret_cast<const uint64_t*>(data + h.polyOffset)};
+    const uint64_t Q{h.Q};
+    if (std::any_of(words, words + polyWords, [Q](uint64_t w) { return w >= Q; }))
+        OPENFHE_THROW("The bootstrapping key cache " + filename + " is corrupted");
+
+    // the polynomials are adopted in place: every one is a chunk of a slab over the mapping
+    static_assert(sizeof(NativeInteger) == sizeof(uint64_t), "the key cache stores NativeInteger as 64-bit words");
+    const auto& polyParams{params->GetRingGSWParams()->GetPolyParams()};
+    auto slab = std::make_shared<ArenaSlab>(reinterpret_cast<char*>(file->Data() + h.polyOffset),
+                                            polyWords * sizeof(uint64_t), file);
+    const auto* ffts{reinterpret_cast<const double*>(data + h.fftOffset)};
+    const uint32_t N{static_cast<uint32_t>(h.N)};
+    const uint32_t numKeys{static_cast<uint32_t>(h.numKeys)};
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(numKeys))
+    for (uint32_t k = 0; k < numKeys; ++k) {
+        auto& ek{*keys[k]};
+        const uint32_t rows{shapes[2 * slots[k]]};
+        const uint32_t cols{shapes[2 * slots[k] + 1]};
+        uint64_t offset{firstPoly[k] * N * sizeof(uint64_t)};
+        for (uint32_t r = 0; r < rows; ++r) {
+            for (uint32_t c = 0; c < cols; ++c, offset += N * sizeof(uint64_t)) {
+                NativeVector values(N, polyParams->GetModulus(),
+                                    arena_allocator<NativeInteger>(slab, offset, N * sizeof(uint64_t)));
+                ek[r][c] = NativePoly(polyParams, Format::EVALUATION);
+                ek[r][c].SetValues(std::move(values), Format::EVALUATION);
+            }
+        }
+        if (h.hasFFT) {
+            ek.SetFFTElements(std::shared_ptr<const double>(file, ffts + firstPoly[k] * N),
+                              uint64_t(rows) * cols * N);
+        }
+    }
+
+    if (hasKS) {
+        key.KSkey = std::make_shared<LWESwitchingKeyImpl>(
+            h.ksN, h.ksDigitCount, h.ksBaseKS, h.ksn, NativeInteger(h.qKS), data + h.ksAOffset,
+            reinterpret_cast<const uint64_t*>(data + h.ksBOffset), file);
+    }
+    return key;
+}
+
+}  // namespace lbcrypto
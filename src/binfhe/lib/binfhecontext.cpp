@@ -34,6 +34,7 @@
  */
 
 #include "binfhecontext.h"
+#include "binfhe-keycache.h"
 
 #include <string>
 #include <unordered_map>
@@ -306,6 +307,31 @@ void BinFHEContext::BTKeyGen(ConstLWEPrivateKey& sk, KEYGEN_MODE keygenMode) {
     }
 }
 
+void BinFHEContext::BTKeySaveCache(const std::string& filename) const {
+    SaveBTKeyCache(filename, m_params, m_BTKey);
+}
+
+void BinFHEContext::BTKeyLoadCache(const std::string& filename) {
+    if (m_params == nullptr)
+        OPENFHE_THROW("The context has to be generated before the bootstrapping keys are loaded");
+    m_BTKey = LoadBTKeyCache(filename, m_params);
+    m_binfhescheme->PrecomputeBTKey(m_params, m_BTKey);
+    m_BTKey_map[m_params->GetRingGSWParams()->GetBaseG()] = m_BTKey;
+}
+
+void BinFHEContext::SetFFTAccumulator(bool useFFT) {
+    if (m_params == nullptr)
+        OPENFHE_THROW("The context has to be generated before the accumulator is selected");
+    const auto& RGSWParams = m_params->GetRingGSWParams();
+    if (useFFT)
+        RingGSWAccumulatorCGGIFFT::CheckParams(RGSWParams);
+
+    m_binfhescheme = std::make_shared<BinFHEScheme>(RGSWParams->GetMethod(), useFFT);
+    m_binfhescheme->PrecomputeBTKey(m_params, m_BTKey);
+    for (auto& [baseG, key] : m_BTKey_map)
+        m_binfhescheme->PrecomputeBTKey(m_params, key);
+}
+
 LWECiphertext BinFHEContext::EvalBinGate(const BINGATE gate, ConstLWECiphertext& ct1, ConstLWECiphertext& ct2,
                                          bool extended) const {
     if (ct1 == nullptr)
@@ -321,6 +347,17 @@ LWECiphertext BinFHEContext::EvalBinGate(const BINGATE gate, const std::vector<L
     return m_binfhescheme->EvalBinGate(m_params, gate, m_BTKey, ctvector, extended);
 }
 
+std::vector<LWECiphertext> BinFHEContext::EvalBinGateBatch(
+    const BINGATE gate, const std::vector<std::pair<LWECiphertext, LWECiphertext>>& ctpairs, bool extended) const {
+    for (const auto& [ct1, ct2] : ctpairs) {
+        if (ct1 == nullptr)
+            OPENFHE_THROW("Ciphertext1 is empty");
+        if (ct2 == nullptr)
+            OPENFHE_THROW("Ciphertext2 is empty");
+    }
+    return m_binfhescheme->EvalBinGateBatch(m_params, gate, m_BTKey, ctpairs, extended);
+}
+
 LWECiphertext BinFHEContext::Bootstrap(ConstLWECiphertext& ct, bool extended) const {
     if (ct == nullptr)
         OPENFHE_THROW("Ciphertext is empty");
@@ -343,6 +380,22 @@ LWECiphertext BinFHEContext::EvalFunc(ConstLWECiphertext& ct, const std::vector<
     return m_binfhescheme->EvalFunc(m_params, m_BTKey, ct, LUT, GetBeta());
 }
 
+std::vector<LWECiphertext> BinFHEContext::EvalFuncMulti(ConstLWECiphertext& ct,
+                                                        const std::vector<std::vector<NativeInteger>>& LUTs) const {
+    if (ct == nullptr)
+        OPENFHE_THROW("Ciphertext is empty");
+    return m_binfhescheme->EvalFuncMulti(m_params, m_BTKey, ct, LUTs, GetBeta());
+}
+
+std::vector<LWECiphertext> BinFHEContext::EvalFuncBatch(const std::vector<LWECiphertext>& cts,
+                                                        const std::vector<NativeInteger>& LUT) const {
+    for (const auto& ct : cts) {
+        if (ct == nullptr)
+            OPENFHE_THROW("Ciphertext is empty");
+    }
+    return m_binfhescheme->EvalFuncBatch(m_params, m_BTKey, cts, LUT, GetBeta());
+}
+
 LWECiphertext BinFHEContext::EvalFloor(ConstLWECiphertext& ct, uint32_t roundbits) const {
     //    auto q = m_params->GetLWEParams()->Getq().ConvertToInt();
     //    if (roundbits != 0) {
@@ -34,8 +34,56 @@
 #include "math/binaryuniformgenerator.h"
 #include "math/discreteuniformgenerator.h"
 #include "math/ternaryuniformgenerator.h"
+#include "utils/parallel.h"
+#include "utils/prng/blake2engine.h"
+
+#include <algorithm>
+#include <vector>
+
+// The AVX2 kernel is only built for x86-64 with GCC/Clang since it relies on a function-level
+// target attribute and on __builtin_cpu_supports() for runtime dispatch
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(__EMSCRIPTEN__)
+    #define LWE_KS_AVX2_AVAILABLE 1
+    #include <immintrin.h>
+#else
+    #define LWE_KS_AVX2_AVAILABLE 0
+#endif
 
 namespace lbcrypto {
+
+namespace {
+
+#if LWE_KS_AVX2_AVAILABLE
+// acc[k] = (acc[k] - row[k]) mod q for q < 2^31: the wrapped difference d is corrected by min(d, d + q)
+__attribute__((target("avx2"))) void SubtractRowAVX2(uint32_t* acc, const uint32_t* row, size_t n, uint32_t q) {
+    const __m256i vq = _mm256_set1_epi32(static_cast<int32_t>(q));
+    size_t k         = 0;
+    for (; k + 8 <= n; k += 8) {
+        __m256i d = _mm256_sub_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc + k)),
+                                     _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + k)));
+        d         = _mm256_min_epu32(d, _mm256_add_epi32(d, vq));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + k), d);
+    }
+    for (; k < n; ++k)
+        acc[k] = (acc[k] >= row[k]) ? acc[k] - row[k] : acc[k] + q - row[k];
+}
+#endif
+
+// subtracts one row of the switching key from the accumulator modulo q < 2^31
+void SubtractRow(uint32_t* acc, const uint32_t* row, size_t n, uint32_t q) {
+#if LWE_KS_AVX2_AVAILABLE
+    static const bool hasAVX2 = __builtin_cpu_supports("avx2");
+    if (hasAVX2) {
+        SubtractRowAVX2(acc, row, n, q);
+        return;
+    }
+#endif
+    for (size_t k = 0; k < n; ++k)
+        acc[k] = (acc[k] >= row[k]) ? acc[k] - row[k] : acc[k] + q - row[k];
+}
+
+}  // namespace
+
 // the main rounding operation used in ModSwitch (as described in Section 3 of
 // https://eprint.iacr.org/2014/816) The idea is that Round(x) = 0.5 + Floor(x)
 NativeInteger LWEEncryptionScheme::RoundqQ(const NativeInteger& v, const NativeInteger& q,
@@ -263,16 +311,41 @@ LWECiphertext LWEEncryptionScheme::ModSwitch(NativeInteger q, ConstLWECiphertext
 // Switching key as described in Section 3 of https://eprint.iacr.org/2014/816
 LWESwitchingKey LWEEncryptionScheme::KeySwitchGen(const std::shared_ptr<LWECryptoParams>& params,
                                                   ConstLWEPrivateKey& sk, ConstLWEPrivateKey& skN) const {
-    const size_t n(params->Getn());
-    const size_t N(params->GetN());
+    LWESwitchingKeySeed seed;
+    auto& prng = PseudoRandomNumberGenerator::GetPRNG();
+    for (auto& word : seed)
+        word = prng();
+    return KeySwitchGen(params, sk, skN, seed);
+}
+
+LWESwitchingKey LWEEncryptionScheme::KeySwitchGen(const std::shared_ptr<LWECryptoParams>& params,
+                                                  ConstLWEPrivateKey& sk, ConstLWEPrivateKey& skN,
+                                                  const LWESwitchingKeySeed& seed) const {
+    LWESwitchingKey ksk;
+    KeySwitchGenStream(params, sk, skN, seed, params->GetN(),
+                       [&ksk](ConstLWESwitchingKey& batch, uint32_t) {
+                           ksk = std::const_pointer_cast<LWESwitchingKeyImpl>(batch);
+                       });
+    return ksk;
+}
+
+void LWEEncryptionScheme::KeySwitchGenStream(
+    const std::shared_ptr<LWECryptoParams>& params, ConstLWEPrivateKey& sk, ConstLWEPrivateKey& skN,
+    const LWESwitchingKeySeed& seed, uint32_t rowsPerBatch,
+    const std::function<void(ConstLWESwitchingKey& batch, uint32_t firstRow)>& sink) const {
+    if (rowsPerBatch == 0)
+        OPENFHE_THROW("rowsPerBatch must be positive");
+
+    const uint32_t n(params->Getn());
+    const uint32_t N(params->GetN());
     NativeInteger qKS(params->GetqKS());
     NativeInteger::Integer value{1};
     NativeInteger::Integer baseKS(params->GetBaseKS());
     const auto digitCount =
-        static_cast<size_t>(std::ceil(log(qKS.ConvertToDouble()) / log(static_cast<double>(baseKS))));
+        static_cast<uint32_t>(std::ceil(log(qKS.ConvertToDouble()) / log(static_cast<double>(baseKS))));
     std::vector<NativeInteger> digitsKS;
     digitsKS.reserve(digitCount);
-    for (size_t i = 0; i < digitCount; ++i) {
+    for (uint32_t i = 0; i < digitCount; ++i) {
         digitsKS.emplace_back(value);
         value *= baseKS;
     }
@@ -284,63 +357,56 @@ LWESwitchingKey LWEEncryptionScheme::KeySwitchGen(const std::shared_ptr<LWECrypt
 
     NativeVector svN(skN->GetElement());
     svN.SwitchModulus(qKS);
-    //    NativeVector oldSK(oldSKlargeQ.GetLength(), qKS);
-    //    for (size_t i = 0; i < oldSK.GetLength(); i++) {
-    //        if ((oldSKlargeQ[i] == 0) || (oldSKlargeQ[i] == 1)) {
-    //            oldSK[i] = oldSKlargeQ[i];
-    //        }
-    //        else {
-    //            oldSK[i] = qKS - 1;
-    //        }
-    //    }
-
-    DiscreteUniformGeneratorImpl<NativeVector> dug(qKS);
 
     NativeInteger mu(qKS.ComputeMu());
-
-    std::vector<std::vector<std::vector<NativeVector>>> resultVecA(N);
-    std::vector<std::vector<std::vector<NativeInteger>>> resultVecB(N);
-
-    // TODO (cpascoe/dsuponit): this pragma needs to be revised as it may have to be removed completely
-    // #if !defined(__MINGW32__) && !defined(__MINGW64__)
-    // #pragma omp parallel for num_threads(N)
-    // #pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(N))
-    // #endif
-    for (size_t i = 0; i < N; ++i) {
-        std::vector<std::vector<NativeVector>> vector1A;
-        vector1A.reserve(baseKS);
-        std::vector<std::vector<NativeInteger>> vector1B;
-        vector1B.reserve(baseKS);
-
-        for (size_t j = 0; j < baseKS; ++j) {
-            std::vector<NativeVector> vector2A;
-            vector2A.reserve(digitCount);
-            std::vector<NativeInteger> vector2B;
-            vector2B.reserve(digitCount);
-            for (size_t k = 0; k < digitCount; ++k) {
-                vector2A.emplace_back(dug.GenerateVector(n));
-                NativeVector& a = vector2A.back();
-                NativeInteger b =
-                    (params->GetDggKS().GenerateInteger(qKS)).ModAdd(svN[i].ModMul(j * digitsKS[k], qKS), qKS);
+    const auto& dgg     = params->GetDggKS();
+    const uint64_t q    = qKS.ConvertToInt<uint64_t>();
+    // the smallest mask covering [0, qKS), so that there is no rejection for a power-of-two qKS
+    const uint32_t bits = NativeInteger(q - 1).GetMSB();
+    const uint64_t mask = (bits >= 64) ? ~uint64_t(0) : (uint64_t(1) << bits) - 1;
+
+    for (uint32_t first = 0; first < N; first += rowsPerBatch) {
+        const uint32_t rows = std::min(rowsPerBatch, N - first);
+        auto ksk            = std::make_shared<LWESwitchingKeyImpl>(rows, digitCount, baseKS, n, qKS);
+
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(rows))
+        for (uint32_t r = 0; r < rows; ++r) {
+            const uint32_t i = first + r;
+            default_prng::Blake2Engine::blake2_seed_array_t engineSeed{};
+            std::copy(seed.begin(), seed.end(), engineSeed.begin());
+            engineSeed[seed.size()] = i;
+            default_prng::Blake2Engine engine(engineSeed, 0);
+
+            NativeVector a(n, qKS);
+            for (uint32_t j = 0; j < baseKS; ++j) {
+                for (uint32_t k = 0; k < digitCount; ++k) {
+                    // uniform a by rejection sampling, then the error of b from the same stream
+                    for (uint32_t l = 0; l < n;) {
+                        uint64_t v = engine();
+                        if (bits > 32)
+                            v |= static_cast<uint64_t>(engine()) << 32;
+                        v &= mask;
+                        if (v < q)
+                            a[l++] = v;
+                    }
+                    NativeInteger b =
+                        dgg.GenerateInteger(qKS, engine).ModAdd(svN[i].ModMul(j * digitsKS[k], qKS), qKS);
 #if NATIVEINT == 32
-                for (size_t i = 0; i < n; ++i) {
-                    b.ModAddFastEq(a[i].ModMulFast(sv[i], qKS, mu), qKS);
-                }
+                    for (uint32_t l = 0; l < n; ++l) {
+                        b.ModAddFastEq(a[l].ModMulFast(sv[l], qKS, mu), qKS);
+                    }
 #else
-                for (size_t i = 0; i < n; ++i) {
-                    b += a[i].ModMulFast(sv[i], qKS, mu);
-                }
-                b.ModEq(qKS);
+                    for (uint32_t l = 0; l < n; ++l) {
+                        b += a[l].ModMulFast(sv[l], qKS, mu);
+                    }
+                    b.ModEq(qKS);
 #endif
-                vector2B.emplace_back(b);
+                    ksk->SetElement(r, k, j, a, b);
+                }
             }
-            vector1A.push_back(std::move(vector2A));
-            vector1B.push_back(std::move(vector2B));
         }
-        resultVecA[i] = std::move(vector1A);
-        resultVecB[i] = std::move(vector1B);
+        sink(ksk, first);
     }
-    return std::make_shared<LWESwitchingKeyImpl>(std::move(resultVecA), std::move(resultVecB));
 }
 
 // the key switching operation as described in Section 3 of
@@ -353,20 +419,40 @@ LWECiphertext LWEEncryptionScheme::KeySwitch(const std::shared_ptr<LWECryptoPara
     NativeInteger::Integer baseKS(params->GetBaseKS());
     const auto digitCount = static_cast<size_t>(std::ceil(log(Q.ConvertToDouble()) / log(static_cast<double>(baseKS))));
 
-    NativeVector a(n, Q);
     NativeInteger b(ctQN->GetB());
-    for (size_t i = 0; i < N; ++i) {
-        auto& refA = K->GetElementsA()[i];
-        auto& refB = K->GetElementsB()[i];
-        NativeInteger::Integer atmp(ctQN->GetA(i).ConvertToInt());
-        for (size_t j = 0; j < digitCount; ++j) {
-            const auto a0 = (atmp % baseKS);
-            atmp /= baseKS;
-            b.ModSubFastEq(refB[a0][j], Q);
-            auto& refAj = refA[a0][j];
-            for (size_t k = 0; k < n; ++k)
-                a[k].ModSubFastEq(refAj[k], Q);
+    NativeVector a(n, Q);
+    if (K->IsCompact()) {
+        // the rows are subtracted from a 32-bit accumulator that is copied into a once at the end
+        const uint32_t q = Q.ConvertToInt<uint32_t>();
+        std::vector<uint32_t> acc(n, 0);
+        for (size_t i = 0; i < N; ++i) {
+            NativeInteger::Integer atmp(ctQN->GetA(i).ConvertToInt());
+            for (size_t j = 0; j < digitCount; ++j) {
+                const auto a0 = (atmp % baseKS);
+                atmp /= baseKS;
+                b.ModSubFastEq(NativeInteger(K->GetElementB(i, j, a0)), Q);
+                SubtractRow(acc.data(), K->GetElementA32(i, j, a0), n, q);
+            }
+        }
+        for (size_t k = 0; k < n; ++k)
+            a[k] = acc[k];
+    }
+    else {
+        const uint64_t q = Q.ConvertToInt<uint64_t>();
+        std::vector<uint64_t> acc(n, 0);
+        for (size_t i = 0; i < N; ++i) {
+            NativeInteger::Integer atmp(ctQN->GetA(i).ConvertToInt());
+            for (size_t j = 0; j < digitCount; ++j) {
+                const auto a0 = (atmp % baseKS);
+                atmp /= baseKS;
+                b.ModSubFastEq(NativeInteger(K->GetElementB(i, j, a0)), Q);
+                const uint64_t* row = K->GetElementA64(i, j, a0);
+                for (size_t k = 0; k < n; ++k)
+                    acc[k] = (acc[k] >= row[k]) ? acc[k] - row[k] : acc[k] + q - row[k];
+            }
         }
+        for (size_t k = 0; k < n; ++k)
+            a[k] = acc[k];
     }
     return std::make_shared<LWECiphertextImpl>(std::move(a), b);
 }
@@ -0,0 +1,648 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+  CGGI accumulator with the external products computed in the double-precision FFT domain
+ */
+
+#include "rgsw-acc-cggi.h"
+
+#include "math/hal/intnat/transformnat-simd.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// the AVX2 kernels read the accumulator as plain 64-bit words
+#if NTT_SIMD_AVAILABLE && (NATIVEINT == 64)
+    #include <immintrin.h>
+    #define FFT_SIMD_AVAILABLE 1
+    #define FFT_TARGET_AVX2    __attribute__((target("avx2,fma")))
+#else
+    #define FFT_SIMD_AVAILABLE 0
+#endif
+
+namespace lbcrypto {
+
+namespace {
+
+/*
+ * Negacyclic FFT over double: a real polynomial of R[X]/(X^N + 1) is represented by its values at the
+ * N/2 roots zeta^(4k+1), zeta = exp(i pi / N), one of every complex conjugate pair. Folding the
+ * coefficients into y_j = (a_j + i a_{j+N/2}) zeta^j turns them into a complex DFT of size N/2.
+ * Complex vectors are kept as separate real and imaginary arrays, and the FFT values are in
+ * bit-reversed order, which is the same for every operand.
+ */
+class NegacyclicFFT {
+public:
+    explicit NegacyclicFFT(uint32_t N)
+        : m_N(N),
+          m_h(N >> 1),
+          m_zetaRe(2 * N),
+          m_zetaIm(2 * N),
+          m_untwistRe(N >> 1),
+          m_untwistIm(N >> 1),
+          m_wRe(N >> 1),
+          m_wIm(N >> 1),
+          m_exponent(N >> 1) {
+        const double pi{std::acos(-1.0)};
+        for (uint32_t t = 0; t < 2 * N; ++t) {
+            m_zetaRe[t] = std::cos(pi * t / N);
+            m_zetaIm[t] = std::sin(pi * t / N);
+        }
+        for (uint32_t j = 0; j < m_h; ++j) {
+            m_untwistRe[j] = m_zetaRe[j] / m_h;
+            m_untwistIm[j] = -m_zetaIm[j] / m_h;
+        }
+        // the twiddles exp(2 pi i j / len), j < len / 2, of the stage of length len start at len / 2 - 1
+        for (uint32_t len = 2; len <= m_h; len <<= 1) {
+            for (uint32_t j = 0; j < (len >> 1); ++j) {
+                m_wRe[(len >> 1) - 1 + j] = m_zetaRe[2 * N / len * j];
+                m_wIm[(len >> 1) - 1 + j] = m_zetaIm[2 * N / len * j];
+            }
+        }
+        uint32_t logh{0};
+        while ((1u << logh) < m_h)
+            ++logh;
+        for (uint32_t p = 0; p < m_h; ++p) {
+            uint32_t k{0};
+            for (uint32_t b = 0; b < logh; ++b)
+                k |= ((p >> b) & 1) << (logh - 1 - b);
+            m_exponent[p] = 4 * k + 1;
+        }
+#if FFT_SIMD_AVAILABLE
+        m_useAVX2 = (m_h >= 8) && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+    }
+
+    // number of complex values
+    uint32_t GetSize() const {
+        return m_h;
+    }
+
+    // whether the AVX2 kernels are used
+    bool UseAVX2() const {
+        return m_useAVX2;
+    }
+
+    // re/im hold a_j and a_{j+N/2} on input and the FFT values on output
+    void Forward(double* re, double* im) const {
+#if FFT_SIMD_AVAILABLE
+        if (m_useAVX2)
+            return ForwardAVX2(re, im);
+#endif
+        for (uint32_t j = 0; j < m_h; ++j) {
+            const double r{re[j]};
+            re[j] = r * m_zetaRe[j] - im[j] * m_zetaIm[j];
+            im[j] = r * m_zetaIm[j] + im[j] * m_zetaRe[j];
+        }
+        // decimation in frequency, natural to bit-reversed order
+        for (uint32_t len = m_h; len >= 2; len >>= 1) {
+            const uint32_t half{len >> 1};
+            const double* wr{m_wRe.data() + half - 1};
+            const double* wi{m_wIm.data() + half - 1};
+            for (uint32_t s = 0; s < m_h; s += len) {
+                double* xr{re + s};
+                double* xi{im + s};
+                double* yr{xr + half};
+                double* yi{xi + half};
+                for (uint32_t j = 0; j < half; ++j) {
+                    const double dr{xr[j] - yr[j]};
+                    const double di{xi[j] - yi[j]};
+                    xr[j] += yr[j];
+                    xi[j] += yi[j];
+                    yr[j] = dr * wr[j] - di * wi[j];
+                    yi[j] = dr * wi[j] + di * wr[j];
+                }
+            }
+        }
+    }
+
+    // inverse of Forward()
+    void Inverse(double* re, double* im) const {
+#if FFT_SIMD_AVAILABLE
+        if (m_useAVX2)
+            return InverseAVX2(re, im);
+#endif
+        // decimation in time, bit-reversed to natural order
+        for (uint32_t len = 2; len <= m_h; len <<= 1) {
+            const uint32_t half{len >> 1};
+            const double* wr{m_wRe.data() + half - 1};
+            const double* wi{m_wIm.data() + half - 1};
+            for (uint32_t s = 0; s < m_h; s += len) {
+                double* xr{re + s};
+                double* xi{im + s};
+                double* yr{xr + half};
+                double* yi{xi + half};
+                for (uint32_t j = 0; j < half; ++j) {
+                    const double vr{yr[j] * wr[j] + yi[j] * wi[j]};
+                    const double vi{yi[j] * wr[j] - yr[j] * wi[j]};
+                    yr[j] = xr[j] - vr;
+                    yi[j] = xi[j] - vi;
+                    xr[j] += vr;
+                    xi[j] += vi;
+                }
+            }
+        }
+        for (uint32_t j = 0; j < m_h; ++j) {
+            const double r{re[j]};
+            re[j] = r * m_untwistRe[j] - im[j] * m_untwistIm[j];
+            im[j] = r * m_untwistIm[j] + im[j] * m_untwistRe[j];
+        }
+    }
+
+    // (re, im) = s1 * (X^e1 - 1) + s2 * (X^e2 - 1) in the FFT domain, see RingGSWCryptoParams::GetMonomial()
+    void MulMonomials(const double* s1Re, const double* s1Im, uint32_t e1, const double* s2Re, const double* s2Im,
+                      uint32_t e2, double* re, double* im) const {
+        const uint32_t mask{2 * m_N - 1};
+        e1 &= mask;
+        e2 &= mask;
+        for (uint32_t p = 0; p < m_h; ++p) {
+            const uint32_t t1{(m_exponent[p] * e1) & mask};
+            const uint32_t t2{(m_exponent[p] * e2) & mask};
+            const double m1r{m_zetaRe[t1] - 1.0};
+            const double m2r{m_zetaRe[t2] - 1.0};
+            const double r{s1Re[p] * m1r - s1Im[p] * m_zetaIm[t1] + s2Re[p] * m2r - s2Im[p] * m_zetaIm[t2]};
+            im[p] = s1Re[p] * m_zetaIm[t1] + s1Im[p] * m1r + s2Re[p] * m_zetaIm[t2] + s2Im[p] * m2r;
+            re[p] = r;
+        }
+    }
+
+private:
+#if FFT_SIMD_AVAILABLE
+    FFT_TARGET_AVX2 static inline void MulAVX2(__m256d& xr, __m256d& xi, __m256d wr, __m256d wi) {
+        __m256d r{_mm256_fmsub_pd(xr, wr, _mm256_mul_pd(xi, wi))};
+        xi = _mm256_fmadd_pd(xr, wi, _mm256_mul_pd(xi, wr));
+        xr = r;
+    }
+
+    // the stages of length 4 and 2 inside one vector [x0 x1 x2 x3]; their twiddles are 1 and +-i
+    template <bool Forward>
+    FFT_TARGET_AVX2 static inline void ShortStagesAVX2(__m256d& xr, __m256d& xi) {
+        const __m256d zero{_mm256_setzero_pd()};
+        if (Forward) {
+            // (x0, x2), (x1, x3) with the twiddles 1 and i
+            __m256d rlo{_mm256_permute2f128_pd(xr, xr, 0x00)};
+            __m256d rhi{_mm256_permute2f128_pd(xr, xr, 0x11)};
+            __m256d ilo{_mm256_permute2f128_pd(xi, xi, 0x00)};
+            __m256d ihi{_mm256_permute2f128_pd(xi, xi, 0x11)};
+            __m256d r{_mm256_blend_pd(_mm256_add_pd(rlo, rhi), _mm256_sub_pd(rlo, rhi), 0b1100)};
+            __m256d i{_mm256_blend_pd(_mm256_add_pd(ilo, ihi), _mm256_sub_pd(ilo, ihi), 0b1100)};
+            xr = _mm256_blend_pd(r, _mm256_sub_pd(zero, i), 0b1000);
+            xi = _mm256_blend_pd(i, r, 0b1000);
+        }
+        // (x0, x1), (x2, x3) with the twiddle 1
+        __m256d re{_mm256_movedup_pd(xr)};
+        __m256d ro{_mm256_permute_pd(xr, 0b1111)};
+        __m256d ie{_mm256_movedup_pd(xi)};
+        __m256d io{_mm256_permute_pd(xi, 0b1111)};
+        xr = _mm256_blend_pd(_mm256_add_pd(re, ro), _mm256_sub_pd(re, ro), 0b1010);
+        xi = _mm256_blend_pd(_mm256_add_pd(ie, io), _mm256_sub_pd(ie, io), 0b1010);
+        if (!Forward) {
+            // (x0, x2), (x1, x3) with the twiddles 1 and -i
+            __m256d rlo{_mm256_permute2f128_pd(xr, xr, 0x00)};
+            __m256d rhi{_mm256_permute2f128_pd(xr, xr, 0x11)};
+            __m256d ilo{_mm256_permute2f128_pd(xi, xi, 0x00)};
+            __m256d ihi{_mm256_permute2f128_pd(xi, xi, 0x11)};
+            __m256d vr{_mm256_blend_pd(rhi, ihi, 0b1010)};
+            __m256d vi{_mm256_blend_pd(ihi, _mm256_sub_pd(zero, rhi), 0b1010)};
+            xr = _mm256_blend_pd(_mm256_add_pd(rlo, vr), _mm256_sub_pd(rlo, vr), 0b1100);
+            xi = _mm256_blend_pd(_mm256_add_pd(ilo, vi), _mm256_sub_pd(ilo, vi), 0b1100);
+        }
+    }
+
+    FFT_TARGET_AVX2 void ForwardAVX2(double* re, double* im) const {
+        for (uint32_t j = 0; j < m_h; j += 4) {
+            __m256d xr{_mm256_loadu_pd(re + j)};
+            __m256d xi{_mm256_loadu_pd(im + j)};
+            MulAVX2(xr, xi, _mm256_loadu_pd(m_zetaRe.data() + j), _mm256_loadu_pd(m_zetaIm.data() + j));
+            _mm256_storeu_pd(re + j, xr);
+            _mm256_storeu_pd(im + j, xi);
+        }
+        for (uint32_t len = m_h; len >= 8; len >>= 1) {
+            const uint32_t half{len >> 1};
+            const double* wr{m_wRe.data() + half - 1};
+            const double* wi{m_wIm.data() + half - 1};
+            for (uint32_t s = 0; s < m_h; s += len) {
+                for (uint32_t j = s; j < s + half; j += 4) {
+                    __m256d xr{_mm256_loadu_pd(re + j)};
+                    __m256d xi{_mm256_loadu_pd(im + j)};
+                    __m256d yr{_mm256_loadu_pd(re + j + half)};
+                    __m256d yi{_mm256_loadu_pd(im + j + half)};
+                    __m256d dr{_mm256_sub_pd(xr, yr)};
+                    __m256d di{_mm256_sub_pd(xi, yi)};
+                    MulAVX2(dr, di, _mm256_loadu_pd(wr + j - s), _mm256_loadu_pd(wi + j - s));
+                    _mm256_storeu_pd(re + j, _mm256_add_pd(xr, yr));
+                    _mm256_storeu_pd(im + j, _mm256_add_pd(xi, yi));
+                    _mm256_storeu_pd(re + j + half, dr);
+                    _mm256_storeu_pd(im + j + half, di);
+                }
+            }
+        }
+        for (uint32_t j = 0; j < m_h; j += 4) {
+            __m256d xr{_mm256_loadu_pd(re + j)};
+            __m256d xi{_mm256_loadu_pd(im + j)};
+            ShortStagesAVX2<true>(xr, xi);
+            _mm256_storeu_pd(re + j, xr);
+            _mm256_storeu_pd(im + j, xi);
+        }
+    }
+
+    FFT_TARGET_AVX2 void InverseAVX2(double* re, double* im) const {
+        for (uint32_t j = 0; j < m_h; j += 4) {
+            __m256d xr{_mm256_loadu_pd(re + j)};
+            __m256d xi{_mm256_loadu_pd(im + j)};
+            ShortStagesAVX2<false>(xr, xi);
+            _mm256_storeu_pd(re + j, xr);
+            _mm256_storeu_pd(im + j, xi);
+        }
+        for (uint32_t len = 8; len <= m_h; len <<= 1) {
+            const uint32_t half{len >> 1};
+            const double* wr{m_wRe.data() + half - 1};
+            const double* wi{m_wIm.data() + half - 1};
+            for (uint32_t s = 0; s < m_h; s += len) {
+                for (uint32_t j = s; j < s + half; j += 4) {
+                    __m256d xr{_mm256_loadu_pd(re + j)};
+                    __m256d xi{_mm256_loadu_pd(im + j)};
+                    __m256d vr{_mm256_loadu_pd(re + j + half)};
+                    __m256d vi{_mm256_loadu_pd(im + j + half)};
+                    // multiplication by the conjugate twiddle
+                    MulAVX2(vr, vi, _mm256_loadu_pd(wr + j - s),
+                            _mm256_sub_pd(_mm256_setzero_pd(), _mm256_loadu_pd(wi + j - s)));
+                    _mm256_storeu_pd(re + j, _mm256_add_pd(xr, vr));
+                    _mm256_storeu_pd(im + j, _mm256_add_pd(xi, vi));
+                    _mm256_storeu_pd(re + j + half, _mm256_sub_pd(xr, vr));
+                    _mm256_storeu_pd(im + j + half, _mm256_sub_pd(xi, vi));
+                }
+            }
+        }
+        for (uint32_t j = 0; j < m_h; j += 4) {
+            __m256d xr{_mm256_loadu_pd(re + j)};
+            __m256d xi{_mm256_loadu_pd(im + j)};
+            MulAVX2(xr, xi, _mm256_loadu_pd(m_untwistRe.data() + j), _mm256_loadu_pd(m_untwistIm.data() + j));
+            _mm256_storeu_pd(re + j, xr);
+            _mm256_storeu_pd(im + j, xi);
+        }
+    }
+#endif
+
+    uint32_t m_N;
+    uint32_t m_h;
+    // zeta^t for t < 2N; the first N/2 entries twist the input
+    std::vector<double> m_zetaRe;
+    std::vector<double> m_zetaIm;
+    // zeta^{-j} / (N/2)
+    std::vector<double> m_untwistRe;
+    std::vector<double> m_untwistIm;
+    std::vector<double> m_wRe;
+    std::vector<double> m_wIm;
+    // 4k + 1 for the value at position p
+    std::vector<uint32_t> m_exponent;
+    bool m_useAVX2{false};
+};
+
+const NegacyclicFFT& GetNegacyclicFFT(uint32_t N) {
+    static std::map<uint32_t, NegacyclicFFT> ffts;
+    static std::mutex mtx;
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = ffts.find(N);
+    if (it == ffts.end())
+        it = ffts.emplace(N, NegacyclicFFT(N)).first;
+    return it->second;
+}
+
+// Scratch space of the FFT accumulator updates of one thread
+struct FFTWorkspace {
+    // (digitsG - 1) * 2 digits, N doubles each
+    std::vector<double> digits;
+    // the inner products of the digits with the two columns of both keys, N doubles each
+    std::vector<double> sum;
+};
+
+FFTWorkspace& GetFFTWorkspace(uint32_t N, uint32_t count) {
+    thread_local FFTWorkspace ws;
+    if (ws.digits.size() < size_t(count) * N)
+        ws.digits.resize(size_t(count) * N);
+    if (ws.sum.size() < size_t(4) * N)
+        ws.sum.resize(size_t(4) * N);
+    return ws;
+}
+
+/*
+ * The steps of the external product. The digits are the signed ones of
+ * RingGSWAccumulator::SignedDigitDecompose() (the first digit is ignored), digit i of component c
+ * goes to out + (2 * i + c) * N. The inner products sum[2 * j + k] = sum_d digit[d] * ekj[d][k] are
+ * taken with the columns k of the two keys j. The rounded products are added to the accumulator mod Q.
+ */
+
+void DecomposeScalar(const std::vector<NativePoly>& acc, int64_t Q, uint32_t gBits, uint32_t digitsG, uint32_t N,
+                     double* out) {
+    const int64_t QHalf{Q >> 1};
+    const uint32_t shift{64 - gBits};
+    for (uint32_t c = 0; c < 2; ++c) {
+        for (uint32_t k = 0; k < N; ++k) {
+            auto t{acc[c][k].ConvertToInt<int64_t>()};
+            int64_t d{t < QHalf ? t : t - Q};
+            int64_t r{static_cast<int64_t>(static_cast<uint64_t>(d) << shift) >> shift};
+            d = (d - r) >> gBits;
+            double* o{out + c * N + k};
+            for (uint32_t i = 0; i < digitsG; ++i, o += 2 * N) {
+                r = static_cast<int64_t>(static_cast<uint64_t>(d) << shift) >> shift;
+                d = (d - r) >> gBits;
+                *o = static_cast<double>(r);
+            }
+        }
+    }
+}
+
+void InnerProductScalar(const double* digits, uint32_t count, const double* ek1, const double* ek2, uint32_t N,
+                        double* sum) {
+    const uint32_t h{N >> 1};
+    std::fill(sum, sum + 4 * N, 0.0);
+    for (uint32_t d = 0; d < count; ++d) {
+        const double* xr{digits + d * N};
+        const double* xi{xr + h};
+        for (uint32_t j = 0; j < 4; ++j) {
+            const double* yr{((j < 2) ? ek1 : ek2) + (2 * d + (j & 1)) * N};
+            const double* yi{yr + h};
+            double* sr{sum + j * N};
+            double* si{sr + h};
+            for (uint32_t p = 0; p < h; ++p) {
+                sr[p] += xr[p] * yr[p] - xi[p] * yi[p];
+                si[p] += xr[p] * yi[p] + xi[p] * yr[p];
+            }
+        }
+    }
+}
+
+// adding and subtracting 1.5 * 2^52 rounds a double of magnitude below 2^51 to the nearest integer
+constexpr double ROUND_MAGIC{6755399441055744.0};
+
+void AddRoundedScalar(const double* x, int64_t Q, uint32_t N, NativePoly& acc) {
+    const double Qd{static_cast<double>(Q)};
+    const double QInv{1.0 / Qd};
+    for (uint32_t j = 0; j < N; ++j) {
+        const double r{(x[j] + ROUND_MAGIC) - ROUND_MAGIC};
+        const double t{(r * QInv + ROUND_MAGIC) - ROUND_MAGIC};
+        auto v{static_cast<int64_t>(r - t * Qd)};
+        v += (v < 0) ? Q : 0;
+        auto sum{acc[j].ConvertToInt<int64_t>() + v};
+        acc[j] = static_cast<uint64_t>(sum >= Q ? sum - Q : sum);
+    }
+}
+
+#if FFT_SIMD_AVAILABLE
+
+// requires Q < 2^31 and N divisible by 8; the digits are computed in 32-bit lanes
+FFT_TARGET_AVX2 void DecomposeAVX2(const uint64_t* acc0, const uint64_t* acc1, int64_t Q, uint32_t gBits,
+                                   uint32_t digitsG, uint32_t N, double* out) {
+    const __m256i q{_mm256_set1_epi32(static_cast<int32_t>(Q))};
+    const __m256i qHalf{_mm256_set1_epi32(static_cast<int32_t>((Q >> 1) - 1))};
+    const __m256i lowHalves{_mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7)};
+    const __m128i shift{_mm_cvtsi32_si128(static_cast<int>(32 - gBits))};
+    const __m128i bits{_mm_cvtsi32_si128(static_cast<int>(gBits))};
+    for (uint32_t c = 0; c < 2; ++c) {
+        const uint64_t* acc{c == 0 ? acc0 : acc1};
+        for (uint32_t k = 0; k < N; k += 8) {
+            __m256i lo{_mm256_permutevar8x32_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc + k)),
+                                                   lowHalves)};
+            __m256i hi{_mm256_permutevar8x32_epi32(
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc + k + 4)), lowHalves)};
+            __m256i t{_mm256_permute2x128_si256(lo, hi, 0x20)};
+            __m256i d{_mm256_sub_epi32(t, _mm256_and_si256(_mm256_cmpgt_epi32(t, qHalf), q))};
+            __m256i r{_mm256_sra_epi32(_mm256_sll_epi32(d, shift), shift)};
+            d = _mm256_sra_epi32(_mm256_sub_epi32(d, r), bits);
+            double* o{out + c * N + k};
+            for (uint32_t i = 0; i < digitsG; ++i, o += 2 * N) {
+                r = _mm256_sra_epi32(_mm256_sll_epi32(d, shift), shift);
+                d = _mm256_sra_epi32(_mm256_sub_epi32(d, r), bits);
+                _mm256_storeu_pd(o, _mm256_cvtepi32_pd(_mm256_castsi256_si128(r)));
+                _mm256_storeu_pd(o + 4, _mm256_cvtepi32_pd(_mm256_extracti128_si256(r, 1)));
+            }
+        }
+    }
+}
+
+// the eight sums of four coefficients are kept in registers over all digits
+FFT_TARGET_AVX2 void InnerProductAVX2(const double* digits, uint32_t count, const double* ek1, const double* ek2,
+                                      uint32_t N, double* sum) {
+    const uint32_t h{N >> 1};
+    for (uint32_t p = 0; p < h; p += 4) {
+        __m256d sr[4];
+        __m256d si[4];
+        for (uint32_t j = 0; j < 4; ++j)
+            sr[j] = si[j] = _mm256_setzero_pd();
+        for (uint32_t d = 0; d < count; ++d) {
+            const __m256d xr{_mm256_loadu_pd(digits + d * N + p)};
+            const __m256d xi{_mm256_loadu_pd(digits + d * N + h + p)};
+            for (uint32_t j = 0; j < 4; ++j) {
+                const double* y{((j < 2) ? ek1 : ek2) + (2 * d + (j & 1)) * N + p};
+                const __m256d yr{_mm256_loadu_pd(y)};
+                const __m256d yi{_mm256_loadu_pd(y + h)};
+                sr[j] = _mm256_fnmadd_pd(xi, yi, _mm256_fmadd_pd(xr, yr, sr[j]));
+                si[j] = _mm256_fmadd_pd(xi, yr, _mm256_fmadd_pd(xr, yi, si[j]));
+            }
+        }
+        for (uint32_t j = 0; j < 4; ++j) {
+            _mm256_storeu_pd(sum + j * N + p, sr[j]);
+            _mm256_storeu_pd(sum + j * N + h + p, si[j]);
+        }
+    }
+}
+
+FFT_TARGET_AVX2 void AddRoundedAVX2(const double* x, int64_t Q, uint32_t N, uint64_t* acc) {
+    const __m256d magic{_mm256_set1_pd(ROUND_MAGIC)};
+    const __m256i magicBits{_mm256_castpd_si256(magic)};
+    const __m256d qd{_mm256_set1_pd(static_cast<double>(Q))};
+    const __m256d qInv{_mm256_set1_pd(1.0 / static_cast<double>(Q))};
+    const __m256i q{_mm256_set1_epi64x(Q)};
+    const __m256i qm1{_mm256_set1_epi64x(Q - 1)};
+    const __m256i zero{_mm256_setzero_si256()};
+    for (uint32_t j = 0; j < N; j += 4) {
+        __m256d r{_mm256_sub_pd(_mm256_add_pd(_mm256_loadu_pd(x + j), magic), magic)};
+        __m256d t{_mm256_sub_pd(_mm256_add_pd(_mm256_mul_pd(r, qInv), magic), magic)};
+        // r - t * Q is an integer of magnitude below Q, whose bits are read off r - t * Q + 1.5 * 2^52
+        __m256i v{_mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(_mm256_fnmadd_pd(t, qd, r), magic)),
+                                   magicBits)};
+        v = _mm256_add_epi64(v, _mm256_and_si256(_mm256_cmpgt_epi64(zero, v), q));
+        __m256i s{_mm256_add_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc + j)), v)};
+        s = _mm256_sub_epi64(s, _mm256_and_si256(_mm256_cmpgt_epi64(s, qm1), q));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + j), s);
+    }
+}
+
+#endif  // FFT_SIMD_AVAILABLE
+
+// The accumulation of AddToAccCGGI, acc = acc + dct * ek1 * (X^a - 1) + dct * ek2 * (X^{-a} - 1), in the FFT
+// domain, where both monomials are applied before the single inverse FFT of each component; fft and ws are those
+// of the ring dimension and the digits of params, looked up once per EvalAcc
+void AddToAccCGGIFFT(const std::shared_ptr<RingGSWCryptoParams>& params, const NegacyclicFFT& fft, FFTWorkspace& ws,
+                     ConstRingGSWEvalKey& ek1, ConstRingGSWEvalKey& ek2, uint32_t a, RLWECiphertext& acc) {
+    const double* fft1{ek1->GetFFTElements()};
+    const double* fft2{ek2->GetFFTElements()};
+    if (fft1 == nullptr || fft2 == nullptr)
+        OPENFHE_THROW("The bootstrapping key has no FFT form; it has to be precomputed for the FFT accumulator");
+
+    const uint32_t N{params->GetN()};
+    const uint32_t h{fft.GetSize()};
+    // approximate gadget decomposition is used; the first digit is ignored
+    const uint32_t digitsG{params->GetDigitsG() - 1};
+    const uint32_t digitsG2{digitsG << 1};
+    const auto Q{params->GetQ().ConvertToInt<int64_t>()};
+    const uint32_t gBits{static_cast<uint32_t>(__builtin_ctz(params->GetBaseG()))};
+    auto& accElems{acc->GetElements()};
+
+#if FFT_SIMD_AVAILABLE
+    const bool useAVX2{fft.UseAVX2() && Q < (int64_t(1) << 31)};
+    if (useAVX2)
+        DecomposeAVX2(reinterpret_cast<const uint64_t*>(&accElems[0][0]),
+                      reinterpret_cast<const uint64_t*>(&accElems[1][0]), Q, gBits, digitsG, N, ws.digits.data());
+    else
+#endif
+        DecomposeScalar(accElems, Q, gBits, digitsG, N, ws.digits.data());
+
+    for (uint32_t d = 0; d < digitsG2; ++d)
+        fft.Forward(ws.digits.data() + d * N, ws.digits.data() + d * N + h);
+
+#if FFT_SIMD_AVAILABLE
+    if (useAVX2)
+        InnerProductAVX2(ws.digits.data(), digitsG2, fft1, fft2, N, ws.sum.data());
+    else
+#endif
+        InnerProductScalar(ws.digits.data(), digitsG2, fft1, fft2, N, ws.sum.data());
+
+    // obtain both monomial(index) for sk = 1 and monomial(-index) for sk = -1
+    const uint32_t M{2 * N};
+    for (uint32_t k = 0; k < 2; ++k) {
+        double* s1{ws.sum.data() + k * N};
+        double* s2{ws.sum.data() + (2 + k) * N};
+        fft.MulMonomials(s1, s1 + h, a, s2, s2 + h, M - (a % M), s1, s1 + h);
+        fft.Inverse(s1, s1 + h);
+#if FFT_SIMD_AVAILABLE
+        if (useAVX2)
+            AddRoundedAVX2(s1, Q, N, reinterpret_cast<uint64_t*>(&accElems[k][0]));
+        else
+#endif
+            AddRoundedScalar(s1, Q, N, accElems[k]);
+    }
+}
+
+}  // namespace
+
+void RingGSWAccumulatorCGGIFFT::CheckParams(const std::shared_ptr<RingGSWCryptoParams>& params) {
+    if (params->GetQ().GetMSB() > 32)
+        OPENFHE_THROW("The FFT accumulator requires Q < 2^32");
+    // the largest magnitude of the sums of the inner products of both keys, which are rounded from doubles
+    const double bound{static_cast<double>(params->GetN()) * 2 * (params->GetDigitsG() - 1) *
+                       params->GetBaseG() * params->GetQ().ConvertToDouble() / 2};
+    if (bound >= std::ldexp(1.0, 50)) {
+        OPENFHE_THROW("The FFT accumulator requires N * 2 * (digitsG - 1) * baseG * Q / 2 < 2^50, the bound of its "
+                      "rounding error; use the NTT accumulator for these parameters");
+    }
+}
+
+RingGSWACCKey RingGSWAccumulatorCGGIFFT::KeyGenAcc(const std::shared_ptr<RingGSWCryptoParams>& params,
+                                                   const NativePoly& skNTT, ConstLWEPrivateKey& LWEsk) const {
+    CheckParams(params);
+    auto ek = RingGSWAccumulatorCGGI::KeyGenAcc(params, skNTT, LWEsk);
+    PrecomputeAccKey(params, ek);
+    return ek;
+}
+
+void RingGSWAccumulatorCGGIFFT::PrecomputeAccKey(const std::shared_ptr<RingGSWCryptoParams>& params,
+                                                 RingGSWACCKey& ek) const {
+    CheckParams(params);
+    std::vector<RingGSWEvalKeyImpl*> keys;
+    for (const auto& l1 : ek->GetElements()) {
+        for (const auto& l2 : l1) {
+            for (const auto& key : l2) {
+                if (key != nullptr && key->GetFFTElements() == nullptr)
+                    keys.push_back(key.get());
+            }
+        }
+    }
+
+    const uint32_t N{params->GetN()};
+    const auto& fft{GetNegacyclicFFT(N)};
+    const uint32_t h{fft.GetSize()};
+    const auto Q{params->GetQ().ConvertToInt<int64_t>()};
+    const auto QHalf{Q >> 1};
+    const uint32_t size{static_cast<uint32_t>(keys.size())};
+
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
+    for (uint32_t i = 0; i < size; ++i) {
+        std::vector<double> out;
+        for (const auto& row : keys[i]->GetElements()) {
+            for (const auto& poly : row) {
+                NativePoly coeff(poly);
+                coeff.SetFormat(Format::COEFFICIENT);
+                // the real parts of the folded input are followed by the imaginary ones, so coefficient
+                // j is at position j
+                size_t offset{out.size()};
+                out.resize(offset + N);
+                double* re{out.data() + offset};
+                for (uint32_t j = 0; j < N; ++j) {
+                    auto c{coeff[j].ConvertToInt<int64_t>()};
+                    re[j] = static_cast<double>(c > QHalf ? c - Q : c);
+                }
+                fft.Forward(re, re + h);
+            }
+        }
+        keys[i]->SetFFTElements(std::move(out));
+    }
+}
+
+void RingGSWAccumulatorCGGIFFT::EvalAcc(const std::shared_ptr<RingGSWCryptoParams>& params, ConstRingGSWACCKey& ek,
+                                        RLWECiphertext& acc, const NativeVector& a) const {
+    // the accumulator stays in COEFFICIENT format during the loop
+    auto& accElems = acc->GetElements();
+    accElems[0].SetFormat(Format::COEFFICIENT);
+    accElems[1].SetFormat(Format::COEFFICIENT);
+    const uint32_t N{params->GetN()};
+    const auto& fft{GetNegacyclicFFT(N)};
+    auto& ws{GetFFTWorkspace(N, (params->GetDigitsG() - 1) << 1)};
+    size_t n{a.GetLength()};
+    auto mod{a.GetModulus()};
+    auto MbyMod{NativeInteger(2 * N) / mod};
+    for (size_t i = 0; i < n; ++i) {
+        // handles -a*E(1) and handles -a*E(-1) = a*E(1)
+        AddToAccCGGIFFT(params, fft, ws, (*ek)[0][0][i], (*ek)[0][1][i],
+                        (NativeInteger(0).ModSubFast(a[i], mod) * MbyMod).ConvertToInt<uint32_t>(), acc);
+    }
+    accElems[0].SetFormat(Format::EVALUATION);
+    accElems[1].SetFormat(Format::EVALUATION);
+}
+
+}  // namespace lbcrypto
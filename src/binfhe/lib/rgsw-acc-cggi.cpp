@@ -101,19 +101,8 @@ RingGSWEvalKey RingGSWAccumulatorCGGI::KeyGenCGGI(const std::shared_ptr<RingGSWC
 // This reduces the number of polynomial multiplications which further reduces the runtime
 void RingGSWAccumulatorCGGI::AddToAccCGGI(const std::shared_ptr<RingGSWCryptoParams>& params, ConstRingGSWEvalKey& ek1,
                                           ConstRingGSWEvalKey& ek2, const NativeInteger& a, RLWECiphertext& acc) const {
-    std::vector<NativePoly> ct(acc->GetElements());
-    ct[0].SetFormat(Format::COEFFICIENT);
-    ct[1].SetFormat(Format::COEFFICIENT);
-
-    // approximate gadget decomposition is used; the first digit is ignored
-    uint32_t digitsG2{(params->GetDigitsG() - 1) << 1};
-    std::vector<NativePoly> dct(digitsG2, NativePoly(params->GetPolyParams(), Format::COEFFICIENT, true));
-
-    SignedDigitDecompose(params, ct, dct);
-
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(digitsG2))
-    for (uint32_t i = 0; i < digitsG2; ++i)
-        dct[i].SetFormat(Format::EVALUATION);
+    auto& ws = GetWorkspace(params);
+    DecomposeToEval(params, acc->GetElements(), ws);
 
     // obtain both monomial(index) for sk = 1 and monomial(-index) for sk = -1
     // index is in range [0,m] - so we need to adjust the edge case when index == m to index = 0
@@ -125,29 +114,18 @@ void RingGSWAccumulatorCGGI::AddToAccCGGI(const std::shared_ptr<RingGSWCryptoPar
     const NativePoly& monomialNeg = params->GetMonomial(indexNeg == MInt ? 0 : indexNeg);
 
     // acc = acc + dct * ek1 * monomial + dct * ek2 * negative_monomial;
-    // uses in-place * operators for the last call to dct[i] to gain performance
-    // improvement. Needs to be done using two loops for ternary secrets.
-    // TODO (dsuponit): benchmark cases with operator*() and operator*=(). Make a copy of dct?
-
-    const std::vector<std::vector<NativePoly>>& ev1(ek1->GetElements());
-    NativePoly tmp(dct[0] * ev1[0][0]);
-    for (uint32_t i = 1; i < digitsG2; ++i)
-        tmp += (dct[i] * ev1[i][0]);
-    acc->GetElements()[0] += (tmp *= monomial);
-    tmp = (dct[0] * ev1[0][1]);
-    for (uint32_t i = 1; i < digitsG2; ++i)
-        tmp += (dct[i] * ev1[i][1]);
-    acc->GetElements()[1] += (tmp *= monomial);
-
-    const std::vector<std::vector<NativePoly>>& ev2(ek2->GetElements());
-    tmp = (dct[0] * ev2[0][0]);
-    for (uint32_t i = 1; i < digitsG2; ++i)
-        tmp += (dct[i] * ev2[i][0]);
-    acc->GetElements()[0] += (tmp *= monomialNeg);
-    tmp = (dct[0] * ev2[0][1]);
-    for (uint32_t i = 1; i < digitsG2; ++i)
-        tmp += (dct[i] *= ev2[i][1]);
-    acc->GetElements()[1] += (tmp *= monomialNeg);
+    // the inner products are computed in the workspace and multiplied by the monomials in place
+    // approximate gadget decomposition is used; the first digit is ignored
+    uint32_t digitsG2{(params->GetDigitsG() - 1) << 1};
+    auto& accElems = acc->GetElements();
+
+    InnerProduct(*ek1, digitsG2, ws);
+    accElems[0] += (ws.sum[0] *= monomial);
+    accElems[1] += (ws.sum[1] *= monomial);
+
+    InnerProduct(*ek2, digitsG2, ws);
+    accElems[0] += (ws.sum[0] *= monomialNeg);
+    accElems[1] += (ws.sum[1] *= monomialNeg);
 }
 
 };  // namespace lbcrypto
@@ -117,29 +117,15 @@ RingGSWEvalKey RingGSWAccumulatorDM::KeyGenDM(const std::shared_ptr<RingGSWCrypt
 // AP Accumulation as described in https://eprint.iacr.org/2020/086
 void RingGSWAccumulatorDM::AddToAccDM(const std::shared_ptr<RingGSWCryptoParams>& params, ConstRingGSWEvalKey& ek,
                                       RLWECiphertext& acc) const {
-    std::vector<NativePoly> ct(acc->GetElements());
-    ct[0].SetFormat(Format::COEFFICIENT);
-    ct[1].SetFormat(Format::COEFFICIENT);
+    auto& ws = GetWorkspace(params);
+    DecomposeToEval(params, acc->GetElements(), ws);
 
+    // acc = dct * ek (matrix product);
     // approximate gadget decomposition is used; the first digit is ignored
     uint32_t digitsG2{(params->GetDigitsG() - 1) << 1};
-    std::vector<NativePoly> dct(digitsG2, NativePoly(params->GetPolyParams(), Format::COEFFICIENT, true));
-
-    SignedDigitDecompose(params, ct, dct);
-
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(digitsG2))
-    for (uint32_t j = 0; j < digitsG2; ++j)
-        dct[j].SetFormat(Format::EVALUATION);
-
-    // acc = dct * ek (matrix product);
-    // uses in-place * operators for the last call to dct[i] to gain performance improvement
-    const std::vector<std::vector<NativePoly>>& ev = ek->GetElements();
-    acc->GetElements()[0]                          = (dct[0] * ev[0][0]);
-    for (uint32_t l = 1; l < digitsG2; ++l)
-        acc->GetElements()[0] += (dct[l] * ev[l][0]);
-    acc->GetElements()[1] = (dct[0] *= ev[0][1]);
-    for (uint32_t l = 1; l < digitsG2; ++l)
-        acc->GetElements()[1] += (dct[l] *= ev[l][1]);
+    InnerProduct(*ek, digitsG2, ws);
+    acc->GetElements()[0] = ws.sum[0];
+    acc->GetElements()[1] = ws.sum[1];
 }
 
 };  // namespace lbcrypto
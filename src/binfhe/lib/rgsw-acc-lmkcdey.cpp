@@ -227,30 +227,15 @@ RingGSWEvalKey RingGSWAccumulatorLMKCDEY::KeyGenAuto(const std::shared_ptr<RingG
 // Same as AP, but multiplied once
 void RingGSWAccumulatorLMKCDEY::AddToAccLMKCDEY(const std::shared_ptr<RingGSWCryptoParams>& params,
                                                 ConstRingGSWEvalKey& ek, RLWECiphertext& acc) const {
-    std::vector<NativePoly> ct(acc->GetElements());
-    ct[0].SetFormat(Format::COEFFICIENT);
-    ct[1].SetFormat(Format::COEFFICIENT);
+    auto& ws = GetWorkspace(params);
+    DecomposeToEval(params, acc->GetElements(), ws);
 
+    // acc = dct * ek (matrix product);
     // approximate gadget decomposition is used; the first digit is ignored
     uint32_t digitsG2{(params->GetDigitsG() - 1) << 1};
-
-    std::vector<NativePoly> dct(digitsG2, NativePoly(params->GetPolyParams(), Format::COEFFICIENT, true));
-
-    SignedDigitDecompose(params, ct, dct);
-
-    // calls digitsG2 NTTs
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(digitsG2))
-    for (uint32_t d = 0; d < digitsG2; ++d)
-        dct[d].SetFormat(Format::EVALUATION);
-
-    // acc = dct * ek (matrix product);
-    const std::vector<std::vector<NativePoly>>& ev = ek->GetElements();
-    acc->GetElements()[0]                          = (dct[0] * ev[0][0]);
-    for (uint32_t d = 1; d < digitsG2; ++d)
-        acc->GetElements()[0] += (dct[d] * ev[d][0]);
-    acc->GetElements()[1] = (dct[0] *= ev[0][1]);
-    for (uint32_t d = 1; d < digitsG2; ++d)
-        acc->GetElements()[1] += (dct[d] *= ev[d][1]);
+    InnerProduct(*ek, digitsG2, ws);
+    acc->GetElements()[0] = ws.sum[0];
+    acc->GetElements()[1] = ws.sum[1];
 }
 
 // Automorphism
@@ -264,26 +249,16 @@ void RingGSWAccumulatorLMKCDEY::Automorphism(const std::shared_ptr<RingGSWCrypto
     acc->GetElements()[1] = acc->GetElements()[1].AutomorphismTransform(a.ConvertToInt<usint>(), vec);
 
     NativePoly cta(acc->GetElements()[0]);
-    acc->GetElements()[0].SetValuesToZero();
     cta = cta.AutomorphismTransform(a.ConvertToInt<usint>(), vec);
     cta.SetFormat(COEFFICIENT);
 
-    // approximate gadget decomposition is used; the first digit is ignored
-    uint32_t digitsG{params->GetDigitsG() - 1};
-    std::vector<NativePoly> dcta(digitsG, NativePoly(params->GetPolyParams(), Format::COEFFICIENT, true));
-
-    SignedDigitDecompose(params, cta, dcta);
-
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(digitsG))
-    for (uint32_t d = 0; d < digitsG; ++d)
-        dcta[d].SetFormat(Format::EVALUATION);
-
     // acc = dct * input (matrix product);
-    const std::vector<std::vector<NativePoly>>& ev = ak->GetElements();
-    for (uint32_t d = 0; d < digitsG; ++d)
-        acc->GetElements()[0] += (dcta[d] * ev[d][0]);
-    for (uint32_t d = 0; d < digitsG; ++d)
-        acc->GetElements()[1] += (dcta[d] *= ev[d][1]);
+    // approximate gadget decomposition is used; the first digit is ignored
+    auto& ws = GetWorkspace(params);
+    DecomposeToEval(params, cta, ws);
+    InnerProduct(*ak, params->GetDigitsG() - 1, ws);
+    acc->GetElements()[0] = ws.sum[0];
+    acc->GetElements()[1] += ws.sum[1];
 }
 
 };  // namespace lbcrypto
@@ -45,12 +45,47 @@
  */
 
 #include "lattice/lat-hal.h"
+#include "math/hal/intnat/innerprodnat.h"
 #include "rgsw-acc.h"
 #include <memory>
 #include <vector>
 
 namespace lbcrypto {
 
+void RingGSWAccumulator::PrecomputeAccKey(const std::shared_ptr<RingGSWCryptoParams>& params,
+                                          RingGSWACCKey& ek) const {
+    // the products of two packed residues fit into the 64-bit lanes of the fused inner product
+    if (params->GetQ().GetMSB() > 31)
+        return;
+    std::vector<RingGSWEvalKeyImpl*> keys;
+    for (const auto& l1 : ek->GetElements()) {
+        for (const auto& l2 : l1) {
+            for (const auto& key : l2) {
+                if (key != nullptr && key->GetPackedElements() == nullptr)
+                    keys.push_back(key.get());
+            }
+        }
+    }
+
+    const uint32_t N{params->GetN()};
+    const uint32_t size{static_cast<uint32_t>(keys.size())};
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
+    for (uint32_t i = 0; i < size; ++i) {
+        std::vector<uint32_t> packed;
+        for (const auto& row : keys[i]->GetElements()) {
+            for (const auto& poly : row) {
+                NativePoly eval(poly);
+                eval.SetFormat(Format::EVALUATION);
+                size_t offset{packed.size()};
+                packed.resize(offset + N);
+                for (uint32_t j = 0; j < N; ++j)
+                    packed[offset + j] = eval[j].ConvertToInt<uint32_t>();
+            }
+        }
+        keys[i]->SetPackedElements(std::move(packed));
+    }
+}
+
 void RingGSWAccumulator::SignedDigitDecompose(const std::shared_ptr<RingGSWCryptoParams>& params,
                                               const std::vector<NativePoly>& input,
                                               std::vector<NativePoly>& output) const {
@@ -118,4 +153,105 @@ void RingGSWAccumulator::SignedDigitDecompose(const std::shared_ptr<RingGSWCrypt
     }
 }
 
+RingGSWAccWorkspace& RingGSWAccumulator::GetWorkspace(const std::shared_ptr<RingGSWCryptoParams>& params) {
+    // the workspace keeps its ring parameters alive, so a pointer match means the same ring
+    thread_local RingGSWAccWorkspace ws;
+    const auto& polyParams = params->GetPolyParams();
+    uint32_t digitsG2{(params->GetDigitsG() - 1) << 1};
+    if (ws.polyParams != polyParams || ws.dct.size() < digitsG2) {
+        ws.polyParams = polyParams;
+        ws.ct.assign(2, NativePoly(polyParams, Format::EVALUATION, true));
+        ws.dct.assign(digitsG2, NativePoly(polyParams, Format::COEFFICIENT, true));
+        ws.sum.assign(2, NativePoly(polyParams, Format::EVALUATION, true));
+        ws.tmp = NativePoly(polyParams, Format::EVALUATION, true);
+        ws.x.resize(digitsG2);
+        ws.a.resize(digitsG2);
+        ws.b.resize(digitsG2);
+        ws.a32.resize(digitsG2);
+        ws.b32.resize(digitsG2);
+    }
+    return ws;
+}
+
+void RingGSWAccumulator::DecomposeToEval(const std::shared_ptr<RingGSWCryptoParams>& params,
+                                         const std::vector<NativePoly>& input, RingGSWAccWorkspace& ws) const {
+    ws.ct[0] = input[0];
+    ws.ct[1] = input[1];
+    ws.ct[0].SetFormat(Format::COEFFICIENT);
+    ws.ct[1].SetFormat(Format::COEFFICIENT);
+
+    // approximate gadget decomposition is used; the first digit is ignored
+    uint32_t digitsG2{(params->GetDigitsG() - 1) << 1};
+    uint32_t N{params->GetN()};
+    for (uint32_t d = 0; d < digitsG2; ++d) {
+        for (uint32_t k = 0; k < N; ++k)
+            ws.dct[d][k] = 0;
+        ws.dct[d].OverrideFormat(Format::COEFFICIENT);
+    }
+
+    SignedDigitDecompose(params, ws.ct, ws.dct);
+
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(digitsG2))
+    for (uint32_t d = 0; d < digitsG2; ++d)
+        ws.dct[d].SetFormat(Format::EVALUATION);
+}
+
+void RingGSWAccumulator::DecomposeToEval(const std::shared_ptr<RingGSWCryptoParams>& params, const NativePoly& input,
+                                         RingGSWAccWorkspace& ws) const {
+    // approximate gadget decomposition is used; the first digit is ignored
+    uint32_t digitsG{params->GetDigitsG() - 1};
+    uint32_t N{params->GetN()};
+    for (uint32_t d = 0; d < digitsG; ++d) {
+        for (uint32_t k = 0; k < N; ++k)
+            ws.dct[d][k] = 0;
+        ws.dct[d].OverrideFormat(Format::COEFFICIENT);
+    }
+
+    SignedDigitDecompose(params, input, ws.dct);
+
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(digitsG))
+    for (uint32_t d = 0; d < digitsG; ++d)
+        ws.dct[d].SetFormat(Format::EVALUATION);
+}
+
+void RingGSWAccumulator::InnerProduct(const RingGSWEvalKeyImpl& key, uint32_t count, RingGSWAccWorkspace& ws) {
+    const auto& ev{key.GetElements()};
+    ws.sum[0].OverrideFormat(Format::EVALUATION);
+    ws.sum[1].OverrideFormat(Format::EVALUATION);
+#if defined(HAVE_INT128) && (NATIVEINT == 64)
+    const uint32_t N{ws.polyParams->GetRingDimension()};
+    const uint64_t q{ws.polyParams->GetModulus().ConvertToInt<uint64_t>()};
+    auto* ya{reinterpret_cast<uint64_t*>(&ws.sum[0][0])};
+    auto* yb{reinterpret_cast<uint64_t*>(&ws.sum[1][0])};
+    for (uint32_t d = 0; d < count; ++d)
+        ws.x[d] = reinterpret_cast<const uint64_t*>(ws.dct[d].GetValues().data());
+
+    // the packed form holds the rows one after the other, each as its two columns of N words
+    const uint32_t* packed{key.GetPackedElements()};
+    if (packed != nullptr) {
+        for (uint32_t d = 0; d < count; ++d) {
+            ws.a32[d] = packed + size_t(2 * d) * N;
+            ws.b32[d] = packed + size_t(2 * d + 1) * N;
+        }
+        if (intnat::FastInnerProduct(ws.x.data(), ws.a32.data(), ws.b32.data(), count, q, ya, yb, N))
+            return;
+    }
+
+    for (uint32_t d = 0; d < count; ++d) {
+        ws.a[d] = reinterpret_cast<const uint64_t*>(ev[d][0].GetValues().data());
+        ws.b[d] = reinterpret_cast<const uint64_t*>(ev[d][1].GetValues().data());
+    }
+    if (intnat::FastInnerProduct(ws.x.data(), ws.a.data(), ws.b.data(), count, q, ya, yb, N))
+        return;
+#endif
+    for (uint32_t k = 0; k < 2; ++k) {
+        ws.sum[k] = ws.dct[0];
+        ws.sum[k] *= ev[0][k];
+        for (uint32_t d = 1; d < count; ++d) {
+            ws.tmp = ws.dct[d];
+            ws.sum[k] += (ws.tmp *= ev[d][k]);
+        }
+    }
+}
+
 };  // namespace lbcrypto
@@ -549,3 +549,64 @@ TEST_P(UTGENERAL_FHEW, BINFHE) {
 }
 
 INSTANTIATE_TEST_SUITE_P(UnitTests, UTGENERAL_FHEW, ::testing::ValuesIn(testCasesUTGENERAL_FHEW), testName);
+
+// A seeded switching key does not depend on the number of threads and is the same when it is generated in batches
+TEST(UTGENERAL_FHEW_KEYSWITCHGEN, SeededAndStreamed) {
+    auto cc = BinFHEContext();
+    cc.GenerateBinFHEContext(TOY, GINX);
+
+    auto sk  = cc.KeyGen();
+    auto skN = cc.KeyGenN();
+
+    const auto& params = cc.GetParams()->GetLWEParams();
+    LWESwitchingKeySeed seed{1, 2, 3, 4, 5, 6, 7, 8};
+
+    auto ksk1 = cc.GetLWEScheme()->KeySwitchGen(params, sk, skN, seed);
+    auto ksk2 = cc.GetLWEScheme()->KeySwitchGen(params, sk, skN, seed);
+    EXPECT_EQ(*ksk1, *ksk2);
+
+    LWESwitchingKeySeed otherSeed{8, 7, 6, 5, 4, 3, 2, 1};
+    EXPECT_FALSE(*ksk1 == *cc.GetLWEScheme()->KeySwitchGen(params, sk, skN, otherSeed));
+
+    uint32_t nextRow = 0;
+    cc.GetLWEScheme()->KeySwitchGenStream(
+        params, sk, skN, seed, 100, [&](ConstLWESwitchingKey& batch, uint32_t firstRow) {
+            EXPECT_EQ(nextRow, firstRow);
+            for (uint32_t r = 0; r < batch->GetN(); ++r) {
+                for (uint32_t j = 0; j < batch->GetDigitCount(); ++j) {
+                    for (uint32_t v = 0; v < batch->GetBaseKS(); ++v) {
+                        EXPECT_EQ(ksk1->GetElementB(firstRow + r, j, v), batch->GetElementB(r, j, v));
+                        for (uint32_t k = 0; k < batch->Getn(); ++k)
+                            EXPECT_EQ(ksk1->GetElementA32(firstRow + r, j, v)[k], batch->GetElementA32(r, j, v)[k]);
+                    }
+                }
+            }
+            nextRow += batch->GetN();
+        });
+    EXPECT_EQ(ksk1->GetN(), nextRow);
+
+    NativeInteger Q  = params->GetQ();
+    NativeVector skQ = sk->GetElement();
+    skQ.SwitchModulus(Q);
+    auto ct = cc.Encrypt(skN, 1, SMALL_DIM, 4, Q);
+    LWEPlaintext result;
+    cc.Decrypt(std::make_shared<LWEPrivateKeyImpl>(skQ), cc.GetLWEScheme()->KeySwitch(params, ksk1, ct), &result, 4);
+    EXPECT_EQ(1, result);
+}
+
+// The forms derived from a refreshing key are dropped when its elements can be changed, but not for its copies
+TEST(UTGENERAL_FHEW_EVALKEY, WriteAccessDropsPackedForm) {
+    auto cc = BinFHEContext();
+    cc.GenerateBinFHEContext(TOY, GINX);
+    cc.BTKeyGen(cc.KeyGen());
+
+    const auto& ek = (*cc.GetRefreshKey())[0][0][0];
+    ASSERT_NE(ek->GetPackedElements(), nullptr);
+
+    RingGSWEvalKeyImpl copy(*ek);
+    EXPECT_EQ(copy.GetPackedElements(), ek->GetPackedElements());
+    copy[0][0] = NativePoly(copy[0][0].GetParams(), Format::EVALUATION, true);
+    EXPECT_EQ(copy.GetPackedElements(), nullptr);
+    EXPECT_EQ(copy.GetPackedSize(), 0u);
+    EXPECT_NE(ek->GetPackedElements(), nullptr);
+}
@@ -151,3 +151,109 @@ TEST(UNITTestFHEWExtended, BootStrap) {
     auto ct0 = cc.Bootstrap(cc.Encrypt(pk, 0, LARGE_DIM, 4), true);
     EXPECT_EQ(Q, ct0->GetModulus());
 }
+
+TEST(UNITTestFHEWExtended, EvalBinGateBatch) {
+    auto cc = BinFHEContext();
+    cc.GenerateBinFHEContext(TOY, GINX);
+
+    auto sk = cc.KeyGen();
+    cc.BTKeyGen(sk);
+
+    std::vector<std::pair<LWECiphertext, LWECiphertext>> ctpairs;
+    for (uint32_t i = 0; i < 8; ++i)
+        ctpairs.emplace_back(cc.Encrypt(sk, i & 1), cc.Encrypt(sk, (i >> 1) & 1));
+
+    for (auto gate : {AND, NAND, XOR}) {
+        auto ctResults = cc.EvalBinGateBatch(gate, ctpairs);
+        ASSERT_EQ(ctpairs.size(), ctResults.size());
+        for (uint32_t i = 0; i < ctpairs.size(); ++i) {
+            LWEPlaintext m1 = i & 1, m2 = (i >> 1) & 1, result;
+            LWEPlaintext expected = (gate == AND) ? (m1 & m2) : (gate == NAND) ? !(m1 & m2) : (m1 ^ m2);
+            cc.Decrypt(sk, ctResults[i], &result);
+            EXPECT_EQ(expected, result) << "gate " << gate << ", input " << i;
+        }
+    }
+
+    // invalid pairs are rejected before any gate of the batch is evaluated
+    auto pairs = ctpairs;
+    pairs.back().second = nullptr;
+    EXPECT_THROW(cc.EvalBinGateBatch(AND, pairs), OpenFHEException);
+    pairs.back().second = pairs.back().first;
+    EXPECT_THROW(cc.EvalBinGateBatch(AND, pairs), OpenFHEException);
+}
+
+TEST(UNITTestFHEWExtended, FFTAccumulator) {
+    auto cc = BinFHEContext();
+    cc.GenerateBinFHEContext(TOY, GINX);
+
+    auto sk = cc.KeyGen();
+    cc.BTKeyGen(sk);
+
+    auto ct1 = cc.Encrypt(sk, 1);
+    auto ct0 = cc.Encrypt(sk, 0);
+    auto ctNTT = cc.EvalBinGate(NAND, ct1, ct0);
+
+    // the keys generated for the NTT accumulator are converted; the FFT accumulator is approximate, so the
+    // ciphertexts can differ while they decrypt the same
+    cc.SetFFTAccumulator(true);
+    auto ctFFT = cc.EvalBinGate(NAND, ct1, ct0);
+    LWEPlaintext resultNTT, resultFFT;
+    cc.Decrypt(sk, ctNTT, &resultNTT);
+    cc.Decrypt(sk, ctFFT, &resultFFT);
+    EXPECT_EQ(1, resultNTT);
+    EXPECT_EQ(resultNTT, resultFFT);
+
+    // as are the keys generated with the FFT accumulator selected
+    cc.BTKeyGen(sk);
+    for (auto gate : {AND, NAND, XOR}) {
+        for (uint32_t i = 0; i < 4; ++i) {
+            LWEPlaintext m1 = i & 1, m2 = (i >> 1) & 1, result;
+            LWEPlaintext expected = (gate == AND) ? (m1 & m2) : (gate == NAND) ? !(m1 & m2) : (m1 ^ m2);
+            cc.Decrypt(sk, cc.EvalBinGate(gate, cc.Encrypt(sk, m1), cc.Encrypt(sk, m2)), &result);
+            EXPECT_EQ(expected, result) << "gate " << gate << ", input " << i;
+        }
+    }
+
+    auto ccAP = BinFHEContext();
+    ccAP.GenerateBinFHEContext(TOY, AP);
+    EXPECT_THROW(ccAP.SetFFTAccumulator(true), OpenFHEException);
+
+    // N * 2 * (digitsG - 1) * baseG * Q / 2 reaches 2^51, beyond the bound of the rounding error
+    auto cc256 = BinFHEContext();
+    cc256.GenerateBinFHEContext(STD256, GINX);
+    EXPECT_THROW(cc256.SetFFTAccumulator(true), OpenFHEException);
+}
+
+// The gates of the FFT accumulator decrypt as the ones of the NTT accumulator on the STD parameter sets
+// with the largest products within its error bound
+TEST(UNITTestFHEWExtended, FFTAccumulatorMatchesNTT) {
+    for (auto set : {STD128, STD128_3}) {
+        auto cc = BinFHEContext();
+        cc.GenerateBinFHEContext(set, GINX);
+
+        auto sk = cc.KeyGen();
+        cc.BTKeyGen(sk);
+
+        std::vector<std::pair<LWECiphertext, LWECiphertext>> ctpairs;
+        for (uint32_t i = 0; i < 4; ++i)
+            ctpairs.emplace_back(cc.Encrypt(sk, i & 1), cc.Encrypt(sk, (i >> 1) & 1));
+
+        for (auto gate : {AND, NAND, OR, XOR}) {
+            auto ctNTT = cc.EvalBinGateBatch(gate, ctpairs);
+            cc.SetFFTAccumulator(true);
+            auto ctFFT = cc.EvalBinGateBatch(gate, ctpairs);
+            cc.SetFFTAccumulator(false);
+            for (uint32_t i = 0; i < ctpairs.size(); ++i) {
+                LWEPlaintext m1 = i & 1, m2 = (i >> 1) & 1, resultNTT, resultFFT;
+                LWEPlaintext expected = (gate == AND)    ? (m1 & m2) :
+                                        (gate == NAND)   ? !(m1 & m2) :
+                                        (gate == OR)     ? (m1 | m2) :
+                                                           (m1 ^ m2);
+                cc.Decrypt(sk, ctNTT[i], &resultNTT);
+                cc.Decrypt(sk, ctFFT[i], &resultFFT);
+                EXPECT_EQ(expected, resultNTT) << "set " << set << ", gate " << gate << ", input " << i;
+                EXPECT_EQ(resultNTT, resultFFT) << "set " << set << ", gate " << gate << ", input " << i;
+            }
+        }
+    }
+}
@@ -37,6 +37,10 @@
 
 // these header files are needed for serialization
 #include "binfhecontext-ser.h"
+#include "math/discreteuniformgenerator.h"
+
+#include <fstream>
+#include <vector>
 
 using namespace lbcrypto;
 
@@ -141,3 +145,214 @@ TEST(UnitTestFHEWSerialLMKCDEY, BINARY) {
     std::string msg = "UnitTestFHEWSerialGINX.BINARY serialization test failed: ";
     UnitTestFHEWSerial(SerType::BINARY, TOY, LMKCDEY, SMALL_DIM, msg);
 }
+
+void UnitTestFHEWKeyCache(BINFHE_PARAMSET secLevel, BINFHE_METHOD variant, bool useFFT, const std::string& errMsg) {
+    const std::string filename = "UnitTestFHEWKeyCache.bin";
+    auto cc1                   = BinFHEContext();
+    cc1.GenerateBinFHEContext(secLevel, variant);
+    if (useFFT)
+        cc1.SetFFTAccumulator(true);
+
+    auto sk = cc1.KeyGen();
+    cc1.BTKeyGen(sk);
+    cc1.BTKeySaveCache(filename);
+
+    auto cc2 = BinFHEContext();
+    cc2.GenerateBinFHEContext(secLevel, variant);
+    if (useFFT)
+        cc2.SetFFTAccumulator(true);
+    cc2.BTKeyLoadCache(filename);
+    std::remove(filename.c_str());
+
+    EXPECT_EQ(*(cc2.GetRefreshKey()), *(cc1.GetRefreshKey())) << errMsg << " refresh key mismatch";
+    EXPECT_EQ(*(cc2.GetSwitchKey()), *(cc1.GetSwitchKey())) << errMsg << " switching key mismatch";
+
+    // the ring modulus of TOY is below 2^31, so the loaded key is packed for the external product
+    if (!useFFT) {
+        for (const auto& l1 : cc2.GetRefreshKey()->GetElements()) {
+            for (const auto& l2 : l1) {
+                for (const auto& ek : l2) {
+                    if (ek == nullptr)
+                        continue;
+                    const uint32_t* packed = ek->GetPackedElements();
+                    ASSERT_NE(packed, nullptr) << errMsg << " refresh key not packed";
+                    for (const auto& row : ek->GetElements()) {
+                        for (const auto& poly : row) {
+                            for (uint32_t j = 0; j < poly.GetLength(); ++j, ++packed) {
+                                ASSERT_EQ(poly[j].ConvertToInt<uint32_t>(), *packed)
+                                    << errMsg << " packed key mismatch";
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    for (LWEPlaintext m1 : {0, 1}) {
+        for (LWEPlaintext m2 : {0, 1}) {
+            auto ct1 = cc2.Encrypt(sk, m1);
+            auto ct2 = cc2.Encrypt(sk, m2);
+            LWEPlaintext result;
+            cc2.Decrypt(sk, cc2.EvalBinGate(NAND, ct1, ct2), &result);
+            EXPECT_EQ(!(m1 && m2), result) << errMsg << " NAND(" << m1 << ", " << m2 << ") failed";
+        }
+    }
+}
+
+TEST(UnitTestFHEWKeyCache, GINX) {
+    UnitTestFHEWKeyCache(TOY, GINX, false, "UnitTestFHEWKeyCache.GINX failed:");
+}
+
+TEST(UnitTestFHEWKeyCache, GINX_FFT) {
+    UnitTestFHEWKeyCache(TOY, GINX, true, "UnitTestFHEWKeyCache.GINX_FFT failed:");
+}
+
+TEST(UnitTestFHEWKeyCache, AP) {
+    UnitTestFHEWKeyCache(TOY, AP, false, "UnitTestFHEWKeyCache.AP failed:");
+}
+
+TEST(UnitTestFHEWKeyCache, LMKCDEY) {
+    UnitTestFHEWKeyCache(TOY, LMKCDEY, false, "UnitTestFHEWKeyCache.LMKCDEY failed:");
+}
+
+TEST(UnitTestFHEWKeyCache, ParamsMismatch) {
+    const std::string filename = "UnitTestFHEWKeyCacheMismatch.bin";
+    auto cc1                   = BinFHEContext();
+    cc1.GenerateBinFHEContext(TOY, GINX);
+    cc1.BTKeyGen(cc1.KeyGen());
+    cc1.BTKeySaveCache(filename);
+
+    auto cc2 = BinFHEContext();
+    cc2.GenerateBinFHEContext(TOY, LMKCDEY);
+    EXPECT_THROW(cc2.BTKeyLoadCache(filename), OpenFHEException);
+    std::remove(filename.c_str());
+}
+
+TEST(UnitTestFHEWKeyCache, Corrupted) {
+    const std::string filename = "UnitTestFHEWKeyCacheCorrupted.bin";
+    auto cc                    = BinFHEContext();
+    cc.GenerateBinFHEContext(TOY, GINX);
+    cc.BTKeyGen(cc.KeyGen());
+    cc.BTKeySaveCache(filename);
+
+    // the words of the header at dim1, numPolys and ksN
+    for (std::streamoff word : {12, 16, 18}) {
+        for (uint64_t value : {uint64_t(3), ~uint64_t(0)}) {
+            std::fstream file(filename, std::ios::in | std::ios::out | std::ios::binary);
+            uint64_t original;
+            file.seekg(word * sizeof(uint64_t));
+            file.read(reinterpret_cast<char*>(&original), sizeof(original));
+            file.seekp(word * sizeof(uint64_t));
+            file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+            file.close();
+
+            auto cc2 = BinFHEContext();
+            cc2.GenerateBinFHEContext(TOY, GINX);
+            EXPECT_THROW(cc2.BTKeyLoadCache(filename), OpenFHEException) << "header word " << word;
+
+            file.open(filename, std::ios::in | std::ios::out | std::ios::binary);
+            file.seekp(word * sizeof(uint64_t));
+            file.write(reinterpret_cast<const char*>(&original), sizeof(original));
+        }
+    }
+
+    // the first polynomial word set to Q, read from the header words at Q and polyOffset
+    {
+        std::fstream file(filename, std::ios::in | std::ios::out | std::ios::binary);
+        uint64_t Q, polyOffset;
+        file.seekg(5 * sizeof(uint64_t));
+        file.read(reinterpret_cast<char*>(&Q), sizeof(Q));
+        file.seekg(23 * sizeof(uint64_t));
+        file.read(reinterpret_cast<char*>(&polyOffset), sizeof(polyOffset));
+        file.seekp(polyOffset);
+        file.write(reinterpret_cast<const char*>(&Q), sizeof(Q));
+    }
+    auto cc2 = BinFHEContext();
+    cc2.GenerateBinFHEContext(TOY, GINX);
+    EXPECT_THROW(cc2.BTKeyLoadCache(filename), OpenFHEException) << "unreduced polynomial";
+    std::remove(filename.c_str());
+}
+
+using NestedKeyA = std::vector<std::vector<std::vector<NativeVector>>>;
+using NestedKeyB = std::vector<std::vector<std::vector<NativeInteger>>>;
+
+// the layout of LWESwitchingKeyImpl before the flat buffers (version 1)
+struct LWESwitchingKeyV1 {
+    NestedKeyA a;
+    NestedKeyB b;
+
+    template <class Archive>
+    void save(Archive& ar, std::uint32_t const version) const {
+        ar(::cereal::make_nvp("a", a));
+        ar(::cereal::make_nvp("b", b));
+    }
+};
+
+static LWESwitchingKeyV1 RandomSwitchingKey(uint32_t N, uint32_t digitCount, uint32_t baseKS, uint32_t n,
+                                            const NativeInteger& qKS) {
+    DiscreteUniformGeneratorImpl<NativeVector> dug;
+    dug.SetModulus(qKS);
+    LWESwitchingKeyV1 key{NestedKeyA(N, std::vector<std::vector<NativeVector>>(baseKS)),
+                          NestedKeyB(N, std::vector<std::vector<NativeInteger>>(baseKS))};
+    for (uint32_t i = 0; i < N; ++i) {
+        for (uint32_t v = 0; v < baseKS; ++v) {
+            for (uint32_t j = 0; j < digitCount; ++j) {
+                key.a[i][v].push_back(dug.GenerateVector(n));
+                key.b[i][v].push_back(dug.GenerateInteger());
+            }
+        }
+    }
+    return key;
+}
+
+template <typename ST>
+void UnitTestSwitchingKeySerial(const ST& sertype, const NativeInteger& qKS, bool compact, const std::string& errMsg) {
+    auto nested = RandomSwitchingKey(8, 3, 4, 5, qKS);
+    auto key1   = std::make_shared<LWESwitchingKeyImpl>(nested.a, nested.b);
+    EXPECT_EQ(compact, key1->IsCompact()) << errMsg << " wrong storage of the vectors a";
+
+    LWESwitchingKey key2;
+    {
+        std::stringstream s;
+        Serial::Serialize(key1, s, sertype);
+        Serial::Deserialize(key2, s, sertype);
+    }
+    ASSERT_NE(key2, nullptr) << errMsg << " deserialization failed";
+    EXPECT_EQ(compact, key2->IsCompact()) << errMsg << " wrong storage of the deserialized vectors a";
+    EXPECT_EQ(*key1, *key2) << errMsg << " round trip of the key failed";
+
+    // an archive written before the flat buffers loads into the same key
+    LWESwitchingKeyImpl key3;
+    {
+        std::stringstream s;
+        Serial::Serialize(nested, s, sertype);
+        Serial::Deserialize(key3, s, sertype);
+    }
+    EXPECT_EQ(*key1, key3) << errMsg << " loading a version 1 archive failed";
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+    EXPECT_EQ(nested.a, key2->GetElementsA()) << errMsg << " deprecated GetElementsA failed";
+    EXPECT_EQ(nested.b, key2->GetElementsB()) << errMsg << " deprecated GetElementsB failed";
+
+    LWESwitchingKeyImpl key4(NestedKeyA(nested.a), NestedKeyB(nested.b));
+    EXPECT_EQ(*key1, key4) << errMsg << " deprecated move constructor failed";
+
+    auto other = RandomSwitchingKey(8, 3, 4, 5, qKS);
+    key4.SetElementsA(other.a);
+    key4.SetElementsB(other.b);
+    EXPECT_EQ(LWESwitchingKeyImpl(other.a, other.b), key4) << errMsg << " deprecated setters failed";
+#pragma GCC diagnostic pop
+}
+
+TEST(UnitTestLWESwitchingKeySerial, Compact) {
+    UnitTestSwitchingKeySerial(SerType::BINARY, NativeInteger(1 << 14), true, "UnitTestLWESwitchingKey.BINARY.Compact");
+    UnitTestSwitchingKeySerial(SerType::JSON, NativeInteger(1 << 14), true, "UnitTestLWESwitchingKey.JSON.Compact");
+}
+
+TEST(UnitTestLWESwitchingKeySerial, Wide) {
+    const NativeInteger qKS(uint64_t(1) << 40);
+    UnitTestSwitchingKeySerial(SerType::BINARY, qKS, false, "UnitTestLWESwitchingKey.BINARY.Wide");
+    UnitTestSwitchingKeySerial(SerType::JSON, qKS, false, "UnitTestLWESwitchingKey.JSON.Wide");
+}
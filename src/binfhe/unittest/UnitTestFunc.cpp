@@ -70,6 +70,62 @@ TEST(UnitTestFHEWGINX, EvalArbFunc) {
     }
 }
 
+// Checks the batched arbitrary function evaluation
+TEST(UnitTestFHEWGINX, EvalArbFuncBatch) {
+    auto cc = BinFHEContext();
+    cc.GenerateBinFHEContext(TOY, true, 12);
+    auto sk = cc.KeyGen();
+    cc.BTKeyGen(sk);
+    int p   = cc.GetMaxPlaintextSpace().ConvertToInt();
+    auto fp = [](NativeInteger m, NativeInteger p1) -> NativeInteger {
+        return (m * m + 1) % p1;
+    };
+    auto lut = cc.GenerateLUTviaFunction(fp, p);
+
+    std::vector<LWECiphertext> cts;
+    for (int i = 0; i < p; i++)
+        cts.push_back(cc.Encrypt(sk, i % p, LARGE_DIM, p));
+
+    auto ctResults = cc.EvalFuncBatch(cts, lut);
+    ASSERT_EQ(cts.size(), ctResults.size());
+    for (int i = 0; i < p; i++) {
+        LWEPlaintext result;
+        cc.Decrypt(sk, ctResults[i], &result, p);
+        EXPECT_EQ(usint(fp(i, p).ConvertToInt()), result) << "Batched Arbitrary Function Evaluation failed";
+    }
+
+    cts.back() = nullptr;
+    EXPECT_THROW(cc.EvalFuncBatch(cts, lut), OpenFHEException);
+}
+
+// Checks the evaluation of several functions with shared bootstrapping
+TEST(UnitTestFHEWGINX, EvalArbFuncMulti) {
+    auto cc = BinFHEContext();
+    cc.GenerateBinFHEContext(TOY, true, 12);
+    auto sk = cc.KeyGen();
+    cc.BTKeyGen(sk);
+    int p = cc.GetMaxPlaintextSpace().ConvertToInt();
+    std::vector<NativeInteger (*)(NativeInteger, NativeInteger)> fps{
+        [](NativeInteger m, NativeInteger p1) -> NativeInteger { return (m * m * m) % p1; },
+        [](NativeInteger m, NativeInteger p1) -> NativeInteger { return (m * m + 1) % p1; },
+        [](NativeInteger m, NativeInteger p1) -> NativeInteger { return m < p1 / 2 ? 0 : 1; },
+    };
+    std::vector<std::vector<NativeInteger>> luts;
+    for (auto fp : fps)
+        luts.push_back(cc.GenerateLUTviaFunction(fp, p));
+
+    for (int i = 0; i < p; i++) {
+        auto ct1       = cc.Encrypt(sk, i % p, LARGE_DIM, p);
+        auto ctResults = cc.EvalFuncMulti(ct1, luts);
+        ASSERT_EQ(fps.size(), ctResults.size());
+        for (size_t k = 0; k < fps.size(); ++k) {
+            LWEPlaintext result;
+            cc.Decrypt(sk, ctResults[k], &result, p);
+            EXPECT_EQ(usint(fps[k](i, p).ConvertToInt()), result) << "function " << k << ", input " << i;
+        }
+    }
+}
+
 // Checks the rounding down evaluation
 TEST(UnitTestFHEWGINX, EvalFloorFunc) {
     auto cc = BinFHEContext();
@@ -40,7 +40,9 @@
 
 #include "lattice/hal/default/poly-impl.h"
 #include "lattice/hal/default/dcrtpoly.h"
+#include "math/hal/intnat/baseconvnat.h"
 
+#include "utils/blockAllocator/arenaallocator.h"
 #include "utils/exception.h"
 #include "utils/inttypes.h"
 #include "utils/parallel.h"
@@ -906,17 +908,133 @@ void DCRTPolyImpl<VecType>::TimesQovert(const std::shared_ptr<Params>& paramsQ,
     }
 }
 
+template <typename VecType>
+void DCRTPolyImpl<VecType>::MakeContiguous() {
+    if (m_vectors.empty() || IsContiguous())
+        return;
+    const usint ringDim{m_params->GetRingDimension()};
+    const size_t towerSize{ringDim * sizeof(NativeInteger)};
+    auto slab = std::make_shared<ArenaSlab>(m_vectors.size() * towerSize);
+    for (size_t i = 0; i < m_vectors.size(); ++i) {
+        auto& tower = m_vectors[i];
+        NativeVector values(ringDim, tower.GetModulus(), arena_allocator<NativeInteger>(slab, i * towerSize, towerSize));
+        // the assignment copies into the existing storage as the lengths are equal
+        if (!tower.IsEmpty())
+            values = tower.GetValues();
+        tower.SetValues(std::move(values), tower.GetFormat());
+    }
+}
+
+template <typename VecType>
+void DCRTPolyImpl<VecType>::AdoptContiguous(NativeInteger* data, std::shared_ptr<void> owner) {
+    const auto& towerParams{m_params->GetParams()};
+    const usint ringDim{m_params->GetRingDimension()};
+    const size_t towerSize{ringDim * sizeof(NativeInteger)};
+    auto slab = std::make_shared<ArenaSlab>(reinterpret_cast<char*>(data), towerParams.size() * towerSize,
+                                            std::move(owner));
+    m_vectors.clear();
+    m_vectors.reserve(towerParams.size());
+    for (size_t i = 0; i < towerParams.size(); ++i) {
+        // the vector is placed into the external buffer and keeps its values
+        NativeVector values(ringDim, towerParams[i]->GetModulus(),
+                            arena_allocator<NativeInteger>(slab, i * towerSize, towerSize));
+        m_vectors.emplace_back(towerParams[i], m_format);
+        m_vectors.back().SetValues(std::move(values), m_format);
+    }
+}
+
+template <typename VecType>
+std::shared_ptr<typename DCRTPolyImpl<VecType>::Params> DCRTPolyImpl<VecType>::ParamsFromTowers() const {
+    if (m_vectors.empty())
+        return nullptr;
+    // all the polynomials of a ciphertext or key share their tower params, so the last result is reused
+    thread_local std::weak_ptr<Params> cached;
+    auto params = cached.lock();
+    if (params != nullptr && params->GetParams().size() == m_vectors.size()) {
+        size_t i = 0;
+        while (i < m_vectors.size() && params->GetParams()[i] == m_vectors[i].GetParams())
+            ++i;
+        if (i == m_vectors.size())
+            return params;
+    }
+    std::vector<std::shared_ptr<ILNativeParams>> towers;
+    towers.reserve(m_vectors.size());
+    for (const auto& tower : m_vectors)
+        towers.push_back(tower.GetParams());
+    params = std::make_shared<Params>(m_vectors[0].GetParams()->GetCyclotomicOrder(), towers);
+    cached = params;
+    return params;
+}
+
+template <typename VecType>
+void DCRTPolyImpl<VecType>::MakeSeparate() {
+    if (!IsContiguous())
+        return;
+    for (auto& tower : m_vectors)
+        tower.SetValues(NativeVector(tower.GetValues()), tower.GetFormat());
+}
+
+template <typename VecType>
+bool DCRTPolyImpl<VecType>::IsContiguous() const {
+    if (m_vectors.empty() || m_vectors[0].IsEmpty())
+        return false;
+    const usint ringDim{m_params->GetRingDimension()};
+    const NativeInteger* base{m_vectors[0].GetValues().data()};
+    for (size_t i = 1; i < m_vectors.size(); ++i) {
+        if (m_vectors[i].IsEmpty() || m_vectors[i].GetValues().data() != base + i * ringDim)
+            return false;
+    }
+    return true;
+}
+
+template <typename VecType>
+NativeInteger* DCRTPolyImpl<VecType>::GetContiguousData() {
+    return IsContiguous() ? &m_vectors[0][0] : nullptr;
+}
+
 template <typename VecType>
 DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::ApproxSwitchCRTBasis(
     const std::shared_ptr<Params>& paramsQ, const std::shared_ptr<Params>& paramsP,
     const std::vector<NativeInteger>& QHatInvModq, const std::vector<NativeInteger>& QHatInvModqPrecon,
     const std::vector<std::vector<NativeInteger>>& QHatModp, const std::vector<DoubleNativeInt>& modpBarrettMu) const {
-    DCRTPolyImpl<VecType> ans(paramsP, m_format, true);
+    // all output towers in one buffer: a single allocation, written with a fixed stride
+    DCRTPolyImpl<VecType> ans(paramsP, m_format);
+    ans.MakeContiguous();
     uint32_t sizeQ = (m_vectors.size() > paramsQ->GetParams().size()) ? paramsQ->GetParams().size() : m_vectors.size();
     uint32_t sizeP = ans.m_vectors.size();
 #if defined(HAVE_INT128) && (NATIVEINT == 64) && !defined(WITH_REDUCED_NOISE) && \
     (defined(WITH_OPENMP) || (defined(__clang__) && !defined(WITH_NATIVEOPT)))
     uint32_t ringDim = m_params->GetRingDimension();
+    // the conversion runs as one cache-blocked matrix product over raw 64-bit words
+    std::vector<const uint64_t*> x(sizeQ);
+    std::vector<uint64_t> q(sizeQ);
+    std::vector<uint64_t> QHatModpFlat(sizeQ * sizeP);
+    for (uint32_t i = 0; i < sizeQ; ++i) {
+        x[i] = reinterpret_cast<const uint64_t*>(m_vectors[i].GetValues().data());
+        q[i] = m_vectors[i].GetModulus().ConvertToInt();
+        for (uint32_t j = 0; j < sizeP; ++j)
+            QHatModpFlat[i * sizeP + j] = QHatModp[i][j].ConvertToInt();
+    }
+    auto y = reinterpret_cast<uint64_t*>(ans.GetContiguousData());
+    std::vector<uint64_t*> yj(sizeP);
+    std::vector<uint64_t> p(sizeP);
+    for (uint32_t j = 0; j < sizeP; ++j) {
+        yj[j] = y + j * ringDim;
+        p[j]  = ans.m_vectors[j].GetModulus().ConvertToInt();
+    }
+    intnat::BaseConvTables tables{sizeQ,
+                                  sizeP,
+                                  q.data(),
+                                  reinterpret_cast<const uint64_t*>(QHatInvModq.data()),
+                                  reinterpret_cast<const uint64_t*>(QHatInvModqPrecon.data()),
+                                  QHatModpFlat.data(),
+                                  p.data(),
+                                  modpBarrettMu.data(),
+                                  nullptr,
+                                  nullptr};
+    if (intnat::FastBaseConvert(tables, x.data(), yj.data(), ringDim))
+        return ans;
+
     std::vector<DoubleNativeInt> sum(sizeP);
     #pragma omp parallel for firstprivate(sum) num_threads(OpenFHEParallelControls.GetThreadLimit(8))
     for (uint32_t ri = 0; ri < ringDim; ++ri) {
@@ -930,10 +1048,8 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::ApproxSwitchCRTBasis(
             for (uint32_t j = 0; j < sizeP; ++j)
                 sum[j] += Mul128(xQHatInvModqi, QHatModpi[j].ConvertToInt<uint64_t>());
         }
-        for (uint32_t j = 0; j < sizeP; ++j) {
-            auto&& pj            = ans.m_vectors[j].GetModulus().template ConvertToInt<uint64_t>();
-            ans.m_vectors[j][ri] = BarrettUint128ModUint64(sum[j], pj, modpBarrettMu[j]);
-        }
+        for (uint32_t j = 0; j < sizeP; ++j)
+            yj[j][ri] = BarrettUint128ModUint64(sum[j], p[j], modpBarrettMu[j]);
     }
 #else
     for (uint32_t i = 0; i < sizeQ; ++i) {
@@ -1073,6 +1189,40 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::SwitchCRTBasis(const std::shared_pt
     DCRTPolyImpl<VecType> ans(paramsP, m_format, true);
     uint32_t ringDim = m_params->GetRingDimension();
 
+#if defined(HAVE_INT128) && NATIVEINT == 64
+    // the conversion runs as one cache-blocked matrix product over raw 64-bit words
+    std::vector<const uint64_t*> x(sizeQ);
+    std::vector<uint64_t> q(sizeQ);
+    std::vector<uint64_t> QHatModpFlat(sizeQ * sizeP);
+    for (uint32_t i = 0; i < sizeQ; ++i) {
+        x[i] = reinterpret_cast<const uint64_t*>(m_vectors[i].GetValues().data());
+        q[i] = m_vectors[i].GetModulus().ConvertToInt();
+        for (uint32_t j = 0; j < sizeP; ++j)
+            QHatModpFlat[i * sizeP + j] = QHatModp[j][i].ConvertToInt();
+    }
+    std::vector<uint64_t*> y(sizeP);
+    std::vector<uint64_t> p(sizeP);
+    std::vector<uint64_t> alphaQModpFlat((sizeQ + 1) * sizeP);
+    for (uint32_t j = 0; j < sizeP; ++j) {
+        y[j] = reinterpret_cast<uint64_t*>(&ans.m_vectors[j][0]);
+        p[j] = ans.m_vectors[j].GetModulus().ConvertToInt();
+        for (uint32_t a = 0; a <= sizeQ; ++a)
+            alphaQModpFlat[a * sizeP + j] = alphaQModp[a][j].ConvertToInt();
+    }
+    intnat::BaseConvTables tables{sizeQ,
+                                  sizeP,
+                                  q.data(),
+                                  reinterpret_cast<const uint64_t*>(QHatInvModq.data()),
+                                  reinterpret_cast<const uint64_t*>(QHatInvModqPrecon.data()),
+                                  QHatModpFlat.data(),
+                                  p.data(),
+                                  modpBarrettMu.data(),
+                                  qInv.data(),
+                                  alphaQModpFlat.data()};
+    if (intnat::FastBaseConvert(tables, x.data(), y.data(), ringDim))
+        return ans;
+#endif
+
 #pragma omp parallel for firstprivate(xQHatInvModq) num_threads(OpenFHEParallelControls.GetThreadLimit(8))
     for (uint32_t ri = 0; ri < ringDim; ++ri) {
         double nu{0.5};
@@ -1952,6 +2102,9 @@ void DCRTPolyImpl<VecType>::FastBaseConvSK(
 template <typename VecType>
 void DCRTPolyImpl<VecType>::SwitchFormat() {
     m_format = (m_format == Format::COEFFICIENT) ? Format::EVALUATION : Format::COEFFICIENT;
+    // with fewer towers than threads, the batched transform also splits each tower across threads
+    if (PolyType::SwitchFormatBatch(m_vectors))
+        return;
     size_t size{m_vectors.size()};
 #pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
     for (size_t i = 0; i < size; ++i)
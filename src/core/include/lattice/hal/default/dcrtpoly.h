@@ -333,10 +333,22 @@ public:
 
     void SwitchModulusAtIndex(size_t index, const Integer& modulus, const Integer& rootOfUnity) override;
 
+    // Binary archives of version 2 do not repeat the params: the towers reference their params, which the archive
+    // stores once, and the params of the polynomial are rebuilt from them. They are only stored if they differ
+    // from the rebuilt ones
     template <class Archive>
     void save(Archive& ar, std::uint32_t const version) const {
         ar(::cereal::make_nvp("v", m_vectors));
         ar(::cereal::make_nvp("f", m_format));
+        if constexpr (!cereal::traits::is_text_archive<Archive>::value) {
+            if (version >= 2) {
+                auto params     = ParamsFromTowers();
+                bool fromTowers = (params != nullptr) && (*params == *m_params);
+                ar(fromTowers);
+                if (fromTowers)
+                    return;
+            }
+        }
         ar(::cereal::make_nvp("p", m_params));
     }
 
@@ -348,6 +360,18 @@ public:
         }
         ar(::cereal::make_nvp("v", m_vectors));
         ar(::cereal::make_nvp("f", m_format));
+        if constexpr (!cereal::traits::is_text_archive<Archive>::value) {
+            if (version >= 2) {
+                bool fromTowers;
+                ar(fromTowers);
+                if (fromTowers) {
+                    m_params = ParamsFromTowers();
+                    if (m_params == nullptr)
+                        OPENFHE_THROW("DCRTPoly without towers cannot rebuild its params");
+                    return;
+                }
+            }
+        }
         ar(::cereal::make_nvp("p", m_params));
     }
 
@@ -360,7 +384,7 @@ public:
     }
 
     static uint32_t SerializedVersion() {
-        return 1;
+        return 2;
     }
 
     inline Format GetFormat() const final {
@@ -391,7 +415,47 @@ public:
         m_vectors[index] = std::move(element);
     }
 
+    /**
+   * Switches to the contiguous layout: the coefficients of all towers are placed back to back in one
+   * 64-byte aligned buffer, tower i starting at offset i * ring dimension. The towers remain regular
+   * NativePoly objects that refer to their part of the buffer; towers without values become zero.
+   * Copies of a tower or of the whole polynomial get separate storage again.
+   */
+    void MakeContiguous();
+
+    /**
+   * Switches to the contiguous layout on an external buffer, e.g. a mapped file or a received message,
+   * without a copy: the towers are replaced by views of the buffer, whose current contents become the
+   * coefficients. The buffer holds one tower per params of the polynomial, each of ring dimension
+   * coefficients, and must stay writable as operations may update the towers in place.
+   *
+   * @param data the first coefficient of the first tower.
+   * @param owner keeps the buffer alive as long as any tower refers to it.
+   */
+    void AdoptContiguous(NativeInteger* data, std::shared_ptr<void> owner);
+
+    /**
+   * Switches back to the default layout where every tower owns its own buffer.
+   */
+    void MakeSeparate();
+
+    /**
+   * @return true if the towers are laid out back to back in one buffer.
+   */
+    bool IsContiguous() const;
+
+    /**
+   * @return the first coefficient of the first tower in the contiguous layout, nullptr otherwise.
+   */
+    NativeInteger* GetContiguousData();
+
 protected:
+    /**
+   * @return the params made of the params of the towers, nullptr if there are no towers. Consecutive calls
+   * on polynomials with the same tower params return the same object.
+   */
+    std::shared_ptr<Params> ParamsFromTowers() const;
+
     std::shared_ptr<Params> m_params{std::make_shared<DCRTPolyImpl::Params>()};
     Format m_format{Format::EVALUATION};
     std::vector<PolyType> m_vectors;
@@ -45,7 +45,9 @@
 #include "utils/exception.h"
 #include "utils/inttypes.h"
 
+#include <atomic>
 #include <string>
+#include <type_traits>
 #include <utility>
 
 namespace lbcrypto {
@@ -59,7 +61,8 @@ namespace lbcrypto {
 template <typename IntType>
 class ILParamsImpl final : public ElemParams<IntType> {
 public:
-    using Integer = IntType;
+    using Integer   = IntType;
+    using NTTTables = intnat::NTTTablesNat<NativeVector>;
 
     constexpr ILParamsImpl() : ElemParams<IntType>() {}
     ~ILParamsImpl() override = default;
@@ -93,7 +96,8 @@ public:
    *
    * @param &rhs the input set of parameters which is copied.
    */
-    ILParamsImpl(const ILParamsImpl& rhs) : ElemParams<IntType>(rhs) {}
+    ILParamsImpl(const ILParamsImpl& rhs)
+        : ElemParams<IntType>(rhs), m_nttTables(rhs.m_nttTables.load(std::memory_order_acquire)) {}
 
     /**
    * @brief Copy Assignment Operator.
@@ -103,6 +107,7 @@ public:
    */
     ILParamsImpl& operator=(const ILParamsImpl& rhs) {
         ElemParams<IntType>::operator=(rhs);
+        m_nttTables.store(rhs.m_nttTables.load(std::memory_order_acquire), std::memory_order_release);
         return *this;
     }
 
@@ -111,10 +116,12 @@ public:
    *
    * @param &rhs the input set of parameters which is copied.
    */
-    ILParamsImpl(ILParamsImpl&& rhs) noexcept : ElemParams<IntType>(std::move(rhs)) {}
+    ILParamsImpl(ILParamsImpl&& rhs) noexcept
+        : ElemParams<IntType>(std::move(rhs)), m_nttTables(rhs.m_nttTables.load(std::memory_order_acquire)) {}
 
     ILParamsImpl& operator=(ILParamsImpl&& rhs) noexcept {
         ElemParams<IntType>::operator=(std::move(rhs));
+        m_nttTables.store(rhs.m_nttTables.load(std::memory_order_acquire), std::memory_order_release);
         return *this;
     }
 
@@ -135,6 +142,32 @@ public:
         return ElemParams<IntType>::operator==(rhs);
     }
 
+    /**
+   * @brief Returns the NTT tables for this modulus and cyclotomic order, fetching them from
+   * NTTTableRegistryNat on first use. The pointer is cached, so later calls perform no lookups.
+   *
+   * @return pointer to the tables or nullptr for non-native integers or if the parameters do not
+   * describe a power-of-two cyclotomic ring with a usable root of unity.
+   */
+    const NTTTables* GetNTTTables() const {
+        if constexpr (!std::is_same_v<IntType, NativeInteger>) {
+            return nullptr;
+        }
+        else {
+            auto tables = m_nttTables.load(std::memory_order_acquire);
+            if (tables == nullptr) {
+                const auto& co{ElemParams<IntType>::GetCyclotomicOrder()};
+                const auto& ru{ElemParams<IntType>::GetRootOfUnity()};
+                if (ElemParams<IntType>::GetRingDimension() != (co >> 1) || ru == IntType(0) || ru == IntType(1))
+                    return nullptr;
+                tables =
+                    &intnat::NTTTableRegistryNat<NativeVector>::GetTables(ru, co, ElemParams<IntType>::GetModulus());
+                m_nttTables.store(tables, std::memory_order_release);
+            }
+            return tables;
+        }
+    }
+
     template <class Archive>
     void save(Archive& ar, std::uint32_t const version) const {
         ar(::cereal::base_class<ElemParams<IntType>>(this));
@@ -162,6 +195,10 @@ protected:
         ElemParams<IntType>::doprint(out);
         return out << std::endl;
     }
+
+private:
+    // cached pointer into the process-wide NTT table registry; entries are immutable and never freed
+    mutable std::atomic<const NTTTables*> m_nttTables{nullptr};
 };
 
 }  // namespace lbcrypto
@@ -47,6 +47,7 @@
 #include <memory>
 #include <ostream>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -430,6 +431,21 @@ void PolyImpl<VecType>::SwitchFormat() {
     if (!m_values)
         OPENFHE_THROW("Poly switch format to empty values");
 
+    if constexpr (std::is_same_v<VecType, NativeVector>) {
+        // the tables cached in the params avoid the per-call lookups of the modulus-keyed maps
+        const auto* tables = m_params->GetNTTTables();
+        if (tables != nullptr && tables->modulus == m_values->GetModulus()) {
+            if (m_format != Format::COEFFICIENT) {
+                m_format = Format::COEFFICIENT;
+                ChineseRemainderTransformFTT<VecType>().InverseTransformFromBitReverseInPlace(*tables, &(*m_values));
+                return;
+            }
+            m_format = Format::EVALUATION;
+            ChineseRemainderTransformFTT<VecType>().ForwardTransformToBitReverseInPlace(*tables, &(*m_values));
+            return;
+        }
+    }
+
     if (m_format != Format::COEFFICIENT) {
         m_format = Format::COEFFICIENT;
         ChineseRemainderTransformFTT<VecType>().InverseTransformFromBitReverseInPlace(ru, co, &(*m_values));
@@ -439,6 +455,36 @@ void PolyImpl<VecType>::SwitchFormat() {
     ChineseRemainderTransformFTT<VecType>().ForwardTransformToBitReverseInPlace(ru, co, &(*m_values));
 }
 
+template <typename VecType>
+bool PolyImpl<VecType>::SwitchFormatBatch(std::vector<PolyImpl<VecType>>& polys) {
+    if constexpr (std::is_same_v<VecType, NativeVector>) {
+        if (polys.size() < 2)
+            return false;
+        const Format format{polys[0].m_format};
+        std::vector<const typename Params::NTTTables*> tables(polys.size());
+        std::vector<VecType*> values(polys.size());
+        for (size_t i = 0; i < polys.size(); ++i) {
+            auto& p = polys[i];
+            if (p.m_format != format || p.m_values == nullptr)
+                return false;
+            tables[i] = p.m_params->GetNTTTables();
+            if (tables[i] == nullptr || tables[i]->modulus != p.m_values->GetModulus())
+                return false;
+            values[i] = &(*p.m_values);
+        }
+
+        ChineseRemainderTransformFTT<VecType> crt;
+        bool done = (format == Format::COEFFICIENT) ? crt.ForwardTransformToBitReverseInPlaceBatch(tables, values) :
+                                                      crt.InverseTransformFromBitReverseInPlaceBatch(tables, values);
+        if (!done)
+            return false;
+        for (auto& p : polys)
+            p.m_format = (format == Format::COEFFICIENT) ? Format::EVALUATION : Format::COEFFICIENT;
+        return true;
+    }
+    return false;
+}
+
 template <typename VecType>
 void PolyImpl<VecType>::ArbitrarySwitchFormat() {
     if (m_values == nullptr)
@@ -326,6 +326,16 @@ public:
     }
 
     void SwitchFormat() override;
+
+    /**
+     * @brief Switches the format of several polynomials with the same ring dimension at once, so
+     * that one transform can be split across threads when there are fewer polynomials than threads.
+     * Used for the towers of a DCRT polynomial.
+     *
+     * @param polys are the polynomials; all have to be in the same format.
+     * @return false if nothing was done and SwitchFormat() has to be called on each polynomial.
+     */
+    static bool SwitchFormatBatch(std::vector<PolyImpl>& polys);
     void MakeSparse(uint32_t wFactor) override;
     bool InverseExists() const override;
     double Norm() const override;
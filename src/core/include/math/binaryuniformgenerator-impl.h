@@ -41,6 +41,7 @@
 
 #include "utils/inttypes.h"
 
+#include <algorithm>
 #include <random>
 
 namespace lbcrypto {
@@ -57,8 +58,17 @@ template <typename VecType>
 VecType BinaryUniformGeneratorImpl<VecType>::GenerateVector(const usint size,
                                                             const typename VecType::Integer& modulus) const {
     VecType v(size, modulus);
-    for (usint i = 0; i < size; i++)
-        v[i] = GenerateInteger();
+    // 64 bits per word of PRNG output
+    uint64_t block[PRNG_FILL_WORDS];
+    auto& prng = PseudoRandomNumberGenerator::GetPRNG();
+    for (usint i = 0; i < size;) {
+        const usint words = std::min<usint>(PRNG_FILL_WORDS, (size - i + 63) / 64);
+        PseudoRandomNumberGenerator::Fill(prng, block, words * sizeof(uint64_t));
+        for (usint w = 0; w < words; ++w) {
+            for (uint32_t k = 0; k < 64 && i < size; ++k, ++i)
+                v[i] = typename VecType::Integer((block[w] >> k) & 1);
+        }
+    }
     return v;
 }
 
@@ -40,6 +40,7 @@
 #include "math/discretegaussiangenerator.h"
 #include "utils/exception.h"
 
+#include <algorithm>
 #include <cmath>
 #include <memory>
 #include <string>
@@ -94,17 +95,48 @@ void DiscreteGaussianGeneratorImpl<VecType>::Initialize() {
 
     for (int x = 0; x < fin; ++x)
         m_vals[x] *= m_a;
+
+    // the thresholds of SampleCDT() are computed from the tails P(|x| > k), summed from the far end
+    // so that the small probabilities keep their precision; the thresholds that round to 2^63 are
+    // never reached and are dropped
+    m_cdt.clear();
+    if (static_cast<uint32_t>(fin) <= DGG_CDT_MAX_SIZE) {
+        std::vector<double> tails(fin);
+        double tail{0.0};
+        for (int x = fin; x >= 1; --x) {
+            tail += std::exp(-(static_cast<double>(x * x) / variance));
+            tails[x - 1] = 2 * m_a * tail;
+        }
+        for (int x = 0; x < fin; ++x) {
+            auto t = static_cast<uint64_t>(std::llround(std::ldexp(tails[x], 63)));
+            if (t == 0)
+                break;
+            m_cdt.push_back((uint64_t(1) << 63) - t);
+        }
+    }
 }
 
 template <typename VecType>
 int32_t DiscreteGaussianGeneratorImpl<VecType>::GenerateInt() const {
+    return static_cast<int32_t>(GenerateIntPeikert(PseudoRandomNumberGenerator::GetPRNG()));
+}
+
+template <typename VecType>
+int64_t DiscreteGaussianGeneratorImpl<VecType>::GenerateIntPeikert(PRNG& prng) const {
+    if (!m_cdt.empty()) {
+        uint64_t rand;
+        PseudoRandomNumberGenerator::Fill(prng, &rand, sizeof(rand));
+        int64_t val;
+        SampleCDT(m_cdt.data(), m_cdt.size(), &rand, &val, 1);
+        return val;
+    }
     // we need to use the binary uniform generator rather than regular continuous
     // distribution; see DG14 for details
-    double seed = std::uniform_real_distribution<double>(0.0, 1.0)(PseudoRandomNumberGenerator::GetPRNG()) - 0.5;
+    double seed = std::uniform_real_distribution<double>(0.0, 1.0)(prng) - 0.5;
     double tmp  = std::abs(seed) - m_a / 2;
     if (tmp <= 0)
         return 0;
-    return static_cast<int32_t>(FindInVector(m_vals, tmp)) * (seed > 0 ? 1 : -1);
+    return static_cast<int64_t>(FindInVector(m_vals, tmp)) * (seed > 0 ? 1 : -1);
 }
 
 template <typename VecType>
@@ -117,16 +149,26 @@ std::shared_ptr<int64_t> DiscreteGaussianGeneratorImpl<VecType>::GenerateIntVect
         return ans;
     }
 
-    std::uniform_real_distribution<double> distribution(0.0, 1.0);
-    for (uint32_t i = 0; i < size; ++i) {
-        // we need to use the binary uniform generator rather than regular
-        // continuous distribution; see DG14 for details
-        double seed = distribution(PseudoRandomNumberGenerator::GetPRNG()) - 0.5;
-        double tmp  = std::abs(seed) - m_a / 2;
-        int64_t val = 0;
-        if (tmp > 0)
-            val = static_cast<int64_t>(FindInVector(m_vals, tmp)) * (seed > 0 ? 1 : -1);
-        (ans.get())[i] = val;
+    uint64_t block[PRNG_FILL_WORDS];
+    auto& prng = PseudoRandomNumberGenerator::GetPRNG();
+    for (uint32_t first = 0; first < size; first += PRNG_FILL_WORDS) {
+        const uint32_t count = std::min(PRNG_FILL_WORDS, size - first);
+        PseudoRandomNumberGenerator::Fill(prng, block, count * sizeof(uint64_t));
+        if (!m_cdt.empty()) {
+            SampleCDT(m_cdt.data(), m_cdt.size(), block, ans.get() + first, count);
+            continue;
+        }
+        for (uint32_t i = 0; i < count; ++i) {
+            // we need to use the binary uniform generator rather than regular
+            // continuous distribution; see DG14 for details. The uniform value in [0, 1)
+            // has the 53 bits of precision of std::uniform_real_distribution<double>
+            double seed = static_cast<double>(block[i] >> 11) * 0x1p-53 - 0.5;
+            double tmp  = std::abs(seed) - m_a / 2;
+            int64_t val = 0;
+            if (tmp > 0)
+                val = static_cast<int64_t>(FindInVector(m_vals, tmp)) * (seed > 0 ? 1 : -1);
+            (ans.get())[first + i] = val;
+        }
     }
     return ans;
 }
@@ -144,11 +186,13 @@ uint32_t DiscreteGaussianGeneratorImpl<VecType>::FindInVector(const std::vector<
 template <typename VecType>
 typename VecType::Integer DiscreteGaussianGeneratorImpl<VecType>::GenerateInteger(
     const typename VecType::Integer& modulus) const {
-    double seed = std::uniform_real_distribution<double>(0.0, 1.0)(PseudoRandomNumberGenerator::GetPRNG()) - 0.5;
-    double tmp  = std::abs(seed) - m_a / 2;
-    if (tmp <= 0)
-        return typename VecType::Integer(0);
-    auto val = static_cast<int32_t>(FindInVector(m_vals, tmp)) * (seed > 0 ? 1 : -1);
+    return GenerateInteger(modulus, PseudoRandomNumberGenerator::GetPRNG());
+}
+
+template <typename VecType>
+typename VecType::Integer DiscreteGaussianGeneratorImpl<VecType>::GenerateInteger(
+    const typename VecType::Integer& modulus, PRNG& prng) const {
+    int64_t val = GenerateIntPeikert(prng);
     if (val < 0)
         return modulus - typename VecType::Integer(-val);
     return typename VecType::Integer(val);
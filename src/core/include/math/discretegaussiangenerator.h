@@ -61,7 +61,12 @@
  * kept, which are precalculated in constructor. The method is not prone to
  * timing attacks but it is usable for single center, single deviation only.
  * It should be also noted that the memory requirement grows with the standard
- * deviation, therefore it is advised to use it with smaller deviations.   */
+ * deviation, therefore it is advised to use it with smaller deviations.
+ * For small standard deviations (up to about 5, which covers the usual 3.19) the
+ * inversion method runs on a table of 63-bit integer thresholds instead: every
+ * sample is compared with all entries of the table, without branches and in
+ * batches of 64-bit random words, so that its running time does not depend on
+ * the value sampled.   */
 
 #ifndef LBCRYPTO_INC_MATH_DISCRETEGAUSSIANGENERATOR_H_
 #define LBCRYPTO_INC_MATH_DISCRETEGAUSSIANGENERATOR_H_
@@ -78,6 +83,21 @@ namespace lbcrypto {
 
 constexpr double KARNEY_THRESHOLD = 300.0;
 
+// distributions whose cumulative distribution table has at most this many entries are sampled with SampleCDT()
+constexpr uint32_t DGG_CDT_MAX_SIZE = 64;
+
+/**
+ * @brief Constant-time sampling of a discrete Gaussian centered at zero from its cumulative distribution table:
+ * bit 63 of every random word is the sign of the sample and the lower 63 bits are compared with all entries of
+ * the table. There are no branches on the data, and 16 samples are compared at once with AVX2 if the CPU has it.
+ * @param table the thresholds 2^63 * P(|x| <= k) for k = 0, 1, ..., rounded, all below 2^63.
+ * @param size the number of thresholds.
+ * @param rand count uniformly random words.
+ * @param out count samples in [-size, size].
+ * @param count the number of samples.
+ */
+void SampleCDT(const uint64_t* table, uint32_t size, const uint64_t* rand, int64_t* out, uint32_t count);
+
 /**
  * @brief The class for Discrete Gaussion Distribution generator.
  */
@@ -141,6 +161,15 @@ public:
    */
     typename VecType::Integer GenerateInteger(const typename VecType::Integer& modulus) const;
 
+    /**
+   * @brief  Returns a generated integer drawn from the given PRNG instead of the
+   * shared one. Uses Peikert's inversion method.
+   * @param modulus modulus used to represent negative values.
+   * @param prng the source of randomness.
+   * @return A random value within this Discrete Gaussian Distribution.
+   */
+    typename VecType::Integer GenerateInteger(const typename VecType::Integer& modulus, PRNG& prng) const;
+
     /**
    * @brief           Generates a vector of random values within this Discrete
    * Gaussian Distribution. Uses Peikert's inversion method.
@@ -197,10 +226,15 @@ private:
     double m_std{1.0};
     double m_a{0.0};
     std::vector<double> m_vals;
+    // thresholds of SampleCDT(); empty if the table would exceed DGG_CDT_MAX_SIZE entries
+    std::vector<uint64_t> m_cdt;
     bool peikert{false};
 
     uint32_t FindInVector(const std::vector<double>& S, double search) const;
 
+    // a single sample of the inversion method drawn from prng, as a signed integer
+    int64_t GenerateIntPeikert(PRNG& prng) const;
+
     static double UnnormalizedGaussianPDF(const double& mean, const double& sigma, int32_t x) {
         return pow(M_E, -pow(x - mean, 2) / (2. * sigma * sigma));
     }
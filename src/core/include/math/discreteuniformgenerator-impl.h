@@ -41,6 +41,8 @@
 #include "math/distributiongenerator.h"
 #include "utils/exception.h"
 
+#include <algorithm>
+
 namespace lbcrypto {
 
 template <typename VecType>
@@ -82,8 +84,7 @@ typename VecType::Integer DiscreteUniformGeneratorImpl<VecType>::GenerateInteger
 template <typename VecType>
 VecType DiscreteUniformGeneratorImpl<VecType>::GenerateVector(const uint32_t size) const {
     VecType v(size, m_modulus);
-    for (uint32_t i = 0; i < size; ++i)
-        v[i] = this->GenerateInteger();
+    this->FillVector(v);
     return v;
 }
 
@@ -92,11 +93,55 @@ VecType DiscreteUniformGeneratorImpl<VecType>::GenerateVector(const uint32_t siz
                                                               const typename VecType::Integer& modulus) {
     this->SetModulus(modulus);
     VecType v(size, m_modulus);
-    for (uint32_t i = 0; i < size; ++i)
-        v[i] = this->GenerateInteger();
+    this->FillVector(v);
     return v;
 }
 
+template <typename VecType>
+void DiscreteUniformGeneratorImpl<VecType>::FillVector(VecType& v) const {
+    if (m_modulus == typename VecType::Integer(0))
+        OPENFHE_THROW("0 modulus?");
+
+    const uint32_t size = v.GetLength();
+    const uint32_t bits = m_modulus.GetMSB();
+    if (bits > 64) {
+        for (uint32_t i = 0; i < size; ++i)
+            v[i] = this->GenerateInteger();
+        return;
+    }
+
+    // candidates of the bit length of the modulus, of which more than a half are accepted; this is the
+    // same distribution as the chunk-wise sampling of GenerateInteger()
+    const uint64_t q    = m_modulus.template ConvertToInt<uint64_t>();
+    const uint64_t mask = (bits == 64) ? ~uint64_t(0) : (uint64_t(1) << bits) - 1;
+    uint64_t block[PRNG_FILL_WORDS];
+    auto& prng = PseudoRandomNumberGenerator::GetPRNG();
+    for (uint32_t i = 0; i < size;) {
+        if (bits <= 32) {
+            // two candidates per word
+            const uint32_t words = std::min(PRNG_FILL_WORDS, (size - i + 1) / 2);
+            PseudoRandomNumberGenerator::Fill(prng, block, words * sizeof(uint64_t));
+            for (uint32_t w = 0; w < words && i < size; ++w) {
+                uint64_t x = block[w] & mask;
+                if (x < q)
+                    v[i++] = typename VecType::Integer(x);
+                x = (block[w] >> 32) & mask;
+                if (x < q && i < size)
+                    v[i++] = typename VecType::Integer(x);
+            }
+        }
+        else {
+            const uint32_t words = std::min(PRNG_FILL_WORDS, size - i);
+            PseudoRandomNumberGenerator::Fill(prng, block, words * sizeof(uint64_t));
+            for (uint32_t w = 0; w < words && i < size; ++w) {
+                const uint64_t x = block[w] & mask;
+                if (x < q)
+                    v[i++] = typename VecType::Integer(x);
+            }
+        }
+    }
+}
+
 }  // namespace lbcrypto
 
 #endif
@@ -71,12 +71,15 @@ public:
     typename VecType::Integer GenerateInteger() const;
 
     /**
-   * @brief Generates a vector of random integers using GenerateInteger()
+   * @brief Generates a vector of random integers; moduli of up to 64 bits are sampled by rejection from
+   * blocks of PRNG output
    */
     VecType GenerateVector(const uint32_t size) const;
     VecType GenerateVector(const uint32_t size, const typename VecType::Integer& modulus);
 
 private:
+    void FillVector(VecType& v) const;
+
     typename VecType::Integer m_modulus{};
     uint32_t m_chunksPerValue{};
     uint32_t m_shiftChunk{};
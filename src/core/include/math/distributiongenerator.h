@@ -45,6 +45,21 @@
 
 namespace lbcrypto {
 
+/**
+ * @brief The PRNG engines built into OpenFHE
+ */
+enum PRNGEngineType {
+    // BLAKE2b-based engine (default)
+    PRNG_BLAKE2 = 0,
+    // AES-256 in counter mode; requires a CPU with the AES instructions
+    PRNG_AES_CTR,
+    // ChaCha20 stream cipher, vectorized with AVX2 when available
+    PRNG_CHACHA20,
+};
+
+// the samplers draw their randomness from PseudoRandomNumberGenerator::Fill() in blocks of up to this many 64-bit words
+constexpr uint32_t PRNG_FILL_WORDS{512};
+
 /**
  * @brief PseudoRandomNumberGenerator provides the PRNG capability to all random distribution generators in OpenFHE.
  * The security of Ring Learning With Errors (used for all crypto capabilities in OpenFHE) depends on
@@ -62,24 +77,53 @@ public:
     */
     static void InitPRNGEngine(const std::string& libPath = std::string());
 
+    /**
+     * @brief SetPRNGEngine() selects one of the built-in PRNG engines, replacing the engine chosen by InitPRNGEngine().
+     *        The engine of every thread is recreated on its next call to GetPRNG(), seeded the same way as the default
+     *        engine. The engines differ in throughput only: all of them are cryptographically secure
+     * @param engine the engine to use
+     * @note this function must not be called while other threads are sampling, and references previously returned
+     *       by GetPRNG() become invalid
+     */
+    static void SetPRNGEngine(PRNGEngineType engine);
+
     /**
      * @brief Returns a reference to the PRNG engine
      */
     static PRNG& GetPRNG();
 
+    /**
+     * @brief Fills a buffer with the output of prng, as PRNG::Fill(). An engine loaded by InitPRNGEngine() from an
+     *        external library may have been built against a version of prng.h without Fill(), so its output is
+     *        read through operator() instead
+     * @param prng the engine returned by GetPRNG()
+     * @param buffer the buffer to fill
+     * @param size the number of bytes
+     */
+    static void Fill(PRNG& prng, void* buffer, size_t size) {
+        if (externalEngine)
+            prng.PRNG::Fill(buffer, size);
+        else
+            prng.Fill(buffer, size);
+    }
+
 private:
     using GenPRNGEngineFuncPtr = PRNG* (*)();
 
 #if defined(WITH_OPENMP)
     // shared pointer to a thread-specific PRNG engine
     static std::shared_ptr<PRNG> m_prng;
+    // the value of the engine epoch when m_prng was created
+    static uint32_t m_prngEpoch;
     #if !defined(FIXED_SEED)
         // avoid contention on m_prng: local copies of m_prng are created for each thread
-        #pragma omp threadprivate(m_prng)
+        #pragma omp threadprivate(m_prng, m_prngEpoch)
     #endif
 #endif
     // pointer to the function generating PRNG
     static GenPRNGEngineFuncPtr genPRNGEngine;
+    // whether genPRNGEngine comes from an external library
+    static bool externalEngine;
 };
 
 }  // namespace lbcrypto
@@ -0,0 +1,96 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+ This file contains the cache-blocked RNS base conversion kernel for the native math backend
+*/
+
+#ifndef LBCRYPTO_MATH_HAL_INTNAT_BASECONVNAT_H
+#define LBCRYPTO_MATH_HAL_INTNAT_BASECONVNAT_H
+
+#include "math/hal/basicint.h"
+
+#include <cstdint>
+
+/**
+ * @namespace intnat
+ * The namespace of intnat
+ */
+namespace intnat {
+
+/**
+ * @brief Precomputations of a fast base conversion from the RNS base {q_i} (sizeQ moduli) to the
+ * RNS base {p_j} (sizeP moduli), as plain 64-bit words.
+ */
+struct BaseConvTables {
+    uint32_t sizeQ;
+    uint32_t sizeP;
+    // q_i
+    const uint64_t* q;
+    // (Q/q_i)^{-1} mod q_i and their Shoup precomputations
+    const uint64_t* QHatInvModq;
+    const uint64_t* QHatInvModqPrecon;
+    // sizeQ x sizeP row-major matrix of (Q/q_i) mod p_j
+    const uint64_t* QHatModp;
+    // p_j
+    const uint64_t* p;
+    // Barrett constants of p_j as used by BarrettUint128ModUint64()
+    const DoubleNativeInt* modpBarrettMu;
+    // 1.0/q_i for the exact conversion, nullptr for the approximate one
+    const double* qInv;
+    // (sizeQ + 1) x sizeP row-major matrix of (alpha * Q) mod p_j, only read if qInv is set
+    const uint64_t* alphaQModp;
+};
+
+/**
+ * Fast base conversion of n coefficients, computed as the matrix product
+ * [x_i (Q/q_i)^{-1}]_{q_i} (n x sizeQ) times (Q/q_i) mod p_j (sizeQ x sizeP) with the sums kept in
+ * 128-bit accumulators that are reduced mod p_j only at the end (for moduli of up to 60 bits).
+ * The coefficients are processed in blocks sized so that the scaled inputs and the accumulators of
+ * a block stay in L1, and the blocks are distributed over the OpenMP threads.
+ *
+ * Without qInv the result is the approximate conversion x + u*Q mod p_j with 0 <= u < sizeQ
+ * (ApproxSwitchCRTBasis), with qInv the overflow u is estimated in floating point and subtracted
+ * (SwitchCRTBasis). The results are identical to the coefficient-wise code.
+ *
+ * @param tables are the moduli and precomputations of the conversion.
+ * @param x are the sizeQ input limbs of n coefficients in [0, q_i).
+ * @param y are the sizeP output limbs of n coefficients.
+ * @param n is the number of coefficients.
+ * @return false if there is no 128-bit integer type or the moduli are too large to accumulate two
+ * products in 128 bits, in which case the caller should fall back to another implementation.
+ */
+bool FastBaseConvert(const BaseConvTables& tables, const uint64_t* const* x, uint64_t* const* y, uint32_t n);
+
+}  // namespace intnat
+
+#endif
@@ -0,0 +1,81 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+ This file contains the fused multiply-accumulate kernel of the key switching inner product for the native math backend
+*/
+
+#ifndef LBCRYPTO_MATH_HAL_INTNAT_INNERPRODNAT_H
+#define LBCRYPTO_MATH_HAL_INTNAT_INNERPRODNAT_H
+
+#include <cstdint>
+
+/**
+ * @namespace intnat
+ * The namespace of intnat
+ */
+namespace intnat {
+
+/**
+ * Computes the pair of inner products ya = sum_j x_j * a_j mod q and yb = sum_j x_j * b_j mod q of n
+ * coefficients, as needed by the key switching inner product of the digits x_j with the key
+ * components a_j and b_j. The products are accumulated in 128-bit lanes and every coefficient is
+ * reduced once at the end (for moduli of up to 60 bits), with the coefficients processed in blocks
+ * whose accumulators stay in L1. Moduli below 2^31 are accumulated in 64-bit lanes with AVX2 when
+ * the CPU supports it.
+ *
+ * @param x are the count digits of n coefficients in [0, q).
+ * @param a are the count first key components of n coefficients in [0, q).
+ * @param b are the count second key components of n coefficients in [0, q).
+ * @param count is the number of digits.
+ * @param q is the modulus.
+ * @param ya is the output for the inner product with a, may not alias the inputs.
+ * @param yb is the output for the inner product with b, may not alias the inputs.
+ * @param n is the number of coefficients.
+ * @return false if there is no 128-bit integer type or the modulus is too large to accumulate two
+ * products in 128 bits, in which case the caller should fall back to another implementation.
+ */
+bool FastInnerProduct(const uint64_t* const* x, const uint64_t* const* a, const uint64_t* const* b, uint32_t count,
+                      uint64_t q, uint64_t* ya, uint64_t* yb, uint32_t n);
+
+/**
+ * FastInnerProduct() with the key components packed into 32-bit words, for moduli below 2^31.
+ *
+ * @return false if there is no 128-bit integer type or q is not below 2^31, in which case the caller
+ * should fall back to another implementation.
+ */
+bool FastInnerProduct(const uint64_t* const* x, const uint32_t* const* a, const uint32_t* const* b, uint32_t count,
+                      uint64_t q, uint64_t* ya, uint64_t* yb, uint32_t n);
+
+}  // namespace intnat
+
+#endif
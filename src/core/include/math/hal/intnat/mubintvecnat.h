@@ -40,6 +40,7 @@
 #include "math/hal/intnat/ubintnat.h"
 #include "math/hal/vector.h"
 
+#include "utils/blockAllocator/arenaallocator.h"
 #include "utils/blockAllocator/xvector.h"
 #include "utils/exception.h"
 #include "utils/inttypes.h"
@@ -69,6 +70,76 @@ template <typename IntType>
 class NativeVectorT;
 using NativeVector = NativeVectorT<NativeInteger>;
 
+/**
+ * @brief Packs the values of count native integers, each below 2^bits, into ceil(count * bits / 64)
+ * 64-bit words: the value i takes the bits [i * bits, (i + 1) * bits) of the sequence of words,
+ * least significant bits first.
+ * @param in the values.
+ * @param count the number of values.
+ * @param bits the bit width of the values, at most the bit width of the integer type.
+ * @param out the words.
+ */
+template <typename IntegerType>
+void PackBits(const IntegerType* in, size_t count, uint32_t bits, uint64_t* out) {
+    using T              = typename IntegerType::Integer;
+    constexpr auto width = static_cast<uint32_t>(8 * sizeof(T));
+    uint64_t acc         = 0;
+    uint32_t fill        = 0;
+    for (size_t i = 0; i < count; ++i) {
+        T x = in[i].ConvertToInt();
+        for (uint32_t left = bits; left > 0;) {
+            const uint32_t take = std::min(left, 64 - fill);
+            uint64_t chunk      = static_cast<uint64_t>(x);
+            if (take < 64)
+                chunk &= (uint64_t(1) << take) - 1;
+            acc |= chunk << fill;
+            fill += take;
+            left -= take;
+            x = (take < width) ? static_cast<T>(x >> take) : T(0);
+            if (fill == 64) {
+                *out++ = acc;
+                acc    = 0;
+                fill   = 0;
+            }
+        }
+    }
+    if (fill > 0)
+        *out = acc;
+}
+
+/**
+ * @brief Unpacks count values of bits bits each packed by PackBits().
+ * @param in the words.
+ * @param count the number of values.
+ * @param bits the bit width of the values, at most the bit width of the integer type.
+ * @param out the values.
+ */
+template <typename IntegerType>
+void UnpackBits(const uint64_t* in, size_t count, uint32_t bits, IntegerType* out) {
+    using T          = typename IntegerType::Integer;
+    uint64_t current = 0;
+    uint32_t avail   = 0;
+    for (size_t i = 0; i < count; ++i) {
+        T x = 0;
+        for (uint32_t got = 0; got < bits;) {
+            if (avail == 0) {
+                current = *in++;
+                avail   = 64;
+            }
+            const uint32_t take = std::min(bits - got, avail);
+            uint64_t chunk      = current;
+            if (take < 64) {
+                chunk &= (uint64_t(1) << take) - 1;
+                current >>= take;
+            }
+            x |= static_cast<T>(chunk) << got;
+            got += take;
+            avail -= take;
+        }
+        out[i] = IntegerType(x);
+    }
+}
+
 /**
  * @brief The class for representing vectors of native integers.
  */
@@ -124,7 +195,8 @@ private:
     IntegerType m_modulus{0};
 
 #if BLOCK_VECTOR_ALLOCATION != 1
-    std::vector<IntegerType> m_data{};
+    // drawn from the per-thread arena inside an ArenaScope, from the heap otherwise
+    std::vector<IntegerType, arena_allocator<IntegerType>> m_data{};
 #else
     xvector<IntegerType> m_data{};
 #endif
@@ -165,6 +237,20 @@ public:
         //                              " bits larger than max modulus bits " + std::to_string(MAX_MODULUS_SIZE));
     }
 
+#if BLOCK_VECTOR_ALLOCATION != 1
+    /**
+   * Constructor for a zero vector placed where \p alloc says, e.g. into a chunk of an ArenaSlab
+   * shared by all towers of a DCRT polynomial.
+   *
+   * @param length is the length of the native vector, in terms of the number of
+   * entries.
+   * @param modulus is the modulus of the ring.
+   * @param alloc is the allocator of the coefficients.
+   */
+    NativeVectorT(usint length, const IntegerType& modulus, const arena_allocator<IntegerType>& alloc)
+        : m_modulus{modulus}, m_data(length, alloc) {}
+#endif
+
     constexpr NativeVectorT(usint length, const IntegerType& modulus, const IntegerType& val) noexcept
         : m_modulus{modulus}, m_data(length, val.Mod(modulus)) {
         // TODO: better performance if this check is done at poly level
@@ -345,6 +431,20 @@ public:
         return m_data.size();
     }
 
+    /**
+   * Gets a pointer to the contiguous storage of the vector entries.
+   * Used by kernels that operate directly on the underlying words.
+   *
+   * @return pointer to the first entry.
+   */
+    IntegerType* data() noexcept {
+        return m_data.data();
+    }
+
+    const IntegerType* data() const noexcept {
+        return m_data.data();
+    }
+
     // MODULAR ARITHMETIC OPERATIONS
 
     /**
@@ -653,15 +753,29 @@ public:
         return os;
     }
 
+    // the binary format packs the values at the bit width of the modulus (version 2), or of the
+    // largest value if a value is not reduced; version 1 stored the values at sizeof(IntegerType).
+    // Vector types without a registered class version keep the format of version 1
     template <class Archive>
     typename std::enable_if<!cereal::traits::is_text_archive<Archive>::value, void>::type save(
         Archive& ar, std::uint32_t const version) const {
         ::cereal::size_type size = m_data.size();
         ar(size);
-        if (size > 0) {
-            ar(::cereal::binary_data(m_data.data(), size * sizeof(IntegerType)));
+        if (version < 2) {
+            if (size > 0) {
+                ar(::cereal::binary_data(m_data.data(), size * sizeof(IntegerType)));
+            }
+            ar(m_modulus);
+            return;
         }
         ar(m_modulus);
+        uint8_t bits = PackedBitWidth();
+        ar(bits);
+        if (size > 0 && bits > 0) {
+            std::vector<uint64_t> words((size * bits + 63) / 64);
+            PackBits(m_data.data(), size, bits, words.data());
+            ar(::cereal::binary_data(words.data(), words.size() * sizeof(uint64_t)));
+        }
     }
 
     template <class Archive>
@@ -681,15 +795,31 @@ public:
         ::cereal::size_type size;
         ar(size);
         m_data.resize(size);
-        if (size > 0) {
-            auto* data = reinterpret_cast<IntegerType*>(malloc(size * sizeof(IntegerType)));
-            ar(::cereal::binary_data(data, size * sizeof(IntegerType)));
-            for (::cereal::size_type i = 0; i < size; i++) {
-                m_data[i] = data[i];
+        if (version < 2) {
+            if (size > 0) {
+                auto* data = reinterpret_cast<IntegerType*>(malloc(size * sizeof(IntegerType)));
+                ar(::cereal::binary_data(data, size * sizeof(IntegerType)));
+                for (::cereal::size_type i = 0; i < size; i++) {
+                    m_data[i] = data[i];
+                }
+                free(data);
             }
-            free(data);
+            ar(m_modulus);
+            return;
         }
         ar(m_modulus);
+        uint8_t bits;
+        ar(bits);
+        if (bits > 8 * sizeof(typename IntegerType::Integer))
+            OPENFHE_THROW("invalid bit width " + std::to_string(bits) + " of the packed values");
+        if (size > 0 && bits > 0) {
+            std::vector<uint64_t> words((size * bits + 63) / 64);
+            ar(::cereal::binary_data(words.data(), words.size() * sizeof(uint64_t)));
+            UnpackBits(words.data(), size, bits, m_data.data());
+        }
+        else {
+            std::fill(m_data.begin(), m_data.end(), IntegerType(0));
+        }
     }
 
     template <class Archive>
@@ -708,7 +838,20 @@ public:
     }
 
     static uint32_t SerializedVersion() {
-        return 1;
+        return 2;
+    }
+
+private:
+    // the bit width of the packed values: that of the largest value below the modulus, or of the
+    // largest value if some value is not reduced
+    uint8_t PackedBitWidth() const {
+        auto maxBits = static_cast<uint8_t>(m_modulus == 0 ? 8 * sizeof(typename IntegerType::Integer) :
+                                                             (m_modulus - IntegerType(1)).GetMSB());
+        typename IntegerType::Integer all = 0;
+        for (const auto& v : m_data)
+            all |= v.ConvertToInt();
+        const auto bits = static_cast<uint8_t>(IntegerType(all).GetMSB());
+        return std::max(maxBits, bits);
     }
 };
 
@@ -0,0 +1,64 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+ This file contains the Shoup's modular multiplication helpers shared by the native NTT kernels
+*/
+
+#ifndef LBCRYPTO_MATH_HAL_INTNAT_SHOUPNAT_H
+#define LBCRYPTO_MATH_HAL_INTNAT_SHOUPNAT_H
+
+#include <cstdint>
+
+/**
+ * @namespace intnat
+ * The namespace of intnat
+ */
+namespace intnat {
+
+#if defined(__SIZEOF_INT128__)
+
+// Shoup's precomputation floor(w * 2^64 / q)
+inline uint64_t PrecomputeShoup(uint64_t w, uint64_t q) {
+    return static_cast<uint64_t>((static_cast<unsigned __int128>(w) << 64) / q);
+}
+
+// x * w mod q in [0, 2q) for any 64-bit x
+inline uint64_t MulShoupLazy(uint64_t x, uint64_t w, uint64_t wPrecon, uint64_t q) {
+    auto hi = static_cast<uint64_t>((static_cast<unsigned __int128>(x) * wPrecon) >> 64);
+    return x * w - hi * q;
+}
+
+#endif  // __SIZEOF_INT128__
+
+}  // namespace intnat
+
+#endif
@@ -40,6 +40,8 @@
 #include "math/hal/intnat/ubintnat.h"
 #include "math/hal/intnat/mubintvecnat.h"
 #include "math/hal/intnat/transformnat.h"
+#include "math/hal/intnat/transformnat-lazy.h"
+#include "math/hal/intnat/transformnat-simd.h"
 #include "math/nbtheory.h"
 
 #include "utils/exception.h"
@@ -47,6 +49,8 @@
 #include "utils/utilities.h"
 
 #include <map>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 namespace intnat {
@@ -54,28 +58,7 @@ namespace intnat {
 using namespace lbcrypto;
 
 template <typename VecType>
-std::map<typename VecType::Integer, VecType>
-    ChineseRemainderTransformFTTNat<VecType>::m_cycloOrderInverseTableByModulus;
-
-template <typename VecType>
-std::map<typename VecType::Integer, VecType>
-    ChineseRemainderTransformFTTNat<VecType>::m_cycloOrderInversePreconTableByModulus;
-
-template <typename VecType>
-std::map<typename VecType::Integer, VecType>
-    ChineseRemainderTransformFTTNat<VecType>::m_rootOfUnityReverseTableByModulus;
-
-template <typename VecType>
-std::map<typename VecType::Integer, VecType>
-    ChineseRemainderTransformFTTNat<VecType>::m_rootOfUnityInverseReverseTableByModulus;
-
-template <typename VecType>
-std::map<typename VecType::Integer, VecType>
-    ChineseRemainderTransformFTTNat<VecType>::m_rootOfUnityPreconReverseTableByModulus;
-
-template <typename VecType>
-std::map<typename VecType::Integer, VecType>
-    ChineseRemainderTransformFTTNat<VecType>::m_rootOfUnityInversePreconReverseTableByModulus;
+typename NTTTableRegistryNat<VecType>::NodeList NTTTableRegistryNat<VecType>::m_nodes;
 
 template <typename VecType>
 std::map<typename VecType::Integer, VecType> ChineseRemainderTransformArbNat<VecType>::m_cyclotomicPolyMap;
@@ -319,6 +302,26 @@ void NumberTheoreticTransformNat<VecType>::ForwardTransformToBitReverseInPlace(c
     //
 
     const auto modulus{element->GetModulus()};
+    if constexpr (sizeof(typename IntType::Integer) == sizeof(uint64_t)) {
+        // use the vectorized kernel selected at runtime if there is one for this modulus,
+        // otherwise the selected scalar variant, cache-blocked for large rings
+        if (ForwardTransformToBitReverseInPlaceSIMD(reinterpret_cast<const uint64_t*>(rootOfUnityTable.data()),
+                                                    reinterpret_cast<const uint64_t*>(preconRootOfUnityTable.data()),
+                                                    modulus.ConvertToInt(), element->GetLength(),
+                                                    reinterpret_cast<uint64_t*>(element->data())))
+            return;
+        if (ForwardTransformToBitReverseInPlaceBlocked(reinterpret_cast<const uint64_t*>(rootOfUnityTable.data()),
+                                                       reinterpret_cast<const uint64_t*>(preconRootOfUnityTable.data()),
+                                                       modulus.ConvertToInt(), element->GetLength(),
+                                                       reinterpret_cast<uint64_t*>(element->data())))
+            return;
+        if (ForwardTransformToBitReverseInPlaceLazy(reinterpret_cast<const uint64_t*>(rootOfUnityTable.data()),
+                                                    reinterpret_cast<const uint64_t*>(preconRootOfUnityTable.data()),
+                                                    modulus.ConvertToInt(), element->GetLength(),
+                                                    reinterpret_cast<uint64_t*>(element->data())))
+            return;
+    }
+
     const uint32_t n(element->GetLength() >> 1);
     for (uint32_t m{1}, t{n}, logt{GetMSB(t)}; m < n; m <<= 1, t >>= 1, --logt) {
         for (uint32_t i{0}; i < m; ++i) {
@@ -533,6 +536,29 @@ void NumberTheoreticTransformNat<VecType>::InverseTransformFromBitReverseInPlace
     auto modulus{element->GetModulus()};
     uint32_t n(element->GetLength());
 
+    if constexpr (sizeof(typename IntType::Integer) == sizeof(uint64_t)) {
+        // use the vectorized kernel selected at runtime if there is one for this modulus,
+        // otherwise the selected scalar variant, cache-blocked for large rings
+        if (InverseTransformFromBitReverseInPlaceSIMD(
+                reinterpret_cast<const uint64_t*>(rootOfUnityInverseTable.data()),
+                reinterpret_cast<const uint64_t*>(preconRootOfUnityInverseTable.data()), cycloOrderInv.ConvertToInt(),
+                preconCycloOrderInv.ConvertToInt(), modulus.ConvertToInt(), n,
+                reinterpret_cast<uint64_t*>(element->data())))
+            return;
+        if (InverseTransformFromBitReverseInPlaceBlocked(
+                reinterpret_cast<const uint64_t*>(rootOfUnityInverseTable.data()),
+                reinterpret_cast<const uint64_t*>(preconRootOfUnityInverseTable.data()), cycloOrderInv.ConvertToInt(),
+                preconCycloOrderInv.ConvertToInt(), modulus.ConvertToInt(), n,
+                reinterpret_cast<uint64_t*>(element->data())))
+            return;
+        if (InverseTransformFromBitReverseInPlaceLazy(
+                reinterpret_cast<const uint64_t*>(rootOfUnityInverseTable.data()),
+                reinterpret_cast<const uint64_t*>(preconRootOfUnityInverseTable.data()), cycloOrderInv.ConvertToInt(),
+                preconCycloOrderInv.ConvertToInt(), modulus.ConvertToInt(), n,
+                reinterpret_cast<uint64_t*>(element->data())))
+            return;
+    }
+
     // precomputed omega[bitreversed(1)] * (n inverse). used in final stage of intt.
     auto omega1Inv{rootOfUnityInverseTable[1].ModMulFastConst(cycloOrderInv, modulus, preconCycloOrderInv)};
     auto preconOmega1Inv{omega1Inv.PrepModMulConst(modulus)};
@@ -662,13 +688,10 @@ void ChineseRemainderTransformFTTNat<VecType>::ForwardTransformToBitReverseInPla
 
     IntType modulus = element->GetModulus();
 
-    auto mapSearch = m_rootOfUnityReverseTableByModulus.find(modulus);
-    if (mapSearch == m_rootOfUnityReverseTableByModulus.end() || mapSearch->second.GetLength() != CycloOrderHf) {
-        PreCompute(rootOfUnity, CycloOrder, modulus);
-    }
+    const auto& tables = NTTTableRegistryNat<VecType>::GetTables(rootOfUnity, CycloOrder, modulus);
 
     NumberTheoreticTransformNat<VecType>().ForwardTransformToBitReverseInPlace(
-        m_rootOfUnityReverseTableByModulus[modulus], m_rootOfUnityPreconReverseTableByModulus[modulus], element);
+        tables.rootOfUnityReverse, tables.rootOfUnityPreconReverse, element);
 }
 
 template <typename VecType>
@@ -691,14 +714,10 @@ void ChineseRemainderTransformFTTNat<VecType>::ForwardTransformToBitReverse(cons
 
     IntType modulus = element.GetModulus();
 
-    auto mapSearch = m_rootOfUnityReverseTableByModulus.find(modulus);
-    if (mapSearch == m_rootOfUnityReverseTableByModulus.end() || mapSearch->second.GetLength() != CycloOrderHf) {
-        PreCompute(rootOfUnity, CycloOrder, modulus);
-    }
+    const auto& tables = NTTTableRegistryNat<VecType>::GetTables(rootOfUnity, CycloOrder, modulus);
 
-    NumberTheoreticTransformNat<VecType>().ForwardTransformToBitReverse(
-        element, m_rootOfUnityReverseTableByModulus[modulus], m_rootOfUnityPreconReverseTableByModulus[modulus],
-        result);
+    NumberTheoreticTransformNat<VecType>().ForwardTransformToBitReverse(element, tables.rootOfUnityReverse,
+                                                                        tables.rootOfUnityPreconReverse, result);
 
     return;
 }
@@ -722,16 +741,11 @@ void ChineseRemainderTransformFTTNat<VecType>::InverseTransformFromBitReverseInP
 
     IntType modulus = element->GetModulus();
 
-    auto mapSearch = m_rootOfUnityReverseTableByModulus.find(modulus);
-    if (mapSearch == m_rootOfUnityReverseTableByModulus.end() || mapSearch->second.GetLength() != CycloOrderHf) {
-        PreCompute(rootOfUnity, CycloOrder, modulus);
-    }
+    const auto& tables = NTTTableRegistryNat<VecType>::GetTables(rootOfUnity, CycloOrder, modulus);
 
-    usint msb = GetMSB(CycloOrderHf - 1);
     NumberTheoreticTransformNat<VecType>().InverseTransformFromBitReverseInPlace(
-        m_rootOfUnityInverseReverseTableByModulus[modulus], m_rootOfUnityInversePreconReverseTableByModulus[modulus],
-        m_cycloOrderInverseTableByModulus[modulus][msb], m_cycloOrderInversePreconTableByModulus[modulus][msb],
-        element);
+        tables.rootOfUnityInverseReverse, tables.rootOfUnityInversePreconReverse, tables.cycloOrderInv,
+        tables.cycloOrderInvPrecon, element);
 }
 
 template <typename VecType>
@@ -754,10 +768,7 @@ void ChineseRemainderTransformFTTNat<VecType>::InverseTransformFromBitReverse(co
 
     IntType modulus = element.GetModulus();
 
-    auto mapSearch = m_rootOfUnityReverseTableByModulus.find(modulus);
-    if (mapSearch == m_rootOfUnityReverseTableByModulus.end() || mapSearch->second.GetLength() != CycloOrderHf) {
-        PreCompute(rootOfUnity, CycloOrder, modulus);
-    }
+    const auto& tables = NTTTableRegistryNat<VecType>::GetTables(rootOfUnity, CycloOrder, modulus);
 
     usint n = element.GetLength();
     result->SetModulus(element.GetModulus());
@@ -765,69 +776,84 @@ void ChineseRemainderTransformFTTNat<VecType>::InverseTransformFromBitReverse(co
         (*result)[i] = element[i];
     }
 
-    usint msb = GetMSB(CycloOrderHf - 1);
     NumberTheoreticTransformNat<VecType>().InverseTransformFromBitReverseInPlace(
-        m_rootOfUnityInverseReverseTableByModulus[modulus], m_rootOfUnityInversePreconReverseTableByModulus[modulus],
-        m_cycloOrderInverseTableByModulus[modulus][msb], m_cycloOrderInversePreconTableByModulus[modulus][msb], result);
+        tables.rootOfUnityInverseReverse, tables.rootOfUnityInversePreconReverse, tables.cycloOrderInv,
+        tables.cycloOrderInvPrecon, result);
 
     return;
 }
 
 template <typename VecType>
-void ChineseRemainderTransformFTTNat<VecType>::PreCompute(const IntType& rootOfUnity, const usint CycloOrder,
-                                                          const IntType& modulus) {
-    usint CycloOrderHf = (CycloOrder >> 1);
-
-    auto mapSearch = m_rootOfUnityReverseTableByModulus.find(modulus);
-    if (mapSearch == m_rootOfUnityReverseTableByModulus.end() || mapSearch->second.GetLength() != CycloOrderHf) {
-#pragma omp critical
-        {
-            IntType x(1), xinv(1);
-            usint msb  = GetMSB(CycloOrderHf - 1);
-            IntType mu = modulus.ComputeMu();
-            VecType Table(CycloOrderHf, modulus);
-            VecType TableI(CycloOrderHf, modulus);
-            IntType rootOfUnityInverse = rootOfUnity.ModInverse(modulus);
-            usint iinv;
-            for (usint i = 0; i < CycloOrderHf; i++) {
-                iinv         = ReverseBits(i, msb);
-                Table[iinv]  = x;
-                TableI[iinv] = xinv;
-                x.ModMulEq(rootOfUnity, modulus, mu);
-                xinv.ModMulEq(rootOfUnityInverse, modulus, mu);
-            }
-            m_rootOfUnityReverseTableByModulus[modulus]        = Table;
-            m_rootOfUnityInverseReverseTableByModulus[modulus] = TableI;
-
-            VecType TableCOI(msb + 1, modulus);
-            for (usint i = 0; i < msb + 1; i++) {
-                IntType coInv(IntType(1 << i).ModInverse(modulus));
-                TableCOI[i] = coInv;
-            }
-            m_cycloOrderInverseTableByModulus[modulus] = TableCOI;
-
-            NativeInteger nativeModulus = modulus.ConvertToInt();
-            VecType preconTable(CycloOrderHf, nativeModulus);
-            VecType preconTableI(CycloOrderHf, nativeModulus);
+void ChineseRemainderTransformFTTNat<VecType>::ForwardTransformToBitReverseInPlace(const NTTTablesNat<VecType>& tables,
+                                                                                   VecType* element) {
+    if (element->GetLength() != (tables.cycloOrder >> 1))
+        OPENFHE_THROW("element size must be equal to CyclotomicOrder / 2");
+    NumberTheoreticTransformNat<VecType>().ForwardTransformToBitReverseInPlace(
+        tables.rootOfUnityReverse, tables.rootOfUnityPreconReverse, element);
+}
 
-            for (usint i = 0; i < CycloOrderHf; i++) {
-                preconTable[i] = NativeInteger(m_rootOfUnityReverseTableByModulus[modulus][i].ConvertToInt())
-                                     .PrepModMulConst(nativeModulus);
-                preconTableI[i] = NativeInteger(m_rootOfUnityInverseReverseTableByModulus[modulus][i].ConvertToInt())
-                                      .PrepModMulConst(nativeModulus);
-            }
+template <typename VecType>
+void ChineseRemainderTransformFTTNat<VecType>::InverseTransformFromBitReverseInPlace(const NTTTablesNat<VecType>& tables,
+                                                                                     VecType* element) {
+    if (element->GetLength() != (tables.cycloOrder >> 1))
+        OPENFHE_THROW("element size must be equal to CyclotomicOrder / 2");
+    NumberTheoreticTransformNat<VecType>().InverseTransformFromBitReverseInPlace(
+        tables.rootOfUnityInverseReverse, tables.rootOfUnityInversePreconReverse, tables.cycloOrderInv,
+        tables.cycloOrderInvPrecon, element);
+}
 
-            VecType preconTableCOI(msb + 1, nativeModulus);
-            for (usint i = 0; i < msb + 1; i++) {
-                preconTableCOI[i] = NativeInteger(m_cycloOrderInverseTableByModulus[modulus][i].ConvertToInt())
-                                        .PrepModMulConst(nativeModulus);
-            }
+template <typename VecType>
+bool ChineseRemainderTransformFTTNat<VecType>::ForwardTransformToBitReverseInPlaceBatch(
+    const std::vector<const NTTTablesNat<VecType>*>& tables, const std::vector<VecType*>& elements) {
+    if constexpr (sizeof(typename IntType::Integer) == sizeof(uint64_t)) {
+        if (tables.empty() || tables.size() != elements.size())
+            return false;
+        const uint32_t n = tables[0]->cycloOrder >> 1;
+        std::vector<NTTBatchLimb> limbs(tables.size());
+        for (size_t i = 0; i < tables.size(); ++i) {
+            if ((tables[i]->cycloOrder >> 1) != n || elements[i]->GetLength() != n)
+                return false;
+            limbs[i] = {reinterpret_cast<const uint64_t*>(tables[i]->rootOfUnityReverse.data()),
+                        reinterpret_cast<const uint64_t*>(tables[i]->rootOfUnityPreconReverse.data()),
+                        0,
+                        0,
+                        tables[i]->modulus.ConvertToInt(),
+                        reinterpret_cast<uint64_t*>(elements[i]->data())};
+        }
+        return intnat::ForwardTransformToBitReverseInPlaceBatch(limbs.data(), limbs.size(), n);
+    }
+    return false;
+}
 
-            m_rootOfUnityPreconReverseTableByModulus[modulus]        = preconTable;
-            m_rootOfUnityInversePreconReverseTableByModulus[modulus] = preconTableI;
-            m_cycloOrderInversePreconTableByModulus[modulus]         = preconTableCOI;
+template <typename VecType>
+bool ChineseRemainderTransformFTTNat<VecType>::InverseTransformFromBitReverseInPlaceBatch(
+    const std::vector<const NTTTablesNat<VecType>*>& tables, const std::vector<VecType*>& elements) {
+    if constexpr (sizeof(typename IntType::Integer) == sizeof(uint64_t)) {
+        if (tables.empty() || tables.size() != elements.size())
+            return false;
+        const uint32_t n = tables[0]->cycloOrder >> 1;
+        std::vector<NTTBatchLimb> limbs(tables.size());
+        for (size_t i = 0; i < tables.size(); ++i) {
+            if ((tables[i]->cycloOrder >> 1) != n || elements[i]->GetLength() != n)
+                return false;
+            limbs[i] = {reinterpret_cast<const uint64_t*>(tables[i]->rootOfUnityInverseReverse.data()),
+                        reinterpret_cast<const uint64_t*>(tables[i]->rootOfUnityInversePreconReverse.data()),
+                        tables[i]->cycloOrderInv.ConvertToInt(),
+                        tables[i]->cycloOrderInvPrecon.ConvertToInt(),
+                        tables[i]->modulus.ConvertToInt(),
+                        reinterpret_cast<uint64_t*>(elements[i]->data())};
         }
+        return intnat::InverseTransformFromBitReverseInPlaceBatch(limbs.data(), limbs.size(), n);
     }
+    return false;
+}
+
+template <typename VecType>
+void ChineseRemainderTransformFTTNat<VecType>::PreCompute(const IntType& rootOfUnity, const usint CycloOrder,
+                                                          const IntType& modulus) {
+    if (rootOfUnity == IntType(1) || rootOfUnity == IntType(0))
+        return;
+    NTTTableRegistryNat<VecType>::GetTables(rootOfUnity, CycloOrder, modulus);
 }
 
 template <typename VecType>
@@ -849,12 +875,89 @@ void ChineseRemainderTransformFTTNat<VecType>::PreCompute(std::vector<IntType>&
 
 template <typename VecType>
 void ChineseRemainderTransformFTTNat<VecType>::Reset() {
-    m_cycloOrderInverseTableByModulus.clear();
-    m_cycloOrderInversePreconTableByModulus.clear();
-    m_rootOfUnityReverseTableByModulus.clear();
-    m_rootOfUnityInverseReverseTableByModulus.clear();
-    m_rootOfUnityPreconReverseTableByModulus.clear();
-    m_rootOfUnityInversePreconReverseTableByModulus.clear();
+    // the tables live in NTTTableRegistryNat and may be referenced by cached params, so they are kept
+}
+
+template <typename VecType>
+NTTTableRegistryNat<VecType>::NodeList::~NodeList() {
+    const Node* node = head.load(std::memory_order_acquire);
+    while (node != nullptr) {
+        const Node* next = node->next;
+        delete node;
+        node = next;
+    }
+}
+
+template <typename VecType>
+const NTTTablesNat<VecType>* NTTTableRegistryNat<VecType>::FindTables(usint cycloOrder, const IntType& modulus) {
+    for (const Node* node = m_nodes.head.load(std::memory_order_acquire); node != nullptr; node = node->next) {
+        if (node->tables.cycloOrder == cycloOrder && node->tables.modulus == modulus)
+            return &node->tables;
+    }
+    return nullptr;
+}
+
+template <typename VecType>
+const NTTTablesNat<VecType>& NTTTableRegistryNat<VecType>::GetTables(const IntType& rootOfUnity, usint cycloOrder,
+                                                                     const IntType& modulus) {
+    if (!IsPowerOfTwo(cycloOrder))
+        OPENFHE_THROW("CyclotomicOrder is not a power of two");
+    if (rootOfUnity == IntType(1) || rootOfUnity == IntType(0))
+        OPENFHE_THROW("rootOfUnity must be a primitive CyclotomicOrder-th root of unity");
+
+    if (auto tables = FindTables(cycloOrder, modulus))
+        return *tables;
+
+    std::lock_guard<std::mutex> lock(m_nodes.insertMutex);
+    // another thread may have registered the same entry while we were waiting for the lock
+    if (auto tables = FindTables(cycloOrder, modulus))
+        return *tables;
+
+    auto node = std::make_unique<Node>();
+    BuildTables(rootOfUnity, cycloOrder, modulus, node->tables);
+    node->next = m_nodes.head.load(std::memory_order_relaxed);
+    m_nodes.head.store(node.get(), std::memory_order_release);
+    return node.release()->tables;
+}
+
+template <typename VecType>
+void NTTTableRegistryNat<VecType>::BuildTables(const IntType& rootOfUnity, usint cycloOrder, const IntType& modulus,
+                                               NTTTablesNat<VecType>& tables) {
+    usint n   = cycloOrder >> 1;
+    usint msb = GetMSB(n - 1);
+
+    tables.modulus     = modulus;
+    tables.rootOfUnity = rootOfUnity;
+    tables.cycloOrder  = cycloOrder;
+
+    IntType mu = modulus.ComputeMu();
+    IntType rootOfUnityInverse(rootOfUnity.ModInverse(modulus));
+    VecType table(n, modulus);
+    VecType tableI(n, modulus);
+    IntType x(1), xinv(1);
+    for (usint i = 0; i < n; ++i) {
+        usint iinv   = ReverseBits(i, msb);
+        table[iinv]  = x;
+        tableI[iinv] = xinv;
+        x.ModMulEq(rootOfUnity, modulus, mu);
+        xinv.ModMulEq(rootOfUnityInverse, modulus, mu);
+    }
+
+    NativeInteger nativeModulus = modulus.ConvertToInt();
+    VecType preconTable(n, nativeModulus);
+    VecType preconTableI(n, nativeModulus);
+    for (usint i = 0; i < n; ++i) {
+        preconTable[i]  = NativeInteger(table[i].ConvertToInt()).PrepModMulConst(nativeModulus);
+        preconTableI[i] = NativeInteger(tableI[i].ConvertToInt()).PrepModMulConst(nativeModulus);
+    }
+
+    tables.cycloOrderInv       = IntType(n).ModInverse(modulus);
+    tables.cycloOrderInvPrecon = NativeInteger(tables.cycloOrderInv.ConvertToInt()).PrepModMulConst(nativeModulus);
+
+    tables.rootOfUnityReverse              = std::move(table);
+    tables.rootOfUnityInverseReverse       = std::move(tableI);
+    tables.rootOfUnityPreconReverse        = std::move(preconTable);
+    tables.rootOfUnityInversePreconReverse = std::move(preconTableI);
 }
 
 template <typename VecType>
@@ -0,0 +1,190 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+ This file contains the lazy-reduction (Harvey) scalar NTT variant for the native math backend
+*/
+
+#ifndef LBCRYPTO_MATH_HAL_INTNAT_TRANSFORMNAT_LAZY_H
+#define LBCRYPTO_MATH_HAL_INTNAT_TRANSFORMNAT_LAZY_H
+
+#include <cstdint>
+
+/**
+ * @namespace intnat
+ * The namespace of intnat
+ */
+namespace intnat {
+
+/**
+ * @brief Scalar NTT variants for the 64-bit native backend. Both produce bit-identical results.
+ * NTT_VARIANT_STANDARD fully reduces after every butterfly. NTT_VARIANT_HARVEY_LAZY keeps the
+ * values in [0, 4q) (forward) or [0, 2q) (inverse) between stages, folds the multiplication by
+ * n^{-1} into the final INTT stage and reduces to [0, q) only once at the end.
+ */
+enum NTTVariant {
+    NTT_VARIANT_STANDARD = 0,
+    NTT_VARIANT_HARVEY_LAZY,
+};
+
+/**
+ * Gets the scalar NTT variant used by the native NTT/INTT when no SIMD kernel applies.
+ * NTT_VARIANT_HARVEY_LAZY is used by default.
+ */
+NTTVariant GetNTTVariant();
+
+/**
+ * Selects the scalar NTT variant used by the native NTT/INTT when no SIMD kernel applies.
+ *
+ * @param variant is the variant to use.
+ */
+void SetNTTVariant(NTTVariant variant);
+
+/**
+ * In-place forward NTT in the ring Z_q[X]/(X^n+1) with lazy (Harvey) butterflies.
+ *
+ * @param rootOfUnityTable is the table with the n-th root of unity powers in bit reverse order.
+ * @param preconRootOfUnityTable is the table with Shoup's precomputations for rootOfUnityTable.
+ * @param modulus is the prime modulus q.
+ * @param n is the ring dimension.
+ * @param[in,out] element is the input/output of the transform with entries in [0, q)
+ * ([0, 4q) is accepted when root > 1).
+ * @param root selects the twiddles w[root * m + i] for stage m and group i, see
+ * ForwardTransformToBitReverseInPlaceSIMD().
+ * @return false if the lazy variant is not selected, n < 16 or q >= 2^62, in which case the
+ * caller should run the standard code.
+ */
+bool ForwardTransformToBitReverseInPlaceLazy(const uint64_t* rootOfUnityTable, const uint64_t* preconRootOfUnityTable,
+                                             uint64_t modulus, uint32_t n, uint64_t* element, uint32_t root = 1);
+
+/**
+ * In-place inverse NTT in the ring Z_q[X]/(X^n+1) with lazy (Harvey) butterflies and the
+ * multiplication by n^{-1} fused into the final stage.
+ *
+ * @param rootOfUnityInverseTable is the table with the inverse 2n-th root of unity powers in bit reverse order.
+ * @param preconRootOfUnityInverseTable is the table with Shoup's precomputations for rootOfUnityInverseTable.
+ * @param cycloOrderInv is the inverse of n modulo q.
+ * @param preconCycloOrderInv is Shoup's precomputation for cycloOrderInv.
+ * @param modulus is the prime modulus q.
+ * @param n is the ring dimension.
+ * @param[in,out] element is the input/output of the transform with entries in [0, q).
+ * @param root selects the twiddles w[root * m + i] for stage m and group i, see
+ * InverseTransformFromBitReverseInPlaceSIMD().
+ * @return false if the lazy variant is not selected, n < 16 or q >= 2^62.
+ */
+bool InverseTransformFromBitReverseInPlaceLazy(const uint64_t* rootOfUnityInverseTable,
+                                               const uint64_t* preconRootOfUnityInverseTable, uint64_t cycloOrderInv,
+                                               uint64_t preconCycloOrderInv, uint64_t modulus, uint32_t n,
+                                               uint64_t* element, uint32_t root = 1);
+
+/**
+ * Cache-blocked in-place forward NTT for large rings (n >= 2^16) whose coefficients do not fit into
+ * L2. The vector is viewed as a 2^k x (n / 2^k) matrix with rows of 4096 coefficients: the first k
+ * stages are applied to one tile of columns at a time, the remaining stages to one row at a time,
+ * so each coefficient is brought into L1 twice instead of log(n) times. The result is bit-identical
+ * to the radix-2 transform.
+ *
+ * @param rootOfUnityTable is the bit-reversed table of powers of the root of unity.
+ * @param preconRootOfUnityTable is the table of Shoup precomputations for rootOfUnityTable.
+ * @param modulus is q.
+ * @param n is the ring dimension.
+ * @param[in,out] element is the input/output of the transform.
+ * @return false if the ring is too small, or the lazy variant is not selected or does not apply,
+ * in which case the caller should fall back to another implementation.
+ */
+bool ForwardTransformToBitReverseInPlaceBlocked(const uint64_t* rootOfUnityTable,
+                                                const uint64_t* preconRootOfUnityTable, uint64_t modulus, uint32_t n,
+                                                uint64_t* element);
+
+/**
+ * Cache-blocked in-place inverse NTT for large rings, see ForwardTransformToBitReverseInPlaceBlocked().
+ * The rows are transformed first, then the column tiles with the final stage fused with n^{-1}.
+ *
+ * @param rootOfUnityInverseTable is the bit-reversed table of powers of the inverse root of unity.
+ * @param preconRootOfUnityInverseTable is the table of Shoup precomputations for rootOfUnityInverseTable.
+ * @param cycloOrderInv is n^{-1} mod q.
+ * @param preconCycloOrderInv is the Shoup precomputation for cycloOrderInv.
+ * @param modulus is q.
+ * @param n is the ring dimension.
+ * @param[in,out] element is the input/output of the transform.
+ * @return false if the caller should fall back to another implementation.
+ */
+bool InverseTransformFromBitReverseInPlaceBlocked(const uint64_t* rootOfUnityInverseTable,
+                                                  const uint64_t* preconRootOfUnityInverseTable,
+                                                  uint64_t cycloOrderInv, uint64_t preconCycloOrderInv,
+                                                  uint64_t modulus, uint32_t n, uint64_t* element);
+
+/**
+ * @brief One RNS limb of a batched NTT: the twiddle tables (inverse tables for the INTT),
+ * n^{-1} for the INTT, the modulus and the coefficients.
+ */
+struct NTTBatchLimb {
+    const uint64_t* rootOfUnityTable;
+    const uint64_t* preconRootOfUnityTable;
+    uint64_t cycloOrderInv;
+    uint64_t preconCycloOrderInv;
+    uint64_t modulus;
+    uint64_t* element;
+};
+
+/**
+ * In-place forward NTT of several limbs of the same ring dimension, for the case where there are
+ * fewer limbs than OpenMP threads. The first k stages of every limb are run by all threads on
+ * disjoint column chunks as in ForwardTransformToBitReverseInPlaceBlocked(), after which each limb
+ * splits into 2^k independent rows that are finished by the SIMD or lazy kernel; k is chosen so
+ * that every thread gets work.
+ * The result is bit-identical to transforming each limb on its own.
+ *
+ * @param limbs are the limbs to transform.
+ * @param numLimbs is the number of limbs.
+ * @param n is the ring dimension.
+ * @return false if batching does not pay off (at least as many limbs as threads, nested parallel
+ * region, ring too small), or the lazy variant is not selected or does not apply, in which case the
+ * caller should transform the limbs one by one.
+ */
+bool ForwardTransformToBitReverseInPlaceBatch(const NTTBatchLimb* limbs, uint32_t numLimbs, uint32_t n);
+
+/**
+ * In-place inverse NTT of several limbs of the same ring dimension, see
+ * ForwardTransformToBitReverseInPlaceBatch(). The independent blocks are processed first and the
+ * last k stages, including the one fused with n^{-1}, are run cooperatively.
+ *
+ * @param limbs are the limbs to transform, with the inverse twiddle tables.
+ * @param numLimbs is the number of limbs.
+ * @param n is the ring dimension.
+ * @return false if the caller should transform the limbs one by one.
+ */
+bool InverseTransformFromBitReverseInPlaceBatch(const NTTBatchLimb* limbs, uint32_t numLimbs, uint32_t n);
+
+}  // namespace intnat
+
+#endif
@@ -0,0 +1,131 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+ This file contains the SIMD (AVX2/AVX-512 IFMA) NTT kernels for the native math backend
+*/
+
+#ifndef LBCRYPTO_MATH_HAL_INTNAT_TRANSFORMNAT_SIMD_H
+#define LBCRYPTO_MATH_HAL_INTNAT_TRANSFORMNAT_SIMD_H
+
+#include <cstdint>
+
+// The vectorized kernels are only built for x86-64 with GCC/Clang since they rely on
+// function-level target attributes and on __builtin_cpu_supports() for runtime dispatch
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(__EMSCRIPTEN__)
+    #define NTT_SIMD_AVAILABLE 1
+#else
+    #define NTT_SIMD_AVAILABLE 0
+#endif
+
+/**
+ * @namespace intnat
+ * The namespace of intnat
+ */
+namespace intnat {
+
+/**
+ * @brief NTT kernels that can be selected for the 64-bit native backend.
+ * NTT_KERNEL_AUTO picks the fastest kernel supported by the CPU at runtime.
+ */
+enum NTTKernel {
+    NTT_KERNEL_AUTO = 0,
+    NTT_KERNEL_SCALAR,
+    NTT_KERNEL_AVX2,
+    NTT_KERNEL_AVX512IFMA,
+};
+
+/**
+ * Checks whether the CPU the library runs on can execute the given kernel.
+ *
+ * @param kernel is the kernel to check.
+ * @return true if the kernel can be used.
+ */
+bool IsNTTKernelSupported(NTTKernel kernel);
+
+/**
+ * Gets the kernel used by the native NTT/INTT. Never returns NTT_KERNEL_AUTO.
+ */
+NTTKernel GetNTTKernel();
+
+/**
+ * Selects the kernel used by the native NTT/INTT. NTT_KERNEL_AUTO restores the
+ * CPUID-based choice. Throws if the kernel is not supported by the CPU.
+ *
+ * @param kernel is the kernel to use.
+ */
+void SetNTTKernel(NTTKernel kernel);
+
+/**
+ * In-place forward NTT in the ring Z_q[X]/(X^n+1) using the selected SIMD kernel.
+ * Butterflies are Harvey/Shoup butterflies that keep the values in [0, 4q) and
+ * reduce to [0, q) only after the final stage, so the output is bit-identical to
+ * the scalar NumberTheoreticTransformNat::ForwardTransformToBitReverseInPlace().
+ *
+ * @param rootOfUnityTable is the table with the n-th root of unity powers in bit reverse order.
+ * @param preconRootOfUnityTable is the table with Shoup's precomputations for rootOfUnityTable.
+ * @param modulus is the prime modulus q.
+ * @param n is the ring dimension.
+ * @param[in,out] element is the input/output of the transform with entries in [0, q)
+ * ([0, 4q) is accepted when root > 1).
+ * @param root selects the twiddles w[root * m + i] for stage m and group i. The default 1 is a
+ * complete NTT; root = 2^k + b runs the last log2(n) stages of an NTT of size 2^k * n on its b-th block.
+ * @return false if no SIMD kernel applies (scalar kernel selected, modulus or ring
+ * dimension out of range) and the caller should run the scalar code instead.
+ */
+bool ForwardTransformToBitReverseInPlaceSIMD(const uint64_t* rootOfUnityTable, const uint64_t* preconRootOfUnityTable,
+                                             uint64_t modulus, uint32_t n, uint64_t* element, uint32_t root = 1);
+
+/**
+ * In-place inverse NTT in the ring Z_q[X]/(X^n+1) using the selected SIMD kernel.
+ * Values are kept in [0, 2q) between stages and the final stage is fused with the
+ * multiplication by n^{-1}.
+ *
+ * @param rootOfUnityInverseTable is the table with the inverse 2n-th root of unity powers in bit reverse order.
+ * @param preconRootOfUnityInverseTable is the table with Shoup's precomputations for rootOfUnityInverseTable.
+ * @param cycloOrderInv is the inverse of n modulo q.
+ * @param preconCycloOrderInv is Shoup's precomputation for cycloOrderInv.
+ * @param modulus is the prime modulus q.
+ * @param n is the ring dimension.
+ * @param[in,out] element is the input/output of the transform with entries in [0, q).
+ * @param root selects the twiddles w[root * m + i] for stage m and group i. The default 1 is a
+ * complete INTT; root = 2^k + b runs the first log2(n) stages of an INTT of size 2^k * n on its
+ * b-th block, without the multiplication by n^{-1} and leaving the entries in [0, 2q).
+ * @return false if no SIMD kernel applies and the caller should run the scalar code instead.
+ */
+bool InverseTransformFromBitReverseInPlaceSIMD(const uint64_t* rootOfUnityInverseTable,
+                                               const uint64_t* preconRootOfUnityInverseTable, uint64_t cycloOrderInv,
+                                               uint64_t preconCycloOrderInv, uint64_t modulus, uint32_t n,
+                                               uint64_t* element, uint32_t root = 1);
+
+}  // namespace intnat
+
+#endif
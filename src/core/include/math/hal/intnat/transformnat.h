@@ -40,6 +40,7 @@
 
 #include "utils/inttypes.h"
 
+#include <atomic>
 #include <map>
 #include <mutex>
 #include <unordered_map>
@@ -241,6 +242,80 @@ public:
                                                VecType* element);
 };
 
+/**
+ * @brief Immutable negacyclic NTT precomputations for a single (modulus, cyclotomic order) pair.
+ *
+ * Holds the bit-reversed forward/inverse twiddle tables, their Shoup precomputations and n^{-1} mod q
+ * (with its precomputation) next to each other, so a transform needs a single pointer to reach every
+ * table it touches. Instances are created only by NTTTableRegistryNat and never modified afterwards.
+ */
+template <typename VecType>
+struct alignas(64) NTTTablesNat {
+    using IntType = typename VecType::Integer;
+
+    IntType modulus;
+    IntType rootOfUnity;
+    usint cycloOrder{0};
+    /// n^{-1} mod q and its Shoup precomputation (n = cycloOrder / 2)
+    IntType cycloOrderInv;
+    IntType cycloOrderInvPrecon;
+    /// forward and inverse twiddle factors in bit-reversed order
+    VecType rootOfUnityReverse;
+    VecType rootOfUnityInverseReverse;
+    /// Shoup's precomputations of the above twiddle tables
+    VecType rootOfUnityPreconReverse;
+    VecType rootOfUnityInversePreconReverse;
+};
+
+/**
+ * @brief Process-wide registry of NTTTablesNat keyed by (modulus, cyclotomic order).
+ *
+ * Lookups walk an append-only singly-linked list published with release/acquire atomics and never
+ * take a lock. Only the (rare) insertion of a new entry is serialized, so several crypto contexts can
+ * warm up the registry concurrently. Entries live until the process exits, which lets callers (e.g.
+ * ILParamsImpl) cache raw pointers to them.
+ */
+template <typename VecType>
+class NTTTableRegistryNat {
+    using IntType = typename VecType::Integer;
+
+public:
+    /**
+   * Returns the tables for (modulus, cycloOrder), building and registering them on first use.
+   *
+   * @param &rootOfUnity is the 2n-th root of unity in Z_q used to build the tables
+   * @param cycloOrder is 2n, a power of two
+   * @param &modulus is q, the prime modulus
+   * @return reference to the registered tables
+   */
+    static const NTTTablesNat<VecType>& GetTables(const IntType& rootOfUnity, usint cycloOrder,
+                                                  const IntType& modulus);
+
+    /**
+   * Looks up already registered tables without building them.
+   *
+   * @return pointer to the tables or nullptr if (modulus, cycloOrder) has not been registered yet
+   */
+    static const NTTTablesNat<VecType>* FindTables(usint cycloOrder, const IntType& modulus);
+
+private:
+    struct Node {
+        NTTTablesNat<VecType> tables;
+        const Node* next{nullptr};
+    };
+
+    static void BuildTables(const IntType& rootOfUnity, usint cycloOrder, const IntType& modulus,
+                            NTTTablesNat<VecType>& tables);
+
+    struct NodeList {
+        std::atomic<const Node*> head{nullptr};
+        std::mutex insertMutex;
+        ~NodeList();
+    };
+
+    static NodeList m_nodes;
+};
+
 /**
  * @brief Golden Chinese Remainder Transform FFT implementation.
  */
@@ -318,6 +393,46 @@ public:
    */
     void InverseTransformFromBitReverseInPlace(const IntType& rootOfUnity, const usint CycloOrder, VecType* element);
 
+    /**
+   * In-place Forward Transform using tables obtained from NTTTableRegistryNat. No map lookups are
+   * performed, so this is the preferred entry point when the caller caches the tables.
+   *
+   * @param &tables are the precomputed tables for the modulus and cyclotomic order of \p element
+   * @param[in,out] &element is the input/output of the transform of type VecType and length n.
+   */
+    void ForwardTransformToBitReverseInPlace(const NTTTablesNat<VecType>& tables, VecType* element);
+
+    /**
+   * In-place Inverse Transform using tables obtained from NTTTableRegistryNat.
+   *
+   * @param &tables are the precomputed tables for the modulus and cyclotomic order of \p element
+   * @param[in,out] &element is the input/output of the transform of type VecType and length n.
+   */
+    void InverseTransformFromBitReverseInPlace(const NTTTablesNat<VecType>& tables, VecType* element);
+
+    /**
+   * In-place Forward Transform of all towers of a DCRT polynomial at once, see
+   * intnat::ForwardTransformToBitReverseInPlaceBatch(). Only pays off when there are fewer towers
+   * than threads, as one transform is then split across several threads.
+   *
+   * @param &tables are the tables of each tower, all for the same cyclotomic order.
+   * @param &elements are the inputs/outputs of the transforms, one per entry in \p tables.
+   * @return false if nothing was done and the towers have to be transformed one by one.
+   */
+    bool ForwardTransformToBitReverseInPlaceBatch(const std::vector<const NTTTablesNat<VecType>*>& tables,
+                                                  const std::vector<VecType*>& elements);
+
+    /**
+   * In-place Inverse Transform of all towers of a DCRT polynomial at once, see
+   * intnat::InverseTransformFromBitReverseInPlaceBatch().
+   *
+   * @param &tables are the tables of each tower, all for the same cyclotomic order.
+   * @param &elements are the inputs/outputs of the transforms, one per entry in \p tables.
+   * @return false if nothing was done and the towers have to be transformed one by one.
+   */
+    bool InverseTransformFromBitReverseInPlaceBatch(const std::vector<const NTTTablesNat<VecType>*>& tables,
+                                                    const std::vector<VecType*>& elements);
+
     /**
    * Precomputation of root of unity tables for transforms in the ring
    * Z_q[X]/(X^n+1)
@@ -343,29 +458,10 @@ public:
     void PreCompute(std::vector<IntType>& rootOfUnity, const usint CycloOrder, std::vector<IntType>& moduliChain);
 
     /**
-   * Reset cached values for the root of unity tables to empty.
+   * Kept for interface compatibility. The root of unity tables are owned by NTTTableRegistryNat
+   * and are not released, as params may hold pointers to them.
    */
     void Reset();
-
-    /// map to store the cyclo order inverse with modulus as a key
-    /// For inverse FTT, we also need #m_cycloOrderInversePreconTableByModulus (this is to use an N-size NTT for FTT instead of 2N-size NTT).
-    static std::map<IntType, VecType> m_cycloOrderInverseTableByModulus;
-
-    /// map to store the cyclo order inverse preconditioned with modulus as a key
-    /// Shoup's precomputation of above #m_cycloOrderInverseTableByModulus
-    static std::map<IntType, VecType> m_cycloOrderInversePreconTableByModulus;
-
-    /// map to store the forward roots of Unity for NTT, with bits reversed, with modulus as a key (aka twiddle factors)
-    static std::map<IntType, VecType> m_rootOfUnityReverseTableByModulus;
-
-    /// map to store inverse roots of unity for iNTT, with bits reversed, with modulus as a key (aka inverse twiddle factors)
-    static std::map<IntType, VecType> m_rootOfUnityInverseReverseTableByModulus;
-
-    /// map to store Shoup's precomputations of forward roots of unity for NTT, with bits reversed, with modulus as a key
-    static std::map<IntType, VecType> m_rootOfUnityPreconReverseTableByModulus;
-
-    /// map to store Shoup's precomputations of inverse rou for iNTT, with bits reversed, with modulus as a key
-    static std::map<IntType, VecType> m_rootOfUnityInversePreconReverseTableByModulus;
 };
 
 // struct used as a key in BlueStein transform
@@ -41,8 +41,10 @@
 
 #include "utils/inttypes.h"
 
+#include <algorithm>
 #include <memory>
 #include <random>
+#include <vector>
 
 namespace lbcrypto {
 
@@ -58,15 +60,14 @@ VecType TernaryUniformGeneratorImpl<VecType>::GenerateVector(usint size, const t
 
     if (h == 0) {
         // regular ternary distribution
-
-        int32_t randomNumber;
-
+        std::vector<int32_t> values(size);
+        FillTernary(values.data(), size);
+        const typename VecType::Integer minusOne(modulus - typename VecType::Integer(1));
         for (usint i = 0; i < size; i++) {
-            randomNumber = m_distribution(PseudoRandomNumberGenerator::GetPRNG());
-            if (randomNumber < 0)
-                v[i] = modulus - typename VecType::Integer(1);
+            if (values[i] < 0)
+                v[i] = minusOne;
             else
-                v[i] = typename VecType::Integer(randomNumber);
+                v[i] = typename VecType::Integer(values[i]);
         }
     }
     else {
@@ -113,9 +114,7 @@ std::shared_ptr<int32_t> TernaryUniformGeneratorImpl<VecType>::GenerateIntVector
     std::shared_ptr<int32_t> ans(new int32_t[size], std::default_delete<int32_t[]>());
 
     if (h == 0) {
-        for (usint i = 0; i < size; i++) {
-            (ans.get())[i] = m_distribution(PseudoRandomNumberGenerator::GetPRNG());
-        }
+        FillTernary(ans.get(), size);
     }
     else {
         int32_t randomIndex;
@@ -156,6 +155,26 @@ std::shared_ptr<int32_t> TernaryUniformGeneratorImpl<VecType>::GenerateIntVector
     return ans;
 }
 
+template <typename VecType>
+void TernaryUniformGeneratorImpl<VecType>::FillTernary(int32_t* out, usint size) {
+    // each word is sliced into 32 two-bit values, of which 0, 1, 2 are accepted as -1, 0, 1 and 3 is
+    // rejected; the loop is branch-free as out[i] is overwritten after a rejection
+    uint64_t block[PRNG_FILL_WORDS];
+    auto& prng = PseudoRandomNumberGenerator::GetPRNG();
+    for (usint i = 0; i < size;) {
+        const usint words = std::min<usint>(PRNG_FILL_WORDS, (size - i) / 24 + 1);
+        PseudoRandomNumberGenerator::Fill(prng, block, words * sizeof(uint64_t));
+        for (usint w = 0; w < words && i < size; ++w) {
+            uint64_t x = block[w];
+            for (uint32_t k = 0; k < 32 && i < size; ++k, x >>= 2) {
+                const auto t = static_cast<int32_t>(x & 3);
+                out[i]       = t - 1;
+                i += (t != 3);
+            }
+        }
+    }
+}
+
 }  // namespace lbcrypto
 
 #endif
@@ -82,6 +82,9 @@ public:
     std::shared_ptr<int32_t> GenerateIntVector(usint size, usint h = 0) const;
 
 private:
+    // fills out with uniform values in {-1, 0, 1}
+    static void FillTernary(int32_t* out, usint size);
+
     static std::uniform_int_distribution<int> m_distribution;
 };
 
@@ -0,0 +1,221 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+#ifndef _ARENAALLOCATOR_H
+#define _ARENAALLOCATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+/*
+  Per-thread size-class arena for the large, power-of-two sized buffers that back the towers of
+  DCRT polynomials. While an ArenaScope is alive on a thread, buffers freed on that thread are kept
+  in a free list per size class and handed out again to the next allocation of the same size, so
+  loops that create and destroy the same temporaries (key switching, rotations) stop going through
+  malloc/free. When the outermost scope of the thread ends, the cached buffers are released. The
+  outermost scope of a thread outside of a parallel region extends to the threads of its OpenMP team,
+  which allocate most tower buffers in the parallel loops over the towers.
+
+  All buffers come from ::operator new with their exact size, so a buffer can be allocated inside a
+  scope and freed outside of it (or on another thread), and vice versa.
+
+  An allocator can also be bound to a chunk of an ArenaSlab, one aligned buffer shared by several
+  vectors (the towers of a contiguous DCRT polynomial): a vector of exactly the chunk size is then
+  placed into the chunk, and the slab is released with the last vector that refers to it. A slab can
+  also adopt external memory (a mapped file, a received message); vectors placed into it then keep
+  the values that are already there instead of being zeroed.
+ */
+
+/**
+ * @brief Allocates \p size bytes, from the arena of the calling thread if one is active.
+ */
+void* arena_malloc(size_t size);
+
+/**
+ * @brief Frees a buffer of \p size bytes obtained from arena_malloc(), keeping it in the arena of
+ * the calling thread if one is active.
+ */
+void arena_free(void* ptr, size_t size);
+
+/**
+ * @brief Number of bytes currently cached by the arena of the calling thread.
+ */
+size_t arena_cached_bytes();
+
+/**
+ * @brief RAII evaluation region: the arena of the calling thread is active while at least one
+ * ArenaScope is alive on it. Scopes nest; the cache is emptied when the outermost one ends. Opened
+ * outside of a parallel region, the outermost scope also activates the arenas of the OpenMP team.
+ */
+class ArenaScope {
+public:
+    ArenaScope();
+    ~ArenaScope();
+
+    ArenaScope(const ArenaScope&)            = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+    /**
+     * @brief Whether an ArenaScope is alive on the calling thread or on the thread whose team it joined.
+     */
+    static bool IsActive();
+};
+
+/**
+ * @brief One 64-byte aligned buffer that is split into chunks for several vectors.
+ */
+class ArenaSlab {
+public:
+    explicit ArenaSlab(size_t size);
+
+    /**
+     * @brief Adopts the \p size bytes at \p data, which stay alive as long as \p owner does.
+     */
+    ArenaSlab(char* data, size_t size, std::shared_ptr<void> owner);
+
+    ~ArenaSlab();
+
+    ArenaSlab(const ArenaSlab&)            = delete;
+    ArenaSlab& operator=(const ArenaSlab&) = delete;
+
+    char* data() const {
+        return m_data;
+    }
+
+    size_t size() const {
+        return m_size;
+    }
+
+    bool Contains(const void* ptr) const {
+        auto p = static_cast<const char*>(ptr);
+        return p >= m_data && p < m_data + m_size;
+    }
+
+    /**
+     * @brief Whether the slab adopted external memory.
+     */
+    bool IsExternal() const {
+        return m_external;
+    }
+
+private:
+    char* m_data;
+    size_t m_size;
+    bool m_external{false};
+    std::shared_ptr<void> m_owner{nullptr};
+};
+
+/**
+ * @brief STL allocator drawing from the per-thread arena, see arena_malloc(), or from a chunk of
+ * an ArenaSlab.
+ */
+template <typename T>
+class arena_allocator {
+public:
+    typedef T value_type;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    arena_allocator() = default;
+
+    /**
+     * @brief Binds the allocator to the \p size bytes at \p offset in \p slab.
+     */
+    arena_allocator(std::shared_ptr<ArenaSlab> slab, size_t offset, size_t size)
+        : m_slab{std::move(slab)}, m_offset{offset}, m_size{size}, m_keepValues{m_slab && m_slab->IsExternal()} {}
+
+    template <class U>
+    arena_allocator(const arena_allocator<U>& rhs)
+        : m_slab{rhs.m_slab}, m_offset{rhs.m_offset}, m_size{rhs.m_size}, m_keepValues{rhs.m_keepValues} {}
+
+    // copies of a vector get their own storage
+    arena_allocator select_on_container_copy_construction() const {
+        return arena_allocator();
+    }
+
+    T* allocate(size_t n) {
+        if (m_slab && n * sizeof(T) == m_size)
+            return reinterpret_cast<T*>(m_slab->data() + m_offset);
+        return static_cast<T*>(arena_malloc(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n) {
+        if (m_slab && m_slab->Contains(p))
+            return;
+        arena_free(p, n * sizeof(T));
+    }
+
+    // value-initialization, except for the elements placed into a chunk of external memory, which keep
+    // the values that are already there
+    template <typename U>
+    void construct(U* p) {
+        if (!m_keepValues || !InChunk(p))
+            ::new (static_cast<void*>(p)) U();
+    }
+
+    template <typename U, typename... Args>
+    void construct(U* p, Args&&... args) {
+        ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Allocators are equal if they can free each other's memory: those bound to the same slab, or
+     * both to none.
+     */
+    template <typename U>
+    bool operator==(const arena_allocator<U>& rhs) const {
+        return m_slab == rhs.m_slab;
+    }
+
+    template <typename U>
+    bool operator!=(const arena_allocator<U>& rhs) const {
+        return !(*this == rhs);
+    }
+
+private:
+    template <typename U>
+    friend class arena_allocator;
+
+    bool InChunk(const void* p) const {
+        auto chunk = m_slab->data() + m_offset;
+        return static_cast<const char*>(p) >= chunk && static_cast<const char*>(p) < chunk + m_size;
+    }
+
+    std::shared_ptr<ArenaSlab> m_slab{nullptr};
+    size_t m_offset{0};
+    size_t m_size{0};
+    bool m_keepValues{false};
+};
+
+#endif
@@ -0,0 +1,97 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+  PRNG engine based on AES-256 in counter mode
+ */
+
+#ifndef __AESCTRENGINE_H__
+#define __AESCTRENGINE_H__
+
+#include "utils/prng/counterengine.h"
+
+#include <array>
+#include <cstdint>
+
+namespace default_prng {
+/**
+ * @brief PRNG engine producing the keystream of AES-256 in counter mode (NIST SP 800-38A). It uses the
+ * AES instructions of x86-64 CPUs and is not available on other platforms: a table-based software AES
+ * would leak the key through cache timing.
+ */
+class AESCTREngine : public CounterModeEngine {
+public:
+    enum {
+        // 256-bit key followed by the 128-bit initial counter block
+        KEY_WORDS     = 8,
+        MAX_SEED_GENS = 12
+    };
+    using aes_seed_array_t = std::array<PRNG::result_type, MAX_SEED_GENS>;
+
+    /**
+     * @brief Main constructor taking the key and the initial counter block as a seed and a counter.
+     *        The counter is added to the initial counter block, which is incremented as a 128-bit
+     *        big-endian integer for every 16 bytes of output. If there is no value for the counter,
+     *        then pass zero as the counter value
+     */
+    AESCTREngine(const aes_seed_array_t& seed, uint64_t counter);
+
+    ~AESCTREngine() override;
+
+    /**
+     * @brief checks if the CPU has the AES instructions the engine requires
+     */
+    static bool IsSupported();
+
+protected:
+    void Generate(void* out) override;
+
+private:
+    // AES-256 round keys
+    alignas(16) std::array<uint8_t, 15 * 16> m_roundKeys{};
+
+    // the current counter block as a 128-bit integer
+    uint64_t m_ctrHi = 0;
+    uint64_t m_ctrLo = 0;
+};
+
+/**
+ * @brief createAESCTREngineInstance() generates an AESCTREngine object which is dynamically allocated. The
+ * key and the initial counter block are drawn from a freshly seeded Blake2Engine
+ * @return pointer to the generated AESCTREngine object
+ * @attention the caller is responsible for freeing the memory allocated by this function
+ **/
+PRNG* createAESCTREngineInstance();
+
+}  // namespace default_prng
+
+#endif
@@ -73,7 +73,7 @@ class Blake2Engine : public PRNG {
         // makes a call to the BLAKE2 generator only when the currently buffered values are all consumed precomputations and
         // done only once for the current buffer
         if (m_bufferIndex == 0)
-            Generate();
+            Generate(m_buffer.data());
 
         PRNG::result_type result = m_buffer[m_bufferIndex];
         m_bufferIndex++;
@@ -81,11 +81,17 @@ class Blake2Engine : public PRNG {
         return result;
     }
 
+    /**
+     * @brief bulk output of the same stream as operator(): the buffered samples are copied first, and
+     * whole blocks of PRNG_BUFFER_SIZE samples are hashed directly into the output
+     */
+    void Fill(void* buffer, size_t size) override;
+
  private:
     /**
-     * @brief The main call to blake2xb function
+     * @brief The main call to blake2xb function: writes the next PRNG_BUFFER_SIZE samples to out
      */
-    void Generate();
+    void Generate(void* out);
 
     // The vector to store random samples generated using the hash function
     std::array<PRNG::result_type, PRNG_BUFFER_SIZE> m_buffer{};
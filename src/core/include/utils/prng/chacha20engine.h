@@ -0,0 +1,87 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+  PRNG engine based on the ChaCha20 stream cipher
+ */
+
+#ifndef __CHACHA20ENGINE_H__
+#define __CHACHA20ENGINE_H__
+
+#include "utils/prng/counterengine.h"
+
+#include <array>
+#include <cstdint>
+
+namespace default_prng {
+/**
+ * @brief PRNG engine producing the keystream of ChaCha20 with a 64-bit block counter and a 64-bit nonce
+ * (the original variant of ChaCha). Eight blocks are computed at once with AVX2 when the CPU supports
+ * it, the portable implementation is used otherwise.
+ */
+class ChaCha20Engine : public CounterModeEngine {
+public:
+    enum {
+        // 256-bit key followed by the 64-bit nonce
+        KEY_WORDS     = 8,
+        MAX_SEED_GENS = 10
+    };
+    using chacha_seed_array_t = std::array<PRNG::result_type, MAX_SEED_GENS>;
+
+    /**
+     * @brief Main constructor taking the key and the nonce as a seed and a counter.
+     *        The counter is the initial block counter; it gets incremented for every 64 bytes of output.
+     *        If there is no value for the counter, then pass zero as the counter value
+     */
+    ChaCha20Engine(const chacha_seed_array_t& seed, uint64_t counter);
+
+    ~ChaCha20Engine() override;
+
+protected:
+    void Generate(void* out) override;
+
+private:
+    // the input block: constants, key, block counter and nonce
+    std::array<uint32_t, 16> m_state{};
+};
+
+/**
+ * @brief createChaCha20EngineInstance() generates a ChaCha20Engine object which is dynamically allocated.
+ * The key and the nonce are drawn from a freshly seeded Blake2Engine
+ * @return pointer to the generated ChaCha20Engine object
+ * @attention the caller is responsible for freeing the memory allocated by this function
+ **/
+PRNG* createChaCha20EngineInstance();
+
+}  // namespace default_prng
+
+#endif
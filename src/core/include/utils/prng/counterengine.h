@@ -0,0 +1,127 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+  Common buffering of the counter-mode PRNG engines (AES-CTR and ChaCha20)
+ */
+
+#ifndef __COUNTERENGINE_H__
+#define __COUNTERENGINE_H__
+
+#include "utils/prng/prng.h"
+#include "utils/memory.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace default_prng {
+/**
+ * @brief Base class of the counter-mode engines: the stream is the keystream of a block cipher or a
+ * stream cipher run on consecutive counter values. The keystream is produced in blocks of
+ * PRNG_BUFFER_SIZE samples by Generate(), which the derived class implements.
+ */
+class CounterModeEngine : public PRNG {
+public:
+    enum {
+        // the buffer stores 1024 samples of 32-bit integers
+        PRNG_BUFFER_SIZE = 1024
+    };
+
+    /**
+     * @brief main call to the PRNG
+     */
+    PRNG::result_type operator()() override {
+        if (m_bufferIndex == static_cast<size_t>(PRNG_BUFFER_SIZE))
+            m_bufferIndex = 0;
+
+        if (m_bufferIndex == 0)
+            Generate(m_buffer.data());
+
+        return m_buffer[m_bufferIndex++];
+    }
+
+    /**
+     * @brief bulk output of the same stream as operator(): the buffered samples are copied first, and
+     * whole blocks of PRNG_BUFFER_SIZE samples are generated directly into the output
+     */
+    void Fill(void* buffer, size_t size) override {
+        constexpr size_t sampleBytes = sizeof(PRNG::result_type);
+        constexpr size_t blockBytes  = PRNG_BUFFER_SIZE * sampleBytes;
+
+        auto* out = static_cast<uint8_t*>(buffer);
+        while (size > 0) {
+            if (m_bufferIndex == 0 || m_bufferIndex == static_cast<size_t>(PRNG_BUFFER_SIZE)) {
+                if (size >= blockBytes) {
+                    Generate(out);
+                    m_bufferIndex = PRNG_BUFFER_SIZE;
+                    out += blockBytes;
+                    size -= blockBytes;
+                    continue;
+                }
+                Generate(m_buffer.data());
+                m_bufferIndex = 0;
+            }
+            size_t bytes = std::min(size, (PRNG_BUFFER_SIZE - m_bufferIndex) * sampleBytes);
+            std::memcpy(out, m_buffer.data() + m_bufferIndex, bytes);
+            m_bufferIndex += (bytes + sampleBytes - 1) / sampleBytes;
+            out += bytes;
+            size -= bytes;
+        }
+    }
+
+protected:
+    CounterModeEngine() = default;
+
+    ~CounterModeEngine() override {
+        // IMPORTANT: the unconsumed samples are cleared for security reasons
+        lbcrypto::secure_memset(m_buffer.data(), 0, m_buffer.size() * sizeof(m_buffer[0]));
+    }
+
+    /**
+     * @brief writes the next PRNG_BUFFER_SIZE samples of the keystream to out
+     */
+    virtual void Generate(void* out) = 0;
+
+private:
+    // samples of the current keystream block
+    std::array<PRNG::result_type, PRNG_BUFFER_SIZE> m_buffer{};
+
+    // Index in m_buffer corresponding to the current PRNG sample
+    size_t m_bufferIndex = 0;
+};
+
+}  // namespace default_prng
+
+#endif
@@ -48,7 +48,9 @@
 #ifndef __PRNG_H__
 #define __PRNG_H__
 
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <limits>
 
 // ATTENTION (VERY IMPORTANT):
@@ -79,6 +81,27 @@ public:
     virtual result_type operator()() = 0;
     virtual ~PRNG()                  = default;
 
+    /**
+     * @brief fills a buffer with random bytes: the consecutive outputs of operator() in the native byte
+     * order; the bytes of the last output that do not fit are dropped. Engines can override it with a
+     * bulk implementation producing the same stream. External engines built against a version of this
+     * header without Fill() do not implement it, so the samplers call it through
+     * PseudoRandomNumberGenerator::Fill(), which uses operator() for external engines
+     * @param buffer the buffer to fill
+     * @param size the number of bytes
+     */
+    virtual void Fill(void* buffer, size_t size) {
+        auto* out = static_cast<unsigned char*>(buffer);
+        for (; size >= sizeof(result_type); size -= sizeof(result_type), out += sizeof(result_type)) {
+            result_type r = (*this)();
+            std::memcpy(out, &r, sizeof(r));
+        }
+        if (size != 0) {
+            result_type r = (*this)();
+            std::memcpy(out, &r, size);
+        }
+    }
+
 protected:
     PRNG() = default;
 };
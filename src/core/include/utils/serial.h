@@ -69,6 +69,7 @@
 #include "cereal/archives/portable_binary.hpp"
 #include "cereal/archives/json.hpp"
 #include "cereal/cereal.hpp"
+#include "cereal/types/array.hpp"
 #include "cereal/types/map.hpp"
 #include "cereal/types/memory.hpp"
 #include "cereal/types/polymorphic.hpp"
@@ -0,0 +1,115 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+  This code provides the constant-time sampling from a cumulative distribution table used by
+  DiscreteGaussianGeneratorImpl for small standard deviations
+ */
+
+#include "math/discretegaussiangenerator.h"
+
+#include <cstdint>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(__EMSCRIPTEN__)
+    #define DGG_CDT_AVX2_AVAILABLE
+    #include <immintrin.h>
+#endif
+
+namespace lbcrypto {
+
+namespace {
+
+constexpr uint64_t CDT_MAGNITUDE_MASK = (uint64_t(1) << 63) - 1;
+
+void SampleCDTScalar(const uint64_t* table, uint32_t size, const uint64_t* rand, int64_t* out, uint32_t count) {
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint64_t u = rand[i] & CDT_MAGNITUDE_MASK;
+        // |x| is the number of thresholds not above u
+        int64_t mag = 0;
+        for (uint32_t k = 0; k < size; ++k)
+            mag += static_cast<int64_t>(table[k] <= u);
+        // negated if the sign bit is set: (mag ^ -1) + 1 == -mag
+        const int64_t sign = -static_cast<int64_t>(rand[i] >> 63);
+        out[i]             = (mag ^ sign) - sign;
+    }
+}
+
+#if defined(DGG_CDT_AVX2_AVAILABLE)
+// 16 samples per pass over the table; the thresholds and u are below 2^63, so the signed comparison of
+// AVX2 is exact
+__attribute__((target("avx2"))) void SampleCDTAVX2(const uint64_t* table, uint32_t size, const uint64_t* rand,
+                                                   int64_t* out, uint32_t count) {
+    constexpr uint32_t VECS  = 4;
+    constexpr uint32_t BATCH = 4 * VECS;
+    const __m256i maskMag    = _mm256_set1_epi64x(static_cast<int64_t>(CDT_MAGNITUDE_MASK));
+    const __m256i zero       = _mm256_setzero_si256();
+    const __m256i sizeVec    = _mm256_set1_epi64x(size);
+
+    uint32_t i = 0;
+    for (; i + BATCH <= count; i += BATCH) {
+        __m256i u[VECS], mag[VECS];
+        for (uint32_t v = 0; v < VECS; ++v) {
+            u[v]   = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(rand + i + 4 * v)), maskMag);
+            mag[v] = sizeVec;
+        }
+        // every threshold above u subtracts one (the comparison yields -1)
+        for (uint32_t k = 0; k < size; ++k) {
+            const __m256i t = _mm256_set1_epi64x(static_cast<int64_t>(table[k]));
+            for (uint32_t v = 0; v < VECS; ++v)
+                mag[v] = _mm256_add_epi64(mag[v], _mm256_cmpgt_epi64(t, u[v]));
+        }
+        for (uint32_t v = 0; v < VECS; ++v) {
+            // all ones if the sign bit is set
+            const __m256i sign = _mm256_cmpgt_epi64(
+                zero, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rand + i + 4 * v)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + 4 * v),
+                                _mm256_sub_epi64(_mm256_xor_si256(mag[v], sign), sign));
+        }
+    }
+    SampleCDTScalar(table, size, rand + i, out + i, count - i);
+}
+#endif  // DGG_CDT_AVX2_AVAILABLE
+
+}  // namespace
+
+void SampleCDT(const uint64_t* table, uint32_t size, const uint64_t* rand, int64_t* out, uint32_t count) {
+#if defined(DGG_CDT_AVX2_AVAILABLE)
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    if (avx2) {
+        SampleCDTAVX2(table, size, rand, out, count);
+        return;
+    }
+#endif
+    SampleCDTScalar(table, size, rand, out, count);
+}
+
+}  // namespace lbcrypto
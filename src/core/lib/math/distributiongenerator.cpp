@@ -35,9 +35,12 @@
  */
 
 #include "math/distributiongenerator.h"
+#include "utils/prng/aesctrengine.h"
 #include "utils/prng/blake2engine.h"
+#include "utils/prng/chacha20engine.h"
 #include "utils/exception.h"
 
+#include <atomic>
 #include <iostream>
 #if (defined(__linux__) || defined(__unix__)) && !defined(__APPLE__) && defined(__GNUC__) && !defined(__clang__)
     #include <dlfcn.h>
@@ -47,10 +50,16 @@ namespace lbcrypto {
 
 #if defined(WITH_OPENMP)
     std::shared_ptr<PRNG> PseudoRandomNumberGenerator::m_prng = nullptr;
+    uint32_t PseudoRandomNumberGenerator::m_prngEpoch         = 0;
 #else
     thread_local std::shared_ptr<PRNG> m_prng = nullptr;
+    thread_local uint32_t m_prngEpoch         = 0;
 #endif
 PseudoRandomNumberGenerator::GenPRNGEngineFuncPtr PseudoRandomNumberGenerator::genPRNGEngine = nullptr;
+bool PseudoRandomNumberGenerator::externalEngine                                             = false;
+
+// incremented by SetPRNGEngine(): the thread-specific engines created before are replaced
+static std::atomic<uint32_t> prngEngineEpoch{0};
 
 void PseudoRandomNumberGenerator::InitPRNGEngine(const std::string& libPath) {
     if (genPRNGEngine)  // if genPRNGEngine has already been initialized
@@ -83,6 +92,7 @@ void PseudoRandomNumberGenerator::InitPRNGEngine(const std::string& libPath) {
             dlclose(libraryHandle);
             OPENFHE_THROW(errMsg);
         }
+        externalEngine = true;
         std::cerr << __FUNCTION__ << ": using external PRNG" << std::endl;
 #else
         OPENFHE_THROW("OpenFHE may use an external PRNG library linked with g++ on Linux only");
@@ -90,9 +100,35 @@ void PseudoRandomNumberGenerator::InitPRNGEngine(const std::string& libPath) {
     }
 }
 
+void PseudoRandomNumberGenerator::SetPRNGEngine(PRNGEngineType engine) {
+    GenPRNGEngineFuncPtr gen = nullptr;
+    switch (engine) {
+        case PRNG_BLAKE2:
+            gen = default_prng::createEngineInstance;
+            break;
+        case PRNG_AES_CTR:
+            if (!default_prng::AESCTREngine::IsSupported())
+                OPENFHE_THROW("The AES-CTR PRNG engine requires a CPU with the AES instructions");
+            gen = default_prng::createAESCTREngineInstance;
+            break;
+        case PRNG_CHACHA20:
+            gen = default_prng::createChaCha20EngineInstance;
+            break;
+        default:
+            OPENFHE_THROW("Unknown PRNG engine type");
+    }
+#pragma omp critical
+    {
+        genPRNGEngine  = gen;
+        externalEngine = false;
+        prngEngineEpoch++;
+    }
+}
+
 PRNG& PseudoRandomNumberGenerator::GetPRNG() {
     // initialization of PRNGs
-    if (m_prng == nullptr) {
+    const uint32_t epoch = prngEngineEpoch.load(std::memory_order_acquire);
+    if (m_prng == nullptr || m_prngEpoch != epoch) {
 #pragma omp critical
         {
             // we would like to believe that the block of code below is a good defense line
@@ -104,6 +140,7 @@ PRNG& PseudoRandomNumberGenerator::GetPRNG() {
             m_prng = std::shared_ptr<PRNG>(genPRNGEngine());
             if (!m_prng)
                 OPENFHE_THROW("Cannot create a PRNG engine");
+            m_prngEpoch = prngEngineEpoch.load(std::memory_order_acquire);
         }  // pragma omp critical
     }
     return *m_prng;
@@ -0,0 +1,177 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  This code provides the cache-blocked RNS base conversion for the native math backend
+ */
+
+#include "math/hal/intnat/baseconvnat.h"
+
+#include "utils/parallel.h"
+#include "utils/utilities-int.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace intnat {
+
+namespace {
+
+#if defined(HAVE_INT128) && (NATIVEINT == 64)
+
+// the scaled inputs and the accumulators of one block of coefficients should fit into 32KB of L1
+constexpr uint32_t BASECONV_BLOCK_BYTES = (1 << 15);
+constexpr uint32_t BASECONV_MIN_BLOCK   = 16;
+constexpr uint32_t BASECONV_MAX_BLOCK   = 1024;
+
+inline uint32_t BitLength(uint64_t x) {
+    uint32_t len = 0;
+    for (; x != 0; x >>= 1)
+        ++len;
+    return len;
+}
+
+// x * w mod q in [0, q) with Shoup's precomputation floor(w * 2^64 / q)
+inline uint64_t MulShoup(uint64_t x, uint64_t w, uint64_t wPrecon, uint64_t q) {
+    auto hi = static_cast<uint64_t>((static_cast<unsigned __int128>(x) * wPrecon) >> 64);
+    auto r  = x * w - hi * q;
+    return (r >= q) ? r - q : r;
+}
+
+// Number of coefficients converted per block, a power of two
+uint32_t BlockSize(uint32_t sizeQ, uint32_t n) {
+    const uint32_t bytesPerCoeff = sizeQ * sizeof(uint64_t) + sizeof(unsigned __int128) + sizeof(double);
+    uint32_t block               = BASECONV_MAX_BLOCK;
+    while (block > BASECONV_MIN_BLOCK && block * bytesPerCoeff > BASECONV_BLOCK_BYTES)
+        block >>= 1;
+    return std::min(block, n);
+}
+
+void ConvertBlock(const BaseConvTables& tables, const uint64_t* const* x, uint64_t* const* y, uint32_t first,
+                  uint32_t len, uint32_t chunk, uint64_t* scaled, unsigned __int128* sum, double* nu) {
+    const uint32_t sizeQ = tables.sizeQ;
+    const uint32_t sizeP = tables.sizeP;
+
+    // [x_i (Q/q_i)^{-1}]_{q_i} for all limbs of the block
+    for (uint32_t i = 0; i < sizeQ; ++i) {
+        const uint64_t* xi = x[i] + first;
+        uint64_t* si       = scaled + i * len;
+        const uint64_t qi  = tables.q[i];
+        const uint64_t wi  = tables.QHatInvModq[i];
+        const uint64_t wPi = tables.QHatInvModqPrecon[i];
+        for (uint32_t r = 0; r < len; ++r)
+            si[r] = MulShoup(xi[r], wi, wPi, qi);
+    }
+
+    // the number of q-overflows, summed in the same order as in the coefficient-wise code
+    if (tables.qInv != nullptr) {
+        std::fill(nu, nu + len, 0.5);
+        for (uint32_t i = 0; i < sizeQ; ++i) {
+            const uint64_t* si = scaled + i * len;
+            const double qInvi = tables.qInv[i];
+            for (uint32_t r = 0; r < len; ++r)
+                nu[r] += static_cast<double>(si[r]) * qInvi;
+        }
+    }
+
+    for (uint32_t j = 0; j < sizeP; ++j) {
+        const uint64_t pj          = tables.p[j];
+        const DoubleNativeInt& muj = tables.modpBarrettMu[j];
+        std::fill(sum, sum + len, 0);
+        for (uint32_t i0 = 0; i0 < sizeQ; i0 += chunk) {
+            const uint32_t i1 = std::min(sizeQ, i0 + chunk);
+            for (uint32_t i = i0; i < i1; ++i) {
+                const uint64_t* si = scaled + i * len;
+                const uint64_t c   = tables.QHatModp[i * sizeP + j];
+                for (uint32_t r = 0; r < len; ++r)
+                    sum[r] += static_cast<unsigned __int128>(si[r]) * c;
+            }
+            // fold the partial sums before they can overflow
+            if (i1 < sizeQ) {
+                for (uint32_t r = 0; r < len; ++r)
+                    sum[r] = lbcrypto::BarrettUint128ModUint64(sum[r], pj, muj);
+            }
+        }
+        uint64_t* yj = y[j] + first;
+        if (tables.qInv == nullptr) {
+            for (uint32_t r = 0; r < len; ++r)
+                yj[r] = lbcrypto::BarrettUint128ModUint64(sum[r], pj, muj);
+        }
+        else {
+            for (uint32_t r = 0; r < len; ++r) {
+                const uint64_t v     = lbcrypto::BarrettUint128ModUint64(sum[r], pj, muj);
+                const uint64_t alpha = tables.alphaQModp[static_cast<size_t>(nu[r]) * sizeP + j];
+                yj[r]                = (v >= alpha) ? v - alpha : v + pj - alpha;
+            }
+        }
+    }
+}
+
+#endif  // HAVE_INT128 && NATIVEINT == 64
+
+}  // namespace
+
+bool FastBaseConvert(const BaseConvTables& tables, const uint64_t* const* x, uint64_t* const* y, uint32_t n) {
+#if defined(HAVE_INT128) && (NATIVEINT == 64)
+    const uint32_t sizeQ = tables.sizeQ;
+    if (sizeQ == 0 || tables.sizeP == 0 || n == 0)
+        return true;
+
+    // products of (bitsQ + bitsP) bits: 2^(128 - bitsQ - bitsP) - 1 of them can be added to a folded sum
+    uint64_t maxQ = *std::max_element(tables.q, tables.q + sizeQ);
+    uint64_t maxP = *std::max_element(tables.p, tables.p + tables.sizeP);
+    uint32_t bits = BitLength(maxQ) + BitLength(maxP);
+    if (bits > 126)
+        return false;
+    uint32_t chunk = (bits <= 96) ? sizeQ : std::min(sizeQ, (uint32_t(1) << (128 - bits)) - 1);
+
+    const uint32_t block   = BlockSize(sizeQ, n);
+    const uint32_t nBlocks = (n + block - 1) / block;
+
+    #pragma omp parallel num_threads(lbcrypto::OpenFHEParallelControls.GetThreadLimit(std::min(nBlocks, uint32_t(8))))
+    {
+        std::vector<uint64_t> scaled(size_t(sizeQ) * block);
+        std::vector<unsigned __int128> sum(block);
+        std::vector<double> nu(tables.qInv != nullptr ? block : 0);
+    #pragma omp for schedule(static)
+        for (uint32_t b = 0; b < nBlocks; ++b) {
+            const uint32_t first = b * block;
+            ConvertBlock(tables, x, y, first, std::min(block, n - first), chunk, scaled.data(), sum.data(),
+                         nu.data());
+        }
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+}  // namespace intnat
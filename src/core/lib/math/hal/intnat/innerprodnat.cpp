@@ -0,0 +1,216 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  This code provides the fused multiply-accumulate kernel of the key switching inner product for the native math backend
+ */
+
+#include "math/hal/intnat/innerprodnat.h"
+
+#include "math/hal/basicint.h"
+#include "math/hal/intnat/transformnat-simd.h"
+#include "math/nbtheory.h"
+#include "utils/utilities-int.h"
+
+#include <algorithm>
+
+#if NTT_SIMD_AVAILABLE
+    #include <immintrin.h>
+#endif
+
+namespace intnat {
+
+namespace {
+
+#if defined(HAVE_INT128) && (NATIVEINT == 64)
+
+// the two accumulators of one block take 16KB and leave room in L1 for the streamed inputs
+constexpr uint32_t INNERPROD_BLOCK = 512;
+
+// below this bound the products of two residues fit into 62 bits and are accumulated in 64-bit lanes
+constexpr uint64_t INNERPROD_SMALL_MAX_MODULUS = (uint64_t(1) << 31);
+
+// sumA += x * a, sumB += x * b for residues of less than 32 bits, the key components a and b in 64-bit words or
+// packed into 32-bit ones
+template <typename KeyWord>
+void AccumulateSmall(const uint64_t* x, const KeyWord* a, const KeyWord* b, uint64_t* sumA, uint64_t* sumB,
+                     uint32_t len) {
+    for (uint32_t r = 0; r < len; ++r) {
+        sumA[r] += x[r] * a[r];
+        sumB[r] += x[r] * b[r];
+    }
+}
+
+    #if NTT_SIMD_AVAILABLE
+// the same with 4 lanes; _mm256_mul_epu32 multiplies the low 32 bits of the 64-bit words
+__attribute__((target("avx2"))) void AccumulateSmallAVX2(const uint64_t* x, const uint64_t* a, const uint64_t* b,
+                                                          uint64_t* sumA, uint64_t* sumB, uint32_t len) {
+    uint32_t r = 0;
+    for (; r + 4 <= len; r += 4) {
+        __m256i xr = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + r));
+        __m256i ar = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + r));
+        __m256i br = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + r));
+        __m256i sa = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sumA + r));
+        __m256i sb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sumB + r));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(sumA + r), _mm256_add_epi64(sa, _mm256_mul_epu32(xr, ar)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(sumB + r), _mm256_add_epi64(sb, _mm256_mul_epu32(xr, br)));
+    }
+    AccumulateSmall(x + r, a + r, b + r, sumA + r, sumB + r, len - r);
+}
+
+// the same with packed key components, widened to 64-bit lanes on loading
+__attribute__((target("avx2"))) void AccumulateSmallAVX2(const uint64_t* x, const uint32_t* a, const uint32_t* b,
+                                                          uint64_t* sumA, uint64_t* sumB, uint32_t len) {
+    uint32_t r = 0;
+    for (; r + 4 <= len; r += 4) {
+        __m256i xr = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + r));
+        __m256i ar = _mm256_cvtepu32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + r)));
+        __m256i br = _mm256_cvtepu32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(b + r)));
+        __m256i sa = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sumA + r));
+        __m256i sb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sumB + r));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(sumA + r), _mm256_add_epi64(sa, _mm256_mul_epu32(xr, ar)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(sumB + r), _mm256_add_epi64(sb, _mm256_mul_epu32(xr, br)));
+    }
+    AccumulateSmall(x + r, a + r, b + r, sumA + r, sumB + r, len - r);
+}
+    #endif
+
+// FastInnerProduct() for q < 2^31, the ring moduli of FHEW/TFHE
+template <typename KeyWord>
+void InnerProductSmall(const uint64_t* const* x, const KeyWord* const* a, const KeyWord* const* b, uint32_t count,
+                       uint64_t q, uint64_t* ya, uint64_t* yb, uint32_t n) {
+    void (*accumulate)(const uint64_t*, const KeyWord*, const KeyWord*, uint64_t*, uint64_t*, uint32_t) =
+        AccumulateSmall<KeyWord>;
+    #if NTT_SIMD_AVAILABLE
+    static const bool useAVX2 = __builtin_cpu_supports("avx2");
+    if (useAVX2)
+        accumulate = AccumulateSmallAVX2;
+    #endif
+
+    // (q - 1)^2 < 2^62, so at least 4 products can be added to a folded sum
+    const uint64_t maxProduct = (q - 1) * (q - 1);
+    const uint32_t chunk      = static_cast<uint32_t>(std::min<uint64_t>(count, ~uint64_t(0) / maxProduct - 1));
+    const DoubleNativeInt mu  = ~DoubleNativeInt(0) / q;
+
+    uint64_t sumA[INNERPROD_BLOCK];
+    uint64_t sumB[INNERPROD_BLOCK];
+    for (uint32_t first = 0; first < n; first += INNERPROD_BLOCK) {
+        const uint32_t len = std::min(INNERPROD_BLOCK, n - first);
+        std::fill(sumA, sumA + len, 0);
+        std::fill(sumB, sumB + len, 0);
+        for (uint32_t j0 = 0; j0 < count; j0 += chunk) {
+            const uint32_t j1 = std::min(count, j0 + chunk);
+            for (uint32_t j = j0; j < j1; ++j)
+                accumulate(x[j] + first, a[j] + first, b[j] + first, sumA, sumB, len);
+            // fold the partial sums before they can overflow
+            if (j1 < count) {
+                for (uint32_t r = 0; r < len; ++r) {
+                    sumA[r] = lbcrypto::BarrettUint128ModUint64(sumA[r], q, mu);
+                    sumB[r] = lbcrypto::BarrettUint128ModUint64(sumB[r], q, mu);
+                }
+            }
+        }
+        for (uint32_t r = 0; r < len; ++r) {
+            ya[first + r] = lbcrypto::BarrettUint128ModUint64(sumA[r], q, mu);
+            yb[first + r] = lbcrypto::BarrettUint128ModUint64(sumB[r], q, mu);
+        }
+    }
+}
+
+#endif  // HAVE_INT128 && NATIVEINT == 64
+
+}  // namespace
+
+bool FastInnerProduct(const uint64_t* const* x, const uint64_t* const* a, const uint64_t* const* b, uint32_t count,
+                      uint64_t q, uint64_t* ya, uint64_t* yb, uint32_t n) {
+#if defined(HAVE_INT128) && (NATIVEINT == 64)
+    if (q < INNERPROD_SMALL_MAX_MODULUS) {
+        InnerProductSmall(x, a, b, count, q, ya, yb, n);
+        return true;
+    }
+
+    // products of 2 * bitsQ bits: 2^(128 - 2 * bitsQ) - 1 of them can be added to a folded sum
+    uint32_t bits = 2 * lbcrypto::GetMSB64(q);
+    if (bits > 126)
+        return false;
+    uint32_t chunk = (bits <= 96) ? count : std::min(count, (uint32_t(1) << (128 - bits)) - 1);
+
+    // floor((2^128 - 1) / q) equals floor(2^128 / q) as q is not a power of two
+    const DoubleNativeInt mu = ~DoubleNativeInt(0) / q;
+
+    unsigned __int128 sumA[INNERPROD_BLOCK];
+    unsigned __int128 sumB[INNERPROD_BLOCK];
+    for (uint32_t first = 0; first < n; first += INNERPROD_BLOCK) {
+        const uint32_t len = std::min(INNERPROD_BLOCK, n - first);
+        std::fill(sumA, sumA + len, 0);
+        std::fill(sumB, sumB + len, 0);
+        for (uint32_t j0 = 0; j0 < count; j0 += chunk) {
+            const uint32_t j1 = std::min(count, j0 + chunk);
+            for (uint32_t j = j0; j < j1; ++j) {
+                const uint64_t* xj = x[j] + first;
+                const uint64_t* aj = a[j] + first;
+                const uint64_t* bj = b[j] + first;
+                for (uint32_t r = 0; r < len; ++r) {
+                    sumA[r] += static_cast<unsigned __int128>(xj[r]) * aj[r];
+                    sumB[r] += static_cast<unsigned __int128>(xj[r]) * bj[r];
+                }
+            }
+            // fold the partial sums before they can overflow
+            if (j1 < count) {
+                for (uint32_t r = 0; r < len; ++r) {
+                    sumA[r] = lbcrypto::BarrettUint128ModUint64(sumA[r], q, mu);
+                    sumB[r] = lbcrypto::BarrettUint128ModUint64(sumB[r], q, mu);
+                }
+            }
+        }
+        for (uint32_t r = 0; r < len; ++r) {
+            ya[first + r] = lbcrypto::BarrettUint128ModUint64(sumA[r], q, mu);
+            yb[first + r] = lbcrypto::BarrettUint128ModUint64(sumB[r], q, mu);
+        }
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool FastInnerProduct(const uint64_t* const* x, const uint32_t* const* a, const uint32_t* const* b, uint32_t count,
+                      uint64_t q, uint64_t* ya, uint64_t* yb, uint32_t n) {
+#if defined(HAVE_INT128) && (NATIVEINT == 64)
+    if (q < INNERPROD_SMALL_MAX_MODULUS) {
+        InnerProductSmall(x, a, b, count, q, ya, yb, n);
+        return true;
+    }
+#endif
+    return false;
+}
+
+}  // namespace intnat
@@ -0,0 +1,412 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  This code provides the lazy-reduction (Harvey) scalar NTT/INTT for the native math backend
+ */
+
+#include "math/hal/intnat/transformnat-lazy.h"
+#include "math/hal/intnat/shoupnat.h"
+#include "math/hal/intnat/transformnat-simd.h"
+#include "math/hal/basicint.h"
+
+#include "utils/exception.h"
+#include "utils/parallel.h"
+
+#include <atomic>
+#include <vector>
+
+#ifdef PARALLEL
+    #include <omp.h>
+#endif
+
+namespace intnat {
+
+namespace {
+
+// for tiny rings the call overhead outweighs the saved reductions
+constexpr uint32_t NTT_LAZY_MIN_DIM = 16;
+
+// values in [0, 4q) have to fit into 64-bit words
+constexpr uint64_t NTT_LAZY_MAX_MODULUS = (uint64_t(1) << 62);
+
+// smallest block a batched NTT is split into; smaller blocks cost more in synchronization than they save
+constexpr uint32_t NTT_BATCH_MIN_BLOCK = 1024;
+
+// ring dimension from which the coefficients and both twiddle tables no longer fit into L2 and a
+// single transform is cache-blocked
+constexpr uint32_t NTT_BLOCKED_MIN_DIM = (1 << 16);
+
+// rows of the cache-blocked transform (32KB) fit into L1, column tiles of its first stages (64KB) into L2
+constexpr uint32_t NTT_BLOCKED_BLOCK = (1 << 12);
+constexpr uint32_t NTT_BLOCKED_TILE  = (1 << 13);
+
+std::atomic<int> selectedNTTVariant{NTT_VARIANT_HARVEY_LAZY};
+
+#if defined(HAVE_INT128)
+
+inline uint64_t ReduceOnce(uint64_t x, uint64_t c) {
+    return (x >= c) ? x - c : x;
+}
+
+void ForwardTransformLazy(const uint64_t* w, const uint64_t* wPrecon, uint64_t q, uint32_t n, uint32_t root,
+                          uint64_t* element) {
+    const uint64_t q2 = q << 1;
+    // all stages but the last one: inputs in [0, 4q), outputs in [0, 4q)
+    for (uint32_t m{1}, t{n >> 1}; t > 1; m <<= 1, t >>= 1) {
+        for (uint32_t i{0}; i < m; ++i) {
+            const uint64_t omega       = w[root * m + i];
+            const uint64_t preconOmega = wPrecon[root * m + i];
+            uint64_t* x                = element + ((2 * i) * t);
+            uint64_t* y                = x + t;
+            for (uint32_t j{0}; j < t; ++j) {
+                uint64_t loVal = ReduceOnce(x[j], q2);
+                uint64_t hiVal = MulShoupLazy(y[j], omega, preconOmega, q);
+                x[j]           = loVal + hiVal;
+                y[j]           = loVal - hiVal + q2;
+            }
+        }
+    }
+    // last stage with the only full reduction to [0, q)
+    for (uint32_t i{0}, m{n >> 1}; i < m; ++i) {
+        uint64_t loVal     = ReduceOnce(element[2 * i], q2);
+        uint64_t hiVal     = MulShoupLazy(element[2 * i + 1], w[root * m + i], wPrecon[root * m + i], q);
+        element[2 * i]     = ReduceOnce(ReduceOnce(loVal + hiVal, q2), q);
+        element[2 * i + 1] = ReduceOnce(ReduceOnce(loVal - hiVal + q2, q2), q);
+    }
+}
+
+void InverseTransformLazy(const uint64_t* w, const uint64_t* wPrecon, uint64_t cycloOrderInv,
+                          uint64_t preconCycloOrderInv, uint64_t q, uint32_t n, uint32_t root, uint64_t* element) {
+    const uint64_t q2 = q << 1;
+    // all stages but the last one: inputs in [0, 2q), outputs in [0, 2q); a block of a larger
+    // INTT (root > 1) also runs the m = 1 stage here and stops
+    const uint32_t mEnd = (root == 1) ? 1 : 0;
+    for (uint32_t m{n >> 1}, t{1}; m > mEnd; m >>= 1, t <<= 1) {
+        for (uint32_t i{0}; i < m; ++i) {
+            const uint64_t omega       = w[root * m + i];
+            const uint64_t preconOmega = wPrecon[root * m + i];
+            uint64_t* x                = element + ((2 * i) * t);
+            uint64_t* y                = x + t;
+            for (uint32_t j{0}; j < t; ++j) {
+                uint64_t loVal = x[j];
+                uint64_t hiVal = y[j];
+                x[j]           = ReduceOnce(loVal + hiVal, q2);
+                y[j]           = MulShoupLazy(loVal - hiVal + q2, omega, preconOmega, q);
+            }
+        }
+    }
+    if (root != 1)
+        return;
+
+    // last stage with n^{-1} folded into the twiddles: the upper half uses omega_1^{-1} * n^{-1}
+    // and the lower half n^{-1} itself, so no separate scaling pass is needed
+    uint64_t omega1Inv       = ReduceOnce(MulShoupLazy(w[1], cycloOrderInv, preconCycloOrderInv, q), q);
+    uint64_t preconOmega1Inv = PrecomputeShoup(omega1Inv, q);
+    uint32_t half            = n >> 1;
+    for (uint32_t j{0}; j < half; ++j) {
+        uint64_t loVal    = element[j];
+        uint64_t hiVal    = element[j + half];
+        element[j]        = ReduceOnce(MulShoupLazy(loVal + hiVal, cycloOrderInv, preconCycloOrderInv, q), q);
+        element[j + half] = ReduceOnce(MulShoupLazy(loVal - hiVal + q2, omega1Inv, preconOmega1Inv, q), q);
+    }
+}
+
+// The first k stages of the forward transform restricted to the columns [jBegin, jEnd) of element
+// viewed as a 2^k x (n / 2^k) matrix: the butterflies of these stages never leave a column, and
+// what is left afterwards are independent transforms of the rows. Inputs and outputs in [0, 4q).
+void ForwardColumnStages(const uint64_t* w, const uint64_t* wPrecon, uint64_t q, uint32_t n, uint32_t k,
+                         uint32_t jBegin, uint32_t jEnd, uint64_t* element) {
+    const uint64_t q2   = q << 1;
+    const uint32_t cols = n >> k;
+    for (uint32_t m{1}, t{n >> 1}; m < (uint32_t(1) << k); m <<= 1, t >>= 1) {
+        for (uint32_t i{0}; i < m; ++i) {
+            const uint64_t omega       = w[m + i];
+            const uint64_t preconOmega = wPrecon[m + i];
+            uint64_t* x                = element + ((2 * i) * t);
+            uint64_t* y                = x + t;
+            for (uint32_t r{0}; r < t; r += cols) {
+                for (uint32_t j{r + jBegin}, jr{r + jEnd}; j < jr; ++j) {
+                    uint64_t loVal = ReduceOnce(x[j], q2);
+                    uint64_t hiVal = MulShoupLazy(y[j], omega, preconOmega, q);
+                    x[j]           = loVal + hiVal;
+                    y[j]           = loVal - hiVal + q2;
+                }
+            }
+        }
+    }
+}
+
+// The last k stages of the inverse transform restricted to the columns [jBegin, jEnd), see
+// ForwardColumnStages(). The final stage is fused with n^{-1}: inputs in [0, 2q), outputs in [0, q).
+void InverseColumnStages(const uint64_t* w, const uint64_t* wPrecon, uint64_t cycloOrderInv,
+                         uint64_t preconCycloOrderInv, uint64_t omega1Inv, uint64_t preconOmega1Inv, uint64_t q,
+                         uint32_t n, uint32_t k, uint32_t jBegin, uint32_t jEnd, uint64_t* element) {
+    const uint64_t q2   = q << 1;
+    const uint32_t cols = n >> k;
+    for (uint32_t m{(uint32_t(1) << k) >> 1}, t{cols}; m > 1; m >>= 1, t <<= 1) {
+        for (uint32_t i{0}; i < m; ++i) {
+            const uint64_t omega       = w[m + i];
+            const uint64_t preconOmega = wPrecon[m + i];
+            uint64_t* x                = element + ((2 * i) * t);
+            uint64_t* y                = x + t;
+            for (uint32_t r{0}; r < t; r += cols) {
+                for (uint32_t j{r + jBegin}, jr{r + jEnd}; j < jr; ++j) {
+                    uint64_t loVal = x[j];
+                    uint64_t hiVal = y[j];
+                    x[j]           = ReduceOnce(loVal + hiVal, q2);
+                    y[j]           = MulShoupLazy(loVal - hiVal + q2, omega, preconOmega, q);
+                }
+            }
+        }
+    }
+    uint64_t* x = element;
+    uint64_t* y = element + (n >> 1);
+    for (uint32_t r{0}; r < (n >> 1); r += cols) {
+        for (uint32_t j{r + jBegin}, jr{r + jEnd}; j < jr; ++j) {
+            uint64_t loVal = x[j];
+            uint64_t hiVal = y[j];
+            x[j]           = ReduceOnce(MulShoupLazy(loVal + hiVal, cycloOrderInv, preconCycloOrderInv, q), q);
+            y[j]           = ReduceOnce(MulShoupLazy(loVal - hiVal + q2, omega1Inv, preconOmega1Inv, q), q);
+        }
+    }
+}
+
+// Row b of the 2^k x (n / 2^k) matrix of ForwardColumnStages(), by the SIMD kernel if there is one
+void ForwardTransformRow(const uint64_t* w, const uint64_t* wPrecon, uint64_t q, uint32_t n, uint32_t k, uint32_t b,
+                         uint64_t* element) {
+    const uint32_t rowSize = n >> k;
+    const uint32_t root    = (uint32_t(1) << k) + b;
+    uint64_t* row          = element + b * rowSize;
+    if (!ForwardTransformToBitReverseInPlaceSIMD(w, wPrecon, q, rowSize, row, root))
+        ForwardTransformLazy(w, wPrecon, q, rowSize, root, row);
+}
+
+// Row b of the 2^k x (n / 2^k) matrix of InverseColumnStages(), by the SIMD kernel if there is one
+void InverseTransformRow(const uint64_t* w, const uint64_t* wPrecon, uint64_t cycloOrderInv,
+                         uint64_t preconCycloOrderInv, uint64_t q, uint32_t n, uint32_t k, uint32_t b,
+                         uint64_t* element) {
+    const uint32_t rowSize = n >> k;
+    const uint32_t root    = (uint32_t(1) << k) + b;
+    uint64_t* row          = element + b * rowSize;
+    if (!InverseTransformFromBitReverseInPlaceSIMD(w, wPrecon, cycloOrderInv, preconCycloOrderInv, q, rowSize, row,
+                                                   root))
+        InverseTransformLazy(w, wPrecon, cycloOrderInv, preconCycloOrderInv, q, rowSize, root, row);
+}
+
+// Number k of stages run cooperatively by the batched NTT, 0 if batching does not pay off
+uint32_t BatchSplitStages(const NTTBatchLimb* limbs, uint32_t numLimbs, uint32_t n) {
+    if (numLimbs == 0 || GetNTTVariant() != NTT_VARIANT_HARVEY_LAZY)
+        return 0;
+    #ifdef PARALLEL
+    uint32_t threads = omp_in_parallel() ? 1 : static_cast<uint32_t>(omp_get_max_threads());
+    #else
+    uint32_t threads = 1;
+    #endif
+    if (numLimbs >= threads)
+        return 0;
+    for (uint32_t l = 0; l < numLimbs; ++l) {
+        if (limbs[l].modulus >= NTT_LAZY_MAX_MODULUS)
+            return 0;
+    }
+    uint32_t k = 0;
+    while ((numLimbs << k) < threads && (n >> (k + 1)) >= NTT_BATCH_MIN_BLOCK)
+        ++k;
+    return k;
+}
+
+#endif  // HAVE_INT128
+
+}  // namespace
+
+NTTVariant GetNTTVariant() {
+    return static_cast<NTTVariant>(selectedNTTVariant.load(std::memory_order_relaxed));
+}
+
+void SetNTTVariant(NTTVariant variant) {
+    if (variant != NTT_VARIANT_STANDARD && variant != NTT_VARIANT_HARVEY_LAZY)
+        OPENFHE_THROW("Unknown NTT variant");
+    selectedNTTVariant.store(variant, std::memory_order_relaxed);
+}
+
+bool ForwardTransformToBitReverseInPlaceLazy(const uint64_t* rootOfUnityTable, const uint64_t* preconRootOfUnityTable,
+                                             uint64_t modulus, uint32_t n, uint64_t* element, uint32_t root) {
+#if defined(HAVE_INT128)
+    if (n < NTT_LAZY_MIN_DIM || modulus >= NTT_LAZY_MAX_MODULUS || GetNTTVariant() != NTT_VARIANT_HARVEY_LAZY)
+        return false;
+    ForwardTransformLazy(rootOfUnityTable, preconRootOfUnityTable, modulus, n, root, element);
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool InverseTransformFromBitReverseInPlaceLazy(const uint64_t* rootOfUnityInverseTable,
+                                               const uint64_t* preconRootOfUnityInverseTable, uint64_t cycloOrderInv,
+                                               uint64_t preconCycloOrderInv, uint64_t modulus, uint32_t n,
+                                               uint64_t* element, uint32_t root) {
+#if defined(HAVE_INT128)
+    if (n < NTT_LAZY_MIN_DIM || modulus >= NTT_LAZY_MAX_MODULUS || GetNTTVariant() != NTT_VARIANT_HARVEY_LAZY)
+        return false;
+    InverseTransformLazy(rootOfUnityInverseTable, preconRootOfUnityInverseTable, cycloOrderInv, preconCycloOrderInv,
+                         modulus, n, root, element);
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool ForwardTransformToBitReverseInPlaceBlocked(const uint64_t* rootOfUnityTable,
+                                                const uint64_t* preconRootOfUnityTable, uint64_t modulus, uint32_t n,
+                                                uint64_t* element) {
+#if defined(HAVE_INT128)
+    if (n < NTT_BLOCKED_MIN_DIM || modulus >= NTT_LAZY_MAX_MODULUS || GetNTTVariant() != NTT_VARIANT_HARVEY_LAZY)
+        return false;
+    uint32_t k = 0;
+    while ((n >> k) > NTT_BLOCKED_BLOCK)
+        ++k;
+    const uint32_t cols = n >> k;
+    const uint32_t tile = NTT_BLOCKED_TILE >> k;
+    for (uint32_t j = 0; j < cols; j += tile)
+        ForwardColumnStages(rootOfUnityTable, preconRootOfUnityTable, modulus, n, k, j, j + tile, element);
+    for (uint32_t b = 0; b < (uint32_t(1) << k); ++b)
+        ForwardTransformRow(rootOfUnityTable, preconRootOfUnityTable, modulus, n, k, b, element);
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool InverseTransformFromBitReverseInPlaceBlocked(const uint64_t* rootOfUnityInverseTable,
+                                                  const uint64_t* preconRootOfUnityInverseTable,
+                                                  uint64_t cycloOrderInv, uint64_t preconCycloOrderInv,
+                                                  uint64_t modulus, uint32_t n, uint64_t* element) {
+#if defined(HAVE_INT128)
+    if (n < NTT_BLOCKED_MIN_DIM || modulus >= NTT_LAZY_MAX_MODULUS || GetNTTVariant() != NTT_VARIANT_HARVEY_LAZY)
+        return false;
+    uint32_t k = 0;
+    while ((n >> k) > NTT_BLOCKED_BLOCK)
+        ++k;
+    const uint32_t cols = n >> k;
+    const uint32_t tile = NTT_BLOCKED_TILE >> k;
+    for (uint32_t b = 0; b < (uint32_t(1) << k); ++b)
+        InverseTransformRow(rootOfUnityInverseTable, preconRootOfUnityInverseTable, cycloOrderInv,
+                            preconCycloOrderInv, modulus, n, k, b, element);
+    uint64_t omega1Inv =
+        ReduceOnce(MulShoupLazy(rootOfUnityInverseTable[1], cycloOrderInv, preconCycloOrderInv, modulus), modulus);
+    uint64_t preconOmega1Inv = PrecomputeShoup(omega1Inv, modulus);
+    for (uint32_t j = 0; j < cols; j += tile)
+        InverseColumnStages(rootOfUnityInverseTable, preconRootOfUnityInverseTable, cycloOrderInv,
+                            preconCycloOrderInv, omega1Inv, preconOmega1Inv, modulus, n, k, j, j + tile, element);
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool ForwardTransformToBitReverseInPlaceBatch(const NTTBatchLimb* limbs, uint32_t numLimbs, uint32_t n) {
+#if defined(HAVE_INT128)
+    const uint32_t k = BatchSplitStages(limbs, numLimbs, n);
+    if (k == 0)
+        return false;
+
+    // each limb is a 2^k x (n / 2^k) matrix: the columns are cut into 2^k chunks for the first k
+    // stages, after which the rows are independent
+    const uint32_t chunks     = numLimbs << k;
+    const uint32_t blockCount = uint32_t(1) << k;
+    const uint32_t chunkCols  = (n >> k) >> k;
+    #pragma omp parallel num_threads(lbcrypto::OpenFHEParallelControls.GetThreadLimit(chunks))
+    {
+    #pragma omp for schedule(static)
+        for (uint32_t c = 0; c < chunks; ++c) {
+            const NTTBatchLimb& limb = limbs[c >> k];
+            const uint32_t j         = (c & (blockCount - 1)) * chunkCols;
+            ForwardColumnStages(limb.rootOfUnityTable, limb.preconRootOfUnityTable, limb.modulus, n, k, j,
+                                j + chunkCols, limb.element);
+        }
+    #pragma omp for schedule(static)
+        for (uint32_t c = 0; c < chunks; ++c) {
+            const NTTBatchLimb& limb = limbs[c >> k];
+            ForwardTransformRow(limb.rootOfUnityTable, limb.preconRootOfUnityTable, limb.modulus, n, k,
+                                c & (blockCount - 1), limb.element);
+        }
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool InverseTransformFromBitReverseInPlaceBatch(const NTTBatchLimb* limbs, uint32_t numLimbs, uint32_t n) {
+#if defined(HAVE_INT128)
+    const uint32_t k = BatchSplitStages(limbs, numLimbs, n);
+    if (k == 0)
+        return false;
+
+    // (omega_1^{-1} * n^{-1}) mod q per limb for the final stage
+    std::vector<uint64_t> omega1Inv(numLimbs);
+    std::vector<uint64_t> preconOmega1Inv(numLimbs);
+    for (uint32_t l = 0; l < numLimbs; ++l) {
+        const NTTBatchLimb& limb = limbs[l];
+        omega1Inv[l] = ReduceOnce(MulShoupLazy(limb.rootOfUnityTable[1], limb.cycloOrderInv,
+                                               limb.preconCycloOrderInv, limb.modulus),
+                                  limb.modulus);
+        preconOmega1Inv[l] = PrecomputeShoup(omega1Inv[l], limb.modulus);
+    }
+
+    const uint32_t chunks     = numLimbs << k;
+    const uint32_t blockCount = uint32_t(1) << k;
+    const uint32_t chunkCols  = (n >> k) >> k;
+    #pragma omp parallel num_threads(lbcrypto::OpenFHEParallelControls.GetThreadLimit(chunks))
+    {
+    #pragma omp for schedule(static)
+        for (uint32_t c = 0; c < chunks; ++c) {
+            const NTTBatchLimb& limb = limbs[c >> k];
+            InverseTransformRow(limb.rootOfUnityTable, limb.preconRootOfUnityTable, limb.cycloOrderInv,
+                                limb.preconCycloOrderInv, limb.modulus, n, k, c & (blockCount - 1), limb.element);
+        }
+    #pragma omp for schedule(static)
+        for (uint32_t c = 0; c < chunks; ++c) {
+            const uint32_t l         = c >> k;
+            const NTTBatchLimb& limb = limbs[l];
+            const uint32_t j         = (c & (blockCount - 1)) * chunkCols;
+            InverseColumnStages(limb.rootOfUnityTable, limb.preconRootOfUnityTable, limb.cycloOrderInv,
+                                limb.preconCycloOrderInv, omega1Inv[l], preconOmega1Inv[l], limb.modulus, n, k, j,
+                                j + chunkCols, limb.element);
+        }
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+}  // namespace intnat
@@ -0,0 +1,596 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  This code provides the AVX2 and AVX-512 IFMA NTT/INTT kernels for the native math backend
+ */
+
+#include "math/hal/intnat/transformnat-simd.h"
+#include "math/hal/intnat/shoupnat.h"
+
+#include "utils/exception.h"
+
+#include <atomic>
+#include <utility>
+
+#if NTT_SIMD_AVAILABLE
+    #include <immintrin.h>
+
+    // _mm512_undefined_epi32() used inside of several AVX-512 intrinsics triggers a false positive in GCC 12
+    #if defined(__GNUC__) && !defined(__clang__)
+        #pragma GCC diagnostic push
+        #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    #endif
+
+    #define NTT_TARGET_AVX2      __attribute__((target("avx2")))
+    #define NTT_TARGET_AVX512IFMA __attribute__((target("avx512f,avx512ifma")))
+#endif
+
+namespace intnat {
+
+namespace {
+
+// smallest ring dimension for which the vectorized kernels are used
+constexpr uint32_t NTT_SIMD_MIN_DIM = 16;
+
+// the lazy values in [0, 4q) have to stay below 2^63 for the signed AVX2 comparisons and
+// have to fit into 52-bit words for IFMA
+constexpr uint64_t NTT_AVX2_MAX_MODULUS = (uint64_t(1) << 61);
+constexpr uint64_t NTT_IFMA_MAX_MODULUS = (uint64_t(1) << 50);
+// below this bound the lazy values in [0, 4q) fit into 32 bits and the AVX2 kernel multiplies
+// with single 32 x 32 -> 64 bit multiplications
+constexpr uint64_t NTT_AVX2_SMALL_MAX_MODULUS = (uint64_t(1) << 30);
+
+std::atomic<int> selectedNTTKernel{NTT_KERNEL_AUTO};
+
+NTTKernel DetectNTTKernel() {
+    if (IsNTTKernelSupported(NTT_KERNEL_AVX512IFMA))
+        return NTT_KERNEL_AVX512IFMA;
+    if (IsNTTKernelSupported(NTT_KERNEL_AVX2))
+        return NTT_KERNEL_AVX2;
+    return NTT_KERNEL_SCALAR;
+}
+
+#if NTT_SIMD_AVAILABLE
+
+// (omega_1^{-1} * n^{-1}) mod q and its Shoup's precomputation, used in the final INTT stage
+inline std::pair<uint64_t, uint64_t> ComputeOmega1Inv(uint64_t omega1, uint64_t cycloOrderInv,
+                                                      uint64_t preconCycloOrderInv, uint64_t q) {
+    uint64_t omega1Inv = MulShoupLazy(omega1, cycloOrderInv, preconCycloOrderInv, q);
+    if (omega1Inv >= q)
+        omega1Inv -= q;
+    return {omega1Inv, PrecomputeShoup(omega1Inv, q)};
+}
+
+/*
+ * AVX2 kernel: 4 x 64-bit lanes. AVX2 has no 64-bit multiplier, so the low and high
+ * halves of the 64x64 products are assembled from 32x32 -> 64 bit multiplications.
+ * Moduli below 2^30 (the ring moduli of FHEW/TFHE) get an instantiation that works with
+ * 32-bit operands, where each modular product costs three multiplications instead of ten.
+ */
+
+NTT_TARGET_AVX2 inline __m256i MulLo64AVX2(__m256i a, __m256i b) {
+    __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b),
+                                     _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+    return _mm256_add_epi64(_mm256_mul_epu32(a, b), _mm256_slli_epi64(cross, 32));
+}
+
+NTT_TARGET_AVX2 inline __m256i MulHi64AVX2(__m256i a, __m256i b) {
+    const __m256i mask32 = _mm256_set1_epi64x(0xFFFFFFFF);
+    __m256i aHi          = _mm256_srli_epi64(a, 32);
+    __m256i bHi          = _mm256_srli_epi64(b, 32);
+    __m256i lolo         = _mm256_mul_epu32(a, b);
+    __m256i t            = _mm256_add_epi64(_mm256_mul_epu32(aHi, b), _mm256_srli_epi64(lolo, 32));
+    __m256i u            = _mm256_add_epi64(_mm256_mul_epu32(a, bHi), _mm256_and_si256(t, mask32));
+    __m256i hihi         = _mm256_mul_epu32(aHi, bHi);
+    return _mm256_add_epi64(hihi, _mm256_add_epi64(_mm256_srli_epi64(t, 32), _mm256_srli_epi64(u, 32)));
+}
+
+// x * w mod q in [0, 2q). With Small (q < 2^30, so x, w < 2^32) wPrecon is the 32-bit Shoup's
+// precomputation floor(w * 2^32 / q) and every product is a single 32 x 32 -> 64 bit multiplication.
+template <bool Small>
+NTT_TARGET_AVX2 inline __m256i MulShoupAVX2(__m256i x, __m256i w, __m256i wPrecon, __m256i q) {
+    if (Small) {
+        __m256i hi = _mm256_srli_epi64(_mm256_mul_epu32(x, wPrecon), 32);
+        return _mm256_sub_epi64(_mm256_mul_epu32(x, w), _mm256_mul_epu32(hi, q));
+    }
+    return _mm256_sub_epi64(MulLo64AVX2(x, w), MulLo64AVX2(MulHi64AVX2(x, wPrecon), q));
+}
+
+// converts the 64-bit Shoup's precomputations floor(w * 2^64 / q) into the ones used by MulShoupAVX2
+template <bool Small>
+NTT_TARGET_AVX2 inline __m256i PreconAVX2(__m256i wPrecon) {
+    return Small ? _mm256_srli_epi64(wPrecon, 32) : wPrecon;
+}
+
+template <bool Small>
+inline uint64_t PreconAVX2(uint64_t wPrecon) {
+    return Small ? (wPrecon >> 32) : wPrecon;
+}
+
+// x >= c ? x - c : x; all values are below 2^63, so the signed comparison is safe
+NTT_TARGET_AVX2 inline __m256i ReduceAVX2(__m256i x, __m256i c) {
+    return _mm256_sub_epi64(x, _mm256_andnot_si256(_mm256_cmpgt_epi64(c, x), c));
+}
+
+// Cooley-Tukey butterfly: [0, 4q) x [0, 4q) -> [0, 4q) x [0, 4q)
+template <bool Small>
+NTT_TARGET_AVX2 inline void ForwardButterflyAVX2(__m256i& x, __m256i& y, __m256i w, __m256i wPrecon, __m256i q,
+                                                 __m256i q2) {
+    x         = ReduceAVX2(x, q2);
+    __m256i t = MulShoupAVX2<Small>(y, w, wPrecon, q);
+    y         = _mm256_add_epi64(_mm256_sub_epi64(x, t), q2);
+    x         = _mm256_add_epi64(x, t);
+}
+
+// Gentleman-Sande butterfly: [0, 2q) x [0, 2q) -> [0, 2q) x [0, 2q)
+template <bool Small>
+NTT_TARGET_AVX2 inline void InverseButterflyAVX2(__m256i& x, __m256i& y, __m256i w, __m256i wPrecon, __m256i q,
+                                                 __m256i q2) {
+    __m256i d = _mm256_add_epi64(_mm256_sub_epi64(x, y), q2);
+    x         = ReduceAVX2(_mm256_add_epi64(x, y), q2);
+    y         = MulShoupAVX2<Small>(d, w, wPrecon, q);
+}
+
+NTT_TARGET_AVX2 inline __m256i LoadAVX2(const uint64_t* p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+
+NTT_TARGET_AVX2 inline void StoreAVX2(uint64_t* p, __m256i v) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+}
+
+template <bool Small>
+NTT_TARGET_AVX2 void ForwardTransformAVX2(const uint64_t* w, const uint64_t* wPrecon, uint64_t modulus, uint32_t n,
+                                          uint32_t root, uint64_t* element) {
+    const __m256i q{_mm256_set1_epi64x(modulus)};
+    const __m256i q2{_mm256_set1_epi64x(modulus << 1)};
+
+    uint32_t m{1};
+    for (uint32_t t{n >> 1}; t >= 4; m <<= 1, t >>= 1) {
+        for (uint32_t i{0}; i < m; ++i) {
+            const __m256i omega{_mm256_set1_epi64x(w[root * m + i])};
+            const __m256i preconOmega{_mm256_set1_epi64x(PreconAVX2<Small>(wPrecon[root * m + i]))};
+            uint64_t* lo{element + 2 * i * t};
+            uint64_t* hi{lo + t};
+            for (uint32_t j{0}; j < t; j += 4) {
+                __m256i x{LoadAVX2(lo + j)};
+                __m256i y{LoadAVX2(hi + j)};
+                ForwardButterflyAVX2<Small>(x, y, omega, preconOmega, q, q2);
+                StoreAVX2(lo + j, x);
+                StoreAVX2(hi + j, y);
+            }
+        }
+    }
+
+    // t = 2: two butterfly blocks per 8 words, x = [a0 a1 a4 a5], y = [a2 a3 a6 a7]
+    for (uint32_t i{0}; i < m; i += 2) {
+        uint64_t* p{element + 4 * i};
+        __m256i v0{LoadAVX2(p)};
+        __m256i v1{LoadAVX2(p + 4)};
+        __m256i x{_mm256_permute2x128_si256(v0, v1, 0x20)};
+        __m256i y{_mm256_permute2x128_si256(v0, v1, 0x31)};
+        __m256i omega{_mm256_permute4x64_epi64(LoadAVX2(w + root * m + i), _MM_SHUFFLE(1, 1, 0, 0))};
+        __m256i preconOmega{
+            _mm256_permute4x64_epi64(PreconAVX2<Small>(LoadAVX2(wPrecon + root * m + i)), _MM_SHUFFLE(1, 1, 0, 0))};
+        ForwardButterflyAVX2<Small>(x, y, omega, preconOmega, q, q2);
+        StoreAVX2(p, _mm256_permute2x128_si256(x, y, 0x20));
+        StoreAVX2(p + 4, _mm256_permute2x128_si256(x, y, 0x31));
+    }
+    m <<= 1;
+
+    // t = 1: four butterfly blocks per 8 words, x = [a0 a4 a2 a6], y = [a1 a5 a3 a7];
+    // the final reduction to [0, q) is merged into this stage
+    for (uint32_t i{0}; i < m; i += 4) {
+        uint64_t* p{element + 2 * i};
+        __m256i v0{LoadAVX2(p)};
+        __m256i v1{LoadAVX2(p + 4)};
+        __m256i x{_mm256_unpacklo_epi64(v0, v1)};
+        __m256i y{_mm256_unpackhi_epi64(v0, v1)};
+        __m256i omega{_mm256_permute4x64_epi64(LoadAVX2(w + root * m + i), _MM_SHUFFLE(3, 1, 2, 0))};
+        __m256i preconOmega{
+            _mm256_permute4x64_epi64(PreconAVX2<Small>(LoadAVX2(wPrecon + root * m + i)), _MM_SHUFFLE(3, 1, 2, 0))};
+        ForwardButterflyAVX2<Small>(x, y, omega, preconOmega, q, q2);
+        x = ReduceAVX2(ReduceAVX2(x, q2), q);
+        y = ReduceAVX2(ReduceAVX2(y, q2), q);
+        StoreAVX2(p, _mm256_unpacklo_epi64(x, y));
+        StoreAVX2(p + 4, _mm256_unpackhi_epi64(x, y));
+    }
+}
+
+template <bool Small>
+NTT_TARGET_AVX2 void InverseTransformAVX2(const uint64_t* w, const uint64_t* wPrecon, uint64_t cycloOrderInv,
+                                          uint64_t preconCycloOrderInv, uint64_t modulus, uint32_t n, uint32_t root,
+                                          uint64_t* element) {
+    const __m256i q{_mm256_set1_epi64x(modulus)};
+    const __m256i q2{_mm256_set1_epi64x(modulus << 1)};
+
+    // t = 1
+    uint32_t m{n >> 1};
+    for (uint32_t i{0}; i < m; i += 4) {
+        uint64_t* p{element + 2 * i};
+        __m256i v0{LoadAVX2(p)};
+        __m256i v1{LoadAVX2(p + 4)};
+        __m256i x{_mm256_unpacklo_epi64(v0, v1)};
+        __m256i y{_mm256_unpackhi_epi64(v0, v1)};
+        __m256i omega{_mm256_permute4x64_epi64(LoadAVX2(w + root * m + i), _MM_SHUFFLE(3, 1, 2, 0))};
+        __m256i preconOmega{
+            _mm256_permute4x64_epi64(PreconAVX2<Small>(LoadAVX2(wPrecon + root * m + i)), _MM_SHUFFLE(3, 1, 2, 0))};
+        InverseButterflyAVX2<Small>(x, y, omega, preconOmega, q, q2);
+        StoreAVX2(p, _mm256_unpacklo_epi64(x, y));
+        StoreAVX2(p + 4, _mm256_unpackhi_epi64(x, y));
+    }
+    m >>= 1;
+
+    // t = 2
+    for (uint32_t i{0}; i < m; i += 2) {
+        uint64_t* p{element + 4 * i};
+        __m256i v0{LoadAVX2(p)};
+        __m256i v1{LoadAVX2(p + 4)};
+        __m256i x{_mm256_permute2x128_si256(v0, v1, 0x20)};
+        __m256i y{_mm256_permute2x128_si256(v0, v1, 0x31)};
+        __m256i omega{_mm256_permute4x64_epi64(LoadAVX2(w + root * m + i), _MM_SHUFFLE(1, 1, 0, 0))};
+        __m256i preconOmega{
+            _mm256_permute4x64_epi64(PreconAVX2<Small>(LoadAVX2(wPrecon + root * m + i)), _MM_SHUFFLE(1, 1, 0, 0))};
+        InverseButterflyAVX2<Small>(x, y, omega, preconOmega, q, q2);
+        StoreAVX2(p, _mm256_permute2x128_si256(x, y, 0x20));
+        StoreAVX2(p + 4, _mm256_permute2x128_si256(x, y, 0x31));
+    }
+    m >>= 1;
+
+    // a block of a larger INTT (root > 1) also runs the m = 1 stage as a regular stage
+    const uint32_t mEnd{(root == 1) ? 1u : 0u};
+    for (uint32_t t{4}; m > mEnd; m >>= 1, t <<= 1) {
+        for (uint32_t i{0}; i < m; ++i) {
+            const __m256i omega{_mm256_set1_epi64x(w[root * m + i])};
+            const __m256i preconOmega{_mm256_set1_epi64x(PreconAVX2<Small>(wPrecon[root * m + i]))};
+            uint64_t* lo{element + 2 * i * t};
+            uint64_t* hi{lo + t};
+            for (uint32_t j{0}; j < t; j += 4) {
+                __m256i x{LoadAVX2(lo + j)};
+                __m256i y{LoadAVX2(hi + j)};
+                InverseButterflyAVX2<Small>(x, y, omega, preconOmega, q, q2);
+                StoreAVX2(lo + j, x);
+                StoreAVX2(hi + j, y);
+            }
+        }
+    }
+
+    if (root != 1)
+        return;
+
+    // final stage fused with the multiplication by n^{-1} and the reduction to [0, q)
+    auto [omega1Inv, preconOmega1Inv] = ComputeOmega1Inv(w[1], cycloOrderInv, preconCycloOrderInv, modulus);
+    const __m256i nInv{_mm256_set1_epi64x(cycloOrderInv)};
+    const __m256i preconNInv{_mm256_set1_epi64x(PreconAVX2<Small>(preconCycloOrderInv))};
+    const __m256i omega{_mm256_set1_epi64x(omega1Inv)};
+    const __m256i preconOmega{_mm256_set1_epi64x(PreconAVX2<Small>(preconOmega1Inv))};
+    const uint32_t t{n >> 1};
+    for (uint32_t j{0}; j < t; j += 4) {
+        __m256i x{LoadAVX2(element + j)};
+        __m256i y{LoadAVX2(element + j + t)};
+        __m256i d{_mm256_add_epi64(_mm256_sub_epi64(x, y), q2)};
+        x = MulShoupAVX2<Small>(_mm256_add_epi64(x, y), nInv, preconNInv, q);
+        y = MulShoupAVX2<Small>(d, omega, preconOmega, q);
+        StoreAVX2(element + j, ReduceAVX2(x, q));
+        StoreAVX2(element + j + t, ReduceAVX2(y, q));
+    }
+}
+
+/*
+ * AVX-512 IFMA kernel: 8 x 52-bit lanes using the 52-bit multiply-add instructions.
+ * The 52-bit Shoup's precomputation floor(w * 2^52 / q) is derived from the 64-bit
+ * one by a right shift, so the same precomputed tables are used by every kernel.
+ */
+
+NTT_TARGET_AVX512IFMA inline __m512i MulShoupIFMA(__m512i x, __m512i w, __m512i wPrecon52, __m512i q,
+                                                  __m512i mask52) {
+    const __m512i zero{_mm512_setzero_si512()};
+    __m512i hi{_mm512_madd52hi_epu64(zero, x, wPrecon52)};
+    __m512i r{_mm512_sub_epi64(_mm512_madd52lo_epu64(zero, x, w), _mm512_madd52lo_epu64(zero, hi, q))};
+    return _mm512_and_si512(r, mask52);
+}
+
+NTT_TARGET_AVX512IFMA inline __m512i ReduceIFMA(__m512i x, __m512i c) {
+    return _mm512_min_epu64(x, _mm512_sub_epi64(x, c));
+}
+
+NTT_TARGET_AVX512IFMA inline void ForwardButterflyIFMA(__m512i& x, __m512i& y, __m512i w, __m512i wPrecon52,
+                                                       __m512i q, __m512i q2, __m512i mask52) {
+    x         = ReduceIFMA(x, q2);
+    __m512i t = MulShoupIFMA(y, w, wPrecon52, q, mask52);
+    y         = _mm512_add_epi64(_mm512_sub_epi64(x, t), q2);
+    x         = _mm512_add_epi64(x, t);
+}
+
+NTT_TARGET_AVX512IFMA inline void InverseButterflyIFMA(__m512i& x, __m512i& y, __m512i w, __m512i wPrecon52,
+                                                       __m512i q, __m512i q2, __m512i mask52) {
+    __m512i d = _mm512_add_epi64(_mm512_sub_epi64(x, y), q2);
+    x         = ReduceIFMA(_mm512_add_epi64(x, y), q2);
+    y         = MulShoupIFMA(d, w, wPrecon52, q, mask52);
+}
+
+// Lane permutations for the stages with t < 8, where one 16-word group [v0 v1] holds
+// 16 / 2t butterfly blocks: x/y gather the low/high halves of the blocks, out0/out1
+// scatter them back and root selects the twiddle of the block each lane belongs to.
+struct ShortStagePermutation {
+    uint64_t x[8];
+    uint64_t y[8];
+    uint64_t out0[8];
+    uint64_t out1[8];
+    uint64_t root[8];
+};
+
+// clang-format off
+constexpr ShortStagePermutation SHORT_STAGE_PERMUTATIONS[3] = {
+    // t = 4
+    {{0, 1, 2, 3, 8, 9, 10, 11}, {4, 5, 6, 7, 12, 13, 14, 15},
+     {0, 1, 2, 3, 8, 9, 10, 11}, {4, 5, 6, 7, 12, 13, 14, 15}, {0, 0, 0, 0, 1, 1, 1, 1}},
+    // t = 2
+    {{0, 1, 4, 5, 8, 9, 12, 13}, {2, 3, 6, 7, 10, 11, 14, 15},
+     {0, 1, 8, 9, 2, 3, 10, 11}, {4, 5, 12, 13, 6, 7, 14, 15}, {0, 0, 1, 1, 2, 2, 3, 3}},
+    // t = 1
+    {{0, 2, 4, 6, 8, 10, 12, 14}, {1, 3, 5, 7, 9, 11, 13, 15},
+     {0, 8, 1, 9, 2, 10, 3, 11}, {4, 12, 5, 13, 6, 14, 7, 15}, {0, 1, 2, 3, 4, 5, 6, 7}},
+};
+// clang-format on
+
+NTT_TARGET_AVX512IFMA inline __m512i LoadIFMA(const uint64_t* p) {
+    return _mm512_loadu_si512(reinterpret_cast<const void*>(p));
+}
+
+NTT_TARGET_AVX512IFMA inline void StoreIFMA(uint64_t* p, __m512i v) {
+    _mm512_storeu_si512(reinterpret_cast<void*>(p), v);
+}
+
+// t in {4, 2, 1}; perm is the matching entry of SHORT_STAGE_PERMUTATIONS and the twiddles
+// of the stage start at w + m
+template <bool Forward, bool Reduce>
+NTT_TARGET_AVX512IFMA void ShortStageIFMA(const uint64_t* w, const uint64_t* wPrecon, uint32_t m, uint32_t t,
+                                          const ShortStagePermutation& perm, __m512i q, __m512i q2, __m512i mask52,
+                                          uint32_t n, uint64_t* element) {
+    const __m512i xIdx{LoadIFMA(perm.x)};
+    const __m512i yIdx{LoadIFMA(perm.y)};
+    const __m512i out0Idx{LoadIFMA(perm.out0)};
+    const __m512i out1Idx{LoadIFMA(perm.out1)};
+    const __m512i rootIdx{LoadIFMA(perm.root)};
+    for (uint32_t j{0}; j < n; j += 16) {
+        const uint32_t i{j / (t << 1)};
+        __m512i v0{LoadIFMA(element + j)};
+        __m512i v1{LoadIFMA(element + j + 8)};
+        __m512i x{_mm512_permutex2var_epi64(v0, xIdx, v1)};
+        __m512i y{_mm512_permutex2var_epi64(v0, yIdx, v1)};
+        __m512i omega{_mm512_permutexvar_epi64(rootIdx, LoadIFMA(w + m + i))};
+        __m512i preconOmega{
+            _mm512_srli_epi64(_mm512_permutexvar_epi64(rootIdx, LoadIFMA(wPrecon + m + i)), 12)};
+        if (Forward) {
+            ForwardButterflyIFMA(x, y, omega, preconOmega, q, q2, mask52);
+        }
+        else {
+            InverseButterflyIFMA(x, y, omega, preconOmega, q, q2, mask52);
+        }
+        if (Reduce) {
+            x = ReduceIFMA(ReduceIFMA(x, q2), q);
+            y = ReduceIFMA(ReduceIFMA(y, q2), q);
+        }
+        StoreIFMA(element + j, _mm512_permutex2var_epi64(x, out0Idx, y));
+        StoreIFMA(element + j + 8, _mm512_permutex2var_epi64(x, out1Idx, y));
+    }
+}
+
+NTT_TARGET_AVX512IFMA void ForwardTransformIFMA(const uint64_t* w, const uint64_t* wPrecon, uint64_t modulus,
+                                                uint32_t n, uint32_t root, uint64_t* element) {
+    const __m512i q{_mm512_set1_epi64(modulus)};
+    const __m512i q2{_mm512_set1_epi64(modulus << 1)};
+    const __m512i mask52{_mm512_set1_epi64((uint64_t(1) << 52) - 1)};
+
+    uint32_t m{1};
+    uint32_t t{n >> 1};
+    for (; t >= 8; m <<= 1, t >>= 1) {
+        for (uint32_t i{0}; i < m; ++i) {
+            const __m512i omega{_mm512_set1_epi64(w[root * m + i])};
+            const __m512i preconOmega{_mm512_set1_epi64(wPrecon[root * m + i] >> 12)};
+            uint64_t* lo{element + 2 * i * t};
+            uint64_t* hi{lo + t};
+            for (uint32_t j{0}; j < t; j += 8) {
+                __m512i x{LoadIFMA(lo + j)};
+                __m512i y{LoadIFMA(hi + j)};
+                ForwardButterflyIFMA(x, y, omega, preconOmega, q, q2, mask52);
+                StoreIFMA(lo + j, x);
+                StoreIFMA(hi + j, y);
+            }
+        }
+    }
+    ShortStageIFMA<true, false>(w, wPrecon, root * m, 4, SHORT_STAGE_PERMUTATIONS[0], q, q2, mask52, n, element);
+    ShortStageIFMA<true, false>(w, wPrecon, root * (m << 1), 2, SHORT_STAGE_PERMUTATIONS[1], q, q2, mask52, n,
+                                element);
+    ShortStageIFMA<true, true>(w, wPrecon, root * (m << 2), 1, SHORT_STAGE_PERMUTATIONS[2], q, q2, mask52, n,
+                               element);
+}
+
+NTT_TARGET_AVX512IFMA void InverseTransformIFMA(const uint64_t* w, const uint64_t* wPrecon, uint64_t cycloOrderInv,
+                                                uint64_t preconCycloOrderInv, uint64_t modulus, uint32_t n,
+                                                uint32_t root, uint64_t* element) {
+    const __m512i q{_mm512_set1_epi64(modulus)};
+    const __m512i q2{_mm512_set1_epi64(modulus << 1)};
+    const __m512i mask52{_mm512_set1_epi64((uint64_t(1) << 52) - 1)};
+
+    uint32_t m{n >> 1};
+    ShortStageIFMA<false, false>(w, wPrecon, root * m, 1, SHORT_STAGE_PERMUTATIONS[2], q, q2, mask52, n, element);
+    ShortStageIFMA<false, false>(w, wPrecon, root * (m >> 1), 2, SHORT_STAGE_PERMUTATIONS[1], q, q2, mask52, n,
+                                 element);
+    ShortStageIFMA<false, false>(w, wPrecon, root * (m >> 2), 4, SHORT_STAGE_PERMUTATIONS[0], q, q2, mask52, n,
+                                 element);
+    m >>= 3;
+
+    // a block of a larger INTT (root > 1) also runs the m = 1 stage as a regular stage
+    const uint32_t mEnd{(root == 1) ? 1u : 0u};
+    for (uint32_t t{8}; m > mEnd; m >>= 1, t <<= 1) {
+        for (uint32_t i{0}; i < m; ++i) {
+            const __m512i omega{_mm512_set1_epi64(w[root * m + i])};
+            const __m512i preconOmega{_mm512_set1_epi64(wPrecon[root * m + i] >> 12)};
+            uint64_t* lo{element + 2 * i * t};
+            uint64_t* hi{lo + t};
+            for (uint32_t j{0}; j < t; j += 8) {
+                __m512i x{LoadIFMA(lo + j)};
+                __m512i y{LoadIFMA(hi + j)};
+                InverseButterflyIFMA(x, y, omega, preconOmega, q, q2, mask52);
+                StoreIFMA(lo + j, x);
+                StoreIFMA(hi + j, y);
+            }
+        }
+    }
+
+    if (root != 1)
+        return;
+
+    // final stage fused with the multiplication by n^{-1} and the reduction to [0, q)
+    auto [omega1Inv, preconOmega1Inv] = ComputeOmega1Inv(w[1], cycloOrderInv, preconCycloOrderInv, modulus);
+    const __m512i nInv{_mm512_set1_epi64(cycloOrderInv)};
+    const __m512i preconNInv{_mm512_set1_epi64(preconCycloOrderInv >> 12)};
+    const __m512i omega{_mm512_set1_epi64(omega1Inv)};
+    const __m512i preconOmega{_mm512_set1_epi64(preconOmega1Inv >> 12)};
+    const uint32_t t{n >> 1};
+    for (uint32_t j{0}; j < t; j += 8) {
+        __m512i x{LoadIFMA(element + j)};
+        __m512i y{LoadIFMA(element + j + t)};
+        __m512i d{_mm512_add_epi64(_mm512_sub_epi64(x, y), q2)};
+        x = MulShoupIFMA(_mm512_add_epi64(x, y), nInv, preconNInv, q, mask52);
+        y = MulShoupIFMA(d, omega, preconOmega, q, mask52);
+        StoreIFMA(element + j, ReduceIFMA(x, q));
+        StoreIFMA(element + j + t, ReduceIFMA(y, q));
+    }
+}
+
+#endif  // NTT_SIMD_AVAILABLE
+
+}  // namespace
+
+bool IsNTTKernelSupported(NTTKernel kernel) {
+    switch (kernel) {
+        case NTT_KERNEL_AUTO:
+        case NTT_KERNEL_SCALAR:
+            return true;
+#if NTT_SIMD_AVAILABLE
+        case NTT_KERNEL_AVX2:
+            return __builtin_cpu_supports("avx2");
+        case NTT_KERNEL_AVX512IFMA:
+            return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512ifma");
+#endif
+        default:
+            return false;
+    }
+}
+
+NTTKernel GetNTTKernel() {
+    static const NTTKernel detectedKernel{DetectNTTKernel()};
+    auto kernel = static_cast<NTTKernel>(selectedNTTKernel.load(std::memory_order_relaxed));
+    return (kernel == NTT_KERNEL_AUTO) ? detectedKernel : kernel;
+}
+
+void SetNTTKernel(NTTKernel kernel) {
+    if (!IsNTTKernelSupported(kernel))
+        OPENFHE_THROW("The requested NTT kernel is not supported by this CPU");
+    selectedNTTKernel.store(kernel, std::memory_order_relaxed);
+}
+
+bool ForwardTransformToBitReverseInPlaceSIMD(const uint64_t* rootOfUnityTable, const uint64_t* preconRootOfUnityTable,
+                                             uint64_t modulus, uint32_t n, uint64_t* element, uint32_t root) {
+#if NTT_SIMD_AVAILABLE
+    if (n < NTT_SIMD_MIN_DIM)
+        return false;
+    switch (GetNTTKernel()) {
+        case NTT_KERNEL_AVX512IFMA:
+            if (modulus < NTT_IFMA_MAX_MODULUS) {
+                ForwardTransformIFMA(rootOfUnityTable, preconRootOfUnityTable, modulus, n, root, element);
+                return true;
+            }
+            // every CPU with AVX-512 IFMA also supports AVX2
+            [[fallthrough]];
+        case NTT_KERNEL_AVX2:
+            if (modulus < NTT_AVX2_SMALL_MAX_MODULUS) {
+                ForwardTransformAVX2<true>(rootOfUnityTable, preconRootOfUnityTable, modulus, n, root, element);
+                return true;
+            }
+            if (modulus < NTT_AVX2_MAX_MODULUS) {
+                ForwardTransformAVX2<false>(rootOfUnityTable, preconRootOfUnityTable, modulus, n, root, element);
+                return true;
+            }
+            return false;
+        default:
+            return false;
+    }
+#else
+    return false;
+#endif
+}
+
+bool InverseTransformFromBitReverseInPlaceSIMD(const uint64_t* rootOfUnityInverseTable,
+                                               const uint64_t* preconRootOfUnityInverseTable, uint64_t cycloOrderInv,
+                                               uint64_t preconCycloOrderInv, uint64_t modulus, uint32_t n,
+                                               uint64_t* element, uint32_t root) {
+#if NTT_SIMD_AVAILABLE
+    if (n < NTT_SIMD_MIN_DIM)
+        return false;
+    switch (GetNTTKernel()) {
+        case NTT_KERNEL_AVX512IFMA:
+            if (modulus < NTT_IFMA_MAX_MODULUS) {
+                InverseTransformIFMA(rootOfUnityInverseTable, preconRootOfUnityInverseTable, cycloOrderInv,
+                                     preconCycloOrderInv, modulus, n, root, element);
+                return true;
+            }
+            // every CPU with AVX-512 IFMA also supports AVX2
+            [[fallthrough]];
+        case NTT_KERNEL_AVX2:
+            if (modulus < NTT_AVX2_SMALL_MAX_MODULUS) {
+                InverseTransformAVX2<true>(rootOfUnityInverseTable, preconRootOfUnityInverseTable, cycloOrderInv,
+                                           preconCycloOrderInv, modulus, n, root, element);
+                return true;
+            }
+            if (modulus < NTT_AVX2_MAX_MODULUS) {
+                InverseTransformAVX2<false>(rootOfUnityInverseTable, preconRootOfUnityInverseTable, cycloOrderInv,
+                                            preconCycloOrderInv, modulus, n, root, element);
+                return true;
+            }
+            return false;
+        default:
+            return false;
+    }
+#else
+    return false;
+#endif
+}
+
+}  // namespace intnat
+
+#if NTT_SIMD_AVAILABLE && defined(__GNUC__) && !defined(__clang__)
+    #pragma GCC diagnostic pop
+#endif
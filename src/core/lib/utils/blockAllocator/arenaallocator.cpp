@@ -0,0 +1,214 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Per-thread size-class arena for the tower buffers of DCRT polynomials
+ */
+
+#include "utils/blockAllocator/arenaallocator.h"
+#include "utils/parallel.h"
+
+#include <atomic>
+#include <new>
+#include <vector>
+
+namespace {
+
+// only buffers of 2^ARENA_MIN_CLASS .. 2^ARENA_MAX_CLASS bytes are cached: smaller ones are cheap for
+// malloc, and tower buffers are always a power of two in size
+constexpr uint32_t ARENA_MIN_CLASS = 12;
+constexpr uint32_t ARENA_MAX_CLASS = 27;
+
+// upper bound on what one thread keeps cached; beyond it buffers are freed as usual
+constexpr size_t ARENA_MAX_CACHED_BYTES = (size_t(1) << 30);
+
+// generation of the outermost scope of a thread, shared with the OpenMP threads that joined it; odd while
+// the scope is alive
+using TeamToken = std::shared_ptr<std::atomic<uint64_t>>;
+
+class ThreadArena {
+public:
+    ~ThreadArena() {
+        Release();
+    }
+
+    // a thread caches buffers while it has a scope of its own or while the scope of the thread whose
+    // OpenMP team it joined is alive
+    bool IsActive() {
+        if (depth > 0)
+            return true;
+        if (!joined)
+            return false;
+        if (joined->load(std::memory_order_acquire) == joinedGeneration)
+            return true;
+        // the scope ended without its closing region reaching this thread
+        Leave();
+        return false;
+    }
+
+    void* Allocate(size_t size) {
+        int c = SizeClass(size);
+        if (c >= 0 && !freeLists[c].empty() && IsActive()) {
+            void* ptr = freeLists[c].back();
+            freeLists[c].pop_back();
+            cachedBytes -= size;
+            return ptr;
+        }
+        return ::operator new(size);
+    }
+
+    void Free(void* ptr, size_t size) {
+        int c = SizeClass(size);
+        if (c >= 0 && cachedBytes + size <= ARENA_MAX_CACHED_BYTES && IsActive()) {
+            freeLists[c].push_back(ptr);
+            cachedBytes += size;
+            return;
+        }
+        ::operator delete(ptr);
+    }
+
+    void Release() {
+        for (auto& list : freeLists) {
+            for (void* ptr : list)
+                ::operator delete(ptr);
+            list.clear();
+        }
+        cachedBytes = 0;
+    }
+
+    void Join(const TeamToken& team, uint64_t generation) {
+        joined           = team;
+        joinedGeneration = generation;
+    }
+
+    void Leave() {
+        joined.reset();
+        if (depth == 0)
+            Release();
+    }
+
+    uint32_t depth{0};
+    size_t cachedBytes{0};
+    TeamToken token;
+    TeamToken joined;
+    uint64_t joinedGeneration{0};
+
+private:
+    static int SizeClass(size_t size) {
+        if (size < (size_t(1) << ARENA_MIN_CLASS) || size > (size_t(1) << ARENA_MAX_CLASS) || (size & (size - 1)))
+            return -1;
+        int c = 0;
+        while ((size_t(1) << (ARENA_MIN_CLASS + c)) < size)
+            ++c;
+        return c;
+    }
+
+    std::vector<void*> freeLists[ARENA_MAX_CLASS - ARENA_MIN_CLASS + 1];
+};
+
+thread_local ThreadArena threadArena;
+
+// Most tower buffers of a DCRT polynomial are allocated and freed inside the parallel loops over its
+// towers, so the outermost scope of a thread outside of a parallel region also activates the arenas
+// of the OpenMP threads it runs these loops on, until the scope ends.
+void OpenTeam() {
+#ifdef PARALLEL
+    const int threads = lbcrypto::OpenFHEParallelControls.GetMachineThreads();
+    if (threads < 2 || omp_in_parallel())
+        return;
+    if (!threadArena.token)
+        threadArena.token = std::make_shared<std::atomic<uint64_t>>(0);
+    const TeamToken team      = threadArena.token;
+    const uint64_t generation = team->fetch_add(1, std::memory_order_acq_rel) + 1;
+    #pragma omp parallel num_threads(threads)
+    {
+        if (omp_get_thread_num() != 0)
+            threadArena.Join(team, generation);
+    }
+#endif
+}
+
+void CloseTeam() {
+#ifdef PARALLEL
+    const TeamToken team = threadArena.token;
+    if (!team || (team->load(std::memory_order_relaxed) & 1) == 0)
+        return;
+    team->fetch_add(1, std::memory_order_acq_rel);
+    // threads the region does not reach release their cache at their next allocation
+    #pragma omp parallel num_threads(lbcrypto::OpenFHEParallelControls.GetMachineThreads())
+    {
+        if (omp_get_thread_num() != 0 && threadArena.joined == team)
+            threadArena.Leave();
+    }
+#endif
+}
+
+}  // namespace
+
+void* arena_malloc(size_t size) {
+    return threadArena.Allocate(size);
+}
+
+void arena_free(void* ptr, size_t size) {
+    threadArena.Free(ptr, size);
+}
+
+size_t arena_cached_bytes() {
+    return threadArena.cachedBytes;
+}
+
+ArenaScope::ArenaScope() {
+    if (threadArena.depth++ == 0)
+        OpenTeam();
+}
+
+ArenaScope::~ArenaScope() {
+    if (--threadArena.depth == 0) {
+        CloseTeam();
+        if (!threadArena.IsActive())
+            threadArena.Release();
+    }
+}
+
+bool ArenaScope::IsActive() {
+    return threadArena.IsActive();
+}
+
+ArenaSlab::ArenaSlab(size_t size)
+    : m_data{static_cast<char*>(::operator new(size, std::align_val_t(64)))}, m_size{size} {}
+
+ArenaSlab::ArenaSlab(char* data, size_t size, std::shared_ptr<void> owner)
+    : m_data{data}, m_size{size}, m_external{true}, m_owner{std::move(owner)} {}
+
+ArenaSlab::~ArenaSlab() {
+    if (!m_external)
+        ::operator delete(m_data, std::align_val_t(64));
+}
@@ -0,0 +1,191 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+#include "utils/prng/aesctrengine.h"
+#include "utils/prng/blake2engine.h"
+#include "utils/exception.h"
+#include "utils/memory.h"
+
+#include <cstring>
+#include <memory>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(__EMSCRIPTEN__)
+    #define PRNG_AESNI_AVAILABLE
+    #include <immintrin.h>
+#endif
+
+namespace default_prng {
+
+namespace {
+
+#if defined(PRNG_AESNI_AVAILABLE)
+// the two halves of a step of the AES-256 key expansion (FIPS 197, Section 5.2)
+__attribute__((target("aes,sse2"))) inline __m128i ExpandEven(__m128i k, __m128i assist) {
+    assist = _mm_shuffle_epi32(assist, 0xff);
+    k      = _mm_xor_si128(k, _mm_slli_si128(k, 4));
+    k      = _mm_xor_si128(k, _mm_slli_si128(k, 8));
+    return _mm_xor_si128(k, assist);
+}
+
+__attribute__((target("aes,sse2"))) inline __m128i ExpandOdd(__m128i even, __m128i k) {
+    __m128i assist = _mm_shuffle_epi32(_mm_aeskeygenassist_si128(even, 0x00), 0xaa);
+    k              = _mm_xor_si128(k, _mm_slli_si128(k, 4));
+    k              = _mm_xor_si128(k, _mm_slli_si128(k, 8));
+    return _mm_xor_si128(k, assist);
+}
+
+__attribute__((target("aes,sse2"))) void ExpandKey256(const uint8_t* key, uint8_t* roundKeys) {
+    auto* rk  = reinterpret_cast<__m128i*>(roundKeys);
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key));
+    __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key + 16));
+    rk[0]     = a;
+    rk[1]     = b;
+    // the round constants must be immediates
+    a     = ExpandEven(a, _mm_aeskeygenassist_si128(b, 0x01));
+    b     = ExpandOdd(a, b);
+    rk[2] = a;
+    rk[3] = b;
+    a     = ExpandEven(a, _mm_aeskeygenassist_si128(b, 0x02));
+    b     = ExpandOdd(a, b);
+    rk[4] = a;
+    rk[5] = b;
+    a     = ExpandEven(a, _mm_aeskeygenassist_si128(b, 0x04));
+    b     = ExpandOdd(a, b);
+    rk[6] = a;
+    rk[7] = b;
+    a     = ExpandEven(a, _mm_aeskeygenassist_si128(b, 0x08));
+    b     = ExpandOdd(a, b);
+    rk[8] = a;
+    rk[9] = b;
+    a      = ExpandEven(a, _mm_aeskeygenassist_si128(b, 0x10));
+    b      = ExpandOdd(a, b);
+    rk[10] = a;
+    rk[11] = b;
+    a      = ExpandEven(a, _mm_aeskeygenassist_si128(b, 0x20));
+    b      = ExpandOdd(a, b);
+    rk[12] = a;
+    rk[13] = b;
+    rk[14] = ExpandEven(a, _mm_aeskeygenassist_si128(b, 0x40));
+}
+
+// encrypts nBlocks consecutive counter blocks starting at (hi, lo); 8 blocks are kept in flight to
+// hide the latency of AESENC
+__attribute__((target("aes,sse2"))) void EncryptCounterBlocks(const uint8_t* roundKeys, uint64_t& hi, uint64_t& lo,
+                                                             uint8_t* out, size_t nBlocks) {
+    constexpr size_t LANES = 8;
+    const auto* rk         = reinterpret_cast<const __m128i*>(roundKeys);
+    __m128i k[15];
+    for (size_t r = 0; r < 15; ++r)
+        k[r] = _mm_load_si128(rk + r);
+
+    for (size_t b = 0; b < nBlocks; b += LANES) {
+        __m128i x[LANES];
+        for (size_t j = 0; j < LANES; ++j) {
+            // the counter block is stored big-endian
+            x[j] = _mm_xor_si128(_mm_set_epi64x(static_cast<int64_t>(__builtin_bswap64(lo)),
+                                                static_cast<int64_t>(__builtin_bswap64(hi))),
+                                 k[0]);
+            if (++lo == 0)
+                ++hi;
+        }
+        for (size_t r = 1; r < 14; ++r) {
+            for (size_t j = 0; j < LANES; ++j)
+                x[j] = _mm_aesenc_si128(x[j], k[r]);
+        }
+        for (size_t j = 0; j < LANES; ++j)
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16 * (b + j)), _mm_aesenclast_si128(x[j], k[14]));
+    }
+
+    // IMPORTANT: clear the round keys on the stack for security reasons
+    lbcrypto::secure_memset(k, 0, sizeof(k));
+}
+#endif  // PRNG_AESNI_AVAILABLE
+
+}  // namespace
+
+bool AESCTREngine::IsSupported() {
+#if defined(PRNG_AESNI_AVAILABLE)
+    static const bool supported = __builtin_cpu_supports("aes") && __builtin_cpu_supports("sse2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+AESCTREngine::AESCTREngine(const aes_seed_array_t& seed, uint64_t counter) {
+    if (!IsSupported())
+        OPENFHE_THROW("AESCTREngine requires a CPU with the AES instructions");
+#if defined(PRNG_AESNI_AVAILABLE)
+    uint8_t bytes[MAX_SEED_GENS * sizeof(PRNG::result_type)];
+    std::memcpy(bytes, seed.data(), sizeof(bytes));
+    ExpandKey256(bytes, m_roundKeys.data());
+
+    // the initial counter block follows the key, big-endian
+    const uint8_t* iv = bytes + KEY_WORDS * sizeof(PRNG::result_type);
+    for (size_t i = 0; i < 8; ++i) {
+        m_ctrHi = (m_ctrHi << 8) | iv[i];
+        m_ctrLo = (m_ctrLo << 8) | iv[8 + i];
+    }
+    m_ctrLo += counter;
+    if (m_ctrLo < counter)
+        ++m_ctrHi;
+
+    // IMPORTANT: re-init the key for security reasons
+    lbcrypto::secure_memset(bytes, 0, sizeof(bytes));
+#endif
+}
+
+AESCTREngine::~AESCTREngine() {
+    // IMPORTANT: re-init the key schedule for security reasons
+    lbcrypto::secure_memset(m_roundKeys.data(), 0, m_roundKeys.size());
+}
+
+void AESCTREngine::Generate(void* out) {
+#if defined(PRNG_AESNI_AVAILABLE)
+    EncryptCounterBlocks(m_roundKeys.data(), m_ctrHi, m_ctrLo, static_cast<uint8_t*>(out),
+                         PRNG_BUFFER_SIZE * sizeof(PRNG::result_type) / 16);
+#endif
+}
+
+PRNG* createAESCTREngineInstance() {
+    AESCTREngine::aes_seed_array_t seed{};
+    std::unique_ptr<PRNG> seedGen(createEngineInstance());
+    seedGen->Fill(seed.data(), seed.size() * sizeof(seed[0]));
+    PRNG* ptr = new AESCTREngine(seed, 0);
+
+    // IMPORTANT: re-init seed for security reasons
+    const size_t bytes_to_clear = (seed.size() * sizeof(seed[0]));
+    lbcrypto::secure_memset(seed.data(), 0, bytes_to_clear);
+
+    return ptr;
+}
+
+}  // namespace default_prng
@@ -33,7 +33,9 @@
 #include "utils/exception.h"
 #include "utils/memory.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cstring>
 #include <random>
 #include <thread>
 
@@ -45,16 +47,43 @@ Blake2Engine::~Blake2Engine() {
     lbcrypto::secure_memset(m_seed.data(), 0, bytes_to_clear);
 }
 
-void Blake2Engine::Generate() {
+void Blake2Engine::Generate(void* out) {
     // m_counter is the input to the hash function
-    // m_buffer is the output
-    if (blake2xb(static_cast<void*>(m_buffer.data()), m_buffer.size() * sizeof(PRNG::result_type), &m_counter, sizeof(m_counter),
+    // out is the output
+    if (blake2xb(out, PRNG_BUFFER_SIZE * sizeof(PRNG::result_type), &m_counter, sizeof(m_counter),
     static_cast<const void*>(m_seed.data()), m_seed.size() * sizeof(PRNG::result_type)) != 0) {
         OPENFHE_THROW("PRNG: blake2xb failed");
     }
     m_counter++;
 }
 
+void Blake2Engine::Fill(void* buffer, size_t size) {
+    constexpr size_t sampleBytes = sizeof(PRNG::result_type);
+    constexpr size_t blockBytes  = PRNG_BUFFER_SIZE * sampleBytes;
+
+    auto* out = static_cast<uint8_t*>(buffer);
+    while (size > 0) {
+        // m_bufferIndex == 0 or PRNG_BUFFER_SIZE: no buffered samples left
+        if (m_bufferIndex == 0 || m_bufferIndex == static_cast<size_t>(PRNG_BUFFER_SIZE)) {
+            if (size >= blockBytes) {
+                Generate(out);
+                m_bufferIndex = PRNG_BUFFER_SIZE;
+                out += blockBytes;
+                size -= blockBytes;
+                continue;
+            }
+            Generate(m_buffer.data());
+            m_bufferIndex = 0;
+        }
+        // at least one sample is consumed, so m_bufferIndex does not stay 0
+        size_t bytes = std::min(size, (PRNG_BUFFER_SIZE - m_bufferIndex) * sampleBytes);
+        std::memcpy(out, m_buffer.data() + m_bufferIndex, bytes);
+        m_bufferIndex += (bytes + sampleBytes - 1) / sampleBytes;
+        out += bytes;
+        size -= bytes;
+    }
+}
+
 extern "C" {
 // if FIXED_SEED is defined, then PRNG uses a fixed seed number for reproducible results during debug.
 // Use only one OMP thread to ensure reproducibility
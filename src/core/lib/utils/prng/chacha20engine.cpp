@@ -0,0 +1,238 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+#include "utils/prng/chacha20engine.h"
+#include "utils/prng/blake2engine.h"
+#include "utils/memory.h"
+
+#include <cstring>
+#include <memory>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(__EMSCRIPTEN__)
+    #define PRNG_CHACHA_AVX2_AVAILABLE
+    #include <immintrin.h>
+#endif
+
+namespace default_prng {
+
+namespace {
+
+constexpr uint32_t CHACHA_BLOCK_WORDS = 16;
+constexpr uint32_t CHACHA_BLOCK_BYTES = CHACHA_BLOCK_WORDS * sizeof(uint32_t);
+constexpr uint32_t CHACHA_ROUNDS      = 20;
+
+inline uint32_t RotL(uint32_t x, uint32_t n) {
+    return (x << n) | (x >> (32 - n));
+}
+
+inline void QuarterRound(uint32_t* x, uint32_t a, uint32_t b, uint32_t c, uint32_t d) {
+    x[a] += x[b];
+    x[d] = RotL(x[d] ^ x[a], 16);
+    x[c] += x[d];
+    x[b] = RotL(x[b] ^ x[c], 12);
+    x[a] += x[b];
+    x[d] = RotL(x[d] ^ x[a], 8);
+    x[c] += x[d];
+    x[b] = RotL(x[b] ^ x[c], 7);
+}
+
+// the next nBlocks blocks of the keystream; the block counter in state[12..13] is advanced
+void ChaChaBlocks(uint32_t* state, uint8_t* out, size_t nBlocks) {
+    for (size_t blk = 0; blk < nBlocks; ++blk, out += CHACHA_BLOCK_BYTES) {
+        uint32_t x[CHACHA_BLOCK_WORDS];
+        std::memcpy(x, state, sizeof(x));
+        for (uint32_t r = 0; r < CHACHA_ROUNDS; r += 2) {
+            QuarterRound(x, 0, 4, 8, 12);
+            QuarterRound(x, 1, 5, 9, 13);
+            QuarterRound(x, 2, 6, 10, 14);
+            QuarterRound(x, 3, 7, 11, 15);
+            QuarterRound(x, 0, 5, 10, 15);
+            QuarterRound(x, 1, 6, 11, 12);
+            QuarterRound(x, 2, 7, 8, 13);
+            QuarterRound(x, 3, 4, 9, 14);
+        }
+        for (uint32_t i = 0; i < CHACHA_BLOCK_WORDS; ++i)
+            x[i] += state[i];
+        std::memcpy(out, x, sizeof(x));
+        if (++state[12] == 0)
+            ++state[13];
+    }
+}
+
+#if defined(PRNG_CHACHA_AVX2_AVAILABLE)
+__attribute__((target("avx2"))) inline __m256i RotL16(__m256i x) {
+    const __m256i mask = _mm256_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13, 2, 3, 0, 1, 6, 7, 4, 5,
+                                          10, 11, 8, 9, 14, 15, 12, 13);
+    return _mm256_shuffle_epi8(x, mask);
+}
+
+__attribute__((target("avx2"))) inline __m256i RotL8(__m256i x) {
+    const __m256i mask = _mm256_setr_epi8(3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14, 3, 0, 1, 2, 7, 4, 5, 6,
+                                          11, 8, 9, 10, 15, 12, 13, 14);
+    return _mm256_shuffle_epi8(x, mask);
+}
+
+template <int N>
+__attribute__((target("avx2"))) inline __m256i RotL(__m256i x) {
+    return _mm256_or_si256(_mm256_slli_epi32(x, N), _mm256_srli_epi32(x, 32 - N));
+}
+
+__attribute__((target("avx2"))) inline void QuarterRound(__m256i* x, uint32_t a, uint32_t b, uint32_t c,
+                                                         uint32_t d) {
+    x[a] = _mm256_add_epi32(x[a], x[b]);
+    x[d] = RotL16(_mm256_xor_si256(x[d], x[a]));
+    x[c] = _mm256_add_epi32(x[c], x[d]);
+    x[b] = RotL<12>(_mm256_xor_si256(x[b], x[c]));
+    x[a] = _mm256_add_epi32(x[a], x[b]);
+    x[d] = RotL8(_mm256_xor_si256(x[d], x[a]));
+    x[c] = _mm256_add_epi32(x[c], x[d]);
+    x[b] = RotL<7>(_mm256_xor_si256(x[b], x[c]));
+}
+
+// stores 8 consecutive words of 8 blocks, x[i] holding the word i of the block j in its lane j
+__attribute__((target("avx2"))) inline void StoreTransposed(const __m256i* x, uint8_t* out) {
+    __m256i t0 = _mm256_unpacklo_epi32(x[0], x[1]);
+    __m256i t1 = _mm256_unpackhi_epi32(x[0], x[1]);
+    __m256i t2 = _mm256_unpacklo_epi32(x[2], x[3]);
+    __m256i t3 = _mm256_unpackhi_epi32(x[2], x[3]);
+    __m256i t4 = _mm256_unpacklo_epi32(x[4], x[5]);
+    __m256i t5 = _mm256_unpackhi_epi32(x[4], x[5]);
+    __m256i t6 = _mm256_unpacklo_epi32(x[6], x[7]);
+    __m256i t7 = _mm256_unpackhi_epi32(x[6], x[7]);
+
+    __m256i u[8];
+    u[0] = _mm256_unpacklo_epi64(t0, t2);
+    u[1] = _mm256_unpackhi_epi64(t0, t2);
+    u[2] = _mm256_unpacklo_epi64(t1, t3);
+    u[3] = _mm256_unpackhi_epi64(t1, t3);
+    u[4] = _mm256_unpacklo_epi64(t4, t6);
+    u[5] = _mm256_unpackhi_epi64(t4, t6);
+    u[6] = _mm256_unpacklo_epi64(t5, t7);
+    u[7] = _mm256_unpackhi_epi64(t5, t7);
+
+    // u[j] holds the block j in its lower and the block j + 4 in its upper half
+    for (uint32_t j = 0; j < 4; ++j) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + j * CHACHA_BLOCK_BYTES),
+                            _mm256_permute2x128_si256(u[j], u[j + 4], 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + (j + 4) * CHACHA_BLOCK_BYTES),
+                            _mm256_permute2x128_si256(u[j], u[j + 4], 0x31));
+    }
+}
+
+// the same as ChaChaBlocks() for a multiple of 8 blocks, computed one block per 32-bit lane
+__attribute__((target("avx2"))) void ChaChaBlocksAVX2(uint32_t* state, uint8_t* out, size_t nBlocks) {
+    constexpr uint32_t LANES = 8;
+    for (size_t blk = 0; blk < nBlocks; blk += LANES, out += LANES * CHACHA_BLOCK_BYTES) {
+        uint32_t ctrLo[LANES];
+        uint32_t ctrHi[LANES];
+        uint64_t ctr = (static_cast<uint64_t>(state[13]) << 32) | state[12];
+        for (uint32_t j = 0; j < LANES; ++j, ++ctr) {
+            ctrLo[j] = static_cast<uint32_t>(ctr);
+            ctrHi[j] = static_cast<uint32_t>(ctr >> 32);
+        }
+        state[12] = static_cast<uint32_t>(ctr);
+        state[13] = static_cast<uint32_t>(ctr >> 32);
+
+        __m256i in[CHACHA_BLOCK_WORDS];
+        for (uint32_t i = 0; i < CHACHA_BLOCK_WORDS; ++i)
+            in[i] = _mm256_set1_epi32(static_cast<int32_t>(state[i]));
+        in[12] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ctrLo));
+        in[13] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ctrHi));
+
+        __m256i x[CHACHA_BLOCK_WORDS];
+        for (uint32_t i = 0; i < CHACHA_BLOCK_WORDS; ++i)
+            x[i] = in[i];
+        for (uint32_t r = 0; r < CHACHA_ROUNDS; r += 2) {
+            QuarterRound(x, 0, 4, 8, 12);
+            QuarterRound(x, 1, 5, 9, 13);
+            QuarterRound(x, 2, 6, 10, 14);
+            QuarterRound(x, 3, 7, 11, 15);
+            QuarterRound(x, 0, 5, 10, 15);
+            QuarterRound(x, 1, 6, 11, 12);
+            QuarterRound(x, 2, 7, 8, 13);
+            QuarterRound(x, 3, 4, 9, 14);
+        }
+        for (uint32_t i = 0; i < CHACHA_BLOCK_WORDS; ++i)
+            x[i] = _mm256_add_epi32(x[i], in[i]);
+
+        StoreTransposed(x, out);
+        StoreTransposed(x + 8, out + 8 * sizeof(uint32_t));
+    }
+}
+#endif  // PRNG_CHACHA_AVX2_AVAILABLE
+
+}  // namespace
+
+ChaCha20Engine::ChaCha20Engine(const chacha_seed_array_t& seed, uint64_t counter) {
+    // "expand 32-byte k"
+    m_state[0] = 0x61707865;
+    m_state[1] = 0x3320646e;
+    m_state[2] = 0x79622d32;
+    m_state[3] = 0x6b206574;
+    for (uint32_t i = 0; i < KEY_WORDS; ++i)
+        m_state[4 + i] = seed[i];
+    m_state[12] = static_cast<uint32_t>(counter);
+    m_state[13] = static_cast<uint32_t>(counter >> 32);
+    m_state[14] = seed[KEY_WORDS];
+    m_state[15] = seed[KEY_WORDS + 1];
+}
+
+ChaCha20Engine::~ChaCha20Engine() {
+    // IMPORTANT: re-init the key for security reasons
+    lbcrypto::secure_memset(m_state.data(), 0, m_state.size() * sizeof(m_state[0]));
+}
+
+void ChaCha20Engine::Generate(void* out) {
+    constexpr size_t nBlocks = PRNG_BUFFER_SIZE / CHACHA_BLOCK_WORDS;
+#if defined(PRNG_CHACHA_AVX2_AVAILABLE)
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    if (avx2) {
+        ChaChaBlocksAVX2(m_state.data(), static_cast<uint8_t*>(out), nBlocks);
+        return;
+    }
+#endif
+    ChaChaBlocks(m_state.data(), static_cast<uint8_t*>(out), nBlocks);
+}
+
+PRNG* createChaCha20EngineInstance() {
+    ChaCha20Engine::chacha_seed_array_t seed{};
+    std::unique_ptr<PRNG> seedGen(createEngineInstance());
+    seedGen->Fill(seed.data(), seed.size() * sizeof(seed[0]));
+    PRNG* ptr = new ChaCha20Engine(seed, 0);
+
+    // IMPORTANT: re-init seed for security reasons
+    const size_t bytes_to_clear = (seed.size() * sizeof(seed[0]));
+    lbcrypto::secure_memset(seed.data(), 0, bytes_to_clear);
+
+    return ptr;
+}
+
+}  // namespace default_prng
@@ -0,0 +1,141 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2023, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  This code exercises the per-thread arena that backs the native vectors
+ */
+
+#include "gtest/gtest.h"
+
+#include "math/math-hal.h"
+#include "utils/blockAllocator/arenaallocator.h"
+#include "utils/parallel.h"
+
+#include <vector>
+
+using namespace lbcrypto;
+
+TEST(UTArenaAllocate, reuses_buffers_inside_scope) {
+    EXPECT_FALSE(ArenaScope::IsActive());
+    const NativeInteger modulus(1152921504606846577ULL);
+    {
+        ArenaScope arena;
+        EXPECT_TRUE(ArenaScope::IsActive());
+
+        const void* first;
+        {
+            NativeVector v(4096, modulus);
+            first = v.data();
+        }
+        EXPECT_EQ(arena_cached_bytes(), 4096 * sizeof(NativeInteger));
+
+        {
+            // nested scopes share the cache of the thread
+            ArenaScope inner;
+            NativeVector v(4096, modulus);
+            EXPECT_EQ(first, static_cast<const void*>(v.data()));
+            EXPECT_EQ(arena_cached_bytes(), 0u);
+        }
+        EXPECT_TRUE(ArenaScope::IsActive());
+
+        // sizes that are not a power of two are never cached
+        { NativeVector v(4095, modulus); }
+        EXPECT_EQ(arena_cached_bytes(), 4096 * sizeof(NativeInteger));
+    }
+    EXPECT_FALSE(ArenaScope::IsActive());
+    EXPECT_EQ(arena_cached_bytes(), 0u);
+
+    // outside of a scope buffers go back to the heap
+    { NativeVector v(4096, modulus); }
+    EXPECT_EQ(arena_cached_bytes(), 0u);
+}
+
+TEST(UTArenaAllocate, buffers_cross_scope_boundaries) {
+    const NativeInteger modulus(1152921504606846577ULL);
+    NativeVector outside(8192, modulus, 5);
+    NativeVector escaped;
+    {
+        ArenaScope arena;
+        NativeVector inside(8192, modulus, 7);
+        escaped = std::move(inside);
+        // freed inside the scope although allocated outside of it
+        outside = NativeVector();
+        EXPECT_EQ(arena_cached_bytes(), 8192 * sizeof(NativeInteger));
+    }
+    EXPECT_EQ(escaped.GetLength(), 8192u);
+    EXPECT_EQ(escaped[8191], NativeInteger(7));
+}
+
+TEST(UTArenaAllocate, scope_reaches_openmp_team) {
+    const NativeInteger modulus(1152921504606846577ULL);
+    const int threads = OpenFHEParallelControls.GetMachineThreads();
+    std::vector<int> active(threads);
+    std::vector<size_t> cached(threads);
+    {
+        ArenaScope arena;
+        // one iteration per thread of the team
+#pragma omp parallel for num_threads(threads) schedule(static, 1)
+        for (int i = 0; i < threads; ++i) {
+            { NativeVector v(4096, modulus); }
+            active[i] = ArenaScope::IsActive();
+            cached[i] = arena_cached_bytes();
+        }
+        for (int i = 0; i < threads; ++i) {
+            EXPECT_TRUE(active[i]) << "thread " << i;
+            EXPECT_EQ(cached[i], 4096 * sizeof(NativeInteger)) << "thread " << i;
+        }
+    }
+#pragma omp parallel for num_threads(threads) schedule(static, 1)
+    for (int i = 0; i < threads; ++i) {
+        active[i] = ArenaScope::IsActive();
+        cached[i] = arena_cached_bytes();
+    }
+    for (int i = 0; i < threads; ++i) {
+        EXPECT_FALSE(active[i]) << "thread " << i;
+        EXPECT_EQ(cached[i], 0u) << "thread " << i;
+    }
+}
+
+TEST(UTArenaAllocate, external_chunk_keeps_values) {
+    auto owner = std::make_shared<std::vector<uint64_t>>(16, 9);
+    auto slab  = std::make_shared<ArenaSlab>(reinterpret_cast<char*>(owner->data()), 16 * sizeof(uint64_t), owner);
+    arena_allocator<uint64_t> chunk(slab, 8 * sizeof(uint64_t), 8 * sizeof(uint64_t));
+    EXPECT_TRUE(chunk == arena_allocator<uint64_t>(slab, 0, 8 * sizeof(uint64_t)));
+    EXPECT_FALSE(chunk == arena_allocator<uint64_t>());
+
+    std::vector<uint64_t, arena_allocator<uint64_t>> v(8, chunk);
+    EXPECT_EQ(v.data(), owner->data() + 8);
+    EXPECT_EQ(v[7], 9u);
+    // the elements beyond the chunk live in memory of their own and start at zero
+    v.resize(12);
+    EXPECT_EQ(v[7], 9u);
+    EXPECT_EQ(v[11], 0u);
+}
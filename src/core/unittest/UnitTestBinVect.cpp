@@ -34,6 +34,8 @@
  */
 
 #include <iostream>
+#include <random>
+#include <vector>
 #include "gtest/gtest.h"
 
 #include "lattice/lat-hal.h"
@@ -550,3 +552,19 @@ void modmul_vector(const std::string& msg) {
 TEST(UTBinVect, modmul_vector) {
     RUN_BIG_BACKENDS(modmul_vector, "modmul_vector")
 }
+
+TEST(UTBinVect, pack_unpack_bits) {
+    std::mt19937_64 gen(42);
+    for (uint32_t bits : {1u, 7u, 31u, 36u, 50u, 60u, 63u, 64u}) {
+        for (size_t count : {size_t(1), size_t(3), size_t(64), size_t(1001)}) {
+            std::vector<NativeInteger> in(count);
+            for (auto& x : in)
+                x = NativeInteger(bits < 64 ? gen() & ((uint64_t(1) << bits) - 1) : gen());
+            std::vector<uint64_t> words((count * bits + 63) / 64, ~uint64_t(0));
+            intnat::PackBits(in.data(), count, bits, words.data());
+            std::vector<NativeInteger> out(count);
+            intnat::UnpackBits(words.data(), count, bits, out.data());
+            EXPECT_EQ(in, out) << "Failure for " << bits << " bits and " << count << " values";
+        }
+    }
+}
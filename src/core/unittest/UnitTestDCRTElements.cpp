@@ -40,6 +40,7 @@
 #include "utils/debug.h"
 
 #include <iostream>
+#include <memory>
 #include <vector>
 
 using namespace lbcrypto;
@@ -592,6 +593,169 @@ TEST(UTDCRTPoly, DCRT_mod_ops_on_two_elements) {
     RUN_BIG_DCRTPOLYS(DCRT_mod_ops_on_two_elements, "DCRT DCRT_mod_ops_on_two_elements");
 }
 
+template <typename Element>
+void DCRT_contiguous_layout(const std::string& msg) {
+    uint32_t order     = 64;
+    uint32_t nBits     = 24;
+    uint32_t towersize = 4;
+
+    auto ildcrtparams = std::make_shared<ILDCRTParams<typename Element::Integer>>(order, towersize, nBits);
+
+    typename Element::DugType dug;
+
+    Element op(dug, ildcrtparams, Format::COEFFICIENT);
+    const Element expected(op);
+    EXPECT_FALSE(op.IsContiguous()) << msg;
+    EXPECT_EQ(op.GetContiguousData(), nullptr) << msg;
+
+    op.MakeContiguous();
+    EXPECT_TRUE(op.IsContiguous()) << msg;
+    const NativeInteger* data = op.GetContiguousData();
+    ASSERT_NE(data, nullptr) << msg;
+    EXPECT_EQ(op, expected) << msg;
+    for (uint32_t i = 0; i < towersize; i++)
+        EXPECT_EQ(data[i * ildcrtparams->GetRingDimension() + 1], expected.GetElementAtIndex(i)[1]) << msg;
+
+    // the towers keep working in place
+    Element transformed(expected);
+    transformed.SwitchFormat();
+    op.SwitchFormat();
+    EXPECT_TRUE(op.IsContiguous()) << msg;
+    EXPECT_EQ(op, transformed) << msg;
+    op += expected;
+    transformed += expected;
+    EXPECT_TRUE(op.IsContiguous()) << msg;
+    EXPECT_EQ(op, transformed) << msg;
+
+    // copies get their own storage
+    Element copy(op);
+    EXPECT_FALSE(copy.IsContiguous()) << msg;
+    EXPECT_EQ(copy, op) << msg;
+
+    op.MakeSeparate();
+    EXPECT_FALSE(op.IsContiguous()) << msg;
+    EXPECT_EQ(op, transformed) << msg;
+
+    // towers without values become zero
+    Element zero(ildcrtparams, Format::EVALUATION);
+    zero.MakeContiguous();
+    EXPECT_TRUE(zero.IsContiguous()) << msg;
+    EXPECT_EQ(zero, Element(ildcrtparams, Format::EVALUATION, true)) << msg;
+}
+
+TEST(UTDCRTPoly, DCRT_contiguous_layout) {
+    RUN_BIG_DCRTPOLYS(DCRT_contiguous_layout, "DCRT DCRT_contiguous_layout");
+}
+
+template <typename Element>
+void DCRT_adopt_contiguous(const std::string& msg) {
+    uint32_t order     = 64;
+    uint32_t nBits     = 24;
+    uint32_t towersize = 4;
+
+    auto ildcrtparams = std::make_shared<ILDCRTParams<typename Element::Integer>>(order, towersize, nBits);
+    const uint32_t n  = ildcrtparams->GetRingDimension();
+
+    typename Element::DugType dug;
+    const Element expected(dug, ildcrtparams, Format::EVALUATION);
+
+    // an external buffer with the towers back to back
+    auto buffer = std::make_shared<std::vector<NativeInteger>>(towersize * n);
+    for (uint32_t i = 0; i < towersize; i++) {
+        for (uint32_t j = 0; j < n; j++)
+            (*buffer)[i * n + j] = expected.GetElementAtIndex(i)[j];
+    }
+
+    Element op(ildcrtparams, Format::EVALUATION);
+    op.AdoptContiguous(buffer->data(), buffer);
+    EXPECT_TRUE(op.IsContiguous()) << msg;
+    EXPECT_EQ(op.GetContiguousData(), buffer->data()) << msg;
+    EXPECT_EQ(op, expected) << msg;
+
+    // the towers keep working in place and keep the buffer alive
+    std::weak_ptr<std::vector<NativeInteger>> weak = buffer;
+    buffer.reset();
+    EXPECT_FALSE(weak.expired()) << msg;
+    op += expected;
+    EXPECT_EQ(op, expected + expected) << msg;
+    EXPECT_EQ(weak.lock()->at(n + 1), op.GetElementAtIndex(1)[1]) << msg;
+
+    op = Element();
+    EXPECT_TRUE(weak.expired()) << msg;
+}
+
+TEST(UTDCRTPoly, DCRT_adopt_contiguous) {
+    RUN_BIG_DCRTPOLYS(DCRT_adopt_contiguous, "DCRT DCRT_adopt_contiguous");
+}
+
+template <typename Element>
+void DCRT_switch_crt_basis(const std::string& msg) {
+    using BigInt = typename Element::Integer;
+
+    uint32_t order = 4096;
+    uint32_t sizeQ = 4;
+    uint32_t sizeP = 3;
+
+    auto paramsQ = std::make_shared<ILDCRTParams<BigInt>>(order, sizeQ, 50);
+    auto paramsP = std::make_shared<ILDCRTParams<BigInt>>(order, sizeP, 58);
+
+    BigInt Q(paramsQ->GetModulus());
+    std::vector<NativeInteger> QHatInvModq(sizeQ), QHatInvModqPrecon(sizeQ);
+    std::vector<std::vector<NativeInteger>> QHatModp(sizeQ, std::vector<NativeInteger>(sizeP));
+    std::vector<std::vector<NativeInteger>> QHatModpT(sizeP, std::vector<NativeInteger>(sizeQ));
+    std::vector<std::vector<NativeInteger>> alphaQModp(sizeQ + 1, std::vector<NativeInteger>(sizeP));
+    std::vector<BigInt> QHat(sizeQ);
+    std::vector<double> qInv(sizeQ);
+    std::vector<DoubleNativeInt> modpBarrettMu(sizeP);
+    for (uint32_t i = 0; i < sizeQ; ++i) {
+        NativeInteger qi = paramsQ->GetParams()[i]->GetModulus();
+        QHat[i]          = Q / BigInt(qi);
+        QHatInvModq[i]   = NativeInteger((QHat[i] % BigInt(qi)).ConvertToInt()).ModInverse(qi);
+        QHatInvModqPrecon[i] = QHatInvModq[i].PrepModMulConst(qi);
+        qInv[i]              = 1. / static_cast<double>(qi.ConvertToInt());
+        for (uint32_t j = 0; j < sizeP; ++j) {
+            BigInt pj      = BigInt(paramsP->GetParams()[j]->GetModulus());
+            QHatModp[i][j] = QHatModpT[j][i] = NativeInteger((QHat[i] % pj).ConvertToInt());
+        }
+    }
+    for (uint32_t j = 0; j < sizeP; ++j) {
+        BigInt pj = BigInt(paramsP->GetParams()[j]->GetModulus());
+        for (uint32_t a = 0; a <= sizeQ; ++a)
+            alphaQModp[a][j] = NativeInteger(((BigInt(a) * Q) % pj).ConvertToInt());
+        modpBarrettMu[j] = (BigInt(1).LShiftEq(128) / pj).template ConvertToInt<DoubleNativeInt>();
+    }
+
+    typename Element::DugType dug;
+    Element x(dug, paramsQ, Format::COEFFICIENT);
+
+    auto approx = x.ApproxSwitchCRTBasis(paramsQ, paramsP, QHatInvModq, QHatInvModqPrecon, QHatModp, modpBarrettMu);
+    auto exact  = x.SwitchCRTBasis(paramsP, QHatInvModq, QHatInvModqPrecon, QHatModpT, alphaQModp, modpBarrettMu, qInv);
+
+    // approximate conversion: sum_i [x_i (Q/q_i)^{-1}]_{q_i} (Q/q_i); exact conversion: x in (-Q/2, Q/2]
+    uint32_t ringDim  = paramsQ->GetRingDimension();
+    auto interpolated = x.CRTInterpolate();
+    BigInt halfQ(Q >> 1);
+    for (uint32_t ri = 0; ri < ringDim; ++ri) {
+        BigInt sum(0);
+        for (uint32_t i = 0; i < sizeQ; ++i) {
+            const auto& xi = x.GetElementAtIndex(i);
+            sum += BigInt(xi[ri].ModMul(QHatInvModq[i], xi.GetModulus()).ConvertToInt()) * QHat[i];
+        }
+        for (uint32_t j = 0; j < sizeP; ++j) {
+            BigInt pj = BigInt(paramsP->GetParams()[j]->GetModulus());
+            ASSERT_EQ(approx.GetElementAtIndex(j)[ri].ConvertToInt(), (sum % pj).ConvertToInt())
+                << msg << " approximate conversion at " << ri;
+            BigInt centered = (interpolated[ri] > halfQ) ? (interpolated[ri] + pj * (Q / pj + 1) - Q) : interpolated[ri];
+            ASSERT_EQ(exact.GetElementAtIndex(j)[ri].ConvertToInt(), (centered % pj).ConvertToInt())
+                << msg << " exact conversion at " << ri;
+        }
+    }
+}
+
+TEST(UTDCRTPoly, DCRT_switch_crt_basis) {
+    RUN_BIG_DCRTPOLYS(DCRT_switch_crt_basis, "DCRT DCRT_switch_crt_basis");
+}
+
 // only need to try this with one
 void testDCRTPolyConstructorNegative(std::vector<NativePoly>& towers) {
     DCRTPoly expectException(towers);
@@ -33,8 +33,10 @@
   This code exercises the random number distribution generator libraries of the OpenFHE lattice encryption library.
  */
 
+#include <cstring>
 #include <iostream>
 #include <thread>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -43,6 +45,9 @@
 #include "math/nbtheory.h"
 #include "utils/debug.h"
 #include "utils/inttypes.h"
+#include "utils/prng/aesctrengine.h"
+#include "utils/prng/blake2engine.h"
+#include "utils/prng/chacha20engine.h"
 #include "utils/utilities.h"
 
 #include "testdefs.h"
@@ -420,6 +425,141 @@ TEST(UTDistrGen, TernaryUniformGenerator) {
     RUN_ALL_BACKENDS(TernaryUniformGeneratorTest, "TernaryUniformGeneratorTest")
 }
 
+// every value is drawn with probability 1/3
+template <typename V>
+void TernaryUniformGeneratorCountsTest(const std::string& msg) {
+    auto ternaryUniGen = TernaryUniformGeneratorImpl<V>();
+
+    usint length = 90001;
+    auto values  = ternaryUniGen.GenerateIntVector(length);
+
+    usint counts[3] = {0, 0, 0};
+    for (usint i = 0; i < length; i++) {
+        int32_t x = (values.get())[i];
+        ASSERT_TRUE(x >= -1 && x <= 1) << msg << " value out of range: " << x;
+        counts[x + 1]++;
+    }
+    for (usint c : counts)
+        EXPECT_NEAR(c, length / 3, length / 100) << msg << " Ternary Uniform Distribution Failure counts are incorrect";
+}
+
+TEST(UTDistrGen, TernaryUniformGeneratorCounts) {
+    RUN_ALL_BACKENDS(TernaryUniformGeneratorCountsTest, "TernaryUniformGeneratorCountsTest")
+}
+
+// the bulk output of an engine is the stream of its operator(); prng1 and prng2 are two engines with the same seed
+static void PRNGFillTest(PRNG& prng1, PRNG& prng2, const std::string& msg) {
+    // a few single samples, then several blocks, a partial sample and single samples again
+    std::vector<uint32_t> expected(5 + 5000 + 2 + 3);
+    for (auto& x : expected)
+        x = prng2();
+
+    std::vector<uint32_t> actual(expected.size(), 0);
+    for (usint i = 0; i < 5; ++i)
+        actual[i] = prng1();
+    prng1.Fill(actual.data() + 5, 5000 * sizeof(uint32_t));
+    prng1.Fill(actual.data() + 5005, 7);
+    for (usint i = 5007; i < actual.size(); ++i)
+        actual[i] = prng1();
+
+    // only 3 bytes of the sample 5006 are written
+    uint32_t partial = 0;
+    std::memcpy(&partial, &expected[5006], 3);
+    expected[5006] = partial;
+    EXPECT_EQ(expected, actual) << msg << "::Fill does not match operator()";
+}
+
+TEST(UTDistrGen, PRNGFill) {
+    default_prng::Blake2Engine::blake2_seed_array_t seed{};
+    seed[0] = 1;
+    seed[1] = 2;
+    default_prng::Blake2Engine engine1(seed, 0);
+    default_prng::Blake2Engine engine2(seed, 0);
+    PRNGFillTest(engine1, engine2, "Blake2Engine");
+
+    default_prng::ChaCha20Engine::chacha_seed_array_t chachaSeed{};
+    chachaSeed[0] = 1;
+    // a counter close to 2^32 checks the carry into the high word of the block counter
+    default_prng::ChaCha20Engine chacha1(chachaSeed, (uint64_t(1) << 32) - 5);
+    default_prng::ChaCha20Engine chacha2(chachaSeed, (uint64_t(1) << 32) - 5);
+    PRNGFillTest(chacha1, chacha2, "ChaCha20Engine");
+
+    if (default_prng::AESCTREngine::IsSupported()) {
+        default_prng::AESCTREngine::aes_seed_array_t aesSeed{};
+        aesSeed[0] = 1;
+        default_prng::AESCTREngine aes1(aesSeed, ~uint64_t(0) - 5);
+        default_prng::AESCTREngine aes2(aesSeed, ~uint64_t(0) - 5);
+        PRNGFillTest(aes1, aes2, "AESCTREngine");
+    }
+}
+
+// the keystream of ChaCha20 for the test vector of RFC 8439, Section 2.3.2; its 96-bit nonce and 32-bit block
+// counter map to the 64-bit counter 0x0900000000000001 and the 64-bit nonce 0x000000004a000000
+TEST(UTDistrGen, PRNGChaCha20KnownAnswer) {
+    default_prng::ChaCha20Engine::chacha_seed_array_t seed{};
+    for (uint32_t i = 0; i < default_prng::ChaCha20Engine::KEY_WORDS; ++i)
+        seed[i] = (4 * i) | ((4 * i + 1) << 8) | ((4 * i + 2) << 16) | ((4 * i + 3) << 24);
+    seed[8] = 0x4a000000;
+    seed[9] = 0x00000000;
+    default_prng::ChaCha20Engine engine(seed, 0x0900000000000001);
+
+    const std::vector<uint32_t> expected{0xe4e7f110, 0x15593bd1, 0x1fdd0f50, 0xc47120a3, 0xc7f4d1c7, 0x0368c033,
+                                         0x9aaa2204, 0x4e6cd4c3, 0x466482d2, 0x09aa9f07, 0x05d7c214, 0xa2028bd9,
+                                         0xd19c12b5, 0xb94e16de, 0xe883d0cb, 0x4e3c50a2};
+    std::vector<uint32_t> actual(expected.size());
+    for (auto& x : actual)
+        x = engine();
+    EXPECT_EQ(expected, actual) << "ChaCha20Engine does not match the RFC 8439 test vector";
+}
+
+// the keystream of AES-256 in counter mode for the test vector of NIST SP 800-38A, F.5.5 (the output blocks are
+// the plaintext xor the ciphertext)
+TEST(UTDistrGen, PRNGAESCTRKnownAnswer) {
+    if (!default_prng::AESCTREngine::IsSupported())
+        GTEST_SKIP() << "the CPU has no AES instructions";
+
+    const uint8_t key[32] = {0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae,
+                             0xf0, 0x85, 0x7d, 0x77, 0x81, 0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61,
+                             0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4};
+    const uint8_t iv[16]  = {0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7,
+                             0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff};
+    default_prng::AESCTREngine::aes_seed_array_t seed{};
+    std::memcpy(seed.data(), key, sizeof(key));
+    std::memcpy(seed.data() + default_prng::AESCTREngine::KEY_WORDS, iv, sizeof(iv));
+    default_prng::AESCTREngine engine(seed, 0);
+
+    const std::vector<uint8_t> expected{0x0b, 0xdf, 0x7d, 0xf1, 0x59, 0x17, 0x16, 0x33, 0x5e, 0x9a, 0x8b,
+                                        0x15, 0xc8, 0x60, 0xc5, 0x02, 0x5a, 0x6e, 0x69, 0x9d, 0x53, 0x61,
+                                        0x19, 0x06, 0x54, 0x33, 0x86, 0x3c, 0x8f, 0x65, 0x7b, 0x94};
+    std::vector<uint8_t> actual(expected.size());
+    static_cast<PRNG&>(engine).Fill(actual.data(), actual.size());
+    EXPECT_EQ(expected, actual) << "AESCTREngine does not match the SP 800-38A test vector";
+}
+
+// the samplers work with every built-in engine, and switching the engine replaces the engine of the thread
+TEST(UTDistrGen, PRNGEngineSelection) {
+    std::vector<PRNGEngineType> engines{PRNG_CHACHA20};
+    if (default_prng::AESCTREngine::IsSupported())
+        engines.push_back(PRNG_AES_CTR);
+    else
+        EXPECT_THROW(PseudoRandomNumberGenerator::SetPRNGEngine(PRNG_AES_CTR), OpenFHEException);
+
+    for (auto engine : engines) {
+        PseudoRandomNumberGenerator::SetPRNGEngine(engine);
+        PRNG* prng = &PseudoRandomNumberGenerator::GetPRNG();
+        if (engine == PRNG_CHACHA20)
+            EXPECT_NE(dynamic_cast<default_prng::ChaCha20Engine*>(prng), nullptr) << "the engine is not ChaCha20";
+        else
+            EXPECT_NE(dynamic_cast<default_prng::AESCTREngine*>(prng), nullptr) << "the engine is not AES-CTR";
+
+        RUN_ALL_BACKENDS(TernaryUniformGeneratorCountsTest, "TernaryUniformGeneratorCountsTest")
+    }
+
+    PseudoRandomNumberGenerator::SetPRNGEngine(PRNG_BLAKE2);
+    EXPECT_NE(dynamic_cast<default_prng::Blake2Engine*>(&PseudoRandomNumberGenerator::GetPRNG()), nullptr)
+        << "the engine is not Blake2";
+}
+
 ////////////////////////////////////////////////
 // Testing Methods of BigInteger DiscreteGaussianGenerator
 ////////////////////////////////////////////////
@@ -477,6 +617,77 @@ TEST(UTDistrGen, DiscreteGaussianGenerator) {
     RUN_ALL_BACKENDS(DiscreteGaussianGeneratorTest, "DiscreteGaussianGeneratorTest")
 }
 
+// the frequencies of the constant-time table sampler for the usual sigma = 3.19, for GenerateIntVector,
+// GenerateInt and GenerateInteger
+template <typename V>
+void DiscreteGaussianGeneratorCDTTest(const std::string& msg) {
+    const double stdev = 3.19;
+    const int32_t size = 300000;
+    const auto dgg     = DiscreteGaussianGeneratorImpl<V>(stdev);
+    typename V::Integer modulus("10403");
+
+    std::vector<int64_t> samples(size);
+    auto vec = dgg.GenerateIntVector(size / 3);
+    for (int32_t i = 0; i < size / 3; ++i) {
+        samples[i]                = (vec.get())[i];
+        samples[size / 3 + i]     = dgg.GenerateInt();
+        auto x                    = dgg.GenerateInteger(modulus);
+        samples[2 * size / 3 + i] = (x > modulus / typename V::Integer(2)) ?
+                                        -static_cast<int64_t>((modulus - x).ConvertToInt()) :
+                                        static_cast<int64_t>(x.ConvertToInt());
+    }
+
+    double norm = 0;
+    for (int32_t k = -40; k <= 40; ++k)
+        norm += std::exp(-k * k / (2 * stdev * stdev));
+    std::vector<uint32_t> counts(81, 0);
+    for (auto x : samples) {
+        ASSERT_LE(std::abs(x), 40) << msg << " sample out of range: " << x;
+        counts[x + 40]++;
+    }
+    for (int32_t k = -10; k <= 10; ++k) {
+        double expected = size * std::exp(-k * k / (2 * stdev * stdev)) / norm;
+        // 5 standard deviations of the count
+        EXPECT_NEAR(counts[k + 40], expected, 5 * std::sqrt(expected) + 1) << msg << " wrong frequency of " << k;
+    }
+}
+
+TEST(UTDistrGen, DiscreteGaussianGeneratorCDT) {
+    RUN_ALL_BACKENDS(DiscreteGaussianGeneratorCDTTest, "DiscreteGaussianGeneratorCDTTest")
+}
+
+// the boundaries of SampleCDT(): words just below and at each threshold, with either sign; the SIMD path
+// (batches of 16) and the scalar one (single samples) agree
+TEST(UTDistrGen, SampleCDTThresholds) {
+    const std::vector<uint64_t> table{uint64_t(1) << 62, (uint64_t(7) << 60), (uint64_t(1) << 63) - 1};
+    std::vector<uint64_t> rand;
+    std::vector<int64_t> expected;
+    for (uint64_t sign : {uint64_t(0), uint64_t(1) << 63}) {
+        rand.push_back(sign);
+        expected.push_back(0);
+        for (uint32_t k = 0; k < table.size(); ++k) {
+            rand.push_back(sign | (table[k] - 1));
+            expected.push_back(sign ? -int64_t(k) : int64_t(k));
+            rand.push_back(sign | table[k]);
+            expected.push_back(sign ? -int64_t(k + 1) : int64_t(k + 1));
+        }
+    }
+    // 3 batches of 16 and a remainder
+    while (rand.size() < 50) {
+        rand.push_back(rand[rand.size() - 14]);
+        expected.push_back(expected[expected.size() - 14]);
+    }
+
+    std::vector<int64_t> batch(rand.size());
+    SampleCDT(table.data(), table.size(), rand.data(), batch.data(), rand.size());
+    EXPECT_EQ(expected, batch) << "SampleCDT in batches";
+
+    std::vector<int64_t> single(rand.size());
+    for (uint32_t i = 0; i < rand.size(); ++i)
+        SampleCDT(table.data(), table.size(), &rand[i], &single[i], 1);
+    EXPECT_EQ(expected, single) << "SampleCDT of single samples";
+}
+
 #ifdef PARALLEL
 template <typename V>
 void ParallelDiscreteGaussianGenerator_VERY_LONG(const std::string& msg) {
@@ -46,6 +46,7 @@
 #include "math/nbtheory.h"
 #include "testdefs.h"
 #include "utils/inttypes.h"
+#include "utils/parallel.h"
 #include "utils/utilities.h"
 
 using namespace lbcrypto;
@@ -119,3 +120,172 @@ void switch_format_simple_double_crt(const std::string& msg) {
 TEST(UTNTT, switch_format_simple_double_crt) {
     RUN_BIG_DCRTPOLYS(switch_format_simple_double_crt, "switch_format_simple_double_crt")
 }
+
+TEST(UTNTT, simd_kernels_match_scalar) {
+    const std::vector<intnat::NTTKernel> kernels{intnat::NTT_KERNEL_AVX2, intnat::NTT_KERNEL_AVX512IFMA};
+    DiscreteUniformGeneratorImpl<NativeVector> dug;
+    // 30 and 31 bits are on both sides of the bound of the 32-bit AVX2 instantiation
+    for (usint bits : {28, 30, 31, 49, MAX_MODULUS_SIZE}) {
+        for (usint n : {16, 64, 1024, 8192}) {
+            usint m = 2 * n;
+            NativeInteger modulus(LastPrime<NativeInteger>(bits, m));
+            NativeInteger rootOfUnity(RootOfUnity(m, modulus));
+            ChineseRemainderTransformFTT<NativeVector> crtFTT;
+            crtFTT.PreCompute(rootOfUnity, m, modulus);
+
+            NativeVector input(dug.GenerateVector(n, modulus));
+
+            intnat::SetNTTKernel(intnat::NTT_KERNEL_SCALAR);
+            NativeVector expected(input);
+            crtFTT.ForwardTransformToBitReverseInPlace(rootOfUnity, m, &expected);
+
+            for (auto kernel : kernels) {
+                if (!intnat::IsNTTKernelSupported(kernel))
+                    continue;
+                intnat::SetNTTKernel(kernel);
+                std::string msg = "kernel " + std::to_string(kernel) + ", bits " + std::to_string(bits) + ", n " +
+                                  std::to_string(n);
+
+                NativeVector result(input);
+                crtFTT.ForwardTransformToBitReverseInPlace(rootOfUnity, m, &result);
+                EXPECT_EQ(expected, result) << msg;
+
+                crtFTT.InverseTransformFromBitReverseInPlace(rootOfUnity, m, &result);
+                EXPECT_EQ(input, result) << msg;
+            }
+        }
+    }
+    intnat::SetNTTKernel(intnat::NTT_KERNEL_AUTO);
+}
+
+TEST(UTNTT, ntt_table_registry) {
+    usint m = 2048;
+    usint n = m / 2;
+    NativeInteger modulus(LastPrime<NativeInteger>(MAX_MODULUS_SIZE, m));
+    NativeInteger rootOfUnity(RootOfUnity(m, modulus));
+
+    // tables are built once per (modulus, cyclotomic order) and shared by all lookups
+    const auto& tables = intnat::NTTTableRegistryNat<NativeVector>::GetTables(rootOfUnity, m, modulus);
+    EXPECT_EQ(&tables, &intnat::NTTTableRegistryNat<NativeVector>::GetTables(rootOfUnity, m, modulus));
+    EXPECT_EQ(&tables, intnat::NTTTableRegistryNat<NativeVector>::FindTables(m, modulus));
+    EXPECT_EQ(tables.rootOfUnityReverse.GetLength(), n);
+    EXPECT_EQ(tables.cycloOrderInv.ModMul(NativeInteger(n), modulus), NativeInteger(1));
+
+    // the same modulus with a different ring dimension gets its own entry
+    NativeInteger rootOfUnityHalf(rootOfUnity.ModMul(rootOfUnity, modulus));
+    const auto& tablesHalf = intnat::NTTTableRegistryNat<NativeVector>::GetTables(rootOfUnityHalf, m / 2, modulus);
+    EXPECT_NE(&tables, &tablesHalf);
+    EXPECT_EQ(tablesHalf.rootOfUnityReverse.GetLength(), n / 2);
+    EXPECT_EQ(&tables, intnat::NTTTableRegistryNat<NativeVector>::FindTables(m, modulus));
+
+    // params resolve to the registry entry and copies share the cached pointer
+    auto params = std::make_shared<ILNativeParams>(m, modulus, rootOfUnity);
+    EXPECT_EQ(params->GetNTTTables(), &tables);
+    ILNativeParams paramsCopy(*params);
+    EXPECT_EQ(paramsCopy.GetNTTTables(), &tables);
+
+    // transforms through the cached tables match the (rootOfUnity, cycloOrder) entry points
+    DiscreteUniformGeneratorImpl<NativeVector> dug;
+    NativeVector input(dug.GenerateVector(n, modulus));
+    NativeVector expected(input);
+    ChineseRemainderTransformFTT<NativeVector>().ForwardTransformToBitReverseInPlace(rootOfUnity, m, &expected);
+
+    NativePoly poly(params, Format::COEFFICIENT);
+    poly.SetValues(input, Format::COEFFICIENT);
+    poly.SwitchFormat();
+    EXPECT_EQ(expected, poly.GetValues());
+    poly.SwitchFormat();
+    EXPECT_EQ(input, poly.GetValues());
+}
+
+TEST(UTNTT, ntt_variants_match) {
+    const auto variant = intnat::GetNTTVariant();
+    intnat::SetNTTKernel(intnat::NTT_KERNEL_SCALAR);
+    DiscreteUniformGeneratorImpl<NativeVector> dug;
+    for (usint bits : {28, 49, MAX_MODULUS_SIZE}) {
+        // 2^16 and 2^17 take the cache-blocked path
+        for (usint n : {2, 16, 32, 1024, 1 << 16, 1 << 17}) {
+            usint m = 2 * n;
+            NativeInteger modulus(LastPrime<NativeInteger>(bits, m));
+            NativeInteger rootOfUnity(RootOfUnity(m, modulus));
+            ChineseRemainderTransformFTT<NativeVector> crtFTT;
+            std::string msg = "bits " + std::to_string(bits) + ", n " + std::to_string(n);
+
+            NativeVector input(dug.GenerateVector(n, modulus));
+
+            intnat::SetNTTVariant(intnat::NTT_VARIANT_STANDARD);
+            NativeVector expected(input);
+            crtFTT.ForwardTransformToBitReverseInPlace(rootOfUnity, m, &expected);
+            NativeVector expectedInverse(input);
+            crtFTT.InverseTransformFromBitReverseInPlace(rootOfUnity, m, &expectedInverse);
+
+            intnat::SetNTTVariant(intnat::NTT_VARIANT_HARVEY_LAZY);
+            NativeVector result(input);
+            crtFTT.ForwardTransformToBitReverseInPlace(rootOfUnity, m, &result);
+            EXPECT_EQ(expected, result) << msg;
+            NativeVector resultInverse(input);
+            crtFTT.InverseTransformFromBitReverseInPlace(rootOfUnity, m, &resultInverse);
+            EXPECT_EQ(expectedInverse, resultInverse) << msg;
+
+            crtFTT.InverseTransformFromBitReverseInPlace(rootOfUnity, m, &result);
+            EXPECT_EQ(input, result) << msg;
+        }
+    }
+    intnat::SetNTTVariant(variant);
+    intnat::SetNTTKernel(intnat::NTT_KERNEL_AUTO);
+}
+
+#ifdef PARALLEL
+// the batched transform only kicks in with fewer towers than threads, so more threads than towers
+// are requested here regardless of the number of cores
+TEST(UTNTT, ntt_batch_matches_towers) {
+    const int threads = omp_get_max_threads();
+    omp_set_num_threads(8);
+    DiscreteUniformGeneratorImpl<NativeVector> dug;
+    for (auto kernel : {intnat::NTT_KERNEL_SCALAR, intnat::NTT_KERNEL_AVX2, intnat::NTT_KERNEL_AVX512IFMA}) {
+        if (!intnat::IsNTTKernelSupported(kernel))
+            continue;
+        intnat::SetNTTKernel(kernel);
+        for (usint n : {4096, 8192}) {
+            usint m = 2 * n;
+            for (usint towers : {1, 2, 3, 5}) {
+                std::vector<NativeVector> input;
+                std::vector<const intnat::NTTTablesNat<NativeVector>*> tables;
+                NativeInteger modulus(LastPrime<NativeInteger>(MAX_MODULUS_SIZE, m));
+                for (usint i = 0; i < towers; ++i) {
+                    tables.push_back(&intnat::NTTTableRegistryNat<NativeVector>::GetTables(RootOfUnity(m, modulus), m,
+                                                                                           modulus));
+                    input.push_back(dug.GenerateVector(n, modulus));
+                    modulus = PreviousPrime(modulus, m);
+                }
+                std::string msg = "kernel " + std::to_string(kernel) + ", n " + std::to_string(n) + ", towers " +
+                                  std::to_string(towers);
+
+                ChineseRemainderTransformFTT<NativeVector> crtFTT;
+                std::vector<NativeVector> expected(input);
+                std::vector<NativeVector> expectedInverse(input);
+                std::vector<NativeVector> result(input);
+                std::vector<NativeVector> resultInverse(input);
+                std::vector<NativeVector*> resultPtrs;
+                std::vector<NativeVector*> resultInversePtrs;
+                for (usint i = 0; i < towers; ++i) {
+                    crtFTT.ForwardTransformToBitReverseInPlace(*tables[i], &expected[i]);
+                    crtFTT.InverseTransformFromBitReverseInPlace(*tables[i], &expectedInverse[i]);
+                    resultPtrs.push_back(&result[i]);
+                    resultInversePtrs.push_back(&resultInverse[i]);
+                }
+
+                EXPECT_TRUE(crtFTT.ForwardTransformToBitReverseInPlaceBatch(tables, resultPtrs)) << msg;
+                EXPECT_EQ(expected, result) << msg;
+                EXPECT_TRUE(crtFTT.InverseTransformFromBitReverseInPlaceBatch(tables, resultInversePtrs)) << msg;
+                EXPECT_EQ(expectedInverse, resultInverse) << msg;
+
+                crtFTT.InverseTransformFromBitReverseInPlaceBatch(tables, resultPtrs);
+                EXPECT_EQ(input, result) << msg;
+            }
+        }
+    }
+    intnat::SetNTTKernel(intnat::NTT_KERNEL_AUTO);
+    omp_set_num_threads(threads);
+}
+#endif
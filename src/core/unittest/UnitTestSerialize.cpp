@@ -243,6 +243,31 @@ TEST(UTSer, ildcrtpoly_test) {
     RUN_BIG_DCRTPOLYS(ildcrtpoly_test, "ildcrtpoly_test")
 }
 
+TEST(UTSer, native_vector_packed) {
+    // the binary format stores ceil(log2 q) bits per value
+    const uint32_t n = 1024;
+    auto p           = std::make_shared<ILDCRTParams<BigInteger>>(2 * n, 3, 30);
+    DCRTPoly::DugType dug;
+    DCRTPoly poly(dug, p, Format::EVALUATION);
+
+    std::stringstream s;
+    Serial::Serialize(poly.GetElementAtIndex(0).GetValues(), s, SerType::BINARY);
+    EXPECT_LT(s.str().size(), n * 30 / 8 + 128) << "native vector is not bit-packed";
+
+    NativeVector vec;
+    Serial::Deserialize(vec, s, SerType::BINARY);
+    EXPECT_EQ(poly.GetElementAtIndex(0).GetValues(), vec) << "native vector binary ser/deser fails";
+
+    s.str("");
+    Serial::Serialize(poly, s, SerType::BINARY);
+    EXPECT_LT(s.str().size(), 3 * (n * 30 / 8 + 128) + 512) << "DCRTPoly is not bit-packed";
+
+    DCRTPoly deser;
+    Serial::Deserialize(deser, s, SerType::BINARY);
+    EXPECT_EQ(poly, deser) << "DCRTPoly binary ser/deser fails";
+    EXPECT_EQ(*poly.GetParams(), *deser.GetParams()) << "DCRTPoly params are not rebuilt from the towers";
+}
+
 ////////////////////////////////////////////////////////////
 template <typename V>
 void serialize_matrix_bigint(const std::string& msg) {
@@ -0,0 +1,159 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+  Flat wire format of DCRT ciphertexts for zero-copy scatter/gather I/O
+ */
+
+#ifndef LBCRYPTO_CRYPTO_CIPHERTEXTWIRE_H
+#define LBCRYPTO_CRYPTO_CIPHERTEXTWIRE_H
+
+#include "ciphertext.h"
+#include "cryptocontext-fwd.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <vector>
+
+namespace lbcrypto {
+
+/*
+  A message of the wire format is a header followed by the raw towers of the ciphertext elements:
+
+  - a fixed part of CIPHERTEXT_WIRE_PREFIX_SIZE bytes with the magic, the version, the byte order, the
+    sizes of the header and of the whole message, the ring dimension, the numbers of elements and
+    towers, the format and the ciphertext attributes (level, noise scale degree, scaling factors,
+    slots, encoding, hop level);
+  - the modulus and the root of unity of every tower, and the key tag;
+  - padding to a multiple of 64 bytes;
+  - the towers of element 0, then those of element 1, ..., each as ring dimension machine words.
+
+  The towers are 64-byte aligned relative to the start of the message, so a message read into an
+  aligned buffer can be used as the tower storage as it is. The words are in the byte order of the
+  machine, which is checked on reading. A reader accepts all versions up to CIPHERTEXT_WIRE_VERSION
+  and throws for later ones. The metadata map of the ciphertext is not part of the message.
+ */
+
+constexpr uint32_t CIPHERTEXT_WIRE_VERSION   = 1;
+constexpr size_t CIPHERTEXT_WIRE_PREFIX_SIZE   = 128;
+
+/**
+ * @brief One contiguous piece of a message, as in a struct iovec.
+ */
+struct CiphertextWireBuffer {
+    const void* data;
+    size_t size;
+};
+
+/**
+ * Collects the pieces of the message of a ciphertext without copying the towers: the header, then
+ * the towers in order, consecutive towers of a contiguous DCRTPoly as one piece. The pieces point
+ * into header and into the ciphertext, which must not change until they are written.
+ *
+ * @param ciphertext the ciphertext
+ * @param header receives the header
+ * @return the pieces of the message
+ */
+std::vector<CiphertextWireBuffer> GetCiphertextWireBuffers(ConstCiphertext<DCRTPoly>& ciphertext,
+                                                           std::vector<uint8_t>& header);
+
+/**
+ * Writes the message of a ciphertext to a file descriptor (a file, pipe or socket) with writev,
+ * directly from the memory of the towers. Throws on platforms without writev.
+ *
+ * @param fd the file descriptor
+ * @param ciphertext the ciphertext
+ * @return the number of bytes written
+ */
+size_t WriteCiphertextWire(int fd, ConstCiphertext<DCRTPoly>& ciphertext);
+
+/**
+ * Writes the message of a ciphertext to a stream, directly from the memory of the towers.
+ *
+ * @param os the stream
+ * @param ciphertext the ciphertext
+ * @return the number of bytes written
+ */
+size_t WriteCiphertextWire(std::ostream& os, ConstCiphertext<DCRTPoly>& ciphertext);
+
+/**
+ * Size of a message from its first bytes, for framing messages in a stream.
+ *
+ * @param data the start of the message
+ * @param size the number of bytes available at data
+ * @return the size of the whole message, 0 if less than CIPHERTEXT_WIRE_PREFIX_SIZE bytes are available
+ */
+size_t GetCiphertextWireSize(const void* data, size_t size);
+
+/**
+ * Makes a ciphertext of a message without copying it: the towers of the elements are views of the
+ * message (see DCRTPoly::AdoptContiguous), which therefore must be aligned to 8 bytes (64 bytes
+ * preferably) and stay writable, e.g. a private mapping of a file or a receive buffer. The ring
+ * dimension and the moduli and roots of unity of the towers have to be those of the context or of
+ * a prefix of its towers, the number of elements at most the highest relinearization degree of the
+ * context plus one, the key tag at most 256 characters and every residue below its modulus;
+ * messages that do not match throw.
+ *
+ * @param cc the context of the ciphertext
+ * @param data the start of the message
+ * @param size the number of bytes available at data
+ * @param owner keeps the message alive as long as the ciphertext or any of its towers refers to it
+ * @return the ciphertext
+ */
+Ciphertext<DCRTPoly> AdoptCiphertextWire(const CryptoContext<DCRTPoly>& cc, void* data, size_t size,
+                                         std::shared_ptr<void> owner);
+
+/**
+ * Reads a message from a file descriptor into one aligned buffer that becomes the storage of the
+ * towers of the ciphertext. Throws on platforms without POSIX read.
+ *
+ * @param cc the context of the ciphertext
+ * @param fd the file descriptor
+ * @return the ciphertext
+ */
+Ciphertext<DCRTPoly> ReadCiphertextWire(const CryptoContext<DCRTPoly>& cc, int fd);
+
+/**
+ * Reads a message from a stream into one aligned buffer that becomes the storage of the towers of
+ * the ciphertext.
+ *
+ * @param cc the context of the ciphertext
+ * @param is the stream
+ * @return the ciphertext
+ */
+Ciphertext<DCRTPoly> ReadCiphertextWire(const CryptoContext<DCRTPoly>& cc, std::istream& is);
+
+}  // namespace lbcrypto
+
+#endif
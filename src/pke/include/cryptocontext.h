@@ -3445,10 +3445,13 @@ public:
     * @param slots            Number of slots to be bootstrapped.
     * @param correctionFactor Internal rescaling factor to improve precision (only for NATIVE_SIZE=64; 0 = default).
     * @param precompute       Whether to precompute plaintexts for encoding/decoding.
+    * @param lazyDiagonals    Whether to store only the diagonals of the FFT-like encoding/decoding and encode the
+    *                         plaintexts just in time during bootstrapping (much lower memory, some extra encoding time).
     */
     void EvalBootstrapSetup(std::vector<uint32_t> levelBudget = {5, 4}, std::vector<uint32_t> dim1 = {0, 0},
-                            uint32_t slots = 0, uint32_t correctionFactor = 0, bool precompute = true) {
-        GetScheme()->EvalBootstrapSetup(*this, levelBudget, dim1, slots, correctionFactor, precompute);
+                            uint32_t slots = 0, uint32_t correctionFactor = 0, bool precompute = true,
+                            bool lazyDiagonals = false) {
+        GetScheme()->EvalBootstrapSetup(*this, levelBudget, dim1, slots, correctionFactor, precompute, lazyDiagonals);
     }
     /**
     * @brief Generates automorphism keys for EvalBootstrap. Uses baby-step/giant-step strategy. Supported only in CKKS.
@@ -34,6 +34,7 @@
 
 #include "key/evalkey-fwd.h"
 #include "key/key.h"
+#include "key/keyseed.h"
 
 #include <memory>
 #include <vector>
@@ -95,6 +96,38 @@ public:
         OPENFHE_THROW("GetAVector operation not supported");
     }
 
+    /**
+   * Setter function to regenerate Relinearization Element Vector A from a seed instead of storing it.
+   * Throws exception, to be overridden by derived class.
+   *
+   * @param &seed is the seed of A.
+   */
+
+    virtual void SetAVectorSeed(const KeySeed& seed) {
+        OPENFHE_THROW("SetAVectorSeed operation not supported");
+    }
+
+    /**
+   * Checks whether Relinearization Element Vector A is regenerated from a seed.
+   *
+   * @return true if A is regenerated from a seed.
+   */
+
+    virtual bool HasAVectorSeed() const {
+        return false;
+    }
+
+    /**
+   * Getter function to access the seed of Relinearization Element Vector A.
+   * Throws exception, to be overridden by derived class.
+   *
+   * @return the seed of A.
+   */
+
+    virtual const KeySeed& GetAVectorSeed() const {
+        OPENFHE_THROW("GetAVectorSeed operation not supported");
+    }
+
     /**
    * Setter function to store Relinearization Element Vector B.
    * Throws exception, to be overridden by derived class.
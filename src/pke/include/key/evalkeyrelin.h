@@ -34,8 +34,11 @@
 
 #include "key/evalkeyrelin-fwd.h"
 #include "key/evalkey.h"
+#include "key/keyseed.h"
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 #include <utility>
@@ -71,7 +74,11 @@ public:
    *@param &rhs key to copy from
    */
     explicit EvalKeyRelinImpl(const EvalKeyRelinImpl<Element>& rhs)
-        : EvalKeyImpl<Element>(rhs.GetCryptoContext()), m_rKey(rhs.m_rKey) {}
+        : EvalKeyImpl<Element>(rhs.GetCryptoContext()),
+          m_rKey(rhs.m_rKey),
+          m_seed(rhs.m_seed),
+          m_seeded(rhs.m_seeded),
+          m_expanded(rhs.m_expanded.load()) {}
 
     /**
    * Move constructor
@@ -79,7 +86,11 @@ public:
    *@param &rhs key to move from
    */
     explicit EvalKeyRelinImpl(EvalKeyRelinImpl<Element>&& rhs) noexcept
-        : EvalKeyImpl<Element>(rhs.GetCryptoContext()), m_rKey(std::move(rhs.m_rKey)) {}
+        : EvalKeyImpl<Element>(rhs.GetCryptoContext()),
+          m_rKey(std::move(rhs.m_rKey)),
+          m_seed(rhs.m_seed),
+          m_seeded(rhs.m_seeded),
+          m_expanded(rhs.m_expanded.load()) {}
 
     operator bool() const {
         return static_cast<bool>(this->context) && m_rKey.size() != 0;
@@ -93,6 +104,9 @@ public:
     EvalKeyRelinImpl<Element>& operator=(const EvalKeyRelinImpl<Element>& rhs) {
         this->context = rhs.context;
         this->m_rKey  = rhs.m_rKey;
+        m_seed        = rhs.m_seed;
+        m_seeded      = rhs.m_seeded;
+        m_expanded    = rhs.m_expanded.load();
         return *this;
     }
 
@@ -105,6 +119,9 @@ public:
         this->context = rhs.context;
         rhs.context   = 0;
         m_rKey        = std::move(rhs.m_rKey);
+        m_seed        = rhs.m_seed;
+        m_seeded      = rhs.m_seeded;
+        m_expanded    = rhs.m_expanded.load();
         return *this;
     }
 
@@ -115,7 +132,13 @@ public:
    * @param &a is the Element vector to be copied.
    */
     virtual void SetAVector(const std::vector<Element>& a) {
-        m_rKey.insert(m_rKey.begin() + 0, a);
+        // an explicit A replaces the one regenerated from a seed
+        if (m_seeded)
+            m_rKey.at(0) = a;
+        else
+            m_rKey.insert(m_rKey.begin() + 0, a);
+        m_seeded = false;
+        m_expanded.store(false);
     }
 
     /**
@@ -125,7 +148,12 @@ public:
    * @param &&a is the Element vector to be moved.
    */
     virtual void SetAVector(std::vector<Element>&& a) {
-        m_rKey.insert(m_rKey.begin() + 0, std::move(a));
+        if (m_seeded)
+            m_rKey.at(0) = std::move(a);
+        else
+            m_rKey.insert(m_rKey.begin() + 0, std::move(a));
+        m_seeded = false;
+        m_expanded.store(false);
     }
 
     /**
@@ -135,9 +163,47 @@ public:
    * @return Element vector A.
    */
     virtual const std::vector<Element>& GetAVector() const {
+        if (m_seeded && !m_expanded.load(std::memory_order_acquire))
+            ExpandAVector();
         return m_rKey.at(0);
     }
 
+    /**
+   * Setter function to regenerate Relinearization Element Vector A from a seed instead of storing it.
+   * A is expanded on first use with one Element per Element of B and the same parameters, so B has
+   * to be set right after the seed. Overrides base class implementation.
+   *
+   * @param &seed is the seed of A.
+   */
+    virtual void SetAVectorSeed(const KeySeed& seed) {
+        m_rKey.insert(m_rKey.begin() + 0, std::vector<Element>());
+        m_seed   = seed;
+        m_seeded = true;
+        m_expanded.store(false);
+    }
+
+    /**
+   * Checks whether Relinearization Element Vector A is regenerated from a seed.
+   * Overrides base class implementation.
+   *
+   * @return true if A is regenerated from a seed.
+   */
+    virtual bool HasAVectorSeed() const {
+        return m_seeded;
+    }
+
+    /**
+   * Getter function to access the seed of Relinearization Element Vector A.
+   * Overrides base class implementation.
+   *
+   * @return the seed of A.
+   */
+    virtual const KeySeed& GetAVectorSeed() const {
+        if (!m_seeded)
+            OPENFHE_THROW("The A vector of this key is not generated from a seed");
+        return m_seed;
+    }
+
     /**
    * Setter function to store Relinearization Element Vector B.
    * Overrides base class implementation.
@@ -235,6 +301,8 @@ public:
     virtual void ClearKeys() {
         m_rKey.clear();
         m_dcrtKeys.clear();
+        m_seeded = false;
+        m_expanded.store(false);
     }
 
     bool key_compare(const EvalKeyImpl<Element>& other) const {
@@ -243,6 +311,11 @@ public:
         if (!CryptoObject<Element>::operator==(other))
             return false;
 
+        if (m_seeded)
+            GetAVector();
+        if (oth.m_seeded)
+            oth.GetAVector();
+
         if (this->m_rKey.size() != oth.m_rKey.size())
             return false;
         for (size_t i = 0; i < this->m_rKey.size(); i++) {
@@ -259,7 +332,22 @@ public:
     template <class Archive>
     void save(Archive& ar, std::uint32_t const version) const {
         ar(::cereal::base_class<EvalKeyImpl<Element>>(this));
-        ar(::cereal::make_nvp("k", m_rKey));
+        if (version < 2) {
+            // the layout of version 1, with A in full; archives get version 0 where key-ser.h is not included
+            if (m_seeded)
+                GetAVector();
+            ar(::cereal::make_nvp("k", m_rKey));
+            return;
+        }
+        ar(::cereal::make_nvp("sd", m_seeded));
+        if (m_seeded) {
+            // only the seed of A is written
+            ar(::cereal::make_nvp("s", m_seed));
+            ar(::cereal::make_nvp("b", m_rKey.at(1)));
+        }
+        else {
+            ar(::cereal::make_nvp("k", m_rKey));
+        }
     }
 
     template <class Archive>
@@ -269,18 +357,54 @@ public:
                           " is from a later version of the library");
         }
         ar(::cereal::base_class<EvalKeyImpl<Element>>(this));
-        ar(::cereal::make_nvp("k", m_rKey));
+        m_seeded = false;
+        m_expanded.store(false);
+        if (version > 1)
+            ar(::cereal::make_nvp("sd", m_seeded));
+        if (m_seeded) {
+            std::vector<Element> b;
+            ar(::cereal::make_nvp("s", m_seed));
+            ar(::cereal::make_nvp("b", b));
+            m_rKey.clear();
+            m_rKey.push_back(std::vector<Element>());
+            m_rKey.push_back(std::move(b));
+        }
+        else {
+            ar(::cereal::make_nvp("k", m_rKey));
+        }
     }
     std::string SerializedObjectName() const {
         return "EvalKeyRelin";
     }
     static uint32_t SerializedVersion() {
-        return 1;
+        return 2;
     }
 
 private:
+    // regenerates A from the seed; B holds the parameters of every Element of A
+    void ExpandAVector() const {
+        std::lock_guard<std::mutex> lock(m_expandMutex);
+        if (m_expanded.load(std::memory_order_relaxed))
+            return;
+
+        const auto& b = m_rKey.at(1);
+        std::vector<Element> a;
+        a.reserve(b.size());
+        for (uint32_t i = 0; i < b.size(); ++i)
+            a.push_back(ExpandKeySeed(m_seed, i, b[i].GetParams()));
+        m_rKey[0] = std::move(a);
+        m_expanded.store(true, std::memory_order_release);
+    }
+
     // private member to store vector of vector of Element.
-    std::vector<std::vector<Element>> m_rKey;
+    // mutable as A is filled in on first use when it is generated from a seed
+    mutable std::vector<std::vector<Element>> m_rKey;
+
+    // seed of A if A is not stored but regenerated on first use
+    KeySeed m_seed{};
+    bool m_seeded = false;
+    mutable std::atomic<bool> m_expanded{false};
+    mutable std::mutex m_expandMutex;
 
     // Used for hybrid key switching
     std::vector<DCRTPoly> m_dcrtKeys;
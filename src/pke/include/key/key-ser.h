@@ -37,6 +37,7 @@
 #define LBCRYPTO_CRYPTO_KEY_KEY_SER_H
 
 #include "key/evalkeyrelin.h"
+#include "key/publickey.h"
 #include "utils/serial.h"
 
 CEREAL_REGISTER_TYPE(lbcrypto::EvalKeyImpl<lbcrypto::DCRTPoly>);
@@ -45,4 +46,9 @@ CEREAL_REGISTER_TYPE(lbcrypto::EvalKeyRelinImpl<lbcrypto::DCRTPoly>);
 CEREAL_REGISTER_POLYMORPHIC_RELATION(lbcrypto::EvalKeyImpl<lbcrypto::DCRTPoly>,
                                      lbcrypto::EvalKeyRelinImpl<lbcrypto::DCRTPoly>);
 
+CEREAL_CLASS_VERSION(lbcrypto::EvalKeyRelinImpl<lbcrypto::DCRTPoly>,
+                     lbcrypto::EvalKeyRelinImpl<lbcrypto::DCRTPoly>::SerializedVersion());
+CEREAL_CLASS_VERSION(lbcrypto::PublicKeyImpl<lbcrypto::DCRTPoly>,
+                     lbcrypto::PublicKeyImpl<lbcrypto::DCRTPoly>::SerializedVersion());
+
 #endif
@@ -0,0 +1,78 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Seeds from which the uniformly random components of keys are regenerated
+ */
+
+#ifndef LBCRYPTO_CRYPTO_KEY_KEYSEED_H
+#define LBCRYPTO_CRYPTO_KEY_KEYSEED_H
+
+#include "lattice/lat-hal.h"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @namespace lbcrypto
+ * The namespace of lbcrypto
+ */
+namespace lbcrypto {
+
+/**
+ * @brief 256-bit seed of the uniformly random component of a key (the "a" polynomials of public keys and
+ * key switching keys). Keys generated from a seed store and serialize only the seed for that component.
+ */
+using KeySeed = std::array<uint32_t, 8>;
+
+/**
+ * Draws a fresh seed from the PRNG used for all other key material
+ *
+ * @return the seed.
+ */
+KeySeed GenerateKeySeed();
+
+/**
+ * Expands a seed into a uniformly random polynomial in EVALUATION format. Every tower is drawn from its own
+ * Blake2Engine stream keyed by (seed, index, tower) with plain rejection sampling, so the result depends
+ * neither on the number of threads nor on the standard library.
+ *
+ * @param seed the seed.
+ * @param index distinguishes the polynomials expanded from the same seed, e.g., the digits of a key switching key.
+ * @param params the parameters of the polynomial.
+ * @return the uniformly random polynomial.
+ */
+DCRTPoly ExpandKeySeed(const KeySeed& seed, uint32_t index, const std::shared_ptr<ILDCRTParams<BigInteger>>& params);
+
+}  // namespace lbcrypto
+
+#endif
@@ -38,8 +38,11 @@
 
 #include "key/publickey-fwd.h"
 #include "key/key.h"
+#include "key/keyseed.h"
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 #include <utility>
@@ -71,7 +74,11 @@ public:
    *@param &rhs PublicKeyImpl to copy from
    */
     explicit PublicKeyImpl(const PublicKeyImpl<Element>& rhs)
-        : Key<Element>(rhs.GetCryptoContext(), rhs.GetKeyTag()), m_h(rhs.m_h) {}
+        : Key<Element>(rhs.GetCryptoContext(), rhs.GetKeyTag()),
+          m_h(rhs.m_h),
+          m_seed(rhs.m_seed),
+          m_seeded(rhs.m_seeded),
+          m_expanded(rhs.m_expanded.load()) {}
 
     /**
    * Move constructor
@@ -79,7 +86,11 @@ public:
    *@param &rhs PublicKeyImpl to move from
    */
     explicit PublicKeyImpl(PublicKeyImpl<Element>&& rhs) noexcept
-        : Key<Element>(rhs.GetCryptoContext(), rhs.GetKeyTag()), m_h(std::move(rhs.m_h)) {}
+        : Key<Element>(rhs.GetCryptoContext(), rhs.GetKeyTag()),
+          m_h(std::move(rhs.m_h)),
+          m_seed(rhs.m_seed),
+          m_seeded(rhs.m_seeded),
+          m_expanded(rhs.m_expanded.load()) {}
 
     operator bool() const {
         return static_cast<bool>(this->context) && m_h.size() != 0;
@@ -92,7 +103,10 @@ public:
    */
     PublicKeyImpl<Element>& operator=(const PublicKeyImpl<Element>& rhs) {
         CryptoObject<Element>::operator=(rhs);
-        this->m_h = rhs.m_h;
+        this->m_h  = rhs.m_h;
+        m_seed     = rhs.m_seed;
+        m_seeded   = rhs.m_seeded;
+        m_expanded = rhs.m_expanded.load();
         return *this;
     }
 
@@ -103,7 +117,10 @@ public:
    */
     PublicKeyImpl<Element>& operator=(PublicKeyImpl<Element>&& rhs) {
         CryptoObject<Element>::operator=(rhs);
-        m_h = std::move(rhs.m_h);
+        m_h        = std::move(rhs.m_h);
+        m_seed     = rhs.m_seed;
+        m_seeded   = rhs.m_seeded;
+        m_expanded = rhs.m_expanded.load();
         return *this;
     }
 
@@ -114,9 +131,29 @@ public:
    * @return the public key element.
    */
     const std::vector<Element>& GetPublicElements() const {
+        if (m_seeded && !m_expanded.load(std::memory_order_acquire))
+            ExpandPublicElements();
         return this->m_h;
     }
 
+    /**
+   * Checks whether the uniformly random public key Element (at index 1) is regenerated from a seed.
+   * @return true if the Element is regenerated from a seed.
+   */
+    bool HasPublicElementSeed() const {
+        return m_seeded;
+    }
+
+    /**
+   * Gets the seed of the uniformly random public key Element.
+   * @return the seed.
+   */
+    const KeySeed& GetPublicElementSeed() const {
+        if (!m_seeded)
+            OPENFHE_THROW("The public key is not generated from a seed");
+        return m_seed;
+    }
+
     // @Set Properties
 
     /**
@@ -124,7 +161,8 @@ public:
    * @param &element is the public key Element vector to be copied.
    */
     void SetPublicElements(const std::vector<Element>& element) {
-        m_h = element;
+        m_h      = element;
+        m_seeded = false;
     }
 
     /**
@@ -132,7 +170,22 @@ public:
    * @param &&element is the public key Element vector to be moved.
    */
     void SetPublicElements(std::vector<Element>&& element) {
-        m_h = std::move(element);
+        m_h      = std::move(element);
+        m_seeded = false;
+    }
+
+    /**
+   * Sets the public key from its first Element and the seed of its uniformly random second Element,
+   * which is regenerated with the parameters of the first one on first use.
+   * @param &&element is the first public key Element to be moved.
+   * @param &seed is the seed of the second public key Element.
+   */
+    void SetPublicElements(Element&& element, const KeySeed& seed) {
+        m_h.clear();
+        m_h.push_back(std::move(element));
+        m_seed   = seed;
+        m_seeded = true;
+        m_expanded.store(false);
     }
 
     /**
@@ -140,7 +193,11 @@ public:
    * @param &element is the public key Element to be copied.
    */
     void SetPublicElementAtIndex(usint idx, const Element& element) {
+        // an explicitly set Element ends the regeneration from a seed
+        if (m_seeded)
+            GetPublicElements();
         m_h.insert(m_h.begin() + idx, element);
+        m_seeded = false;
     }
 
     /**
@@ -148,7 +205,10 @@ public:
    * @param &&element is the public key Element to be moved.
    */
     void SetPublicElementAtIndex(usint idx, Element&& element) {
+        if (m_seeded)
+            GetPublicElements();
         m_h.insert(m_h.begin() + idx, std::move(element));
+        m_seeded = false;
     }
 
     bool operator==(const PublicKeyImpl& other) const {
@@ -156,12 +216,14 @@ public:
             return false;
         }
 
-        if (m_h.size() != other.m_h.size()) {
+        const auto& h      = GetPublicElements();
+        const auto& otherH = other.GetPublicElements();
+        if (h.size() != otherH.size()) {
             return false;
         }
 
-        for (size_t i = 0; i < m_h.size(); i++) {
-            if (m_h[i] != other.m_h[i]) {
+        for (size_t i = 0; i < h.size(); i++) {
+            if (h[i] != otherH[i]) {
                 return false;
             }
         }
@@ -176,7 +238,21 @@ public:
     template <class Archive>
     void save(Archive& ar, std::uint32_t const version) const {
         ar(::cereal::base_class<Key<Element>>(this));
-        ar(::cereal::make_nvp("h", m_h));
+        if (version < 2) {
+            // the layout of version 1, with both Elements in full; archives get version 0 where key-ser.h is
+            // not included
+            ar(::cereal::make_nvp("h", GetPublicElements()));
+            return;
+        }
+        ar(::cereal::make_nvp("sd", m_seeded));
+        if (m_seeded) {
+            // only the seed of the second Element is written
+            ar(::cereal::make_nvp("s", m_seed));
+            ar(::cereal::make_nvp("b", m_h.at(0)));
+        }
+        else {
+            ar(::cereal::make_nvp("h", m_h));
+        }
     }
 
     template <class Archive>
@@ -186,18 +262,49 @@ public:
                           " is from a later version of the library");
         }
         ar(::cereal::base_class<Key<Element>>(this));
-        ar(::cereal::make_nvp("h", m_h));
+        m_seeded = false;
+        m_expanded.store(false);
+        if (version > 1)
+            ar(::cereal::make_nvp("sd", m_seeded));
+        if (m_seeded) {
+            Element b;
+            ar(::cereal::make_nvp("s", m_seed));
+            ar(::cereal::make_nvp("b", b));
+            m_h.clear();
+            m_h.push_back(std::move(b));
+        }
+        else {
+            ar(::cereal::make_nvp("h", m_h));
+        }
     }
 
     std::string SerializedObjectName() const {
         return "PublicKey";
     }
     static uint32_t SerializedVersion() {
-        return 1;
+        return 2;
     }
 
 private:
-    std::vector<Element> m_h;
+    // regenerates the second Element from the seed with the parameters of the first one
+    void ExpandPublicElements() const {
+        std::lock_guard<std::mutex> lock(m_expandMutex);
+        if (m_expanded.load(std::memory_order_relaxed))
+            return;
+
+        m_h.resize(1);
+        m_h.push_back(ExpandKeySeed(m_seed, 0, m_h[0].GetParams()));
+        m_expanded.store(true, std::memory_order_release);
+    }
+
+    // mutable as the second Element is filled in on first use when it is generated from a seed
+    mutable std::vector<Element> m_h;
+
+    // seed of the second Element if it is not stored but regenerated on first use
+    KeySeed m_seed{};
+    bool m_seeded = false;
+    mutable std::atomic<bool> m_expanded{false};
+    mutable std::mutex m_expandMutex;
 };
 
 }  // namespace lbcrypto
@@ -39,6 +39,7 @@
 #include "utils/caller_info.h"
 #include "math/hal/basicint.h"
 
+#include <complex>
 #include <map>
 #include <memory>
 #include <string>
@@ -51,30 +52,53 @@
  */
 namespace lbcrypto {
 
+/**
+ * Compact form of the plaintexts of an FFT-like linear transform (CoeffsToSlots or SlotsToCoeffs):
+ * the rotated and scaled diagonals of each level together with the parameters they are encoded with,
+ * so that the plaintexts can be encoded just before they are used.
+ */
+class CKKSLinearTransformDiagonals {
+public:
+    // m_diagonals[s][k] is the k-th diagonal of level s; empty for the entries that are not used
+    std::vector<std::vector<std::vector<std::complex<double>>>> m_diagonals;
+
+    // extended (P*Q) parameters of the plaintexts of each level
+    std::vector<std::shared_ptr<ILDCRTParams<BigInteger>>> m_params;
+
+    // number of towers to drop from m_params for the plaintexts of each level
+    std::vector<uint32_t> m_towersToDrop;
+};
+
 class CKKSBootstrapPrecom {
 public:
     CKKSBootstrapPrecom() {}
 
     CKKSBootstrapPrecom(const CKKSBootstrapPrecom& rhs) {
-        m_dim1         = rhs.m_dim1;
-        m_slots        = rhs.m_slots;
-        m_paramsEnc    = rhs.m_paramsEnc;
-        m_paramsDec    = rhs.m_paramsDec;
-        m_U0Pre        = rhs.m_U0Pre;
-        m_U0hatTPre    = rhs.m_U0hatTPre;
-        m_U0PreFFT     = rhs.m_U0PreFFT;
-        m_U0hatTPreFFT = rhs.m_U0hatTPreFFT;
+        m_dim1          = rhs.m_dim1;
+        m_slots         = rhs.m_slots;
+        m_paramsEnc     = rhs.m_paramsEnc;
+        m_paramsDec     = rhs.m_paramsDec;
+        m_U0Pre         = rhs.m_U0Pre;
+        m_U0hatTPre     = rhs.m_U0hatTPre;
+        m_U0PreFFT      = rhs.m_U0PreFFT;
+        m_U0hatTPreFFT  = rhs.m_U0hatTPreFFT;
+        m_lazyDiagonals = rhs.m_lazyDiagonals;
+        m_U0DiagFFT     = rhs.m_U0DiagFFT;
+        m_U0hatTDiagFFT = rhs.m_U0hatTDiagFFT;
     }
 
     CKKSBootstrapPrecom(CKKSBootstrapPrecom&& rhs) {
-        m_dim1         = rhs.m_dim1;
-        m_slots        = rhs.m_slots;
-        m_paramsEnc    = std::move(rhs.m_paramsEnc);
-        m_paramsDec    = std::move(rhs.m_paramsDec);
-        m_U0Pre        = std::move(rhs.m_U0Pre);
-        m_U0hatTPre    = std::move(rhs.m_U0hatTPre);
-        m_U0PreFFT     = std::move(rhs.m_U0PreFFT);
-        m_U0hatTPreFFT = std::move(rhs.m_U0hatTPreFFT);
+        m_dim1          = rhs.m_dim1;
+        m_slots         = rhs.m_slots;
+        m_paramsEnc     = std::move(rhs.m_paramsEnc);
+        m_paramsDec     = std::move(rhs.m_paramsDec);
+        m_U0Pre         = std::move(rhs.m_U0Pre);
+        m_U0hatTPre     = std::move(rhs.m_U0hatTPre);
+        m_U0PreFFT      = std::move(rhs.m_U0PreFFT);
+        m_U0hatTPreFFT  = std::move(rhs.m_U0hatTPreFFT);
+        m_lazyDiagonals = rhs.m_lazyDiagonals;
+        m_U0DiagFFT     = std::move(rhs.m_U0DiagFFT);
+        m_U0hatTDiagFFT = std::move(rhs.m_U0hatTDiagFFT);
     }
 
     virtual ~CKKSBootstrapPrecom() {}
@@ -112,6 +136,16 @@ public:
     // coefficients corresponding to conj(U0^T); used in encoding
     std::vector<std::vector<ReadOnlyPlaintext>> m_U0hatTPreFFT;
 
+    // if set, only the diagonals below are stored for the FFT-like method and the plaintexts
+    // m_U0PreFFT and m_U0hatTPreFFT are left empty
+    bool m_lazyDiagonals = false;
+
+    // diagonals corresponding to U0; used in decoding in the lazy diagonals mode
+    CKKSLinearTransformDiagonals m_U0DiagFFT;
+
+    // diagonals corresponding to conj(U0^T); used in encoding in the lazy diagonals mode
+    CKKSLinearTransformDiagonals m_U0hatTDiagFFT;
+
     template <class Archive>
     void save(Archive& ar) const {
         ar(cereal::make_nvp("dim1_Enc", m_dim1));
@@ -142,8 +176,8 @@ public:
     //------------------------------------------------------------------------------
 
     void EvalBootstrapSetup(const CryptoContextImpl<DCRTPoly>& cc, std::vector<uint32_t> levelBudget,
-                            std::vector<uint32_t> dim1, uint32_t slots, uint32_t correctionFactor,
-                            bool precompute) override;
+                            std::vector<uint32_t> dim1, uint32_t slots, uint32_t correctionFactor, bool precompute,
+                            bool lazyDiagonals) override;
 
     std::shared_ptr<std::map<usint, EvalKey<DCRTPoly>>> EvalBootstrapKeyGen(const PrivateKey<DCRTPoly> privateKey,
                                                                             uint32_t slots) override;
@@ -173,12 +207,22 @@ public:
                                                                          bool flag_i, double scale = 1,
                                                                          uint32_t L = 0) const;
 
+    CKKSLinearTransformDiagonals EvalCoeffsToSlotsDiagonals(const CryptoContextImpl<DCRTPoly>& cc,
+                                                            const std::vector<std::complex<double>>& A,
+                                                            const std::vector<uint32_t>& rotGroup, bool flag_i,
+                                                            double scale = 1, uint32_t L = 0) const;
+
     std::vector<std::vector<ReadOnlyPlaintext>> EvalSlotsToCoeffsPrecompute(const CryptoContextImpl<DCRTPoly>& cc,
                                                                          const std::vector<std::complex<double>>& A,
                                                                          const std::vector<uint32_t>& rotGroup,
                                                                          bool flag_i, double scale = 1,
                                                                          uint32_t L = 0) const;
 
+    CKKSLinearTransformDiagonals EvalSlotsToCoeffsDiagonals(const CryptoContextImpl<DCRTPoly>& cc,
+                                                            const std::vector<std::complex<double>>& A,
+                                                            const std::vector<uint32_t>& rotGroup, bool flag_i,
+                                                            double scale = 1, uint32_t L = 0) const;
+
     //------------------------------------------------------------------------------
     // EVALUATION: CoeffsToSlots and SlotsToCoeffs
     //------------------------------------------------------------------------------
@@ -250,6 +294,15 @@ private:
                                const std::vector<std::complex<double>>& value, size_t noiseScaleDeg, uint32_t level,
                                usint slots) const;
 
+    /**
+     * Gets the plaintexts first, ..., first + count - 1 of level s of an FFT-like linear transform:
+     * taken from A if it is not empty, otherwise encoded from the diagonals.
+     */
+    std::vector<ReadOnlyPlaintext> GetLevelPlaintexts(const CryptoContextImpl<DCRTPoly>& cc,
+                                                      const std::vector<std::vector<ReadOnlyPlaintext>>& A,
+                                                      const CKKSLinearTransformDiagonals& diagonals, uint32_t s,
+                                                      uint32_t first, uint32_t count) const;
+
     Ciphertext<DCRTPoly> EvalMultExt(ConstCiphertext<DCRTPoly> ciphertext, ConstPlaintext plaintext) const;
 
     void EvalAddExtInPlace(Ciphertext<DCRTPoly>& ciphertext1, ConstCiphertext<DCRTPoly> ciphertext2) const;
@@ -81,10 +81,12 @@ public:
    * @param slots - number of slots to be bootstrapped
    * @param correctionFactor - value to rescale message by to improve precision. If set to 0, we use the default logic. This value is only used when NATIVE_SIZE=64
    * @param precompute - flag specifying whether to precompute the plaintexts for encoding and decoding.
+   * @param lazyDiagonals - flag specifying whether to keep only the diagonals for the FFT-like encoding and decoding
+   * and to encode the plaintexts on the fly during bootstrapping.
    */
     virtual void EvalBootstrapSetup(const CryptoContextImpl<Element>& cc, std::vector<uint32_t> levelBudget,
                                     std::vector<uint32_t> dim1, uint32_t slots, uint32_t correctionFactor,
-                                    bool precompute) {
+                                    bool precompute, bool lazyDiagonals) {
         OPENFHE_THROW("Not supported");
     }
 
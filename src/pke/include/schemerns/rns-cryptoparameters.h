@@ -422,6 +422,46 @@ public:
         return m_paramsPartQ[part];
     }
 
+    /**
+   * Method that returns the element parameters corresponding to the first
+   * l+1 towers of the partition {Q_j} of Q, i.e., of the last digit of a
+   * ciphertext at a level where that digit is not complete.
+   * Used in Hybrid key switching
+   *
+   * @param part is the index of the partition.
+   * @param l is the index of the last tower.
+   * @return the pre-computed parameters.
+   */
+    const std::shared_ptr<ILDCRTParams<BigInteger>>& GetParamsPartQl(uint32_t part, uint32_t l) const {
+        return m_paramsPrefixPartQ[part][l];
+    }
+
+    /**
+   * Method that returns the pre-computed element parameters of the extended
+   * CRT basis {Q_l,P} = {q_0,...,q_l,p_1,...,p_k} for a polynomial over the
+   * first towers Q_l of Q, so that key switching does not build them for
+   * every call and all polynomials of a level share one parameter object.
+   * Used in Hybrid key switching
+   *
+   * @param paramsQl are the parameters of the polynomial.
+   * @return the pre-computed parameters, nullptr if paramsQl are not the
+   * first towers of Q.
+   */
+    std::shared_ptr<ILDCRTParams<BigInteger>> FindParamsQlP(
+        const std::shared_ptr<ILDCRTParams<BigInteger>>& paramsQl) const;
+
+    /**
+   * Method that returns the pre-computed element parameters of Q_l for a
+   * polynomial over the extended CRT basis {Q_l,P}.
+   * Used in Hybrid key switching
+   *
+   * @param paramsQlP are the parameters of the polynomial.
+   * @return the pre-computed parameters, nullptr if paramsQlP are not the
+   * first towers of Q followed by P.
+   */
+    std::shared_ptr<ILDCRTParams<BigInteger>> FindParamsQl(
+        const std::shared_ptr<ILDCRTParams<BigInteger>>& paramsQlP) const;
+
     /*
    * Method that returns the element parameters corresponding to the
    * complementary basis of a single digit j, i.e., the basis consisting of
@@ -1478,6 +1518,14 @@ protected:
     // Stores the parameters for complementary {\bar{Q_i},P}
     std::vector<std::vector<std::shared_ptr<ILDCRTParams<BigInteger>>>> m_paramsComplPartQ;
 
+    // Stores the parameters for the first l+1 towers of Q_i
+    std::vector<std::vector<std::shared_ptr<ILDCRTParams<BigInteger>>>> m_paramsPrefixPartQ;
+
+    // Stores the parameters for Q_l = {q_0,...,q_l} and {Q_l,P} for every l;
+    // they share the tower parameters of Q and P
+    std::vector<std::shared_ptr<ILDCRTParams<BigInteger>>> m_paramsPrefixQ;
+    std::vector<std::shared_ptr<ILDCRTParams<BigInteger>>> m_paramsPrefixQP;
+
     // Stores [{(Q_k)^(l)/q_i}^{-1}]_{q_i} for HYBRID
     std::vector<std::vector<std::vector<NativeInteger>>> m_PartQlHatInvModq;
 
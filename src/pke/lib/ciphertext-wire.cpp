@@ -0,0 +1,407 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+  Implementation of the flat wire format of DCRT ciphertexts
+ */
+
+#include "ciphertext-wire.h"
+#include "cryptocontext.h"
+
+#include "utils/exception.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <istream>
+#include <new>
+#include <ostream>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <climits>
+    #include <sys/uio.h>
+    #include <unistd.h>
+    #define CIPHERTEXT_WIRE_POSIX 1
+#else
+    #define CIPHERTEXT_WIRE_POSIX 0
+#endif
+
+namespace lbcrypto {
+
+namespace {
+
+constexpr char CIPHERTEXT_WIRE_MAGIC[8]      = {'O', 'F', 'H', 'E', 'C', 'T', 'W', 'F'};
+constexpr uint64_t CIPHERTEXT_WIRE_BYTEORDER = 0x0102030405060708;
+constexpr uint64_t CIPHERTEXT_WIRE_ALIGN     = 64;
+// the key tags of OpenFHE have 32 characters
+constexpr uint32_t CIPHERTEXT_WIRE_MAX_KEY_TAG = 256;
+
+// the fixed part of the header
+struct CiphertextWireHeader {
+    char magic[8];
+    uint32_t version;
+    // bytes before the first tower
+    uint32_t headerSize;
+    uint64_t byteOrder;
+    // bytes of the whole message
+    uint64_t totalSize;
+    // bytes per coefficient
+    uint32_t wordSize;
+    uint32_t ringDim;
+    uint32_t numElements;
+    uint32_t numTowers;
+    uint32_t format;
+    uint32_t keyTagSize;
+    // attributes of the ciphertext
+    uint32_t level;
+    uint32_t noiseScaleDeg;
+    uint32_t hopLevel;
+    uint32_t slots;
+    uint32_t encodingType;
+    uint32_t reserved0;
+    double scalingFactor;
+    uint64_t scalingFactorInt;
+    uint64_t reserved[4];
+};
+
+static_assert(sizeof(CiphertextWireHeader) == CIPHERTEXT_WIRE_PREFIX_SIZE, "unexpected wire header size");
+
+// the fixed part of the header of the message at data, checked for what a reader of this version needs
+CiphertextWireHeader ReadHeader(const void* data, size_t size) {
+    if (size < CIPHERTEXT_WIRE_PREFIX_SIZE)
+        OPENFHE_THROW("The ciphertext message is truncated");
+    CiphertextWireHeader h;
+    std::memcpy(&h, data, sizeof(h));
+    if (std::memcmp(h.magic, CIPHERTEXT_WIRE_MAGIC, sizeof(h.magic)) != 0)
+        OPENFHE_THROW("Not a ciphertext message");
+    if (h.version == 0 || h.version > CIPHERTEXT_WIRE_VERSION)
+        OPENFHE_THROW("The ciphertext message has version " + std::to_string(h.version) +
+                      ", this library reads up to version " + std::to_string(CIPHERTEXT_WIRE_VERSION));
+    if (h.byteOrder != CIPHERTEXT_WIRE_BYTEORDER)
+        OPENFHE_THROW("The ciphertext message was written on a machine of another byte order");
+    if (h.wordSize != sizeof(NativeInteger))
+        OPENFHE_THROW("The ciphertext message has " + std::to_string(h.wordSize) + "-byte coefficients, expected " +
+                      std::to_string(sizeof(NativeInteger)));
+    // the header of version 1 is padded to the next multiple of CIPHERTEXT_WIRE_ALIGN, and not beyond
+    const uint64_t headerSize{(CIPHERTEXT_WIRE_PREFIX_SIZE + 2 * sizeof(uint64_t) * uint64_t(h.numTowers) +
+                               h.keyTagSize + CIPHERTEXT_WIRE_ALIGN - 1) &
+                              ~(CIPHERTEXT_WIRE_ALIGN - 1)};
+    if (h.ringDim == 0 || h.numElements == 0 || h.numTowers == 0 || h.keyTagSize > CIPHERTEXT_WIRE_MAX_KEY_TAG ||
+        h.headerSize != headerSize || h.totalSize < h.headerSize)
+        OPENFHE_THROW("The header of the ciphertext message is corrupt");
+    const uint64_t towerSize{uint64_t(h.ringDim) * h.wordSize};
+    const uint64_t payload{h.totalSize - h.headerSize};
+    if (payload % towerSize != 0 || payload / towerSize != uint64_t(h.numElements) * h.numTowers)
+        OPENFHE_THROW("The header of the ciphertext message is corrupt");
+    return h;
+}
+
+// checks the fixed part of the header against the context, before anything is allocated for the message
+void CheckHeader(const CryptoContext<DCRTPoly>& cc, const CiphertextWireHeader& h) {
+    const auto& contextParams{cc->GetElementParams()};
+    if (contextParams->GetRingDimension() != h.ringDim)
+        OPENFHE_THROW("The ciphertext message has ring dimension " + std::to_string(h.ringDim) +
+                      ", the context has " + std::to_string(contextParams->GetRingDimension()));
+    if (h.numTowers > contextParams->GetParams().size())
+        OPENFHE_THROW("The ciphertext message has " + std::to_string(h.numTowers) + " towers, the context has " +
+                      std::to_string(contextParams->GetParams().size()));
+    // a ciphertext has up to one element more than the highest degree of the secret key it can be relinearized for
+    const uint32_t maxElements{cc->GetCryptoParameters()->GetMaxRelinSkDeg() + 1};
+    if (h.numElements > std::max<uint32_t>(maxElements, 2))
+        OPENFHE_THROW("The ciphertext message has " + std::to_string(h.numElements) +
+                      " elements, the context relinearizes up to " + std::to_string(maxElements));
+    if (h.format != static_cast<uint32_t>(Format::EVALUATION) && h.format != static_cast<uint32_t>(Format::COEFFICIENT))
+        OPENFHE_THROW("The ciphertext message has the unknown format " + std::to_string(h.format));
+    if (h.encodingType > static_cast<uint32_t>(CKKS_PACKED_ENCODING))
+        OPENFHE_THROW("The ciphertext message has the unknown encoding " + std::to_string(h.encodingType));
+}
+
+// the params of the towers, which have to be the first towers of the context; table is the tower table of the
+// message, checked by CheckHeader to have no more towers than the context
+std::shared_ptr<DCRTPoly::Params> TowerParams(const CryptoContext<DCRTPoly>& cc, const CiphertextWireHeader& h,
+                                              const uint8_t* table) {
+    const auto& contextParams{cc->GetElementParams()};
+    const auto& contextTowers{contextParams->GetParams()};
+    for (uint32_t i = 0; i < h.numTowers; ++i) {
+        uint64_t moduli[2];
+        std::memcpy(moduli, table + i * sizeof(moduli), sizeof(moduli));
+        if (contextTowers[i]->GetModulus() != NativeInteger(moduli[0]) ||
+            contextTowers[i]->GetRootOfUnity() != NativeInteger(moduli[1]))
+            OPENFHE_THROW("Tower " + std::to_string(i) + " of the ciphertext message does not match the context");
+    }
+    if (h.numTowers == contextTowers.size())
+        return contextParams;
+
+    // messages of the same level share their params
+    thread_local std::weak_ptr<DCRTPoly::Params> cached;
+    auto params = cached.lock();
+    if (params != nullptr && params->GetParams().size() == h.numTowers &&
+        std::equal(contextTowers.begin(), contextTowers.begin() + h.numTowers, params->GetParams().begin()))
+        return params;
+    const std::vector<std::shared_ptr<ILNativeParams>> towers(contextTowers.begin(),
+                                                              contextTowers.begin() + h.numTowers);
+    params = std::make_shared<DCRTPoly::Params>(contextParams->GetCyclotomicOrder(), towers);
+    cached = params;
+    return params;
+}
+
+// 64-byte aligned buffer of size bytes
+std::shared_ptr<uint8_t> AllocateMessage(size_t size) {
+    auto* data = static_cast<uint8_t*>(::operator new(size, std::align_val_t(CIPHERTEXT_WIRE_ALIGN)));
+    return std::shared_ptr<uint8_t>(data,
+                                    [](uint8_t* p) { ::operator delete(p, std::align_val_t(CIPHERTEXT_WIRE_ALIGN)); });
+}
+
+// reads a message with readFully(data, size), checking the header and the tower table against the context before
+// the buffer of the message is allocated
+template <typename ReadFully>
+Ciphertext<DCRTPoly> ReadMessage(const CryptoContext<DCRTPoly>& cc, ReadFully&& readFully) {
+    uint8_t prefix[CIPHERTEXT_WIRE_PREFIX_SIZE];
+    readFully(prefix, sizeof(prefix));
+    const auto h = ReadHeader(prefix, sizeof(prefix));
+    CheckHeader(cc, h);
+    std::vector<uint8_t> table(2 * sizeof(uint64_t) * h.numTowers);
+    readFully(table.data(), table.size());
+    TowerParams(cc, h, table.data());
+
+    const size_t size{h.totalSize};
+    auto message = AllocateMessage(size);
+    std::memcpy(message.get(), prefix, sizeof(prefix));
+    std::memcpy(message.get() + sizeof(prefix), table.data(), table.size());
+    readFully(message.get() + sizeof(prefix) + table.size(), size - sizeof(prefix) - table.size());
+    return AdoptCiphertextWire(cc, message.get(), size, message);
+}
+
+}  // namespace
+
+std::vector<CiphertextWireBuffer> GetCiphertextWireBuffers(ConstCiphertext<DCRTPoly>& ciphertext,
+                                                           std::vector<uint8_t>& header) {
+    const auto& elements{ciphertext->GetElements()};
+    if (elements.empty() || elements[0].GetNumOfElements() == 0)
+        OPENFHE_THROW("Cannot write an empty ciphertext");
+    const auto& params{elements[0].GetParams()};
+    const uint32_t ringDim{params->GetRingDimension()};
+    const size_t numTowers{elements[0].GetNumOfElements()};
+    const Format format{elements[0].GetFormat()};
+    for (const auto& element : elements) {
+        if (element.GetNumOfElements() != numTowers || element.GetRingDimension() != ringDim ||
+            element.GetFormat() != format)
+            OPENFHE_THROW("The elements of the ciphertext do not have the same towers and format");
+        for (const auto& tower : element.GetAllElements()) {
+            if (tower.IsEmpty())
+                OPENFHE_THROW("Cannot write a ciphertext with empty towers");
+        }
+    }
+
+    const std::string& keyTag{ciphertext->GetKeyTag()};
+    if (keyTag.size() > CIPHERTEXT_WIRE_MAX_KEY_TAG)
+        OPENFHE_THROW("The key tag of the ciphertext is longer than " + std::to_string(CIPHERTEXT_WIRE_MAX_KEY_TAG) +
+                      " characters");
+    const uint64_t tableSize{2 * sizeof(uint64_t) * numTowers};
+    const uint64_t headerSize{(CIPHERTEXT_WIRE_PREFIX_SIZE + tableSize + keyTag.size() + CIPHERTEXT_WIRE_ALIGN - 1) &
+                              ~(CIPHERTEXT_WIRE_ALIGN - 1)};
+    const uint64_t towerSize{uint64_t(ringDim) * sizeof(NativeInteger)};
+
+    CiphertextWireHeader h{};
+    std::memcpy(h.magic, CIPHERTEXT_WIRE_MAGIC, sizeof(h.magic));
+    h.version          = CIPHERTEXT_WIRE_VERSION;
+    h.headerSize       = static_cast<uint32_t>(headerSize);
+    h.byteOrder        = CIPHERTEXT_WIRE_BYTEORDER;
+    h.totalSize        = headerSize + elements.size() * numTowers * towerSize;
+    h.wordSize         = sizeof(NativeInteger);
+    h.ringDim          = ringDim;
+    h.numElements      = static_cast<uint32_t>(elements.size());
+    h.numTowers        = static_cast<uint32_t>(numTowers);
+    h.format           = static_cast<uint32_t>(format);
+    h.keyTagSize       = static_cast<uint32_t>(keyTag.size());
+    h.level            = static_cast<uint32_t>(ciphertext->GetLevel());
+    h.noiseScaleDeg    = static_cast<uint32_t>(ciphertext->GetNoiseScaleDeg());
+    h.hopLevel         = static_cast<uint32_t>(ciphertext->GetHopLevel());
+    h.slots            = ciphertext->GetSlots();
+    h.encodingType     = static_cast<uint32_t>(ciphertext->GetEncodingType());
+    h.scalingFactor    = ciphertext->GetScalingFactor();
+    h.scalingFactorInt = ciphertext->GetScalingFactorInt().ConvertToInt<uint64_t>();
+
+    header.assign(headerSize, 0);
+    std::memcpy(header.data(), &h, sizeof(h));
+    uint8_t* table{header.data() + CIPHERTEXT_WIRE_PREFIX_SIZE};
+    for (size_t i = 0; i < numTowers; ++i) {
+        const auto& towerParams{elements[0].GetElementAtIndex(i).GetParams()};
+        const uint64_t moduli[2]{towerParams->GetModulus().ConvertToInt<uint64_t>(),
+                                 towerParams->GetRootOfUnity().ConvertToInt<uint64_t>()};
+        std::memcpy(table + i * sizeof(moduli), moduli, sizeof(moduli));
+    }
+    std::memcpy(table + tableSize, keyTag.data(), keyTag.size());
+
+    std::vector<CiphertextWireBuffer> buffers{{header.data(), header.size()}};
+    buffers.reserve(1 + elements.size() * numTowers);
+    for (const auto& element : elements) {
+        for (const auto& tower : element.GetAllElements()) {
+            const auto* data = reinterpret_cast<const uint8_t*>(tower.GetValues().data());
+            // the towers of a contiguous polynomial make one piece
+            auto& last = buffers.back();
+            if (buffers.size() > 1 && static_cast<const uint8_t*>(last.data) + last.size == data)
+                last.size += towerSize;
+            else
+                buffers.push_back({data, towerSize});
+        }
+    }
+    return buffers;
+}
+
+size_t WriteCiphertextWire(int fd, ConstCiphertext<DCRTPoly>& ciphertext) {
+#if CIPHERTEXT_WIRE_POSIX
+    std::vector<uint8_t> header;
+    auto buffers = GetCiphertextWireBuffers(ciphertext, header);
+    std::vector<struct iovec> iov(buffers.size());
+    for (size_t i = 0; i < buffers.size(); ++i)
+        iov[i] = {const_cast<void*>(buffers[i].data), buffers[i].size};
+
+    size_t written{0};
+    size_t first{0};
+    while (first < iov.size()) {
+        const auto count = static_cast<int>(std::min<size_t>(iov.size() - first, IOV_MAX));
+        const ssize_t n{writev(fd, iov.data() + first, count)};
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            OPENFHE_THROW("Cannot write the ciphertext message: " + std::string(std::strerror(errno)));
+        }
+        written += static_cast<size_t>(n);
+        // skip what was written, resuming in the middle of a piece after a partial write
+        auto left = static_cast<size_t>(n);
+        while (first < iov.size() && left >= iov[first].iov_len)
+            left -= iov[first++].iov_len;
+        if (left > 0) {
+            iov[first].iov_base = static_cast<uint8_t*>(iov[first].iov_base) + left;
+            iov[first].iov_len -= left;
+        }
+    }
+    return written;
+#else
+    OPENFHE_THROW("Writing ciphertext messages to file descriptors is not supported on this platform");
+#endif
+}
+
+size_t WriteCiphertextWire(std::ostream& os, ConstCiphertext<DCRTPoly>& ciphertext) {
+    std::vector<uint8_t> header;
+    size_t written{0};
+    for (const auto& buffer : GetCiphertextWireBuffers(ciphertext, header)) {
+        os.write(static_cast<const char*>(buffer.data), static_cast<std::streamsize>(buffer.size));
+        written += buffer.size;
+    }
+    if (!os)
+        OPENFHE_THROW("Cannot write the ciphertext message");
+    return written;
+}
+
+size_t GetCiphertextWireSize(const void* data, size_t size) {
+    if (size < CIPHERTEXT_WIRE_PREFIX_SIZE)
+        return 0;
+    return ReadHeader(data, size).totalSize;
+}
+
+Ciphertext<DCRTPoly> AdoptCiphertextWire(const CryptoContext<DCRTPoly>& cc, void* data, size_t size,
+                                         std::shared_ptr<void> owner) {
+    const auto h = ReadHeader(data, size);
+    if (h.totalSize > size)
+        OPENFHE_THROW("The ciphertext message is truncated");
+    if (reinterpret_cast<uintptr_t>(data) % alignof(NativeInteger) != 0)
+        OPENFHE_THROW("The ciphertext message is not aligned");
+    CheckHeader(cc, h);
+
+    auto* bytes = static_cast<uint8_t*>(data);
+    auto params = TowerParams(cc, h, bytes + CIPHERTEXT_WIRE_PREFIX_SIZE);
+    const std::string keyTag(reinterpret_cast<const char*>(bytes) + CIPHERTEXT_WIRE_PREFIX_SIZE +
+                                 2 * sizeof(uint64_t) * h.numTowers,
+                             h.keyTagSize);
+
+    auto ciphertext = std::make_shared<CiphertextImpl<DCRTPoly>>(cc, keyTag,
+                                                                 static_cast<PlaintextEncodings>(h.encodingType));
+    std::vector<DCRTPoly> elements;
+    elements.reserve(h.numElements);
+    auto* towers = reinterpret_cast<NativeInteger*>(bytes + h.headerSize);
+
+    // the residues have to be reduced; one pass over the towers, which are about to be used anyway
+    const auto* words = reinterpret_cast<const uint64_t*>(towers);
+    for (uint32_t i = 0; i < h.numElements; ++i) {
+        for (uint32_t t = 0; t < h.numTowers; ++t, words += h.ringDim) {
+            const uint64_t q{params->GetParams()[t]->GetModulus().ConvertToInt<uint64_t>()};
+            if (std::any_of(words, words + h.ringDim, [q](uint64_t x) { return x >= q; }))
+                OPENFHE_THROW("Tower " + std::to_string(t) + " of element " + std::to_string(i) +
+                              " of the ciphertext message has residues that are not reduced");
+        }
+    }
+    for (uint32_t i = 0; i < h.numElements; ++i) {
+        elements.emplace_back(params, static_cast<Format>(h.format));
+        elements.back().AdoptContiguous(towers + size_t(i) * h.numTowers * h.ringDim, owner);
+    }
+    ciphertext->SetElements(std::move(elements));
+    ciphertext->SetLevel(h.level);
+    ciphertext->SetNoiseScaleDeg(h.noiseScaleDeg);
+    ciphertext->SetHopLevel(h.hopLevel);
+    ciphertext->SetSlots(h.slots);
+    ciphertext->SetScalingFactor(h.scalingFactor);
+    ciphertext->SetScalingFactorInt(NativeInteger(h.scalingFactorInt));
+    return ciphertext;
+}
+
+Ciphertext<DCRTPoly> ReadCiphertextWire(const CryptoContext<DCRTPoly>& cc, int fd) {
+#if CIPHERTEXT_WIRE_POSIX
+    // reads exactly size bytes
+    return ReadMessage(cc, [fd](uint8_t* data, size_t size) {
+        while (size > 0) {
+            const ssize_t n{read(fd, data, size)};
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n < 0)
+                OPENFHE_THROW("Cannot read the ciphertext message: " + std::string(std::strerror(errno)));
+            if (n == 0)
+                OPENFHE_THROW("The ciphertext message is truncated");
+            data += n;
+            size -= static_cast<size_t>(n);
+        }
+    });
+#else
+    OPENFHE_THROW("Reading ciphertext messages from file descriptors is not supported on this platform");
+#endif
+}
+
+Ciphertext<DCRTPoly> ReadCiphertextWire(const CryptoContext<DCRTPoly>& cc, std::istream& is) {
+    return ReadMessage(cc, [&is](uint8_t* data, size_t size) {
+        if (!is.read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(size)))
+            OPENFHE_THROW("The ciphertext message is truncated");
+    });
+}
+
+}  // namespace lbcrypto
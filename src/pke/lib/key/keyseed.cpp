@@ -0,0 +1,85 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Seeds from which the uniformly random components of keys are regenerated
+ */
+
+#include "key/keyseed.h"
+
+#include "math/distributiongenerator.h"
+#include "utils/parallel.h"
+#include "utils/prng/blake2engine.h"
+
+namespace lbcrypto {
+
+KeySeed GenerateKeySeed() {
+    KeySeed seed;
+    auto& prng = PseudoRandomNumberGenerator::GetPRNG();
+    for (auto& word : seed)
+        word = prng();
+    return seed;
+}
+
+DCRTPoly ExpandKeySeed(const KeySeed& seed, uint32_t index, const std::shared_ptr<ILDCRTParams<BigInteger>>& params) {
+    DCRTPoly result(params, Format::EVALUATION);
+    auto& towers = result.GetAllElements();
+
+    uint32_t sizeQ = towers.size();
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(sizeQ))
+    for (uint32_t i = 0; i < sizeQ; ++i) {
+        default_prng::Blake2Engine::blake2_seed_array_t engineSeed{};
+        std::copy(seed.begin(), seed.end(), engineSeed.begin());
+        engineSeed[seed.size()]     = index;
+        engineSeed[seed.size() + 1] = i;
+        default_prng::Blake2Engine engine(engineSeed, 0);
+
+        const NativeInteger& qi = params->GetParams()[i]->GetModulus();
+        const uint64_t q        = qi.ConvertToInt<uint64_t>();
+        const uint32_t bits     = qi.GetMSB();
+        const uint64_t mask     = (bits >= 64) ? ~uint64_t(0) : (uint64_t(1) << bits) - 1;
+
+        uint32_t n = params->GetRingDimension();
+        NativeVector values(n, qi);
+        for (uint32_t j = 0; j < n;) {
+            uint64_t v = engine();
+            if (bits > 32)
+                v |= static_cast<uint64_t>(engine()) << 32;
+            v &= mask;
+            if (v < q)
+                values[j++] = v;
+        }
+        towers[i].SetValues(std::move(values), Format::EVALUATION);
+    }
+    return result;
+}
+
+}  // namespace lbcrypto
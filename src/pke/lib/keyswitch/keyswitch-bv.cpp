@@ -60,7 +60,6 @@ EvalKey<DCRTPoly> KeySwitchBV::KeySwitchGenInternal(const PrivateKey<DCRTPoly> o
 
     const auto ns      = cryptoParams->GetNoiseScale();
     const DggType& dgg = cryptoParams->GetDiscreteGaussianGenerator();
-    DugType dug;
 
     usint digitSize = cryptoParams->GetDigitSize();
 
@@ -83,7 +82,8 @@ EvalKey<DCRTPoly> KeySwitchBV::KeySwitchGenInternal(const PrivateKey<DCRTPoly> o
         nWindows = sizeSOld;
     }
 
-    std::vector<DCRTPoly> av(nWindows);
+    // the a_i vectors are regenerated from a seed instead of being stored
+    const KeySeed seed = GenerateKeySeed();
     std::vector<DCRTPoly> bv(nWindows);
 
     if (digitSize > 0) {
@@ -94,11 +94,10 @@ EvalKey<DCRTPoly> KeySwitchBV::KeySwitchGenInternal(const PrivateKey<DCRTPoly> o
                 DCRTPoly filtered(elementParams, Format::EVALUATION, true);
                 filtered.SetElementAtIndex(i, sOldDecomposed[k]);
 
-                DCRTPoly a(dug, elementParams, Format::EVALUATION);
+                DCRTPoly a = ExpandKeySeed(seed, k + arrWindows[i], elementParams);
                 DCRTPoly e(dgg, elementParams, Format::EVALUATION);
 
-                av[k + arrWindows[i]] = std::move(a);
-                bv[k + arrWindows[i]] = filtered - (av[k + arrWindows[i]] * sNew + ns * e);
+                bv[k + arrWindows[i]] = filtered - (a * sNew + ns * e);
             }
         }
     }
@@ -107,15 +106,14 @@ EvalKey<DCRTPoly> KeySwitchBV::KeySwitchGenInternal(const PrivateKey<DCRTPoly> o
             DCRTPoly filtered(elementParams, Format::EVALUATION, true);
             filtered.SetElementAtIndex(i, sOld.GetElementAtIndex(i));
 
-            DCRTPoly a(dug, elementParams, Format::EVALUATION);
+            DCRTPoly a = ExpandKeySeed(seed, i, elementParams);
             DCRTPoly e(dgg, elementParams, Format::EVALUATION);
 
-            av[i] = std::move(a);
-            bv[i] = filtered - (av[i] * sNew + ns * e);
+            bv[i] = filtered - (a * sNew + ns * e);
         }
     }
 
-    ek->SetAVector(std::move(av));
+    ek->SetAVectorSeed(seed);
     ek->SetBVector(std::move(bv));
     ek->SetKeyTag(newKey->GetKeyTag());
 
@@ -136,7 +134,6 @@ EvalKey<DCRTPoly> KeySwitchBV::KeySwitchGenInternal(const PrivateKey<DCRTPoly> o
 
     const auto ns      = cryptoParams->GetNoiseScale();
     const DggType& dgg = cryptoParams->GetDiscreteGaussianGenerator();
-    DugType dug;
 
     usint digitSize = cryptoParams->GetDigitSize();
 
@@ -159,6 +156,10 @@ EvalKey<DCRTPoly> KeySwitchBV::KeySwitchGenInternal(const PrivateKey<DCRTPoly> o
         nWindows = sizeSOld;
     }
 
+    // the a_i vectors are regenerated from a seed unless they come from a threshold key that stores them in full
+    const bool seeded  = (ek == nullptr) || ek->HasAVectorSeed();
+    const KeySeed seed = (ek == nullptr) ? GenerateKeySeed() : seeded ? ek->GetAVectorSeed() : KeySeed{};
+
     std::vector<DCRTPoly> av(nWindows);
     std::vector<DCRTPoly> bv(nWindows);
 
@@ -170,9 +171,9 @@ EvalKey<DCRTPoly> KeySwitchBV::KeySwitchGenInternal(const PrivateKey<DCRTPoly> o
                 DCRTPoly filtered(elementParams, Format::EVALUATION, true);
                 filtered.SetElementAtIndex(i, sOldDecomposed[k]);
 
-                if (ek == nullptr) {  // single-key HE
+                if (seeded) {  // single-key HE or seeded threshold HE
                     // Generate a_i vectors
-                    av[k + arrWindows[i]] = DCRTPoly(dug, elementParams, Format::EVALUATION);
+                    av[k + arrWindows[i]] = ExpandKeySeed(seed, k + arrWindows[i], elementParams);
                 }
                 else {  // threshold HE
                     av[k + arrWindows[i]] = ek->GetAVector()[k + arrWindows[i]];
@@ -188,9 +189,9 @@ EvalKey<DCRTPoly> KeySwitchBV::KeySwitchGenInternal(const PrivateKey<DCRTPoly> o
             DCRTPoly filtered(elementParams, Format::EVALUATION, true);
             filtered.SetElementAtIndex(i, sOld.GetElementAtIndex(i));
 
-            if (ek == nullptr) {  // single-key HE
+            if (seeded) {  // single-key HE or seeded threshold HE
                 // Generate a_i vectors
-                av[i] = DCRTPoly(dug, elementParams, Format::EVALUATION);
+                av[i] = ExpandKeySeed(seed, i, elementParams);
             }
             else {  // threshold HE
                 av[i] = ek->GetAVector()[i];
@@ -201,7 +202,10 @@ EvalKey<DCRTPoly> KeySwitchBV::KeySwitchGenInternal(const PrivateKey<DCRTPoly> o
         }
     }
 
-    evalKey->SetAVector(std::move(av));
+    if (seeded)
+        evalKey->SetAVectorSeed(seed);
+    else
+        evalKey->SetAVector(std::move(av));
     evalKey->SetBVector(std::move(bv));
     evalKey->SetKeyTag(newKey->GetKeyTag());
 
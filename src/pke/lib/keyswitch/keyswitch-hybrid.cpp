@@ -42,6 +42,8 @@
 #include "key/evalkeyrelin.h"
 #include "scheme/ckksrns/ckksrns-cryptoparameters.h"
 #include "ciphertext.h"
+#include "utils/blockAllocator/arenaallocator.h"
+#include "math/hal/intnat/innerprodnat.h"
 
 namespace lbcrypto {
 
@@ -89,19 +91,22 @@ EvalKey<DCRTPoly> KeySwitchHYBRID::KeySwitchGenInternal(const PrivateKey<DCRTPol
 
     const auto ns      = cryptoParams->GetNoiseScale();
     const DggType& dgg = cryptoParams->GetDiscreteGaussianGenerator();
-    DugType dug;
 
     size_t numPartQ = cryptoParams->GetNumPartQ();
 
-    std::vector<DCRTPoly> av(numPartQ);
+    // the a_i vectors are regenerated from a seed unless they come from a threshold key that stores them in full
+    const bool seeded  = (ekPrev == nullptr) || ekPrev->HasAVectorSeed();
+    const KeySeed seed = (ekPrev == nullptr) ? GenerateKeySeed() : seeded ? ekPrev->GetAVectorSeed() : KeySeed{};
+
+    std::vector<DCRTPoly> av(seeded ? 0 : numPartQ);
     std::vector<DCRTPoly> bv(numPartQ);
 
     std::vector<NativeInteger> PModq = cryptoParams->GetPModq();
     size_t numPerPartQ               = cryptoParams->GetNumPerPartQ();
 
     for (size_t part = 0; part < numPartQ; ++part) {
-        DCRTPoly a = (ekPrev == nullptr) ? DCRTPoly(dug, paramsQP, Format::EVALUATION) :  // single-key HE
-                                           ekPrev->GetAVector()[part];                                      // threshold HE
+        DCRTPoly a = seeded ? ExpandKeySeed(seed, part, paramsQP) :  // single-key HE or seeded threshold HE
+                         ekPrev->GetAVector()[part];                     // threshold HE
         DCRTPoly e(dgg, paramsQP, Format::EVALUATION);
         DCRTPoly b(paramsQP, Format::EVALUATION, true);
 
@@ -124,11 +129,15 @@ EvalKey<DCRTPoly> KeySwitchHYBRID::KeySwitchGenInternal(const PrivateKey<DCRTPol
             }
         }
 
-        av[part] = a;
+        if (!seeded)
+            av[part] = a;
         bv[part] = b;
     }
 
-    ek->SetAVector(std::move(av));
+    if (seeded)
+        ek->SetAVectorSeed(seed);
+    else
+        ek->SetAVector(std::move(av));
     ek->SetBVector(std::move(bv));
     ek->SetKeyTag(newKey->GetKeyTag());
     return ek;
@@ -232,9 +241,11 @@ Ciphertext<DCRTPoly> KeySwitchHYBRID::KeySwitchExt(ConstCiphertext<DCRTPoly> cip
 
     const std::vector<DCRTPoly>& cv = ciphertext->GetElements();
 
-    const auto paramsQl  = cv[0].GetParams();
-    const auto paramsP   = cryptoParams->GetParamsP();
-    const auto paramsQlP = cv[0].GetExtendedCRTBasis(paramsP);
+    const auto paramsQl = cv[0].GetParams();
+    const auto paramsP  = cryptoParams->GetParamsP();
+    auto paramsQlP      = cryptoParams->FindParamsQlP(paramsQl);
+    if (!paramsQlP)
+        paramsQlP = cv[0].GetExtendedCRTBasis(paramsP);
 
     uint32_t sizeQl = paramsQl->GetParams().size();
     uint32_t sizeCv = cv.size();
@@ -260,15 +271,17 @@ Ciphertext<DCRTPoly> KeySwitchHYBRID::KeySwitchDown(ConstCiphertext<DCRTPoly> ci
     const auto paramsP   = cryptoParams->GetParamsP();
     const auto paramsQlP = ciphertext->GetElements()[0].GetParams();
 
-    // TODO : (Andrey) precompute paramsQl in cryptoparameters
-    usint sizeQl = paramsQlP->GetParams().size() - paramsP->GetParams().size();
-    std::vector<NativeInteger> moduliQ(sizeQl);
-    std::vector<NativeInteger> rootsQ(sizeQl);
-    for (size_t i = 0; i < sizeQl; i++) {
-        moduliQ[i] = paramsQlP->GetParams()[i]->GetModulus();
-        rootsQ[i]  = paramsQlP->GetParams()[i]->GetRootOfUnity();
+    auto paramsQl = cryptoParams->FindParamsQl(paramsQlP);
+    if (!paramsQl) {
+        usint sizeQl = paramsQlP->GetParams().size() - paramsP->GetParams().size();
+        std::vector<NativeInteger> moduliQ(sizeQl);
+        std::vector<NativeInteger> rootsQ(sizeQl);
+        for (size_t i = 0; i < sizeQl; i++) {
+            moduliQ[i] = paramsQlP->GetParams()[i]->GetModulus();
+            rootsQ[i]  = paramsQlP->GetParams()[i]->GetRootOfUnity();
+        }
+        paramsQl = std::make_shared<typename DCRTPoly::Params>(2 * paramsQlP->GetRingDimension(), moduliQ, rootsQ);
     }
-    auto paramsQl = std::make_shared<typename DCRTPoly::Params>(2 * paramsQlP->GetRingDimension(), moduliQ, rootsQ);
 
     auto cTilda = ciphertext->GetElements();
 
@@ -299,15 +312,17 @@ DCRTPoly KeySwitchHYBRID::KeySwitchDownFirstElement(ConstCiphertext<DCRTPoly> ci
     const auto paramsP   = cryptoParams->GetParamsP();
     const auto paramsQlP = cTilda[0].GetParams();
 
-    // TODO : (Andrey) precompute paramsQl in cryptoparameters
-    usint sizeQl = paramsQlP->GetParams().size() - paramsP->GetParams().size();
-    std::vector<NativeInteger> moduliQ(sizeQl);
-    std::vector<NativeInteger> rootsQ(sizeQl);
-    for (size_t i = 0; i < sizeQl; i++) {
-        moduliQ[i] = paramsQlP->GetParams()[i]->GetModulus();
-        rootsQ[i]  = paramsQlP->GetParams()[i]->GetRootOfUnity();
+    auto paramsQl = cryptoParams->FindParamsQl(paramsQlP);
+    if (!paramsQl) {
+        usint sizeQl = paramsQlP->GetParams().size() - paramsP->GetParams().size();
+        std::vector<NativeInteger> moduliQ(sizeQl);
+        std::vector<NativeInteger> rootsQ(sizeQl);
+        for (size_t i = 0; i < sizeQl; i++) {
+            moduliQ[i] = paramsQlP->GetParams()[i]->GetModulus();
+            rootsQ[i]  = paramsQlP->GetParams()[i]->GetRootOfUnity();
+        }
+        paramsQl = std::make_shared<typename DCRTPoly::Params>(2 * paramsQlP->GetRingDimension(), moduliQ, rootsQ);
     }
-    auto paramsQl = std::make_shared<typename DCRTPoly::Params>(2 * paramsQlP->GetRingDimension(), moduliQ, rootsQ);
 
     PlaintextModulus t = (cryptoParams->GetNoiseScale() == 1) ? 0 : cryptoParams->GetPlaintextModulus();
 
@@ -322,17 +337,22 @@ DCRTPoly KeySwitchHYBRID::KeySwitchDownFirstElement(ConstCiphertext<DCRTPoly> ci
 
 std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::KeySwitchCore(const DCRTPoly& a,
                                                                       const EvalKey<DCRTPoly> evalKey) const {
+    // the digits and the extended polynomials of both halves reuse the same tower buffers
+    ArenaScope arena;
     return EvalFastKeySwitchCore(EvalKeySwitchPrecomputeCore(a, evalKey->GetCryptoParameters()), evalKey,
                                  a.GetParams());
 }
 
 std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalKeySwitchPrecomputeCore(
     const DCRTPoly& c, std::shared_ptr<CryptoParametersBase<DCRTPoly>> cryptoParamsBase) const {
+    ArenaScope arena;
     const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(cryptoParamsBase);
 
-    const std::shared_ptr<ParmType> paramsQl  = c.GetParams();
-    const std::shared_ptr<ParmType> paramsP   = cryptoParams->GetParamsP();
-    const std::shared_ptr<ParmType> paramsQlP = c.GetExtendedCRTBasis(paramsP);
+    const std::shared_ptr<ParmType> paramsQl = c.GetParams();
+    const std::shared_ptr<ParmType> paramsP  = cryptoParams->GetParamsP();
+    std::shared_ptr<ParmType> paramsQlP      = cryptoParams->FindParamsQlP(paramsQl);
+    if (!paramsQlP)
+        paramsQlP = c.GetExtendedCRTBasis(paramsP);
 
     size_t sizeQl  = paramsQl->GetParams().size();
     size_t sizeP   = paramsP->GetParams().size();
@@ -350,21 +370,8 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalKeySwitchPrecomputeC
     // Zero-padding and split
     for (uint32_t part = 0; part < numPartQl; part++) {
         if (part == numPartQl - 1) {
-            auto paramsPartQ = cryptoParams->GetParamsPartQ(part);
-
             uint32_t sizePartQl = sizeQl - alpha * part;
-
-            std::vector<NativeInteger> moduli(sizePartQl);
-            std::vector<NativeInteger> roots(sizePartQl);
-
-            for (uint32_t i = 0; i < sizePartQl; i++) {
-                moduli[i] = paramsPartQ->GetParams()[i]->GetModulus();
-                roots[i]  = paramsPartQ->GetParams()[i]->GetRootOfUnity();
-            }
-
-            auto params = DCRTPoly::Params(paramsPartQ->GetCyclotomicOrder(), moduli, roots);
-
-            partsCt[part] = DCRTPoly(std::make_shared<ParmType>(params), Format::EVALUATION, true);
+            partsCt[part] = DCRTPoly(cryptoParams->GetParamsPartQl(part, sizePartQl - 1), Format::EVALUATION, true);
         }
         else {
             partsCt[part] = DCRTPoly(cryptoParams->GetParamsPartQ(part), Format::EVALUATION, true);
@@ -415,6 +422,7 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalKeySwitchPrecomputeC
 std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalFastKeySwitchCore(
     const std::shared_ptr<std::vector<DCRTPoly>> digits, const EvalKey<DCRTPoly> evalKey,
     const std::shared_ptr<ParmType> paramsQl) const {
+    ArenaScope arena;
     const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(evalKey->GetCryptoParameters());
 
     std::shared_ptr<std::vector<DCRTPoly>> cTilda = EvalFastKeySwitchCoreExt(digits, evalKey, paramsQl);
@@ -439,6 +447,7 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalFastKeySwitchCore(
 std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalFastKeySwitchCoreExt(
     const std::shared_ptr<std::vector<DCRTPoly>> digits, const EvalKey<DCRTPoly> evalKey,
     const std::shared_ptr<ParmType> paramsQl) const {
+    ArenaScope arena;
     const auto cryptoParams         = std::dynamic_pointer_cast<CryptoParametersRNS>(evalKey->GetCryptoParameters());
     const std::vector<DCRTPoly>& bv = evalKey->GetBVector();
     const std::vector<DCRTPoly>& av = evalKey->GetAVector();
@@ -450,6 +459,46 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalFastKeySwitchCoreExt
     size_t sizeQlP = paramsQlP->GetParams().size();
     size_t sizeQ   = cryptoParams->GetElementParams()->GetParams().size();
 
+#if defined(HAVE_INT128) && (NATIVEINT == 64)
+    // every tower of the results is written once by the fused inner product over all digits,
+    // without temporaries and with a single modular reduction per coefficient
+    DCRTPoly cTilda0(paramsQlP, Format::EVALUATION);
+    DCRTPoly cTilda1(paramsQlP, Format::EVALUATION);
+    cTilda0.MakeContiguous();
+    cTilda1.MakeContiguous();
+
+    uint32_t numDigits = digits->size();
+    uint32_t ringDim   = paramsQlP->GetRingDimension();
+    auto y0            = reinterpret_cast<uint64_t*>(cTilda0.GetContiguousData());
+    auto y1            = reinterpret_cast<uint64_t*>(cTilda1.GetContiguousData());
+
+    #pragma omp parallel num_threads(OpenFHEParallelControls.GetThreadLimit(sizeQlP))
+    {
+        std::vector<const uint64_t*> x(numDigits), a(numDigits), b(numDigits);
+    #pragma omp for schedule(static)
+        for (uint32_t i = 0; i < sizeQlP; ++i) {
+            // the towers of P follow those of Q in the keys, but directly those of Ql in the digits
+            uint32_t idx = (i < sizeQl) ? i : i - sizeQl + sizeQ;
+            for (uint32_t j = 0; j < numDigits; ++j) {
+                x[j] = reinterpret_cast<const uint64_t*>((*digits)[j].GetElementAtIndex(i).GetValues().data());
+                a[j] = reinterpret_cast<const uint64_t*>(av[j].GetElementAtIndex(idx).GetValues().data());
+                b[j] = reinterpret_cast<const uint64_t*>(bv[j].GetElementAtIndex(idx).GetValues().data());
+            }
+            uint64_t q = paramsQlP->GetParams()[i]->GetModulus().ConvertToInt();
+            if (!intnat::FastInnerProduct(x.data(), a.data(), b.data(), numDigits, q, y1 + i * ringDim,
+                                          y0 + i * ringDim, ringDim)) {
+                auto& c0 = cTilda0.GetAllElements()[i];
+                auto& c1 = cTilda1.GetAllElements()[i];
+                c0       = (*digits)[0].GetElementAtIndex(i) * bv[0].GetElementAtIndex(idx);
+                c1       = (*digits)[0].GetElementAtIndex(i) * av[0].GetElementAtIndex(idx);
+                for (uint32_t j = 1; j < numDigits; ++j) {
+                    c0 += (*digits)[j].GetElementAtIndex(i) * bv[j].GetElementAtIndex(idx);
+                    c1 += (*digits)[j].GetElementAtIndex(i) * av[j].GetElementAtIndex(idx);
+                }
+            }
+        }
+    }
+#else
     DCRTPoly cTilda0(paramsQlP, Format::EVALUATION, true);
     DCRTPoly cTilda1(paramsQlP, Format::EVALUATION, true);
 
@@ -475,6 +524,7 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalFastKeySwitchCoreExt
             cTilda1.SetElementAtIndex(i, cTilda1.GetElementAtIndex(i) + cji * aji);
         }
     }
+#endif
 
     return std::make_shared<std::vector<DCRTPoly>>(
         std::initializer_list<DCRTPoly>{std::move(cTilda0), std::move(cTilda1)});
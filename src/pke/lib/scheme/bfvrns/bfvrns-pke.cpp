@@ -57,7 +57,6 @@ KeyPair<DCRTPoly> PKEBFVRNS::KeyGenInternal(CryptoContext<DCRTPoly> cc, bool mak
 
     const auto ns      = cryptoParams->GetNoiseScale();
     const DggType& dgg = cryptoParams->GetDiscreteGaussianGenerator();
-    DugType dug;
     TugType tug;
 
     // Private Key Generation
@@ -79,7 +78,9 @@ KeyPair<DCRTPoly> PKEBFVRNS::KeyGenInternal(CryptoContext<DCRTPoly> cc, bool mak
 
     // Public Key Generation
 
-    DCRTPoly a(dug, paramsPK, Format::EVALUATION);
+    // a is regenerated from a seed instead of being stored
+    const KeySeed seed = GenerateKeySeed();
+    DCRTPoly a         = ExpandKeySeed(seed, 0, paramsPK);
     DCRTPoly e(dgg, paramsPK, Format::EVALUATION);
     DCRTPoly b(ns * e - a * s);
 
@@ -90,7 +91,7 @@ KeyPair<DCRTPoly> PKEBFVRNS::KeyGenInternal(CryptoContext<DCRTPoly> cc, bool mak
     }
 
     keyPair.secretKey->SetPrivateElement(std::move(s));
-    keyPair.publicKey->SetPublicElements(std::vector<DCRTPoly>{std::move(b), std::move(a)});
+    keyPair.publicKey->SetPublicElements(std::move(b), seed);
     keyPair.publicKey->SetKeyTag(keyPair.secretKey->GetKeyTag());
 
     return keyPair;
@@ -80,7 +80,7 @@ namespace lbcrypto {
 
 void FHECKKSRNS::EvalBootstrapSetup(const CryptoContextImpl<DCRTPoly>& cc, std::vector<uint32_t> levelBudget,
                                     std::vector<uint32_t> dim1, uint32_t numSlots, uint32_t correctionFactor,
-                                    bool precompute) {
+                                    bool precompute, bool lazyDiagonals) {
     const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(cc.GetCryptoParameters());
 
     if (cryptoParams->GetKeySwitchTechnique() != HYBRID)
@@ -121,8 +121,9 @@ void FHECKKSRNS::EvalBootstrapSetup(const CryptoContextImpl<DCRTPoly>& cc, std::
     m_bootPrecomMap[slots]                      = std::make_shared<CKKSBootstrapPrecom>();
     std::shared_ptr<CKKSBootstrapPrecom> precom = m_bootPrecomMap[slots];
 
-    precom->m_slots = slots;
-    precom->m_dim1  = dim1[0];
+    precom->m_slots         = slots;
+    precom->m_dim1          = dim1[0];
+    precom->m_lazyDiagonals = lazyDiagonals;
 
     uint32_t logSlots = std::log2(slots);
     // even for the case of a single slot we need one level for rescaling
@@ -228,6 +229,10 @@ void FHECKKSRNS::EvalBootstrapSetup(const CryptoContextImpl<DCRTPoly>& cc, std::
                 precom->m_U0Pre     = EvalLinearTransformPrecompute(cc, U0, U1, 1, scaleDec, lDec);
             }
         }
+        else if (precom->m_lazyDiagonals) {
+            precom->m_U0hatTDiagFFT = EvalCoeffsToSlotsDiagonals(cc, ksiPows, rotGroup, false, scaleEnc, lEnc);
+            precom->m_U0DiagFFT     = EvalSlotsToCoeffsDiagonals(cc, ksiPows, rotGroup, false, scaleDec, lDec);
+        }
         else {
             precom->m_U0hatTPreFFT = EvalCoeffsToSlotsPrecompute(cc, ksiPows, rotGroup, false, scaleEnc, lEnc);
             precom->m_U0PreFFT     = EvalSlotsToCoeffsPrecompute(cc, ksiPows, rotGroup, false, scaleDec, lDec);
@@ -355,6 +360,10 @@ void FHECKKSRNS::EvalBootstrapPrecompute(const CryptoContextImpl<DCRTPoly>& cc,
             precom->m_U0Pre     = EvalLinearTransformPrecompute(cc, U0, U1, 1, scaleDec, lDec);
         }
     }
+    else if (precom->m_lazyDiagonals) {
+        precom->m_U0hatTDiagFFT = EvalCoeffsToSlotsDiagonals(cc, ksiPows, rotGroup, false, scaleEnc, lEnc);
+        precom->m_U0DiagFFT     = EvalSlotsToCoeffsDiagonals(cc, ksiPows, rotGroup, false, scaleDec, lDec);
+    }
     else {
         precom->m_U0hatTPreFFT = EvalCoeffsToSlotsPrecompute(cc, ksiPows, rotGroup, false, scaleEnc, lEnc);
         precom->m_U0PreFFT     = EvalSlotsToCoeffsPrecompute(cc, ksiPows, rotGroup, false, scaleDec, lDec);
@@ -1206,7 +1215,7 @@ std::vector<ReadOnlyPlaintext> FHECKKSRNS::EvalLinearTransformPrecompute(
     return result;
 }
 
-std::vector<std::vector<ReadOnlyPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecompute(
+CKKSLinearTransformDiagonals FHECKKSRNS::EvalCoeffsToSlotsDiagonals(
     const CryptoContextImpl<DCRTPoly>& cc, const std::vector<std::complex<double>>& A,
     const std::vector<uint32_t>& rotGroup, bool flag_i, double scale, uint32_t L) const {
     uint32_t slots = rotGroup.size();
@@ -1240,15 +1249,16 @@ std::vector<std::vector<ReadOnlyPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecomp
         flagRem = 1;
     }
 
-    // result is the rotated plaintext version of the coefficients
-    std::vector<std::vector<ReadOnlyPlaintext>> result(levelBudget);
+    // result holds the rotated diagonals of each level, the plaintext version of the coefficients
+    CKKSLinearTransformDiagonals result;
+    result.m_diagonals.resize(levelBudget);
     for (uint32_t i = 0; i < static_cast<uint32_t>(levelBudget); i++) {
         if (flagRem == 1 && i == 0) {
             // remainder corresponds to index 0 in encoding and to last index in decoding
-            result[i] = std::vector<ReadOnlyPlaintext>(numRotationsRem);
+            result.m_diagonals[i].resize(numRotationsRem);
         }
         else {
-            result[i] = std::vector<ReadOnlyPlaintext>(numRotations);
+            result.m_diagonals[i].resize(numRotations);
         }
     }
 
@@ -1288,7 +1298,7 @@ std::vector<std::vector<ReadOnlyPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecomp
         roots[sizeQ + i]  = paramsP[i]->GetRootOfUnity();
     }
 
-    // we need to pre-compute the plaintexts in the extended basis P*Q
+    // the plaintexts are encoded in the extended basis P*Q
     std::vector<std::shared_ptr<ILDCRTParams<BigInteger>>> paramsVector(levelBudget - stop);
     for (int32_t s = levelBudget - 1; s >= stop; s--) {
         paramsVector[s - stop] = std::make_shared<ILDCRTParams<BigInteger>>(M, moduli, roots);
@@ -1299,6 +1309,13 @@ std::vector<std::vector<ReadOnlyPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecomp
         }
     }
 
+    result.m_params.resize(levelBudget);
+    result.m_towersToDrop.resize(levelBudget);
+    for (int32_t s = 0; s < levelBudget; s++) {
+        result.m_params[s]       = paramsVector[s - stop];
+        result.m_towersToDrop[s] = level0 - compositeDegree * s;
+    }
+
     if (slots == M / 4) {
         //------------------------------------------------------------------------------
         // fully-packed mode
@@ -1322,10 +1339,7 @@ std::vector<std::vector<ReadOnlyPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecomp
                             }
                         }
 
-                        auto rotateTemp = Rotate(coeff[s][g * i + j], rot);
-
-                        result[s][g * i + j] = MakeAuxPlaintext(cc, paramsVector[s - stop], rotateTemp, 1,
-                                                                level0 - compositeDegree * s, rotateTemp.size());
+                        result.m_diagonals[s][g * i + j] = Rotate(coeff[s][g * i + j], rot);
                     }
                 }
             }
@@ -1341,9 +1355,7 @@ std::vector<std::vector<ReadOnlyPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecomp
                             coeff[stop][gRem * i + j][k] *= scale;
                         }
 
-                        auto rotateTemp = Rotate(coeff[stop][gRem * i + j], rot);
-                        result[stop][gRem * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[0], rotateTemp, 1, level0, rotateTemp.size());
+                        result.m_diagonals[stop][gRem * i + j] = Rotate(coeff[stop][gRem * i + j], rot);
                     }
                 }
             }
@@ -1377,9 +1389,7 @@ std::vector<std::vector<ReadOnlyPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecomp
                             }
                         }
 
-                        auto rotateTemp      = Rotate(clearTemp, rot);
-                        result[s][g * i + j] = MakeAuxPlaintext(cc, paramsVector[s - stop], rotateTemp, 1,
-                                                                level0 - compositeDegree * s, rotateTemp.size());
+                        result.m_diagonals[s][g * i + j] = Rotate(clearTemp, rot);
                     }
                 }
             }
@@ -1399,9 +1409,7 @@ std::vector<std::vector<ReadOnlyPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecomp
                             clearTemp[k] *= scale;
                         }
 
-                        auto rotateTemp = Rotate(clearTemp, rot);
-                        result[stop][gRem * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[0], rotateTemp, 1, level0, rotateTemp.size());
+                        result.m_diagonals[stop][gRem * i + j] = Rotate(clearTemp, rot);
                     }
                 }
             }
@@ -1410,7 +1418,18 @@ std::vector<std::vector<ReadOnlyPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecomp
     return result;
 }
 
-std::vector<std::vector<ReadOnlyPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecompute(
+std::vector<std::vector<ReadOnlyPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecompute(
+    const CryptoContextImpl<DCRTPoly>& cc, const std::vector<std::complex<double>>& A,
+    const std::vector<uint32_t>& rotGroup, bool flag_i, double scale, uint32_t L) const {
+    auto diagonals = EvalCoeffsToSlotsDiagonals(cc, A, rotGroup, flag_i, scale, L);
+
+    std::vector<std::vector<ReadOnlyPlaintext>> result(diagonals.m_diagonals.size());
+    for (uint32_t s = 0; s < result.size(); s++)
+        result[s] = GetLevelPlaintexts(cc, {}, diagonals, s, 0, diagonals.m_diagonals[s].size());
+    return result;
+}
+
+CKKSLinearTransformDiagonals FHECKKSRNS::EvalSlotsToCoeffsDiagonals(
     const CryptoContextImpl<DCRTPoly>& cc, const std::vector<std::complex<double>>& A,
     const std::vector<uint32_t>& rotGroup, bool flag_i, double scale, uint32_t L) const {
     uint32_t slots = rotGroup.size();
@@ -1442,15 +1461,16 @@ std::vector<std::vector<ReadOnlyPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecomp
         flagRem = 1;
     }
 
-    // result is the rotated plaintext version of coeff
-    std::vector<std::vector<ReadOnlyPlaintext>> result(levelBudget);
+    // result holds the rotated diagonals of each level, the plaintext version of coeff
+    CKKSLinearTransformDiagonals result;
+    result.m_diagonals.resize(levelBudget);
     for (uint32_t i = 0; i < static_cast<uint32_t>(levelBudget); i++) {
         if (flagRem == 1 && i == static_cast<uint32_t>(levelBudget - 1)) {
             // remainder corresponds to index 0 in encoding and to last index in decoding
-            result[i] = std::vector<ReadOnlyPlaintext>(numRotationsRem);
+            result.m_diagonals[i].resize(numRotationsRem);
         }
         else {
-            result[i] = std::vector<ReadOnlyPlaintext>(numRotations);
+            result.m_diagonals[i].resize(numRotations);
         }
     }
 
@@ -1490,7 +1510,7 @@ std::vector<std::vector<ReadOnlyPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecomp
         roots[sizeQ + i]  = paramsP[i]->GetRootOfUnity();
     }
 
-    // we need to pre-compute the plaintexts in the extended basis P*Q
+    // the plaintexts are encoded in the extended basis P*Q
     std::vector<std::shared_ptr<ILDCRTParams<BigInteger>>> paramsVector(levelBudget - flagRem + 1);
     for (int32_t s = 0; s < levelBudget - flagRem + 1; s++) {
         paramsVector[s] = std::make_shared<ILDCRTParams<BigInteger>>(M, moduli, roots);
@@ -1501,6 +1521,13 @@ std::vector<std::vector<ReadOnlyPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecomp
         }
     }
 
+    result.m_params.resize(levelBudget);
+    result.m_towersToDrop.resize(levelBudget);
+    for (int32_t s = 0; s < levelBudget; s++) {
+        result.m_params[s]       = paramsVector[s];
+        result.m_towersToDrop[s] = level0 + compositeDegree * s;
+    }
+
     if (slots == M / 4) {
         // fully-packed
         auto coeff = CoeffDecodingCollapse(A, rotGroup, levelBudget, flag_i);
@@ -1518,9 +1545,7 @@ std::vector<std::vector<ReadOnlyPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecomp
                             }
                         }
 
-                        auto rotateTemp      = Rotate(coeff[s][g * i + j], rot);
-                        result[s][g * i + j] = MakeAuxPlaintext(cc, paramsVector[s], rotateTemp, 1,
-                                                                level0 + compositeDegree * s, rotateTemp.size());
+                        result.m_diagonals[s][g * i + j] = Rotate(coeff[s][g * i + j], rot);
                     }
                 }
             }
@@ -1537,9 +1562,7 @@ std::vector<std::vector<ReadOnlyPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecomp
                             coeff[s][gRem * i + j][k] *= scale;
                         }
 
-                        auto rotateTemp         = Rotate(coeff[s][gRem * i + j], rot);
-                        result[s][gRem * i + j] = MakeAuxPlaintext(cc, paramsVector[s], rotateTemp, 1,
-                                                                   level0 + compositeDegree * s, rotateTemp.size());
+                        result.m_diagonals[s][gRem * i + j] = Rotate(coeff[s][gRem * i + j], rot);
                     }
                 }
             }
@@ -1570,9 +1593,7 @@ std::vector<std::vector<ReadOnlyPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecomp
                             }
                         }
 
-                        auto rotateTemp      = Rotate(clearTemp, rot);
-                        result[s][g * i + j] = MakeAuxPlaintext(cc, paramsVector[s], rotateTemp, 1,
-                                                                level0 + compositeDegree * s, rotateTemp.size());
+                        result.m_diagonals[s][g * i + j] = Rotate(clearTemp, rot);
                     }
                 }
             }
@@ -1593,9 +1614,7 @@ std::vector<std::vector<ReadOnlyPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecomp
                             clearTemp[k] *= scale;
                         }
 
-                        auto rotateTemp         = Rotate(clearTemp, rot);
-                        result[s][gRem * i + j] = MakeAuxPlaintext(cc, paramsVector[s], rotateTemp, 1,
-                                                                   level0 + compositeDegree * s, rotateTemp.size());
+                        result.m_diagonals[s][gRem * i + j] = Rotate(clearTemp, rot);
                     }
                 }
             }
@@ -1604,6 +1623,17 @@ std::vector<std::vector<ReadOnlyPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecomp
     return result;
 }
 
+std::vector<std::vector<ReadOnlyPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecompute(
+    const CryptoContextImpl<DCRTPoly>& cc, const std::vector<std::complex<double>>& A,
+    const std::vector<uint32_t>& rotGroup, bool flag_i, double scale, uint32_t L) const {
+    auto diagonals = EvalSlotsToCoeffsDiagonals(cc, A, rotGroup, flag_i, scale, L);
+
+    std::vector<std::vector<ReadOnlyPlaintext>> result(diagonals.m_diagonals.size());
+    for (uint32_t s = 0; s < result.size(); s++)
+        result[s] = GetLevelPlaintexts(cc, {}, diagonals, s, 0, diagonals.m_diagonals[s].size());
+    return result;
+}
+
 //------------------------------------------------------------------------------
 // EVALUATION: CoeffsToSlots and SlotsToCoeffs
 //------------------------------------------------------------------------------
@@ -1786,11 +1816,12 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalCoeffsToSlots(const std::vector<std::vector
         for (int32_t i = 0; i < b; i++) {
             // for the first iteration with j=0:
             int32_t G                  = g * i;
-            Ciphertext<DCRTPoly> inner = EvalMultExt(fastRotation[0], A[s][G]);
+            auto Ai                    = GetLevelPlaintexts(*cc, A, precom->m_U0hatTDiagFFT, s, G, g);
+            Ciphertext<DCRTPoly> inner = EvalMultExt(fastRotation[0], Ai[0]);
             // continue the loop
             for (int32_t j = 1; j < g; j++) {
                 if ((G + j) != static_cast<int32_t>(numRotations)) {
-                    EvalAddExtInPlace(inner, EvalMultExt(fastRotation[j], A[s][G + j]));
+                    EvalAddExtInPlace(inner, EvalMultExt(fastRotation[j], Ai[j]));
                 }
             }
 
@@ -1849,11 +1880,12 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalCoeffsToSlots(const std::vector<std::vector
             Ciphertext<DCRTPoly> inner;
             // for the first iteration with j=0:
             int32_t GRem = gRem * i;
-            inner        = EvalMultExt(fastRotation[0], A[stop][GRem]);
+            auto Ai      = GetLevelPlaintexts(*cc, A, precom->m_U0hatTDiagFFT, stop, GRem, gRem);
+            inner        = EvalMultExt(fastRotation[0], Ai[0]);
             // continue the loop
             for (int32_t j = 1; j < gRem; j++) {
                 if ((GRem + j) != static_cast<int32_t>(numRotationsRem)) {
-                    EvalAddExtInPlace(inner, EvalMultExt(fastRotation[j], A[stop][GRem + j]));
+                    EvalAddExtInPlace(inner, EvalMultExt(fastRotation[j], Ai[j]));
                 }
             }
 
@@ -2001,11 +2033,12 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalSlotsToCoeffs(const std::vector<std::vector
             Ciphertext<DCRTPoly> inner;
             // for the first iteration with j=0:
             int32_t G = g * i;
-            inner     = EvalMultExt(fastRotation[0], A[s][G]);
+            auto Ai   = GetLevelPlaintexts(*cc, A, precom->m_U0DiagFFT, s, G, g);
+            inner     = EvalMultExt(fastRotation[0], Ai[0]);
             // continue the loop
             for (int32_t j = 1; j < g; j++) {
                 if ((G + j) != static_cast<int32_t>(numRotations)) {
-                    EvalAddExtInPlace(inner, EvalMultExt(fastRotation[j], A[s][G + j]));
+                    EvalAddExtInPlace(inner, EvalMultExt(fastRotation[j], Ai[j]));
                 }
             }
 
@@ -2065,11 +2098,12 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalSlotsToCoeffs(const std::vector<std::vector
             Ciphertext<DCRTPoly> inner;
             // for the first iteration with j=0:
             int32_t GRem = gRem * i;
-            inner        = EvalMultExt(fastRotation[0], A[s][GRem]);
+            auto Ai      = GetLevelPlaintexts(*cc, A, precom->m_U0DiagFFT, s, GRem, gRem);
+            inner        = EvalMultExt(fastRotation[0], Ai[0]);
             // continue the loop
             for (int32_t j = 1; j < gRem; j++) {
                 if ((GRem + j) != static_cast<int32_t>(numRotationsRem))
-                    EvalAddExtInPlace(inner, EvalMultExt(fastRotation[j], A[s][GRem + j]));
+                    EvalAddExtInPlace(inner, EvalMultExt(fastRotation[j], Ai[j]));
             }
 
             if (i == 0) {
@@ -2639,6 +2673,33 @@ Plaintext FHECKKSRNS::MakeAuxPlaintext(const CryptoContextImpl<DCRTPoly>& cc, co
 }
 #endif
 
+std::vector<ReadOnlyPlaintext> FHECKKSRNS::GetLevelPlaintexts(const CryptoContextImpl<DCRTPoly>& cc,
+                                                              const std::vector<std::vector<ReadOnlyPlaintext>>& A,
+                                                              const CKKSLinearTransformDiagonals& diagonals, uint32_t s,
+                                                              uint32_t first, uint32_t count) const {
+    std::vector<ReadOnlyPlaintext> result(count);
+
+    if (!A.empty()) {
+        for (uint32_t j = 0; j < count && first + j < A[s].size(); j++)
+            result[j] = A[s][first + j];
+        return result;
+    }
+
+    if (s >= diagonals.m_diagonals.size())
+        OPENFHE_THROW("Neither the plaintexts nor the diagonals of the linear transform were precomputed");
+
+    // encode only the plaintexts needed by one baby-step block, in parallel
+    const auto& diags = diagonals.m_diagonals[s];
+    uint32_t last     = std::min<uint32_t>(first + count, diags.size());
+#pragma omp parallel for
+    for (uint32_t j = first; j < last; j++) {
+        if (!diags[j].empty())
+            result[j - first] = MakeAuxPlaintext(cc, diagonals.m_params[s], diags[j], 1, diagonals.m_towersToDrop[s],
+                                                 diags[j].size());
+    }
+    return result;
+}
+
 Ciphertext<DCRTPoly> FHECKKSRNS::EvalMultExt(ConstCiphertext<DCRTPoly> ciphertext, ConstPlaintext plaintext) const {
     Ciphertext<DCRTPoly> result = ciphertext->Clone();
     std::vector<DCRTPoly>& cv   = result->GetElements();
@@ -54,7 +54,6 @@ KeyPair<Element> PKEBase<Element>::KeyGenInternal(CryptoContext<Element> cc, boo
 
     const auto ns      = cryptoParams->GetNoiseScale();
     const DggType& dgg = cryptoParams->GetDiscreteGaussianGenerator();
-    DugType dug;
     TugType tug;
 
     // Private Key Generation
@@ -77,7 +76,9 @@ KeyPair<Element> PKEBase<Element>::KeyGenInternal(CryptoContext<Element> cc, boo
 
     // Public Key Generation
 
-    Element a(dug, paramsPK, Format::EVALUATION);
+    // a is regenerated from a seed instead of being stored
+    const KeySeed seed = GenerateKeySeed();
+    Element a          = ExpandKeySeed(seed, 0, paramsPK);
     Element e(dgg, paramsPK, Format::EVALUATION);
     Element b(ns * e - a * s);
 
@@ -88,7 +89,7 @@ KeyPair<Element> PKEBase<Element>::KeyGenInternal(CryptoContext<Element> cc, boo
     }
 
     keyPair.secretKey->SetPrivateElement(std::move(s));
-    keyPair.publicKey->SetPublicElements(std::vector<Element>{std::move(b), std::move(a)});
+    keyPair.publicKey->SetPublicElements(std::move(b), seed);
     keyPair.publicKey->SetKeyTag(keyPair.secretKey->GetKeyTag());
 
     return keyPair;
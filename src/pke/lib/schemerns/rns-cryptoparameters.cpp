@@ -280,6 +280,30 @@ void CryptoParametersRNS::PrecomputeCRTTables(KeySwitchTechnique ksTech, Scaling
             }
         }
 
+        // Pre-compute the parameters of Q_l, {Q_l,P} and of the incomplete last digits for every level
+        // from the tower parameters of Q and P, so key switching finds them instead of building them
+        m_paramsPrefixQ.resize(sizeQ);
+        m_paramsPrefixQP.resize(sizeQ);
+        const auto& towersQ = GetElementParams()->GetParams();
+        const auto& towersP = m_paramsP->GetParams();
+        for (uint32_t l = 0; l < sizeQ; l++) {
+            std::vector<std::shared_ptr<ILNativeParams>> towers(towersQ.begin(), towersQ.begin() + l + 1);
+            m_paramsPrefixQ[l] = (l == sizeQ - 1) ? GetElementParams() : std::make_shared<ParmType>(2 * n, towers);
+            towers.insert(towers.end(), towersP.begin(), towersP.end());
+            m_paramsPrefixQP[l] = (l == sizeQ - 1) ? m_paramsQP : std::make_shared<ParmType>(2 * n, towers);
+        }
+        m_paramsPrefixPartQ.resize(m_numPartQ);
+        for (uint32_t j = 0; j < m_numPartQ; j++) {
+            const auto& towersPartQ = m_paramsPartQ[j]->GetParams();
+            m_paramsPrefixPartQ[j].resize(towersPartQ.size());
+            for (uint32_t l = 0; l < towersPartQ.size(); l++) {
+                m_paramsPrefixPartQ[j][l] =
+                    (l == towersPartQ.size() - 1) ?
+                        m_paramsPartQ[j] :
+                        std::make_shared<ParmType>(2 * n, m_paramsPartQ[j]->GetParamPartition(0, l));
+            }
+        }
+
         // Pre-compute values [Q^(l)_j/q_i)^{-1}]_{q_i}
         m_PartQlHatInvModq.resize(m_numPartQ);
         m_PartQlHatInvModqPrecon.resize(m_numPartQ);
@@ -387,6 +411,47 @@ void CryptoParametersRNS::PrecomputeCRTTables(KeySwitchTechnique ksTech, Scaling
     }
 }
 
+namespace {
+
+// checks whether the first towers of two parameter sets have the same moduli, comparing the tower
+// parameters by pointer first as they are usually shared
+bool HasSameTowers(const std::shared_ptr<ILDCRTParams<BigInteger>>& a,
+                   const std::shared_ptr<ILDCRTParams<BigInteger>>& b, uint32_t numTowers) {
+    if (a->GetRingDimension() != b->GetRingDimension())
+        return false;
+    const auto& towersA = a->GetParams();
+    const auto& towersB = b->GetParams();
+    for (uint32_t i = 0; i < numTowers; i++) {
+        if (towersA[i] != towersB[i] && towersA[i]->GetModulus() != towersB[i]->GetModulus())
+            return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+std::shared_ptr<ILDCRTParams<BigInteger>> CryptoParametersRNS::FindParamsQlP(
+    const std::shared_ptr<ILDCRTParams<BigInteger>>& paramsQl) const {
+    uint32_t sizeQl = paramsQl->GetParams().size();
+    if (sizeQl == 0 || sizeQl > m_paramsPrefixQP.size())
+        return nullptr;
+    if (paramsQl == m_paramsPrefixQ[sizeQl - 1] || HasSameTowers(paramsQl, m_paramsPrefixQ[sizeQl - 1], sizeQl))
+        return m_paramsPrefixQP[sizeQl - 1];
+    return nullptr;
+}
+
+std::shared_ptr<ILDCRTParams<BigInteger>> CryptoParametersRNS::FindParamsQl(
+    const std::shared_ptr<ILDCRTParams<BigInteger>>& paramsQlP) const {
+    uint32_t sizeQlP = paramsQlP->GetParams().size();
+    uint32_t sizeP   = m_paramsP ? m_paramsP->GetParams().size() : 0;
+    if (sizeQlP <= sizeP || sizeQlP - sizeP > m_paramsPrefixQ.size())
+        return nullptr;
+    uint32_t sizeQl = sizeQlP - sizeP;
+    if (paramsQlP == m_paramsPrefixQP[sizeQl - 1] || HasSameTowers(paramsQlP, m_paramsPrefixQP[sizeQl - 1], sizeQlP))
+        return m_paramsPrefixQ[sizeQl - 1];
+    return nullptr;
+}
+
 uint64_t CryptoParametersRNS::FindAuxPrimeStep() const {
     return GetElementParams()->GetRingDimension();
 }
@@ -30,17 +30,26 @@
 //==================================================================================
 
 #include "ciphertext-ser.h"
+#include "ciphertext-wire.h"
 #include "cryptocontext-ser.h"
+#include "gen-cryptocontext.h"
 #include "globals.h"  // for SERIALIZE_PRECOMPUTE
 #include "gtest/gtest.h"
+#include "key/keyseed.h"
 #include "scheme/ckksrns/ckksrns-ser.h"
+#include "scheme/ckksrns/gen-cryptocontext-ckksrns.h"
 #include "UnitTestCCParams.h"
 #include "UnitTestCryptoContext.h"
 #include "UnitTestSer.h"
 #include "UnitTestUtils.h"
 
+#include <cstdio>
+#include <cstring>
 #include <iostream>
+#include <memory>
+#include <regex>
 #include <vector>
+#include <sstream>
 #include <string>
 
 using namespace lbcrypto;
@@ -470,3 +479,329 @@ TEST_P(UTCKKSRNS_SER, CKKSSer) {
 }
 
 INSTANTIATE_TEST_SUITE_P(UnitTests, UTCKKSRNS_SER, ::testing::ValuesIn(testCases), testName);
+
+//===========================================================================================================
+TEST(UTCKKSRNS_SER, CKKSWire) {
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetRingDim(1024);
+    parameters.SetMultiplicativeDepth(2);
+    parameters.SetScalingModSize(50);
+    parameters.SetSecurityLevel(HEStd_NotSet);
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+
+    KeyPair<DCRTPoly> kp = cc->KeyGen();
+    cc->EvalMultKeyGen(kp.secretKey);
+
+    std::vector<double> vals = {1.0, 3.0, 5.0, 7.0, 9.0, 2.0, 4.0, 6.0, 8.0, 11.0};
+    std::vector<double> squares(vals.size());
+    for (size_t i = 0; i < vals.size(); ++i)
+        squares[i] = vals[i] * vals[i];
+    Ciphertext<DCRTPoly> ciphertext = cc->Encrypt(kp.publicKey, cc->MakeCKKSPackedPlaintext(vals));
+    // a lower level with a contiguous layout of the towers
+    Ciphertext<DCRTPoly> product = cc->EvalMult(ciphertext, ciphertext);
+    for (auto& element : product->GetElements())
+        element.MakeContiguous();
+
+    auto checkDecryption = [&](ConstCiphertext<DCRTPoly>& ct, const std::vector<double>& expected,
+                               const std::string& msg) {
+        Plaintext result;
+        cc->Decrypt(kp.secretKey, ct, &result);
+        result->SetLength(expected.size());
+        std::vector<std::complex<double>> expectedComplex(expected.begin(), expected.end());
+        checkEquality(expectedComplex, result->GetCKKSPackedValue(), 0.001, msg + " decryption failed");
+    };
+
+    for (auto& [ct, expected] : {std::make_pair(ciphertext, vals), std::make_pair(product, squares)}) {
+        const std::string msg = "level " + std::to_string(ct->GetLevel());
+
+        std::stringstream s;
+        size_t size = WriteCiphertextWire(s, ct);
+        const std::string message = s.str();
+        ASSERT_EQ(size, message.size()) << msg;
+        EXPECT_EQ(size, GetCiphertextWireSize(message.data(), message.size())) << msg;
+        EXPECT_EQ(size_t(0), GetCiphertextWireSize(message.data(), CIPHERTEXT_WIRE_PREFIX_SIZE - 1)) << msg;
+
+        // read into a new buffer
+        auto read = ReadCiphertextWire(cc, s);
+        EXPECT_EQ(ct->GetElements(), read->GetElements()) << msg << " elements differ";
+        EXPECT_EQ(ct->GetLevel(), read->GetLevel()) << msg;
+        EXPECT_EQ(ct->GetNoiseScaleDeg(), read->GetNoiseScaleDeg()) << msg;
+        EXPECT_EQ(ct->GetScalingFactor(), read->GetScalingFactor()) << msg;
+        EXPECT_EQ(ct->GetKeyTag(), read->GetKeyTag()) << msg;
+        checkDecryption(read, expected, msg);
+
+        // adopt an external buffer: the towers are views of it
+        auto buffer = std::make_shared<std::vector<uint64_t>>((size + 7) / 8);
+        std::memcpy(buffer->data(), message.data(), size);
+        auto adopted = AdoptCiphertextWire(cc, buffer->data(), size, buffer);
+        const auto& towers = adopted->GetElements()[0].GetAllElements();
+        EXPECT_GE(reinterpret_cast<const char*>(towers[0].GetValues().data()),
+                  reinterpret_cast<const char*>(buffer->data()))
+            << msg << " towers are not views of the buffer";
+        EXPECT_LT(reinterpret_cast<const char*>(towers.back().GetValues().data()),
+                  reinterpret_cast<const char*>(buffer->data()) + size)
+            << msg << " towers are not views of the buffer";
+        EXPECT_EQ(ct->GetElements(), adopted->GetElements()) << msg << " elements differ";
+        checkDecryption(adopted, expected, msg);
+
+        // the buffer outlives its owner as long as the ciphertext refers to it
+        std::weak_ptr<std::vector<uint64_t>> weak = buffer;
+        buffer.reset();
+        EXPECT_FALSE(weak.expired()) << msg;
+        std::vector<double> doubled(expected);
+        for (auto& x : doubled)
+            x *= 2;
+        checkDecryption(cc->EvalAdd(adopted, adopted), doubled, msg + " EvalAdd");
+        adopted = nullptr;
+        read    = nullptr;
+        EXPECT_TRUE(weak.expired()) << msg;
+
+        // corrupt messages
+        std::string corrupt = message;
+        corrupt[0] = 'X';
+        EXPECT_THROW(GetCiphertextWireSize(corrupt.data(), corrupt.size()), OpenFHEException) << msg;
+        corrupt = message;
+        corrupt[8] = static_cast<char>(CIPHERTEXT_WIRE_VERSION + 1);
+        EXPECT_THROW(GetCiphertextWireSize(corrupt.data(), corrupt.size()), OpenFHEException) << msg;
+        std::stringstream truncated(message.substr(0, size - 8));
+        EXPECT_THROW(ReadCiphertextWire(cc, truncated), OpenFHEException) << msg;
+
+        // messages that do not match the context: ring dimension, format, encoding, the first modulus, more
+        // elements than the context relinearizes, an oversized key tag and an unreduced residue
+        auto expectMismatch = [&](size_t offset, const void* value, size_t width) {
+            std::string mismatch = message;
+            std::memcpy(&mismatch[offset], value, width);
+            std::stringstream stream(mismatch);
+            EXPECT_THROW(ReadCiphertextWire(cc, stream), OpenFHEException) << msg << " offset " << offset;
+            auto copy = std::make_shared<std::vector<uint64_t>>((size + 7) / 8);
+            std::memcpy(copy->data(), mismatch.data(), size);
+            EXPECT_THROW(AdoptCiphertextWire(cc, copy->data(), size, copy), OpenFHEException)
+                << msg << " offset " << offset;
+        };
+        const uint32_t ringDim{2048}, format{2}, encoding{CKKS_PACKED_ENCODING + 1};
+        const uint64_t modulus{cc->GetElementParams()->GetParams()[0]->GetModulus().ConvertToInt<uint64_t>() + 2};
+        expectMismatch(36, &ringDim, sizeof(ringDim));
+        expectMismatch(48, &format, sizeof(format));
+        expectMismatch(72, &encoding, sizeof(encoding));
+        expectMismatch(CIPHERTEXT_WIRE_PREFIX_SIZE, &modulus, sizeof(modulus));
+        const uint32_t numElements{1000}, keyTagSize{1 << 20};
+        expectMismatch(40, &numElements, sizeof(numElements));
+        expectMismatch(52, &keyTagSize, sizeof(keyTagSize));
+        uint32_t headerSize;
+        std::memcpy(&headerSize, message.data() + 12, sizeof(headerSize));
+        const uint64_t unreduced{modulus - 2};
+        expectMismatch(headerSize, &unreduced, sizeof(unreduced));
+    }
+
+    // a context with other moduli
+    parameters.SetScalingModSize(40);
+    CryptoContext<DCRTPoly> ccOther = GenCryptoContext(parameters);
+    std::stringstream other;
+    WriteCiphertextWire(other, ciphertext);
+    EXPECT_THROW(ReadCiphertextWire(ccOther, other), OpenFHEException) << "other context";
+
+#if defined(__unix__) || defined(__APPLE__)
+    // scatter/gather through a file descriptor
+    FILE* file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    int fd      = fileno(file);
+    size_t size = WriteCiphertextWire(fd, product);
+    size += WriteCiphertextWire(fd, ciphertext);
+    EXPECT_EQ(std::ftell(file), static_cast<long>(size)) << "file descriptor";
+    std::rewind(file);
+    auto first  = ReadCiphertextWire(cc, fd);
+    auto second = ReadCiphertextWire(cc, fd);
+    std::fclose(file);
+    EXPECT_EQ(product->GetElements(), first->GetElements()) << "file descriptor";
+    EXPECT_EQ(ciphertext->GetElements(), second->GetElements()) << "file descriptor";
+    checkDecryption(first, squares, "file descriptor");
+#endif
+}
+
+//===========================================================================================================
+TEST(UTCKKSRNS_SER, CKKSKeySeedExpansion) {
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetRingDim(1024);
+    parameters.SetMultiplicativeDepth(3);
+    parameters.SetScalingModSize(50);
+    parameters.SetSecurityLevel(HEStd_NotSet);
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+
+    const auto params = cc->GetElementParams();
+    const KeySeed seed = GenerateKeySeed();
+    const DCRTPoly a   = ExpandKeySeed(seed, 3, params);
+    EXPECT_EQ(a.GetFormat(), Format::EVALUATION);
+    EXPECT_EQ(a, ExpandKeySeed(seed, 3, params)) << "expansion is not deterministic";
+    EXPECT_NE(a, ExpandKeySeed(seed, 4, params)) << "indices share the expansion";
+    KeySeed otherSeed = seed;
+    otherSeed[7] ^= 1;
+    EXPECT_NE(a, ExpandKeySeed(otherSeed, 3, params)) << "seeds share the expansion";
+
+    // every tower only depends on (seed, index, tower), not on the other towers or the number of threads
+    std::vector<NativeInteger> moduli, roots;
+    for (size_t i = 0; i < 2; ++i) {
+        moduli.push_back(params->GetParams()[i]->GetModulus());
+        roots.push_back(params->GetParams()[i]->GetRootOfUnity());
+    }
+    auto prefix = std::make_shared<ILDCRTParams<BigInteger>>(params->GetCyclotomicOrder(), moduli, roots);
+    const DCRTPoly aPrefix = ExpandKeySeed(seed, 3, prefix);
+    for (size_t i = 0; i < moduli.size(); ++i)
+        EXPECT_EQ(a.GetElementAtIndex(i), aPrefix.GetElementAtIndex(i)) << "tower " << i;
+
+    // inside of a parallel region every expansion runs on a single thread
+    std::vector<DCRTPoly> aNested(2);
+#pragma omp parallel for num_threads(2)
+    for (size_t i = 0; i < aNested.size(); ++i)
+        aNested[i] = ExpandKeySeed(seed, 3, params);
+    for (const auto& x : aNested)
+        EXPECT_EQ(a, x) << "expansion depends on the number of threads";
+}
+
+//===========================================================================================================
+TEST(UTCKKSRNS_SER, CKKSSeededKeys) {
+    const std::vector<double> vals = {1.0, 3.0, 5.0, 7.0, 9.0, 2.0, 4.0, 6.0};
+    const std::vector<int32_t> indices{1, -2};
+
+    for (auto ksTech : {BV, HYBRID}) {
+        CCParams<CryptoContextCKKSRNS> parameters;
+        parameters.SetRingDim(1024);
+        parameters.SetMultiplicativeDepth(2);
+        parameters.SetScalingModSize(50);
+        parameters.SetBatchSize(vals.size());
+        parameters.SetKeySwitchTechnique(ksTech);
+        if (ksTech == BV)
+            parameters.SetDigitSize(20);
+        parameters.SetSecurityLevel(HEStd_NotSet);
+        CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+        cc->Enable(PKE);
+        cc->Enable(KEYSWITCH);
+        cc->Enable(LEVELEDSHE);
+
+        CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys();
+        CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+        KeyPair<DCRTPoly> kp = cc->KeyGen();
+        cc->EvalMultKeyGen(kp.secretKey);
+        cc->EvalRotateKeyGen(kp.secretKey, indices);
+
+        const std::string tag = kp.secretKey->GetKeyTag();
+        const auto multKey    = CryptoContextImpl<DCRTPoly>::GetEvalMultKeyVector(tag).at(0);
+        ASSERT_TRUE(kp.publicKey->HasPublicElementSeed()) << ksTech;
+        ASSERT_TRUE(multKey->HasAVectorSeed()) << ksTech;
+
+        auto checkKeys = [&](const std::string& msg) {
+            // keys read back regenerate bit-identical uniform components
+            const auto& key = CryptoContextImpl<DCRTPoly>::GetEvalMultKeyVector(tag).at(0);
+            EXPECT_TRUE(key->HasAVectorSeed()) << msg;
+            EXPECT_EQ(multKey->GetAVectorSeed(), key->GetAVectorSeed()) << msg;
+            EXPECT_EQ(multKey->GetAVector(), key->GetAVector()) << msg << " EvalMult key A differs";
+            EXPECT_EQ(multKey->GetBVector(), key->GetBVector()) << msg << " EvalMult key B differs";
+            for (auto& [index, rotKey] : CryptoContextImpl<DCRTPoly>::GetEvalAutomorphismKeyMap(tag))
+                EXPECT_TRUE(rotKey->HasAVectorSeed()) << msg << " automorphism " << index;
+        };
+
+        auto checkEvaluation = [&](const PublicKey<DCRTPoly>& publicKey, const std::string& msg) {
+            Ciphertext<DCRTPoly> ct = cc->Encrypt(publicKey, cc->MakeCKKSPackedPlaintext(vals));
+            Plaintext result;
+
+            std::vector<std::complex<double>> expected(vals.size());
+            for (size_t i = 0; i < vals.size(); ++i)
+                expected[i] = vals[i] * vals[i];
+            cc->Decrypt(kp.secretKey, cc->EvalMult(ct, ct), &result);
+            result->SetLength(vals.size());
+            checkEquality(expected, result->GetCKKSPackedValue(), 0.001, msg + " EvalMult decryption failed");
+
+            for (int32_t index : indices) {
+                for (size_t i = 0; i < vals.size(); ++i)
+                    expected[i] = vals[(i + vals.size() + index) % vals.size()];
+                cc->Decrypt(kp.secretKey, cc->EvalRotate(ct, index), &result);
+                result->SetLength(vals.size());
+                checkEquality(expected, result->GetCKKSPackedValue(), 0.001,
+                              msg + " EvalRotate(" + std::to_string(index) + ") decryption failed");
+            }
+        };
+
+        auto roundTrip = [&](const auto& sertype, const std::string& name) {
+            const std::string msg = name + " " + std::to_string(ksTech);
+
+            std::stringstream s;
+            Serial::Serialize(kp.publicKey, s, sertype);
+            PublicKey<DCRTPoly> publicKey;
+            Serial::Deserialize(publicKey, s, sertype);
+            ASSERT_TRUE(publicKey) << msg;
+            EXPECT_TRUE(publicKey->HasPublicElementSeed()) << msg;
+            EXPECT_EQ(kp.publicKey->GetPublicElements(), publicKey->GetPublicElements())
+                << msg << " public key differs";
+
+            std::stringstream sm, sa;
+            ASSERT_TRUE(CryptoContextImpl<DCRTPoly>::SerializeEvalMultKey(sm, sertype, tag)) << msg;
+            ASSERT_TRUE(CryptoContextImpl<DCRTPoly>::SerializeEvalAutomorphismKey(sa, sertype, tag)) << msg;
+            CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys();
+            CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+            ASSERT_TRUE(CryptoContextImpl<DCRTPoly>::DeserializeEvalMultKey(sm, sertype)) << msg;
+            ASSERT_TRUE(CryptoContextImpl<DCRTPoly>::DeserializeEvalAutomorphismKey(sa, sertype)) << msg;
+
+            checkKeys(msg);
+            checkEvaluation(publicKey, msg);
+        };
+        roundTrip(SerType::BINARY, "binary");
+        roundTrip(SerType::JSON, "json");
+
+        // an explicitly set A replaces the seed
+        auto fullKey = std::make_shared<EvalKeyRelinImpl<DCRTPoly>>(
+            *std::static_pointer_cast<EvalKeyRelinImpl<DCRTPoly>>(multKey));
+        fullKey->SetAVector(multKey->GetAVector());
+        EXPECT_FALSE(fullKey->HasAVectorSeed()) << ksTech;
+        EXPECT_EQ(multKey->GetAVector(), fullKey->GetAVector()) << ksTech;
+        EXPECT_EQ(multKey->GetBVector(), fullKey->GetBVector()) << ksTech;
+        std::stringstream seeded, full;
+        Serial::Serialize(multKey, seeded, SerType::BINARY);
+        Serial::Serialize(EvalKey<DCRTPoly>(fullKey), full, SerType::BINARY);
+        EXPECT_LT(seeded.str().size(), full.str().size()) << ksTech << " the seed is not written";
+
+        // keys written in full by version 1 of the library
+        auto fullPublicKey = std::make_shared<PublicKeyImpl<DCRTPoly>>(*kp.publicKey);
+        fullPublicKey->SetPublicElements(kp.publicKey->GetPublicElements());
+        EXPECT_FALSE(fullPublicKey->HasPublicElementSeed()) << ksTech;
+        auto toVersion1 = [](const std::string& json) {
+            // the version of the outermost object comes first
+            std::string v1 = std::regex_replace(json, std::regex("\"cereal_class_version\":\\s*2"),
+                                                "\"cereal_class_version\": 0", std::regex_constants::format_first_only);
+            return std::regex_replace(v1, std::regex("\"sd\":\\s*false,\\s*"), "");
+        };
+        std::stringstream pk1(toVersion1(Serial::SerializeToString(PublicKey<DCRTPoly>(fullPublicKey))));
+        std::stringstream ek1(toVersion1(Serial::SerializeToString(EvalKey<DCRTPoly>(fullKey))));
+        EXPECT_EQ(pk1.str().find("\"sd\""), std::string::npos) << ksTech;
+        PublicKey<DCRTPoly> publicKey1;
+        EvalKey<DCRTPoly> evalKey1;
+        Serial::Deserialize(publicKey1, pk1, SerType::JSON);
+        Serial::Deserialize(evalKey1, ek1, SerType::JSON);
+        ASSERT_TRUE(publicKey1) << ksTech;
+        ASSERT_TRUE(evalKey1) << ksTech;
+        EXPECT_FALSE(publicKey1->HasPublicElementSeed()) << ksTech;
+        EXPECT_FALSE(evalKey1->HasAVectorSeed()) << ksTech;
+        EXPECT_EQ(kp.publicKey->GetPublicElements(), publicKey1->GetPublicElements()) << ksTech;
+        EXPECT_EQ(multKey->GetAVector(), evalKey1->GetAVector()) << ksTech;
+        EXPECT_EQ(multKey->GetBVector(), evalKey1->GetBVector()) << ksTech;
+        checkEvaluation(publicKey1, "version 1 " + std::to_string(ksTech));
+
+        // concurrent first use of a key that is expanded lazily
+        std::stringstream s;
+        Serial::Serialize(multKey, s, SerType::BINARY);
+        EvalKey<DCRTPoly> lazyKey;
+        Serial::Deserialize(lazyKey, s, SerType::BINARY);
+        const int threads = 8;
+        std::vector<const std::vector<DCRTPoly>*> seen(threads);
+#pragma omp parallel for num_threads(threads) schedule(static, 1)
+        for (int i = 0; i < threads; ++i)
+            seen[i] = &lazyKey->GetAVector();
+        for (int i = 0; i < threads; ++i) {
+            EXPECT_EQ(seen[0], seen[i]) << ksTech << " thread " << i;
+            EXPECT_EQ(multKey->GetAVector(), *seen[i]) << ksTech << " thread " << i;
+        }
+    }
+    CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys();
+    CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+}